@@ -27,6 +27,18 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
    [1])
   ])
 
+ dnl Headers and functions used in libewf/libewf_direct_io_handle.c and libewf/libewf_memory_map.c
+ AC_CHECK_HEADERS([errno.h fcntl.h sys/mman.h sys/stat.h unistd.h])
+ AC_CHECK_FUNCS([fstat ftruncate mmap munmap posix_memalign pread pwrite stat])
+
+ dnl Monotonic clock function used in libewf/libewf_statistics.c
+ AC_SEARCH_LIBS([clock_gettime],[rt])
+ AC_CHECK_FUNCS([clock_gettime])
+
+ dnl Open file descriptors limit used in libewf/libewf_file_handle_pool.c
+ AC_CHECK_HEADERS([sys/resource.h])
+ AC_CHECK_FUNCS([getrlimit])
+
  dnl Check for internationalization functions in libewf/libewf_i18n.c 
  AC_CHECK_FUNCS([bindtextdomain])
  ])
@@ -119,7 +119,7 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -hOqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -161,6 +161,7 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     use direct (unbuffered) IO to write the segment files\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -1588,6 +1589,7 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                                          = 0;
 	uint8_t swap_byte_pairs                                         = 0;
 	uint8_t use_chunk_data_functions                                = 0;
+	uint8_t use_direct_io                                           = 0;
 	uint8_t verbose                                                 = 0;
 	uint8_t zero_buffer_on_error                                    = 0;
 	int8_t acquiry_parameters_confirmed                             = 0;
@@ -1627,7 +1629,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:Op:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1742,6 +1744,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1983,6 +1990,17 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( imaging_handle_set_direct_io(
+	     ewfacquire_imaging_handle,
+	     use_direct_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set direct IO.\n" );
+
+		goto on_error;
+	}
 	if( device_handle_get_media_size(
 	     ewfacquire_device_handle,
 	     &( ewfacquire_imaging_handle->input_media_size ),
@@ -112,7 +112,7 @@ void usage_fprint(
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -S segment_file_size ] [ -t target ] [ -hOqsuvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -147,6 +147,8 @@ void usage_fprint(
 	                 "\t           if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
+	fprintf( stream, "\t-O:        use direct (unbuffered) IO to read the input and write the\n"
+	                 "\t           EWF output segment files\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-s:        swap byte pairs of the media data (from AB to BA)\n"
@@ -270,6 +272,7 @@ int main( int argc, char * const argv[] )
 	uint8_t print_status_information                              = 1;
 	uint8_t swap_byte_pairs                                       = 0;
 	uint8_t use_chunk_data_functions                              = 0;
+	uint8_t use_direct_io                                         = 0;
 	uint8_t verbose                                               = 0;
 	uint8_t zero_chunk_on_error                                   = 0;
 	int interactive_mode                                          = 1;
@@ -333,7 +336,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:Op:qsS:t:uvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -408,6 +411,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -588,6 +596,17 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	if( export_handle_set_direct_io(
+	     ewfexport_export_handle,
+	     use_direct_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set direct IO.\n" );
+
+		goto on_error;
+	}
 	result = export_handle_open_input(
 	          ewfexport_export_handle,
 	          source_filenames,
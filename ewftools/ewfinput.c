@@ -492,6 +492,32 @@ int ewfinput_determine_compression_method(
 			result              = 1;
 		}
 	}
+#endif
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+	if( string_length == 3 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "lz4" ),
+		     3 ) == 0 )
+		{
+			*compression_method = LIBEWF_COMPRESSION_METHOD_LZ4;
+			result              = 1;
+		}
+	}
+#endif
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+	if( string_length == 4 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "zstd" ),
+		     4 ) == 0 )
+		{
+			*compression_method = LIBEWF_COMPRESSION_METHOD_ZSTD;
+			result              = 1;
+		}
+	}
 #endif
 	return( result );
 }
@@ -77,10 +77,15 @@
 #include "ewftools_libcsystem.h"
 #include "ewftools_libewf.h"
 #include "mount_handle.h"
+#include "nbd_server.h"
 
 mount_handle_t *ewfmount_mount_handle = NULL;
 int ewfmount_abort                    = 0;
 
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+nbd_server_t *ewfmount_nbd_server     = NULL;
+#endif
+
 /* Prints the executable usage information
  */
 void usage_fprint(
@@ -93,15 +98,19 @@ void usage_fprint(
 	fprintf( stream, "Use ewfmount to mount the EWF format (Expert Witness\n"
                          "Compression Format)\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ]\n"
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hnvV ]\n"
 	                 "                ewf_files mount_point\n\n" );
 
 	fprintf( stream, "\tewf_files:   the first or the entire set of EWF segment files\n\n" );
-	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
+	fprintf( stream, "\tmount_point: the directory to serve as mount point, or the path\n"
+	                 "\t             of the Unix domain socket when -n is used\n\n" );
 
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default),\n"
 	                 "\t             files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-n:          serve the media data as a read-only network block\n"
+	                 "\t             device (NBD) export on a Unix domain socket instead\n"
+	                 "\t             of mounting it, restricted to the raw format\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             ewfmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -136,6 +145,24 @@ void ewfmount_signal_handler(
 			 &error );
 		}
 	}
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+	if( ewfmount_nbd_server != NULL )
+	{
+		if( nbd_server_signal_abort(
+		     ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD server to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 	if( libcsystem_file_io_close(
@@ -167,6 +194,7 @@ int ewfmount_fuse_open(
 	libewf_file_entry_t *file_entry = NULL;
 	static char *function           = "ewfmount_fuse_open";
 	size_t path_length              = 0;
+	uint64_t stream_identifier      = 0;
 	int result                      = 0;
 
 	if( path == NULL )
@@ -271,6 +299,27 @@ int ewfmount_fuse_open(
 
 		goto on_error;
 	}
+	if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	{
+		if( mount_handle_open_stream(
+		     ewfmount_mount_handle,
+		     &stream_identifier,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to open stream.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	file_info->fh = stream_identifier;
+
 	return( 0 );
 
 on_error:
@@ -290,6 +339,74 @@ on_error:
 	return( result );
 }
 
+/* Releases a file
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int ewfmount_fuse_release(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewfmount_fuse_release";
+	int result               = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( mount_handle_close_stream(
+	     ewfmount_mount_handle,
+	     (uint64_t) file_info->fh,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close stream.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	file_info->fh = 0;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
 /* Reads a buffer of data at the specified offset
  * Returns number of bytes read if successful or a negative errno value otherwise
  */
@@ -298,7 +415,7 @@ int ewfmount_fuse_read(
      char *buffer,
      size_t size,
      off_t offset,
-     struct fuse_file_info *file_info LIBCSYSTEM_ATTRIBUTE_UNUSED )
+     struct fuse_file_info *file_info )
 {
 	libcerror_error_t *error        = NULL;
 	libewf_file_entry_t *file_entry = NULL;
@@ -373,27 +490,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -475,27 +576,12 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
+			      (uint64_t) file_info->fh,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1357,6 +1443,7 @@ int __stdcall ewfmount_dokan_CreateFile(
 	libewf_file_entry_t *file_entry = NULL;
 	static char *function           = "ewfmount_dokan_CreateFile";
 	size_t path_length              = 0;
+	uint64_t stream_identifier      = 0;
 	int result                      = 0;
 
 	LIBCSYSTEM_UNREFERENCED_PARAMETER( share_mode )
@@ -1502,6 +1589,23 @@ int __stdcall ewfmount_dokan_CreateFile(
 
 			goto on_error;
 		}
+		if( mount_handle_open_stream(
+		     ewfmount_mount_handle,
+		     &stream_identifier,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to open stream.",
+			 function );
+
+			result = -ERROR_GEN_FAILURE;
+
+			goto on_error;
+		}
+		file_info->Context = (ULONG64) stream_identifier;
 	}
 	return( 0 );
 
@@ -1646,14 +1750,12 @@ on_error:
  */
 int __stdcall ewfmount_dokan_CloseFile(
                const wchar_t *path,
-               DOKAN_FILE_INFO *file_info LIBCSYSTEM_ATTRIBUTE_UNUSED )
+               DOKAN_FILE_INFO *file_info )
 {
 	libcerror_error_t *error = NULL;
 	static char *function    = "ewfmount_dokan_CloseFile";
 	int result               = 0;
 
-	LIBCSYSTEM_UNREFERENCED_PARAMETER( file_info )
-
 	if( path == NULL )
 	{
 		libcerror_error_set(
@@ -1667,6 +1769,37 @@ int __stdcall ewfmount_dokan_CloseFile(
 
 		goto on_error;
 	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -ERROR_BAD_ARGUMENTS;
+
+		goto on_error;
+	}
+	if( mount_handle_close_stream(
+	     ewfmount_mount_handle,
+	     (uint64_t) file_info->Context,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close stream.",
+		 function );
+
+		result = -ERROR_GEN_FAILURE;
+
+		goto on_error;
+	}
+	file_info->Context = 0;
+
 	return( 0 );
 
 on_error:
@@ -1689,7 +1822,7 @@ int __stdcall ewfmount_dokan_ReadFile(
                DWORD number_of_bytes_to_read,
                DWORD *number_of_bytes_read,
                LONGLONG offset,
-               DOKAN_FILE_INFO *file_info LIBCSYSTEM_ATTRIBUTE_UNUSED )
+               DOKAN_FILE_INFO *file_info )
 {
 	libcerror_error_t *error        = NULL;
 	libewf_file_entry_t *file_entry = NULL;
@@ -1700,8 +1833,6 @@ int __stdcall ewfmount_dokan_ReadFile(
 	int result                      = 0;
 	int string_index                = 0;
 
-	LIBCSYSTEM_UNREFERENCED_PARAMETER( file_info )
-
 	if( path == NULL )
 	{
 		libcerror_error_set(
@@ -1728,6 +1859,19 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 		goto on_error;
 	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -ERROR_BAD_ARGUMENTS;
+
+		goto on_error;
+	}
 	if( number_of_bytes_read == NULL )
 	{
 		libcerror_error_set(
@@ -1868,27 +2012,12 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
+			      (uint64_t) file_info->Context,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -3096,6 +3225,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_integer_t option                      = 0;
 	int number_of_filenames                                 = 0;
 	int result                                              = 0;
+	int use_nbd_server                                      = 0;
 	int verbose                                             = 0;
 
 #if !defined( HAVE_GLOB_H )
@@ -3147,7 +3277,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "f:hvVX:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "f:hnvVX:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -3174,6 +3304,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'n':
+				use_nbd_server = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'v':
 				verbose = 1;
 
@@ -3337,6 +3472,108 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( use_nbd_server != 0 )
+	{
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+		if( ewfmount_mount_handle->input_format != MOUNT_HANDLE_INPUT_FORMAT_RAW )
+		{
+			fprintf(
+			 stderr,
+			 "NBD export is restricted to the raw format.\n" );
+
+			goto on_error;
+		}
+		if( nbd_server_initialize(
+		     &ewfmount_nbd_server,
+		     ewfmount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize NBD server.\n" );
+
+			goto on_error;
+		}
+		if( nbd_server_open(
+		     ewfmount_nbd_server,
+		     mount_point,
+		     libcstring_narrow_string_length(
+		      mount_point ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open NBD server on: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+			 mount_point );
+
+			goto on_error;
+		}
+		if( libcsystem_signal_attach(
+		     ewfmount_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		fprintf(
+		 stdout,
+		 "Serving NBD export on: %" PRIs_LIBCSTRING_SYSTEM "\n",
+		 mount_point );
+
+		result = nbd_server_run(
+		          ewfmount_nbd_server,
+		          &error );
+
+		if( libcsystem_signal_detach(
+		     NULL ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run NBD server.\n" );
+
+			goto on_error;
+		}
+		if( nbd_server_free(
+		     &ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free NBD server.\n" );
+
+			goto on_error;
+		}
+		if( mount_handle_free(
+		     &ewfmount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free mount handle.\n" );
+
+			goto on_error;
+		}
+		return( EXIT_SUCCESS );
+#else
+		fprintf(
+		 stderr,
+		 "No NBD server support.\n" );
+
+		goto on_error;
+#endif
+	}
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	if( memory_set(
 	     &ewfmount_fuse_operations,
@@ -3385,6 +3622,7 @@ int main( int argc, char * const argv[] )
 		}
 	}
 	ewfmount_fuse_operations.open    = &ewfmount_fuse_open;
+	ewfmount_fuse_operations.release = &ewfmount_fuse_release;
 	ewfmount_fuse_operations.read    = &ewfmount_fuse_read;
 	ewfmount_fuse_operations.readdir = &ewfmount_fuse_readdir;
 	ewfmount_fuse_operations.getattr = &ewfmount_fuse_getattr;
@@ -3429,8 +3667,15 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Reads are positional and can be served by multiple threads
+	 */
+	result = fuse_loop_mt(
+	          ewfmount_fuse_handle );
+#else
 	result = fuse_loop(
 	          ewfmount_fuse_handle );
+#endif
 
 	if( result != 0 )
 	{
@@ -3591,6 +3836,14 @@ on_error:
 	}
 	fuse_opt_free_args(
 	 &ewfmount_fuse_arguments );
+#endif
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+	if( ewfmount_nbd_server != NULL )
+	{
+		nbd_server_free(
+		 &ewfmount_nbd_server,
+		 NULL );
+	}
 #endif
 	if( ewfmount_mount_handle != NULL )
 	{
@@ -66,7 +66,7 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
 	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	                 "                 [ -hOqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -85,6 +85,7 @@ void usage_fprint(
 	                 "\t           if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
+	fprintf( stream, "\t-O:        use direct (unbuffered) IO to read the segment files\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
@@ -166,6 +167,7 @@ int main( int argc, char * const argv[] )
 	uint8_t calculate_md5                                         = 1;
 	uint8_t print_status_information                              = 1;
 	uint8_t use_chunk_data_functions                              = 0;
+	uint8_t use_direct_io                                         = 0;
 	uint8_t verbose                                               = 0;
 	uint8_t zero_chunk_on_error                                   = 0;
 	int number_of_filenames                                       = 0;
@@ -204,7 +206,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:j:hl:Op:qvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -251,6 +253,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (libcstring_system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -513,6 +520,17 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	if( verification_handle_set_direct_io(
+	     ewfverify_verification_handle,
+	     use_direct_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set direct IO.\n" );
+
+		goto on_error;
+	}
 	result = verification_handle_open_input(
 	          ewfverify_verification_handle,
 	          source_filenames,
@@ -23,6 +23,10 @@
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #if defined( WINAPI )
 #include <rpcdce.h>
 
@@ -55,6 +59,8 @@
 #define EXPORT_HANDLE_STRING_SIZE		1024
 #define EXPORT_HANDLE_NOTIFY_STREAM		stderr
 
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_PENDING_SINGLE_FILES	16384
+
 /* Creates an export handle
  * Make sure the value export_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -299,17 +305,17 @@ int export_handle_free(
 				result = -1;
 			}
 		}
-		if( ( *export_handle )->md5_context != NULL )
+		if( ( *export_handle )->integrity_hash != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *export_handle )->md5_context ),
+			if( integrity_hash_free(
+			     &( ( *export_handle )->integrity_hash ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free integrity hash.",
 				 function );
 
 				result = -1;
@@ -320,43 +326,11 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->calculated_md5_hash_string );
 		}
-		if( ( *export_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *export_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *export_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
 			 ( *export_handle )->calculated_sha1_hash_string );
 		}
-		if( ( *export_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *export_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *export_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -482,6 +456,32 @@ int export_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_direct_io(
+     export_handle_t *export_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_direct_io";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->use_direct_io = use_direct_io;
+
+	return( 1 );
+}
+
 /* Opens the input of the export handle
  * Returns 1 if successful or -1 on error
  */
@@ -494,6 +494,7 @@ int export_handle_open_input(
 	libcstring_system_character_t **libewf_filenames = NULL;
 	static char *function                            = "export_handle_open_input";
 	size_t first_filename_length                     = 0;
+	int access_flags                                 = LIBEWF_OPEN_READ;
 
 	if( export_handle == NULL )
 	{
@@ -562,19 +563,23 @@ int export_handle_open_input(
 		}
 		filenames = (libcstring_system_character_t * const *) libewf_filenames;
 	}
+	if( export_handle->use_direct_io != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+	}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     export_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     export_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -799,6 +804,7 @@ int export_handle_open_output(
 	libcstring_system_character_t *filenames[ 1 ] = { NULL };
 	static char *function                         = "export_handle_open_output";
 	size_t filename_length                        = 0;
+	int access_flags                              = LIBEWF_OPEN_WRITE;
 
 	if( export_handle == NULL )
 	{
@@ -862,19 +868,23 @@ int export_handle_open_output(
 		}
 		filenames[ 0 ] = (libcstring_system_character_t *) filename;
 
+		if( export_handle->use_direct_io != 0 )
+		{
+			access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+		}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 		if( libewf_handle_open_wide(
 		     export_handle->ewf_output_handle,
 		     filenames,
 		     1,
-		     LIBEWF_OPEN_WRITE,
+		     access_flags,
 		     error ) != 1 )
 #else
 		if( libewf_handle_open(
 		     export_handle->ewf_output_handle,
 		     filenames,
 		     1,
-		     LIBEWF_OPEN_WRITE,
+		     access_flags,
 		     error ) != 1 )
 #endif
 		{
@@ -964,6 +974,7 @@ int export_handle_open_output(
 
 				return( -1 );
 			}
+			export_handle->write_sparse = 1;
 		}
 	}
 	return( 1 );
@@ -1150,6 +1161,26 @@ ssize_t export_handle_write_storage_media_buffer(
 				       storage_media_buffer->raw_buffer,
 				       write_size );
 		}
+		/* Zero-filled data is skipped so that the output file becomes sparse,
+		 * the last buffer is always written to set the size of the output file
+		 */
+		else if( ( export_handle->write_sparse != 0 )
+		      && ( storage_media_buffer->is_sparse != 0 )
+		      && ( ( (size64_t) storage_media_buffer->storage_media_offset + write_size ) < export_handle->export_size ) )
+		{
+			if( libsmraw_handle_seek_offset(
+			     export_handle->raw_output_handle,
+			     (off64_t) write_size,
+			     SEEK_CUR,
+			     error ) == -1 )
+			{
+				write_count = -1;
+			}
+			else
+			{
+				write_count = (ssize_t) write_size;
+			}
+		}
 		else
 		{
 			write_count = libsmraw_handle_write_buffer(
@@ -1303,73 +1334,35 @@ int export_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_initialize(
-		     &( export_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		export_handle->md5_context_initialized = 1;
-	}
-	if( export_handle->calculate_sha1 != 0 )
+	if( export_handle->integrity_hash != NULL )
 	{
-		if( libhmac_sha1_initialize(
-		     &( export_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - integrity hash value already set.",
+		 function );
 
-			goto on_error;
-		}
-		export_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	if( integrity_hash_initialize(
+	     &( export_handle->integrity_hash ),
+	     export_handle->calculate_md5,
+	     export_handle->calculate_sha1,
+	     export_handle->calculate_sha256,
+	     (uint8_t) ( export_handle->number_of_threads != 0 ),
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( export_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create integrity hash.",
+		 function );
 
-			goto on_error;
-		}
-		export_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( export_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( export_handle->sha1_context ),
-		 NULL );
-	}
-	if( export_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( export_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -1394,98 +1387,114 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( integrity_hash_update(
+	     export_handle->integrity_hash,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update integrity hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	return( 1 );
+}
+
+/* Finalizes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_finalize_integrity_hash(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_finalize_integrity_hash";
+
+	if( export_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( integrity_hash_finalize(
+	     export_handle->integrity_hash,
+	     export_handle->calculated_md5_hash_string,
+	     33,
+	     export_handle->calculated_sha1_hash_string,
+	     41,
+	     export_handle->calculated_sha256_hash_string,
+	     65,
+	     error ) != 1 )
 	{
-		if( libhmac_md5_update(
-		     export_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( export_handle->calculate_sha1 != 0 )
+	return( 1 );
+}
+
+/* Determines if the input is corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int export_handle_input_is_corrupted(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_input_is_corrupted";
+	int result            = 0;
+
+	if( export_handle == NULL )
 	{
-		if( libhmac_sha1_update(
-		     export_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	result = libewf_handle_segment_files_corrupted(
+	          export_handle->input_handle,
+	          error );
+
+	if( result == -1 )
 	{
-		if( libhmac_sha256_update(
-		     export_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Finalizes the integrity hash(es)
+/* Retrieves the chunk size
  * Returns 1 if successful or -1 on error
  */
-int export_handle_finalize_integrity_hash(
+int export_handle_get_output_chunk_size(
      export_handle_t *export_handle,
+     size32_t *chunk_size,
      libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
-	static char *function = "export_handle_finalize_integrity_hash";
+	static char *function = "export_handle_get_output_chunk_size";
 
 	if( export_handle == NULL )
 	{
@@ -1498,153 +1507,66 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( chunk_size == NULL )
 	{
-		if( export_handle->calculated_md5_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated MD5 hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk size.",
+		 function );
 
-			return( -1 );
-		}
-		if( libhmac_md5_finalize(
-		     export_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
+		return( -1 );
+	}
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( export_handle->ewf_output_handle == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing ewf output handle.",
 			 function );
 
 			return( -1 );
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     export_handle->calculated_md5_hash_string,
-		     33,
+		if( libewf_handle_get_chunk_size(
+		     export_handle->ewf_output_handle,
+		     chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk size.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( export_handle->calculate_sha1 != 0 )
-	{
-		if( export_handle->calculated_sha1_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated SHA1 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha1_finalize(
-		     export_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     export_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( export_handle->calculate_sha256 != 0 )
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
 	{
-		if( export_handle->calculated_sha256_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated SHA256 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha256_finalize(
-		     export_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     export_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
-			 function );
-
-			return( -1 );
-		}
+		*chunk_size = export_handle->input_chunk_size;
 	}
 	return( 1 );
 }
 
-/* Determines if the input is corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Determines if the chunks can be passed through from input to output
+ * This requires EWF output with the same chunk size and compression values as the input
+ * and an export range that is chunk aligned
+ * Returns 1 if supported, 0 if not or -1 on error
  */
-int export_handle_input_is_corrupted(
+int export_handle_supports_chunk_passthrough(
      export_handle_t *export_handle,
+     uint8_t swap_byte_pairs,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_input_is_corrupted";
-	int result            = 0;
+	static char *function       = "export_handle_supports_chunk_passthrough";
+	uint16_t compression_method = 0;
+	uint8_t compression_flags   = 0;
+	int8_t compression_level    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1657,87 +1579,59 @@ int export_handle_input_is_corrupted(
 
 		return( -1 );
 	}
-	result = libewf_handle_segment_files_corrupted(
-	          export_handle->input_handle,
-	          error );
-
-	if( result == -1 )
+	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( swap_byte_pairs != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if segment files are corrupted.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	return( result );
-}
-
-/* Retrieves the chunk size
- * Returns 1 if successful or -1 on error
- */
-int export_handle_get_output_chunk_size(
-     export_handle_t *export_handle,
-     size32_t *chunk_size,
-     libcerror_error_t **error )
-{
-	static char *function = "export_handle_get_output_chunk_size";
-
-	if( export_handle == NULL )
+	if( ( export_handle->input_chunk_size == 0 )
+	 || ( export_handle->output_chunk_size != export_handle->input_chunk_size ) )
+	{
+		return( 0 );
+	}
+	if( ( export_handle->export_offset % export_handle->input_chunk_size ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( export_handle->export_offset + export_handle->export_size ) != (uint64_t) export_handle->input_media_size )
+	 && ( ( export_handle->export_size % export_handle->input_chunk_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &compression_method,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression method.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_size == NULL )
+	if( libewf_handle_get_compression_values(
+	     export_handle->input_handle,
+	     &compression_level,
+	     &compression_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression values.",
 		 function );
 
 		return( -1 );
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
-	{
-		if( export_handle->ewf_output_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing ewf output handle.",
-			 function );
-
-			return( -1 );
-		}
-		if( libewf_handle_get_chunk_size(
-		     export_handle->ewf_output_handle,
-		     chunk_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk size.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	if( ( compression_method != export_handle->compression_method )
+	 || ( compression_level != export_handle->compression_level )
+	 || ( compression_flags != export_handle->compression_flags ) )
 	{
-		*chunk_size = export_handle->input_chunk_size;
+		return( 0 );
 	}
 	return( 1 );
 }
@@ -3878,6 +3772,23 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( export_handle->number_of_threads > 1 )
+		{
+			if( libewf_handle_set_number_of_compression_threads(
+			     export_handle->ewf_output_handle,
+			     export_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of compression threads.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( copy_input_values == 0 )
 		{
 			if( libewf_handle_set_sectors_per_chunk(
@@ -3975,6 +3886,14 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		/* Zero-filled data is only skipped when the output is written to a single file,
+		 * segmented output is written without gaps
+		 */
+		if( ( export_handle->maximum_segment_size != 0 )
+		 && ( export_handle->maximum_segment_size < export_handle->export_size ) )
+		{
+			export_handle->write_sparse = 0;
+		}
 	}
 	return( 1 );
 }
@@ -4203,6 +4122,29 @@ ssize_t export_handle_write(
 
 		return( -1 );
 	}
+	if( export_handle->use_chunk_passthrough != 0 )
+	{
+		/* The packed chunk data of the input data chunk is written as-is
+		 */
+		write_count = export_handle_write_storage_media_buffer(
+			       export_handle,
+			       input_storage_media_buffer,
+			       input_size,
+			       error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) input_size );
+	}
 	if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	{
 		if( output_storage_media_buffer == NULL )
@@ -4706,7 +4648,8 @@ int export_handle_output_storage_media_buffer_callback(
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( export_handle->use_chunk_data_functions != 0 )
+		if( ( export_handle->use_chunk_data_functions != 0 )
+		 && ( export_handle->use_chunk_passthrough == 0 ) )
 		{
 			if( storage_media_buffer_initialize(
 			     &output_storage_media_buffer,
@@ -5046,6 +4989,7 @@ int export_handle_export_input(
 	ssize_t write_count                                 = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
+	int result                                          = 0;
 	int status                                          = PROCESS_STATUS_COMPLETED;
 
 	if( export_handle == NULL )
@@ -5146,6 +5090,46 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( export_handle_get_output_chunk_size(
+		     export_handle,
+		     &( export_handle->output_chunk_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the output chunk size.",
+			 function );
+
+			goto on_error;
+		}
+		result = export_handle_supports_chunk_passthrough(
+		          export_handle,
+		          swap_byte_pairs,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk passthrough is supported.",
+			 function );
+
+			goto on_error;
+		}
+		/* The chunks are passed through using the chunk data functions
+		 */
+		else if( result != 0 )
+		{
+			export_handle->use_chunk_data_functions = 1;
+			export_handle->use_chunk_passthrough    = 1;
+		}
+	}
 	if( export_handle->use_chunk_data_functions != 0 )
 	{
 		if( export_handle_get_output_chunk_size(
@@ -5370,12 +5354,24 @@ int export_handle_export_input(
 		{
 			read_size = (size_t) remaining_export_size;
 		}
-		read_count = storage_media_buffer_read_from_handle(
-		              input_storage_media_buffer,
-		              export_handle->input_handle,
-		              read_size,
-		              error );
+		read_count = 0;
 
+		if( export_handle->write_sparse != 0 )
+		{
+			read_count = storage_media_buffer_read_sparse_from_handle(
+			              input_storage_media_buffer,
+			              export_handle->input_handle,
+			              read_size,
+			              error );
+		}
+		if( read_count == 0 )
+		{
+			read_count = storage_media_buffer_read_from_handle(
+			              input_storage_media_buffer,
+			              export_handle->input_handle,
+			              read_size,
+			              error );
+		}
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -5515,6 +5511,7 @@ int export_handle_export_input(
 			export_handle->last_offset_hashed += input_storage_media_buffer->processed_size;
 
 			if( ( export_handle->use_chunk_data_functions != 0 )
+			 && ( export_handle->use_chunk_passthrough == 0 )
 			 && ( output_storage_media_buffer == NULL ) )
 			{
 				if( storage_media_buffer_initialize(
@@ -5997,26 +5994,92 @@ int export_handle_export_single_files(
 	 "Created directory: %" PRIs_LIBCSTRING_SYSTEM ".\n",
 	 export_handle->target_path );
 
-	result = export_handle_export_file_entry(
-	          export_handle,
-	          file_entry,
-	          export_handle->target_path,
-	          export_path_size,
-	          export_path_size - 1,
-	          log_handle,
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to export root file entry.",
-		 function );
-
-		goto on_error;
-	}
+		if( libcthreads_mutex_initialize(
+		     &( export_handle->single_files_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create single files mutex.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->pending_single_files = (export_single_file_t **) memory_allocate(
+		                                                                 sizeof( export_single_file_t * ) * EXPORT_HANDLE_MAXIMUM_NUMBER_OF_PENDING_SINGLE_FILES );
+
+		if( export_handle->pending_single_files == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create pending single files.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->number_of_pending_single_files = 0;
+		export_handle->single_files_sequence_number   = 0;
+	}
+#endif
+	result = export_handle_export_file_entry(
+	          export_handle,
+	          &file_entry,
+	          export_handle->target_path,
+	          export_path_size,
+	          export_path_size - 1,
+	          log_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export root file entry.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->pending_single_files != NULL )
+	{
+		if( export_handle_export_pending_single_files(
+		     export_handle,
+		     log_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export pending single files.",
+			 function );
+
+			goto on_error;
+		}
+		if( export_handle_free_pending_single_files(
+		     export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pending single files.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( export_handle->abort != 0 )
 	{
 		status = PROCESS_STATUS_ABORTED;
@@ -6065,6 +6128,11 @@ int export_handle_export_single_files(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	export_handle_free_pending_single_files(
+	 export_handle,
+	 NULL );
+#endif
 	if( export_handle->process_status != NULL )
 	{
 		process_status_stop(
@@ -6086,11 +6154,13 @@ on_error:
 }
 
 /* Exports a (single) file entry
+ * When the file entry data is exported by the single files thread pool
+ * the file entry is taken over and set to NULL
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const libcstring_system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
@@ -6117,7 +6187,8 @@ int export_handle_export_file_entry(
 
 		return( -1 );
 	}
-	if( file_entry == NULL )
+	if( ( file_entry == NULL )
+	 || ( *file_entry == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -6129,7 +6200,7 @@ int export_handle_export_file_entry(
 		return( -1 );
 	}
 	if( libewf_file_entry_get_type(
-	     file_entry,
+	     *file_entry,
 	     &file_entry_type,
 	     error ) != 1 )
 	{
@@ -6144,12 +6215,12 @@ int export_handle_export_file_entry(
 	}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libewf_file_entry_get_utf16_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #else
 	result = libewf_file_entry_get_utf8_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #endif
@@ -6182,13 +6253,13 @@ int export_handle_export_file_entry(
 		}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libewf_file_entry_get_utf16_name(
-		          file_entry,
+		          *file_entry,
 		          (uint16_t *) name,
 		          name_size,
 		          error );
 #else
 		result = libewf_file_entry_get_utf8_name(
-		          file_entry,
+		          *file_entry,
 		          (uint8_t *) name,
 		          name_size,
 		          error );
@@ -6317,9 +6388,33 @@ int export_handle_export_file_entry(
 			 "Single file: %" PRIs_LIBCSTRING_SYSTEM "\n",
 			 &( target_path[ file_entry_path_index ] ) );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( export_handle->pending_single_files != NULL )
+			{
+				if( export_handle_push_single_file(
+				     export_handle,
+				     file_entry,
+				     &target_path,
+				     target_path_size,
+				     file_entry_path_index,
+				     log_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push single file.",
+					 function );
+
+					goto on_error;
+				}
+				return( 1 );
+			}
+#endif
 			return_value = export_handle_export_file_entry_data(
 				        export_handle,
-			                file_entry,
+			                *file_entry,
 			                target_path,
 			                error );
 
@@ -6389,7 +6484,7 @@ int export_handle_export_file_entry(
 	{
 		result = export_handle_export_file_entry_sub_file_entries(
 		          export_handle,
-		          file_entry,
+		          *file_entry,
 		          target_path,
 		          target_path_size,
 		          file_entry_path_index,
@@ -6772,7 +6867,7 @@ int export_handle_export_file_entry_sub_file_entries(
 		}
 		result = export_handle_export_file_entry(
 		          export_handle,
-		          sub_file_entry,
+		          &sub_file_entry,
 		          export_path,
 		          export_path_size,
 		          file_entry_path_index,
@@ -6822,6 +6917,528 @@ on_error:
 	return( -1 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Pushes a single file to be exported by the single files thread pool
+ * The file entry and target path are taken over and set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_push_single_file(
+     export_handle_t *export_handle,
+     libewf_file_entry_t **file_entry,
+     libcstring_system_character_t **target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	export_single_file_t *single_file = NULL;
+	static char *function             = "export_handle_push_single_file";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->pending_single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing pending single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_single_file_initialize(
+	     &single_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_media_data_offset(
+	     *file_entry,
+	     &( single_file->media_data_offset ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media data offset.",
+		 function );
+
+		goto on_error;
+	}
+	single_file->file_entry            = *file_entry;
+	single_file->target_path           = *target_path;
+	single_file->target_path_size      = target_path_size;
+	single_file->file_entry_path_index = file_entry_path_index;
+	single_file->sequence_number       = export_handle->single_files_sequence_number;
+
+	*file_entry  = NULL;
+	*target_path = NULL;
+
+	export_handle->pending_single_files[ export_handle->number_of_pending_single_files ] = single_file;
+
+	export_handle->number_of_pending_single_files += 1;
+	export_handle->single_files_sequence_number   += 1;
+
+	if( export_handle->number_of_pending_single_files >= EXPORT_HANDLE_MAXIMUM_NUMBER_OF_PENDING_SINGLE_FILES )
+	{
+		if( export_handle_export_pending_single_files(
+		     export_handle,
+		     log_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export pending single files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( single_file != NULL )
+	{
+		export_single_file_free(
+		 &single_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports the pending single files using the single files thread pool
+ * The single files are exported in order of their media data offset so that
+ * the input is read mostly sequentially
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_pending_single_files(
+     export_handle_t *export_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	export_single_file_t *previous_single_file = NULL;
+	export_single_file_t *single_file          = NULL;
+	static char *function                      = "export_handle_export_pending_single_files";
+	int single_file_index                      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->pending_single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing pending single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->single_files_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - single files thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_pending_single_files == 0 )
+	{
+		return( 1 );
+	}
+	/* Single files that have the same target path as a single file encountered
+	 * before are skipped, like they would be if the data was exported directly
+	 */
+	qsort(
+	 export_handle->pending_single_files,
+	 (size_t) export_handle->number_of_pending_single_files,
+	 sizeof( export_single_file_t * ),
+	 (int (*)(const void *, const void *)) &export_single_file_compare_by_target_path );
+
+	for( single_file_index = 0;
+	     single_file_index < export_handle->number_of_pending_single_files;
+	     single_file_index++ )
+	{
+		single_file = export_handle->pending_single_files[ single_file_index ];
+
+		if( ( previous_single_file != NULL )
+		 && ( previous_single_file->target_path_size == single_file->target_path_size )
+		 && ( libcstring_system_string_compare(
+		       previous_single_file->target_path,
+		       single_file->target_path,
+		       single_file->target_path_size ) == 0 ) )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Skipping file entry it already exists.\n" );
+
+			single_file->skip = 1;
+		}
+		previous_single_file = single_file;
+	}
+	qsort(
+	 export_handle->pending_single_files,
+	 (size_t) export_handle->number_of_pending_single_files,
+	 sizeof( export_single_file_t * ),
+	 (int (*)(const void *, const void *)) &export_single_file_compare_by_media_data_offset );
+
+	export_handle->single_files_log_handle = log_handle;
+	export_handle->single_files_error      = 0;
+
+	/* The queue can hold all pending single files, the memory used while exporting
+	 * is bound by the number of threads since every thread uses a single process buffer
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( export_handle->single_files_thread_pool ),
+	     NULL,
+	     export_handle->number_of_threads,
+	     export_handle->number_of_pending_single_files,
+	     (int (*)(intptr_t *, void *)) &export_handle_export_single_file_callback,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize single files thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( single_file_index = 0;
+	     single_file_index < export_handle->number_of_pending_single_files;
+	     single_file_index++ )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		single_file = export_handle->pending_single_files[ single_file_index ];
+
+		if( single_file->skip != 0 )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_push(
+		     export_handle->single_files_thread_pool,
+		     (intptr_t *) single_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push single file: %d onto single files thread pool queue.",
+			 function,
+			 single_file_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &( export_handle->single_files_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join single files thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->single_files_error != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export single file data.",
+		 function );
+
+		goto on_error;
+	}
+	for( single_file_index = 0;
+	     single_file_index < export_handle->number_of_pending_single_files;
+	     single_file_index++ )
+	{
+		if( export_single_file_free(
+		     &( export_handle->pending_single_files[ single_file_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single file: %d.",
+			 function,
+			 single_file_index );
+
+			goto on_error;
+		}
+	}
+	export_handle->number_of_pending_single_files = 0;
+	export_handle->single_files_sequence_number   = 0;
+
+	return( 1 );
+
+on_error:
+	if( export_handle->single_files_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->single_files_thread_pool ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports the data of a single file
+ * Callback function for the single files thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_single_file_callback(
+     export_single_file_t *single_file,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_export_single_file_callback";
+	int result               = 0;
+
+	if( single_file == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	result = export_handle_export_file_entry_data(
+	          export_handle,
+	          single_file->file_entry,
+	          single_file->target_path,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export file entry data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     export_handle->single_files_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab single files mutex.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 export_handle->notify_stream,
+		 "Single file: %" PRIs_LIBCSTRING_SYSTEM " FAILED\n",
+		 &( single_file->target_path[ single_file->file_entry_path_index ] ) );
+
+		if( export_handle->single_files_log_handle != NULL )
+		{
+			log_handle_printf(
+			 export_handle->single_files_log_handle,
+			 "Single file: %" PRIs_LIBCSTRING_SYSTEM " FAILED\n",
+			 &( single_file->target_path[ single_file->file_entry_path_index ] ) );
+		}
+		if( libcthreads_mutex_release(
+		     export_handle->single_files_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release single files mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( export_handle != NULL )
+	{
+		/* Setting the value is atomic hence the mutex is not needed
+		 */
+		export_handle->single_files_error = 1;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Frees the pending single files
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_pending_single_files(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_pending_single_files";
+	int result            = 1;
+	int single_file_index = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->pending_single_files != NULL )
+	{
+		for( single_file_index = 0;
+		     single_file_index < export_handle->number_of_pending_single_files;
+		     single_file_index++ )
+		{
+			if( export_single_file_free(
+			     &( export_handle->pending_single_files[ single_file_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free single file: %d.",
+				 function,
+				 single_file_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 export_handle->pending_single_files );
+
+		export_handle->pending_single_files           = NULL;
+		export_handle->number_of_pending_single_files = 0;
+	}
+	if( export_handle->single_files_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( export_handle->single_files_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Print the hash values to a stream
  * Returns 1 if successful or -1 on error
  */
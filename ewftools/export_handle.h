@@ -32,7 +32,9 @@
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "integrity_hash.h"
 #include "ewftools_libsmraw.h"
+#include "export_single_file.h"
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
@@ -104,17 +106,13 @@ struct export_handle
 	 */
 	int header_codepage;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
-	 */
-	uint8_t calculate_md5;
-
-	/* The MD5 digest context
+	/* The integrity hash
 	 */
-	libhmac_md5_context_t *md5_context;
+	integrity_hash_t *integrity_hash;
 
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -124,14 +122,6 @@ struct export_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha1_hash_string;
@@ -140,14 +130,6 @@ struct export_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha256_hash_string;
@@ -156,6 +138,15 @@ struct export_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the packed chunk data of the input should be written
+	 * to the output without compressing it again
+	 */
+	uint8_t use_chunk_passthrough;
+
+	/* Value to indicate if the segment files should be accessed using direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -182,6 +173,35 @@ struct export_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The single files thread pool
+	 */
+	libcthreads_thread_pool_t *single_files_thread_pool;
+
+	/* The single files mutex
+	 */
+	libcthreads_mutex_t *single_files_mutex;
+
+	/* The pending single files
+	 * these are exported by the single files thread pool in order of their media data offset
+	 */
+	export_single_file_t **pending_single_files;
+
+	/* The number of pending single files
+	 */
+	int number_of_pending_single_files;
+
+	/* The single files sequence number
+	 */
+	int single_files_sequence_number;
+
+	/* The log handle used by the single files thread pool
+	 */
+	log_handle_t *single_files_log_handle;
+
+	/* Value to indicate exporting a single file failed with an error
+	 */
+	uint8_t single_files_error;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -196,6 +216,12 @@ struct export_handle
 	 */
 	uint8_t use_stdout;
 
+	/* Value to indicate if zero-filled data should be skipped
+	 * instead of written, which makes the raw output file sparse
+	 * this is only used when the raw output is a single file
+	 */
+	uint8_t write_sparse;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
@@ -268,6 +294,11 @@ int export_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int export_handle_set_direct_io(
+     export_handle_t *export_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error );
+
 int export_handle_check_write_access(
      export_handle_t *export_handle,
      const libcstring_system_character_t *filename,
@@ -340,6 +371,11 @@ int export_handle_get_output_chunk_size(
      size32_t *chunk_size,
      libcerror_error_t **error );
 
+int export_handle_supports_chunk_passthrough(
+     export_handle_t *export_handle,
+     uint8_t swap_byte_pairs,
+     libcerror_error_t **error );
+
 int export_handle_prompt_for_string(
      export_handle_t *export_handle,
      const libcstring_system_character_t *request_string,
@@ -505,7 +541,7 @@ int export_handle_export_single_files(
 
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const libcstring_system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
@@ -527,6 +563,32 @@ int export_handle_export_file_entry_sub_file_entries(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_push_single_file(
+     export_handle_t *export_handle,
+     libewf_file_entry_t **file_entry,
+     libcstring_system_character_t **target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int export_handle_export_pending_single_files(
+     export_handle_t *export_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int export_handle_export_single_file_callback(
+     export_single_file_t *single_file,
+     export_handle_t *export_handle );
+
+int export_handle_free_pending_single_files(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int export_handle_hash_values_fprint(
      export_handle_t *export_handle,
      FILE *stream,
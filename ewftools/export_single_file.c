@@ -0,0 +1,232 @@
+/*
+ * Single file export
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libewf.h"
+#include "export_single_file.h"
+
+/* Creates a single file
+ * Make sure the value single_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_single_file_initialize(
+     export_single_file_t **single_file,
+     libcerror_error_t **error )
+{
+	static char *function = "export_single_file_initialize";
+
+	if( single_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*single_file = memory_allocate_structure(
+	                export_single_file_t );
+
+	if( *single_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create single file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *single_file,
+	     0,
+	     sizeof( export_single_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear single file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *single_file != NULL )
+	{
+		memory_free(
+		 *single_file );
+
+		*single_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a single file
+ * This includes the file entry and target path
+ * Returns 1 if successful or -1 on error
+ */
+int export_single_file_free(
+     export_single_file_t **single_file,
+     libcerror_error_t **error )
+{
+	static char *function = "export_single_file_free";
+	int result            = 1;
+
+	if( single_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file != NULL )
+	{
+		if( ( *single_file )->file_entry != NULL )
+		{
+			if( libewf_file_entry_free(
+			     &( ( *single_file )->file_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *single_file )->target_path != NULL )
+		{
+			memory_free(
+			 ( *single_file )->target_path );
+		}
+		memory_free(
+		 *single_file );
+
+		*single_file = NULL;
+	}
+	return( result );
+}
+
+/* Compares two single files by their target path
+ * If the target paths are equal the sequence numbers are compared
+ * Returns -1 if the first is less than the second, 0 if equal or 1 if greater
+ */
+int export_single_file_compare_by_target_path(
+     const export_single_file_t **first_single_file,
+     const export_single_file_t **second_single_file )
+{
+	size_t compare_size = 0;
+	int result          = 0;
+
+	compare_size = ( *first_single_file )->target_path_size;
+
+	if( ( *second_single_file )->target_path_size < compare_size )
+	{
+		compare_size = ( *second_single_file )->target_path_size;
+	}
+	result = libcstring_system_string_compare(
+	          ( *first_single_file )->target_path,
+	          ( *second_single_file )->target_path,
+	          compare_size );
+
+	if( result < 0 )
+	{
+		return( -1 );
+	}
+	else if( result > 0 )
+	{
+		return( 1 );
+	}
+	if( ( *first_single_file )->target_path_size < ( *second_single_file )->target_path_size )
+	{
+		return( -1 );
+	}
+	else if( ( *first_single_file )->target_path_size > ( *second_single_file )->target_path_size )
+	{
+		return( 1 );
+	}
+	if( ( *first_single_file )->sequence_number < ( *second_single_file )->sequence_number )
+	{
+		return( -1 );
+	}
+	else if( ( *first_single_file )->sequence_number > ( *second_single_file )->sequence_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares two single files by their media data offset
+ * If the media data offsets are equal the sequence numbers are compared
+ * Returns -1 if the first is less than the second, 0 if equal or 1 if greater
+ */
+int export_single_file_compare_by_media_data_offset(
+     const export_single_file_t **first_single_file,
+     const export_single_file_t **second_single_file )
+{
+	if( ( *first_single_file )->media_data_offset < ( *second_single_file )->media_data_offset )
+	{
+		return( -1 );
+	}
+	else if( ( *first_single_file )->media_data_offset > ( *second_single_file )->media_data_offset )
+	{
+		return( 1 );
+	}
+	if( ( *first_single_file )->sequence_number < ( *second_single_file )->sequence_number )
+	{
+		return( -1 );
+	}
+	else if( ( *first_single_file )->sequence_number > ( *second_single_file )->sequence_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,91 @@
+/*
+ * Single file export
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_SINGLE_FILE_H )
+#define _EXPORT_SINGLE_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct export_single_file export_single_file_t;
+
+struct export_single_file
+{
+	/* The file entry
+	 */
+	libewf_file_entry_t *file_entry;
+
+	/* The target path
+	 */
+	libcstring_system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The index of the file entry path in the target path
+	 */
+	size_t file_entry_path_index;
+
+	/* The media data offset
+	 */
+	off64_t media_data_offset;
+
+	/* The sequence number
+	 * the order in which the file entries were encountered
+	 */
+	int sequence_number;
+
+	/* Value to indicate the single file should not be exported
+	 */
+	uint8_t skip;
+};
+
+int export_single_file_initialize(
+     export_single_file_t **single_file,
+     libcerror_error_t **error );
+
+int export_single_file_free(
+     export_single_file_t **single_file,
+     libcerror_error_t **error );
+
+int export_single_file_compare_by_target_path(
+     const export_single_file_t **first_single_file,
+     const export_single_file_t **second_single_file );
+
+int export_single_file_compare_by_media_data_offset(
+     const export_single_file_t **first_single_file,
+     const export_single_file_t **second_single_file );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_SINGLE_FILE_H ) */
+
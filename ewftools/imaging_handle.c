@@ -288,17 +288,17 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
-		if( ( *imaging_handle )->md5_context != NULL )
+		if( ( *imaging_handle )->integrity_hash != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *imaging_handle )->md5_context ),
+			if( integrity_hash_free(
+			     &( ( *imaging_handle )->integrity_hash ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free integrity hash.",
 				 function );
 
 				result = -1;
@@ -309,43 +309,11 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_md5_hash_string );
 		}
-		if( ( *imaging_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *imaging_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *imaging_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
 			 ( *imaging_handle )->calculated_sha1_hash_string );
 		}
-		if( ( *imaging_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *imaging_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *imaging_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -558,6 +526,32 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_direct_io(
+     imaging_handle_t *imaging_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_direct_io";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->use_direct_io = use_direct_io;
+
+	return( 1 );
+}
+
 /* Opens the output of the imaging handle
  * Returns 1 if successful or -1 on error
  */
@@ -638,6 +632,10 @@ int imaging_handle_open_output(
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
+	if( imaging_handle->use_direct_io != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+	}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     imaging_handle->output_handle,
@@ -798,6 +796,10 @@ int imaging_handle_open_secondary_output(
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
+	if( imaging_handle->use_direct_io != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+	}
 	if( libewf_handle_initialize(
 	     &( imaging_handle->secondary_output_handle ),
 	     error ) != 1 )
@@ -1296,73 +1298,35 @@ int imaging_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( imaging_handle->integrity_hash != NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( imaging_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		imaging_handle->md5_context_initialized = 1;
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_initialize(
-		     &( imaging_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - integrity hash value already set.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( integrity_hash_initialize(
+	     &( imaging_handle->integrity_hash ),
+	     imaging_handle->calculate_md5,
+	     imaging_handle->calculate_sha1,
+	     imaging_handle->calculate_sha256,
+	     (uint8_t) ( imaging_handle->number_of_threads != 0 ),
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( imaging_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create integrity hash.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( imaging_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( imaging_handle->sha1_context ),
-		 NULL );
-	}
-	if( imaging_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( imaging_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -1387,83 +1351,21 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( integrity_hash_update(
+	     imaging_handle->integrity_hash,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update integrity hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     imaging_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     imaging_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_update(
-		     imaging_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	return( 1 );
 }
 
@@ -1474,10 +1376,6 @@ int imaging_handle_finalize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
 	static char *function = "imaging_handle_finalize_integrity_hash";
 
 	if( imaging_handle == NULL )
@@ -1491,140 +1389,24 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( imaging_handle->calculated_md5_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_md5_finalize(
-		     imaging_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     imaging_handle->calculated_md5_hash_string,
-		     33,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( imaging_handle->calculated_sha1_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated SHA1 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha1_finalize(
-		     imaging_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     imaging_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( integrity_hash_finalize(
+	     imaging_handle->integrity_hash,
+	     imaging_handle->calculated_md5_hash_string,
+	     33,
+	     imaging_handle->calculated_sha1_hash_string,
+	     41,
+	     imaging_handle->calculated_sha256_hash_string,
+	     65,
+	     error ) != 1 )
 	{
-		if( imaging_handle->calculated_sha256_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated SHA256 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     imaging_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -4926,6 +4708,23 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	if( imaging_handle->number_of_threads > 1 )
+	{
+		if( libewf_handle_set_number_of_compression_threads(
+		     imaging_handle->output_handle,
+		     imaging_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of compression threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( libewf_handle_set_sectors_per_chunk(
 	     imaging_handle->output_handle,
 	     imaging_handle->sectors_per_chunk,
@@ -5090,6 +4889,23 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( imaging_handle->number_of_threads > 1 )
+		{
+			if( libewf_handle_set_number_of_compression_threads(
+			     imaging_handle->secondary_output_handle,
+			     imaging_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of compression threads in secondary output handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		if( libewf_handle_set_sectors_per_chunk(
 		     imaging_handle->secondary_output_handle,
 		     imaging_handle->sectors_per_chunk,
@@ -6275,6 +6091,18 @@ int imaging_handle_print_parameters(
 		 imaging_handle->notify_stream,
 		 "bzip2" );
 	}
+	else if( imaging_handle->compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "zstd" );
+	}
+	else if( imaging_handle->compression_method == LIBEWF_COMPRESSION_METHOD_LZ4 )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "lz4" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
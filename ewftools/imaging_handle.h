@@ -32,6 +32,7 @@
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "integrity_hash.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 
@@ -155,17 +156,13 @@ struct imaging_handle
 	 */
 	uint64_t acquiry_size;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
+	/* The integrity hash
 	 */
-	uint8_t calculate_md5;
+	integrity_hash_t *integrity_hash;
 
-	/* The MD5 digest context
-	 */
-	libhmac_md5_context_t *md5_context;
-
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -175,14 +172,6 @@ struct imaging_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha1_hash_string;
@@ -191,14 +180,6 @@ struct imaging_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha256_hash_string;
@@ -207,6 +188,10 @@ struct imaging_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the segment files should be accessed using direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -283,6 +268,11 @@ int imaging_handle_check_write_access(
      const libcstring_system_character_t *filename,
      libcerror_error_t **error );
 
+int imaging_handle_set_direct_io(
+     imaging_handle_t *imaging_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error );
+
 int imaging_handle_open_output(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *filename,
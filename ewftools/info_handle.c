@@ -2460,6 +2460,14 @@ int info_handle_media_information_fprint(
 		{
 			value_string = _LIBCSTRING_SYSTEM_STRING( "bzip2" );
 		}
+		else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+		{
+			value_string = _LIBCSTRING_SYSTEM_STRING( "zstd" );
+		}
+		else if( compression_method == LIBEWF_COMPRESSION_METHOD_LZ4 )
+		{
+			value_string = _LIBCSTRING_SYSTEM_STRING( "lz4" );
+		}
 		if( info_handle_section_value_string_fprint(
 		     info_handle,
 		     "compression_method",
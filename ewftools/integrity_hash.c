@@ -0,0 +1,1279 @@
+/*
+ * Integrity hash functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "integrity_hash.h"
+
+/* Creates an integrity hash
+ * Make sure the value integrity_hash is referencing, is set to NULL
+ * If use_threads is set and more than one digest hash is calculated
+ * every additional digest hash is calculated by a separate thread
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_initialize(
+     integrity_hash_t **integrity_hash,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     uint8_t use_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "integrity_hash_initialize";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *integrity_hash != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid integrity hash value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*integrity_hash = memory_allocate_structure(
+	                   integrity_hash_t );
+
+	if( *integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *integrity_hash,
+	     0,
+	     sizeof( integrity_hash_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear integrity hash.",
+		 function );
+
+		memory_free(
+		 *integrity_hash );
+
+		*integrity_hash = NULL;
+
+		return( -1 );
+	}
+	( *integrity_hash )->calculate_md5    = calculate_md5;
+	( *integrity_hash )->calculate_sha1   = calculate_sha1;
+	( *integrity_hash )->calculate_sha256 = calculate_sha256;
+	( *integrity_hash )->digest_type      = -1;
+
+	if( calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( ( *integrity_hash )->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *integrity_hash )->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *integrity_hash )->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( calculate_md5 != 0 )
+	{
+		( *integrity_hash )->digest_type = INTEGRITY_HASH_DIGEST_TYPE_MD5;
+	}
+	else if( calculate_sha1 != 0 )
+	{
+		( *integrity_hash )->digest_type = INTEGRITY_HASH_DIGEST_TYPE_SHA1;
+	}
+	else if( calculate_sha256 != 0 )
+	{
+		( *integrity_hash )->digest_type = INTEGRITY_HASH_DIGEST_TYPE_SHA256;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_threads != 0 )
+	{
+		if( integrity_hash_start_workers(
+		     *integrity_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start workers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *integrity_hash != NULL )
+	{
+		integrity_hash_free(
+		 integrity_hash,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an integrity hash
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_free(
+     integrity_hash_t **integrity_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "integrity_hash_free";
+	int result            = 1;
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *integrity_hash != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( integrity_hash_stop_workers(
+		     *integrity_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop workers.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *integrity_hash )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *integrity_hash )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *integrity_hash )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *integrity_hash )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *integrity_hash )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *integrity_hash )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *integrity_hash );
+
+		*integrity_hash = NULL;
+	}
+	return( result );
+}
+
+/* Updates a specific digest hash
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_update_digest(
+     integrity_hash_t *integrity_hash,
+     int digest_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "integrity_hash_update_digest";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_type )
+	{
+		case INTEGRITY_HASH_DIGEST_TYPE_MD5:
+			if( libhmac_md5_update(
+			     integrity_hash->md5_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update MD5 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case INTEGRITY_HASH_DIGEST_TYPE_SHA1:
+			if( libhmac_sha1_update(
+			     integrity_hash->sha1_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA1 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case INTEGRITY_HASH_DIGEST_TYPE_SHA256:
+			if( libhmac_sha256_update(
+			     integrity_hash->sha256_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA256 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts a worker thread for every digest hash other than the one
+ * calculated by the thread that calls update
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_start_workers(
+     integrity_hash_t *integrity_hash,
+     libcerror_error_t **error )
+{
+	uint8_t calculate_digest[ INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES ];
+
+	integrity_hash_worker_t *worker = NULL;
+	static char *function           = "integrity_hash_start_workers";
+	int digest_type                 = 0;
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->mutex != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid integrity hash - mutex value already set.",
+		 function );
+
+		return( -1 );
+	}
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_MD5 ]    = integrity_hash->calculate_md5;
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_SHA1 ]   = integrity_hash->calculate_sha1;
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_SHA256 ] = integrity_hash->calculate_sha256;
+
+	/* A single digest hash is calculated by the calling thread directly
+	 */
+	if( ( integrity_hash->digest_type == -1 )
+	 || ( ( calculate_digest[ 0 ] + calculate_digest[ 1 ] + calculate_digest[ 2 ] ) <= 1 ) )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( integrity_hash->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( integrity_hash->update_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create update condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( integrity_hash->completed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completed condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( digest_type = 0;
+	     digest_type < INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( ( calculate_digest[ digest_type ] == 0 )
+		 || ( digest_type == integrity_hash->digest_type ) )
+		{
+			continue;
+		}
+		worker = &( integrity_hash->workers[ integrity_hash->number_of_workers ] );
+
+		worker->integrity_hash     = integrity_hash;
+		worker->digest_type        = digest_type;
+		worker->last_update_number = integrity_hash->update_number;
+
+		if( libcthreads_thread_create(
+		     &( worker->thread ),
+		     NULL,
+		     (int (*)(void *)) &integrity_hash_worker_function,
+		     (void *) worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker thread: %d.",
+			 function,
+			 integrity_hash->number_of_workers );
+
+			goto on_error;
+		}
+		integrity_hash->number_of_workers += 1;
+	}
+	return( 1 );
+
+on_error:
+	integrity_hash_stop_workers(
+	 integrity_hash,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Stops the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_stop_workers(
+     integrity_hash_t *integrity_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "integrity_hash_stop_workers";
+	int result            = 1;
+	int worker_index      = 0;
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->number_of_workers > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		integrity_hash->abort = 1;
+
+		if( libcthreads_condition_broadcast(
+		     integrity_hash->update_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast update condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		for( worker_index = 0;
+		     worker_index < integrity_hash->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( integrity_hash->workers[ worker_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker thread: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		integrity_hash->number_of_workers = 0;
+
+		if( integrity_hash->worker_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: worker thread failed.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( integrity_hash->completed_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( integrity_hash->completed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( integrity_hash->update_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( integrity_hash->update_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free update condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( integrity_hash->mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( integrity_hash->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Worker thread function that updates a single digest hash
+ * with every buffer passed to update
+ * If the worker exits on error it marks the workers as failed
+ * and wakes the thread that is waiting for the update to complete
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_worker_function(
+     integrity_hash_worker_t *worker )
+{
+	libcerror_error_t *error         = NULL;
+	integrity_hash_t *integrity_hash = NULL;
+	const uint8_t *buffer            = NULL;
+	static char *function            = "integrity_hash_worker_function";
+	size_t buffer_size               = 0;
+	uint8_t has_mutex                = 0;
+	uint8_t is_pending               = 0;
+	int result                       = 0;
+
+	if( worker == NULL )
+	{
+		return( -1 );
+	}
+	integrity_hash = worker->integrity_hash;
+
+	if( libcthreads_mutex_grab(
+	     integrity_hash->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	has_mutex = 1;
+
+	while( integrity_hash->abort == 0 )
+	{
+		if( integrity_hash->update_number == worker->last_update_number )
+		{
+			if( libcthreads_condition_wait(
+			     integrity_hash->update_condition,
+			     integrity_hash->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for update condition.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		worker->last_update_number = integrity_hash->update_number;
+
+		buffer      = integrity_hash->buffer;
+		buffer_size = integrity_hash->buffer_size;
+		is_pending  = 1;
+
+		/* The buffer remains valid until all the workers have completed
+		 * the update hence the digest hash is updated without the mutex
+		 */
+		if( libcthreads_mutex_release(
+		     integrity_hash->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		has_mutex = 0;
+
+		result = integrity_hash_update_digest(
+		          integrity_hash,
+		          worker->digest_type,
+		          buffer,
+		          buffer_size,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		has_mutex = 1;
+
+		if( result != 1 )
+		{
+			integrity_hash->update_failed = 1;
+		}
+		integrity_hash->number_of_pending_workers -= 1;
+
+		is_pending = 0;
+
+		if( integrity_hash->number_of_pending_workers == 0 )
+		{
+			if( libcthreads_condition_signal(
+			     integrity_hash->completed_condition,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal completed condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     integrity_hash->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( has_mutex == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	/* An update that was broadcast but not yet picked up
+	 * by the worker also counts the worker as pending
+	 */
+	if( ( integrity_hash->number_of_pending_workers > 0 )
+	 && ( integrity_hash->update_number != worker->last_update_number ) )
+	{
+		is_pending = 1;
+	}
+	if( is_pending != 0 )
+	{
+		integrity_hash->number_of_pending_workers -= 1;
+	}
+	integrity_hash->worker_failed = 1;
+
+	libcthreads_condition_broadcast(
+	 integrity_hash->completed_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 integrity_hash->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Updates the integrity hash
+ * The digest hashes calculated by the worker threads are updated
+ * with the same buffer concurrently, the function returns when all
+ * digest hashes have been updated so that the buffer can be reused
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_update(
+     integrity_hash_t *integrity_hash,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t calculate_digest[ INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES ];
+
+	static char *function = "integrity_hash_update";
+	int digest_type       = 0;
+	int result            = 1;
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->digest_type == -1 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( integrity_hash->number_of_workers > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* A worker that exited on error no longer picks up updates
+		 */
+		if( integrity_hash->worker_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker thread failed.",
+			 function );
+
+			libcthreads_mutex_release(
+			 integrity_hash->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		integrity_hash->buffer                    = buffer;
+		integrity_hash->buffer_size               = buffer_size;
+		integrity_hash->number_of_pending_workers = integrity_hash->number_of_workers;
+		integrity_hash->update_failed             = 0;
+		integrity_hash->update_number            += 1;
+
+		if( libcthreads_condition_broadcast(
+		     integrity_hash->update_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast update condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 integrity_hash->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_release(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_MD5 ]    = integrity_hash->calculate_md5;
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_SHA1 ]   = integrity_hash->calculate_sha1;
+	calculate_digest[ INTEGRITY_HASH_DIGEST_TYPE_SHA256 ] = integrity_hash->calculate_sha256;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The additional digest hashes are calculated by the workers
+	 */
+	if( integrity_hash->number_of_workers > 0 )
+	{
+		for( digest_type = 0;
+		     digest_type < INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( digest_type != integrity_hash->digest_type )
+			{
+				calculate_digest[ digest_type ] = 0;
+			}
+		}
+	}
+#endif
+	for( digest_type = 0;
+	     digest_type < INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( calculate_digest[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		if( integrity_hash_update_digest(
+		     integrity_hash,
+		     digest_type,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Wait for the workers even if the update failed
+	 * since they could still be reading from the buffer
+	 */
+	if( integrity_hash->number_of_workers > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( integrity_hash->number_of_pending_workers > 0 )
+		{
+			if( libcthreads_condition_wait(
+			     integrity_hash->completed_condition,
+			     integrity_hash->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for completed condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 integrity_hash->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		integrity_hash->buffer      = NULL;
+		integrity_hash->buffer_size = 0;
+
+		if( ( result == 1 )
+		 && ( ( integrity_hash->update_failed != 0 )
+		  || ( integrity_hash->worker_failed != 0 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash in worker thread.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Finalizes the integrity hash and copies the digest hashes
+ * to the corresponding strings
+ * Returns 1 if successful or -1 on error
+ */
+int integrity_hash_finalize(
+     integrity_hash_t *integrity_hash,
+     libcstring_system_character_t *md5_hash_string,
+     size_t md5_hash_string_size,
+     libcstring_system_character_t *sha1_hash_string,
+     size_t sha1_hash_string_size,
+     libcstring_system_character_t *sha256_hash_string,
+     size_t sha256_hash_string_size,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function = "integrity_hash_finalize";
+
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->calculate_md5 != 0 )
+	{
+		if( md5_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_md5_finalize(
+		     integrity_hash->md5_context,
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     md5_hash_string,
+		     md5_hash_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->calculate_sha1 != 0 )
+	{
+		if( sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_sha1_finalize(
+		     integrity_hash->sha1_context,
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     sha1_hash_string,
+		     sha1_hash_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( integrity_hash->calculate_sha256 != 0 )
+	{
+		if( sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_sha256_finalize(
+		     integrity_hash->sha256_context,
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     sha256_hash_string,
+		     sha256_hash_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,209 @@
+/*
+ * Integrity hash functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _INTEGRITY_HASH_H )
+#define _INTEGRITY_HASH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum INTEGRITY_HASH_DIGEST_TYPES
+{
+	INTEGRITY_HASH_DIGEST_TYPE_MD5		= 0,
+	INTEGRITY_HASH_DIGEST_TYPE_SHA1		= 1,
+	INTEGRITY_HASH_DIGEST_TYPE_SHA256	= 2
+};
+
+#define INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES	3
+
+typedef struct integrity_hash integrity_hash_t;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct integrity_hash_worker integrity_hash_worker_t;
+
+struct integrity_hash_worker
+{
+	/* The integrity hash
+	 */
+	integrity_hash_t *integrity_hash;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The number of the last update that was processed
+	 */
+	uint32_t last_update_number;
+};
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+struct integrity_hash
+{
+	/* Value to indicate if the MD5 digest hash should be calculated
+	 */
+	uint8_t calculate_md5;
+
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* Value to indicate if the SHA1 digest hash should be calculated
+	 */
+	uint8_t calculate_sha1;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The digest type that is calculated by the thread that calls update
+	 */
+	int digest_type;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The workers, one per additional digest type
+	 */
+	integrity_hash_worker_t workers[ INTEGRITY_HASH_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals the workers an update is available
+	 */
+	libcthreads_condition_t *update_condition;
+
+	/* The condition that signals the workers completed the update
+	 */
+	libcthreads_condition_t *completed_condition;
+
+	/* The buffer of the current update
+	 */
+	const uint8_t *buffer;
+
+	/* The buffer size of the current update
+	 */
+	size_t buffer_size;
+
+	/* The number of the current update
+	 */
+	uint32_t update_number;
+
+	/* The number of workers that have not yet completed the current update
+	 */
+	int number_of_pending_workers;
+
+	/* Value to indicate a worker failed to update its digest hash
+	 */
+	uint8_t update_failed;
+
+	/* Value to indicate a worker thread exited on error
+	 */
+	uint8_t worker_failed;
+
+	/* Value to indicate the workers should stop
+	 */
+	uint8_t abort;
+#endif
+};
+
+int integrity_hash_initialize(
+     integrity_hash_t **integrity_hash,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     uint8_t use_threads,
+     libcerror_error_t **error );
+
+int integrity_hash_free(
+     integrity_hash_t **integrity_hash,
+     libcerror_error_t **error );
+
+int integrity_hash_update_digest(
+     integrity_hash_t *integrity_hash,
+     int digest_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int integrity_hash_start_workers(
+     integrity_hash_t *integrity_hash,
+     libcerror_error_t **error );
+
+int integrity_hash_stop_workers(
+     integrity_hash_t *integrity_hash,
+     libcerror_error_t **error );
+
+int integrity_hash_worker_function(
+     integrity_hash_worker_t *worker );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int integrity_hash_update(
+     integrity_hash_t *integrity_hash,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int integrity_hash_finalize(
+     integrity_hash_t *integrity_hash,
+     libcstring_system_character_t *md5_hash_string,
+     size_t md5_hash_string_size,
+     libcstring_system_character_t *sha1_hash_string,
+     size_t sha1_hash_string_size,
+     libcstring_system_character_t *sha256_hash_string,
+     size_t sha256_hash_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -24,7 +24,9 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
 #include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "mount_handle.h"
 
@@ -101,6 +103,21 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *mount_handle )->streams_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize streams mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
 	return( 1 );
@@ -108,6 +125,12 @@ int mount_handle_initialize(
 on_error:
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->input_handle != NULL )
+		{
+			libewf_handle_free(
+			 &( ( *mount_handle )->input_handle ),
+			 NULL );
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -139,6 +162,24 @@ int mount_handle_free(
 	}
 	if( *mount_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *mount_handle )->prefetch_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *mount_handle )->prefetch_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join prefetch thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *mount_handle )->root_file_entry != NULL )
 		{
 			if( libewf_file_entry_free(
@@ -168,6 +209,21 @@ int mount_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *mount_handle )->streams_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free streams mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *mount_handle );
 
@@ -316,6 +372,7 @@ int mount_handle_open_input(
 	libcstring_system_character_t **libewf_filenames = NULL;
 	static char *function                            = "mount_handle_open_input";
 	size_t first_filename_length                     = 0;
+	uint32_t chunk_size                              = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -350,6 +407,27 @@ int mount_handle_open_input(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	{
+		/* Make sure the chunks cache can hold the prefetched chunks of multiple streams
+		 */
+		if( libewf_handle_set_chunks_cache_size(
+		     mount_handle->input_handle,
+		     MOUNT_HANDLE_PREFETCH_CHUNKS_CACHE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunks cache size in input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( number_of_filenames == 1 )
 	{
 		first_filename_length = libcstring_system_string_length(
@@ -464,6 +542,63 @@ int mount_handle_open_input(
 			return( -1 );
 		}
 	}
+	else if( mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	{
+		if( libewf_handle_get_media_size(
+		     mount_handle->input_handle,
+		     &( mount_handle->media_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media size.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_get_chunk_size(
+		     mount_handle->input_handle,
+		     &chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk size.",
+			 function );
+
+			return( -1 );
+		}
+		mount_handle->prefetch_size = (size_t) chunk_size * MOUNT_HANDLE_PREFETCH_NUMBER_OF_CHUNKS;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( mount_handle->prefetch_size > 0 )
+		 && ( mount_handle->prefetch_thread_pool == NULL ) )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( mount_handle->prefetch_thread_pool ),
+			     NULL,
+			     MOUNT_HANDLE_NUMBER_OF_PREFETCH_THREADS,
+			     MOUNT_HANDLE_MAXIMUM_NUMBER_OF_PREFETCHES,
+			     (int (*)(intptr_t *, void *)) &mount_handle_prefetch_callback,
+			     (void *) mount_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create prefetch thread pool.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+	}
 	return( 1 );
 }
 
@@ -487,6 +622,27 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The prefetch threads read from the input handle
+	 * make sure they are finished before the input handle is closed
+	 */
+	if( mount_handle->prefetch_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( mount_handle->prefetch_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join prefetch thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_handle_close(
 	     mount_handle->input_handle,
 	     error ) != 0 )
@@ -500,6 +656,20 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     mount_handle->streams,
+	     0,
+	     sizeof( mount_stream_t ) * MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear streams.",
+		 function );
+
+		return( -1 );
+	}
 	return( 0 );
 }
 
@@ -546,6 +716,210 @@ ssize_t mount_handle_read_buffer(
 	return( read_count );
 }
 
+/* Reads a buffer at a specific offset from the input handle
+ * The read does not change the current offset of the input handle
+ * and can be done by multiple threads at the same time
+ * If the stream identifier is not 0, sequential reads of the stream are detected
+ * and the data that follows is prefetched
+ * Prefetching is best-effort, it is skipped when the prefetch thread pool queue is full
+ * Return the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint64_t stream_identifier,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	off64_t prefetch_offsets[ 2 ];
+
+	mount_stream_t *stream     = NULL;
+	off64_t *prefetch_offset   = NULL;
+	size_t prefetch_block_size = 0;
+	int number_of_prefetches   = 0;
+	int prefetch_index         = 0;
+#endif
+	static char *function      = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count         = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              mount_handle->input_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from input handle.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( stream_identifier == 0 )
+	 || ( read_count == 0 )
+	 || ( mount_handle->prefetch_thread_pool == NULL ) )
+	{
+		return( read_count );
+	}
+	/* The prefetch window is filled in 2 blocks, when half of the window
+	 * has been read the next block is prefetched
+	 */
+	prefetch_block_size = mount_handle->prefetch_size / 2;
+
+	if( libcthreads_mutex_grab(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle_get_stream(
+	     mount_handle,
+	     stream_identifier,
+	     &stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stream: %" PRIu64 ".",
+		 function,
+		 stream_identifier );
+
+		libcthreads_mutex_release(
+		 mount_handle->streams_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	mount_handle->access_counter += 1;
+
+	stream->last_used = mount_handle->access_counter;
+
+	if( offset == stream->next_offset )
+	{
+		stream->number_of_sequential_reads += 1;
+	}
+	else
+	{
+		stream->number_of_sequential_reads = 0;
+		stream->prefetch_offset            = 0;
+	}
+	stream->next_offset = offset + read_count;
+
+	if( stream->number_of_sequential_reads >= MOUNT_HANDLE_SEQUENTIAL_READS_THRESHOLD )
+	{
+		if( stream->prefetch_offset < stream->next_offset )
+		{
+			stream->prefetch_offset = stream->next_offset;
+		}
+		while( ( number_of_prefetches < 2 )
+		    && ( mount_handle->number_of_prefetches < MOUNT_HANDLE_MAXIMUM_NUMBER_OF_PREFETCHES )
+		    && ( (size64_t) stream->prefetch_offset < mount_handle->media_size )
+		    && ( ( stream->prefetch_offset - stream->next_offset ) <= (off64_t) prefetch_block_size ) )
+		{
+			prefetch_offsets[ number_of_prefetches++ ] = stream->prefetch_offset;
+
+			stream->prefetch_offset += prefetch_block_size;
+
+			mount_handle->number_of_prefetches += 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( prefetch_index = 0;
+	     prefetch_index < number_of_prefetches;
+	     prefetch_index++ )
+	{
+		prefetch_offset = memory_allocate_structure(
+		                   off64_t );
+
+		if( prefetch_offset == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create prefetch offset.",
+			 function );
+
+			goto on_error;
+		}
+		*prefetch_offset = prefetch_offsets[ prefetch_index ];
+
+		if( libcthreads_thread_pool_push(
+		     mount_handle->prefetch_thread_pool,
+		     (intptr_t *) prefetch_offset,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push prefetch offset onto prefetch thread pool queue.",
+			 function );
+
+			memory_free(
+			 prefetch_offset );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( read_count );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	/* Release the prefetches that were not pushed
+	 */
+	mount_handle_release_prefetches(
+	 mount_handle,
+	 number_of_prefetches - prefetch_index,
+	 NULL );
+
+	return( -1 );
+#endif
+}
+
 /* Seeks a specific offset from the input handle
  * Return the offset if successful or -1 on error
  */
@@ -588,6 +962,413 @@ off64_t mount_handle_seek_offset(
 	return( offset );
 }
 
+/* Opens a stream
+ * A stream is used to track the reads of a single open file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_stream(
+     mount_handle_t *mount_handle,
+     uint64_t *stream_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_open_stream";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	mount_handle->last_stream_identifier += 1;
+
+	*stream_identifier = mount_handle->last_stream_identifier;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Closes a stream
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_close_stream(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_close_stream";
+	int stream_index      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_identifier == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( stream_index = 0;
+	     stream_index < MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( mount_handle->streams[ stream_index ].identifier == stream_identifier )
+		{
+			mount_handle->streams[ stream_index ].identifier                 = 0;
+			mount_handle->streams[ stream_index ].next_offset                = 0;
+			mount_handle->streams[ stream_index ].prefetch_offset            = 0;
+			mount_handle->streams[ stream_index ].number_of_sequential_reads = 0;
+			mount_handle->streams[ stream_index ].last_used                  = 0;
+
+			break;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a stream
+ * If the stream is not tracked the least recently used stream is reused
+ * The streams mutex must be held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_stream(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     mount_stream_t **stream,
+     libcerror_error_t **error )
+{
+	static char *function         = "mount_handle_get_stream";
+	int least_recently_used_index = 0;
+	int stream_index              = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_identifier == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( stream_index = 0;
+	     stream_index < MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( mount_handle->streams[ stream_index ].identifier == stream_identifier )
+		{
+			*stream = &( mount_handle->streams[ stream_index ] );
+
+			return( 1 );
+		}
+		if( mount_handle->streams[ stream_index ].last_used < mount_handle->streams[ least_recently_used_index ].last_used )
+		{
+			least_recently_used_index = stream_index;
+		}
+	}
+	*stream = &( mount_handle->streams[ least_recently_used_index ] );
+
+	( *stream )->identifier                 = stream_identifier;
+	( *stream )->next_offset                = 0;
+	( *stream )->prefetch_offset            = 0;
+	( *stream )->number_of_sequential_reads = 0;
+	( *stream )->last_used                  = 0;
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Releases a number of prefetches that are no longer queued or being read
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_release_prefetches(
+     mount_handle_t *mount_handle,
+     int number_of_prefetches,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_release_prefetches";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_prefetches > mount_handle->number_of_prefetches )
+	{
+		number_of_prefetches = mount_handle->number_of_prefetches;
+	}
+	mount_handle->number_of_prefetches -= number_of_prefetches;
+
+	if( libcthreads_mutex_release(
+	     mount_handle->streams_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release streams mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prefetches data of the input handle into the chunks cache
+ * Callback function for the prefetch thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_prefetch_callback(
+     off64_t *prefetch_offset,
+     mount_handle_t *mount_handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	static char *function    = "mount_handle_prefetch_callback";
+	size_t buffer_size       = 0;
+	ssize_t read_count       = 0;
+
+	if( prefetch_offset == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefetch offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		goto on_error;
+	}
+	buffer_size = mount_handle->prefetch_size / 2;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data is not used, reading it stores the chunks in the chunks cache
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              mount_handle->input_handle,
+	              buffer,
+	              buffer_size,
+	              *prefetch_offset,
+	              &error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prefetch data at offset: %" PRIi64 " (0x%08" PRIx64 ") from input handle.",
+		 function,
+		 *prefetch_offset,
+		 *prefetch_offset );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	memory_free(
+	 prefetch_offset );
+
+	if( mount_handle_release_prefetches(
+	     mount_handle,
+	     1,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release prefetch.",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( mount_handle != NULL )
+	{
+		mount_handle_release_prefetches(
+		 mount_handle,
+		 1,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( prefetch_offset != NULL )
+	{
+		memory_free(
+		 prefetch_offset );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves the media size of the input handle
  * Returns 1 if successful or -1 on error
  */
@@ -28,6 +28,7 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 
 #if defined( __cplusplus )
@@ -40,6 +41,57 @@ enum MOUNT_HANDLE_INPUT_FORMATS
 	MOUNT_HANDLE_INPUT_FORMAT_RAW	= (int) 'r'
 };
 
+/* The maximum number of open streams that are tracked for sequential reads
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS		32
+
+/* The number of consecutive sequential reads after which a stream is prefetched
+ */
+#define MOUNT_HANDLE_SEQUENTIAL_READS_THRESHOLD		2
+
+/* The number of chunks to prefetch per stream
+ */
+#define MOUNT_HANDLE_PREFETCH_NUMBER_OF_CHUNKS		32
+
+/* The number of threads used to prefetch
+ */
+#define MOUNT_HANDLE_NUMBER_OF_PREFETCH_THREADS		4
+
+/* The maximum number of prefetches that are queued or being read,
+ * this is the size of the prefetch thread pool queue so that pushing
+ * a prefetch never has to wait for the queue to drain
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_PREFETCHES	( MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS * 2 )
+
+/* The size of the chunks cache of the input handle when prefetching
+ */
+#define MOUNT_HANDLE_PREFETCH_CHUNKS_CACHE_SIZE		( 128 * 1024 * 1024 )
+
+typedef struct mount_stream mount_stream_t;
+
+struct mount_stream
+{
+	/* The stream identifier
+	 */
+	uint64_t identifier;
+
+	/* The offset of the next sequential read
+	 */
+	off64_t next_offset;
+
+	/* The end offset of the data that has been prefetched
+	 */
+	off64_t prefetch_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The value of the access counter when the stream was last used
+	 */
+	uint64_t last_used;
+};
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -59,6 +111,40 @@ struct mount_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The prefetch size
+	 */
+	size_t prefetch_size;
+
+	/* The streams
+	 */
+	mount_stream_t streams[ MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS ];
+
+	/* The last stream identifier
+	 */
+	uint64_t last_stream_identifier;
+
+	/* The streams access counter
+	 */
+	uint64_t access_counter;
+
+	/* The number of prefetches that are queued or being read
+	 */
+	int number_of_prefetches;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The streams mutex
+	 */
+	libcthreads_mutex_t *streams_mutex;
+
+	/* The prefetch thread pool
+	 */
+	libcthreads_thread_pool_t *prefetch_thread_pool;
+#endif
 };
 
 int mount_handle_initialize(
@@ -99,12 +185,49 @@ ssize_t mount_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint64_t stream_identifier,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 off64_t mount_handle_seek_offset(
          mount_handle_t *mount_handle,
          off64_t offset,
          int whence,
          libcerror_error_t **error );
 
+int mount_handle_open_stream(
+     mount_handle_t *mount_handle,
+     uint64_t *stream_identifier,
+     libcerror_error_t **error );
+
+int mount_handle_close_stream(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     libcerror_error_t **error );
+
+int mount_handle_get_stream(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     mount_stream_t **stream,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_handle_release_prefetches(
+     mount_handle_t *mount_handle,
+     int number_of_prefetches,
+     libcerror_error_t **error );
+
+int mount_handle_prefetch_callback(
+     off64_t *prefetch_offset,
+     mount_handle_t *mount_handle );
+
+#endif
+
 int mount_handle_get_media_size(
      mount_handle_t *mount_handle,
      size64_t *size,
@@ -0,0 +1,2282 @@
+/*
+ * Network block device (NBD) server
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
+#include "mount_handle.h"
+#include "nbd_server.h"
+
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+
+/* Prevent a SIGPIPE when the client closes the connection
+ */
+#if !defined( MSG_NOSIGNAL )
+#define MSG_NOSIGNAL	0
+#endif
+
+/* Creates a NBD server
+ * Make sure the value nbd_server is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_initialize(
+     nbd_server_t **nbd_server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_initialize";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_server = memory_allocate_structure(
+	               nbd_server_t );
+
+	if( *nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_server,
+	     0,
+	     sizeof( nbd_server_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_server )->mount_handle      = mount_handle;
+	( *nbd_server )->socket_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_server != NULL )
+	{
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD server
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_free(
+     nbd_server_t **nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_free";
+	int result            = 1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		if( nbd_server_join_connections(
+		     *nbd_server,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join connections.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *nbd_server )->socket_descriptor != -1 )
+		{
+			if( nbd_server_close(
+			     *nbd_server,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close NBD server.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD server to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_signal_abort(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_signal_abort";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->abort = 1;
+
+	/* Shutting down the socket makes a blocking accept return
+	 */
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_server->socket_descriptor,
+		 SHUT_RDWR );
+	}
+	return( 1 );
+}
+
+/* Opens the NBD server
+ * Creates a Unix domain socket at the socket path and listens on it
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_open(
+     nbd_server_t *nbd_server,
+     const char *socket_path,
+     size_t socket_path_length,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+
+	static char *function = "nbd_server_open";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server - socket already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( socket_path_length == 0 )
+	 || ( socket_path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( memory_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->socket_path = (char *) memory_allocate(
+	                                    sizeof( char ) * ( socket_path_length + 1 ) );
+
+	if( nbd_server->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     nbd_server->socket_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_server->socket_path[ socket_path_length ] = 0;
+
+	nbd_server->socket_descriptor = socket(
+	                                 AF_UNIX,
+	                                 SOCK_STREAM,
+	                                 0 );
+
+	if( nbd_server->socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( bind(
+	     nbd_server->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to bind socket to: %s.",
+		 function,
+		 nbd_server->socket_path );
+
+		goto on_error;
+	}
+	if( listen(
+	     nbd_server->socket_descriptor,
+	     NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to listen on socket: %s.",
+		 function,
+		 nbd_server->socket_path );
+
+		unlink(
+		 nbd_server->socket_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		close(
+		 nbd_server->socket_descriptor );
+
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path = NULL;
+	}
+	return( -1 );
+}
+
+/* Closes the NBD server
+ * Returns 0 if successful or -1 on error
+ */
+int nbd_server_close(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_close";
+	int result            = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		if( close(
+		     nbd_server->socket_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		if( unlink(
+		     nbd_server->socket_path ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to remove socket: %s.",
+			 function,
+			 nbd_server->socket_path );
+
+			result = -1;
+		}
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path = NULL;
+	}
+	return( result );
+}
+
+/* Runs the NBD server
+ * Accepts connections until the server is signalled to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_run(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	nbd_connection_t *nbd_connection = NULL;
+	static char *function            = "nbd_server_run";
+	int socket_descriptor            = -1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int connection_index             = 0;
+#endif
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD server - missing socket.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_server->abort == 0 )
+	{
+		if( nbd_server_join_connections(
+		     nbd_server,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join finished connections.",
+			 function );
+
+			goto on_error;
+		}
+		socket_descriptor = accept(
+		                     nbd_server->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( nbd_server->abort != 0 )
+			{
+				break;
+			}
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			goto on_error;
+		}
+		if( nbd_server->abort != 0 )
+		{
+			close(
+			 socket_descriptor );
+
+			break;
+		}
+		if( nbd_connection_initialize(
+		     &nbd_connection,
+		     nbd_server,
+		     socket_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( connection_index = 0;
+		     connection_index < NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( nbd_server->connections[ connection_index ] == NULL )
+			{
+				break;
+			}
+		}
+		if( connection_index >= NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS )
+		{
+			libcnotify_printf(
+			 "%s: maximum number of connections reached, refusing connection.\n",
+			 function );
+
+			if( nbd_connection_free(
+			     &nbd_connection,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free connection.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libcthreads_thread_create(
+		     &( nbd_connection->thread ),
+		     NULL,
+		     (int (*)(void *)) &nbd_connection_run,
+		     (void *) nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection thread.",
+			 function );
+
+			goto on_error;
+		}
+		nbd_server->connections[ connection_index ] = nbd_connection;
+
+		nbd_connection = NULL;
+#else
+		/* Without multi-threading support the connections are handled one at a time
+		 */
+		nbd_connection_run(
+		 nbd_connection );
+
+		if( nbd_connection_free(
+		     &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+	}
+	if( nbd_server_join_connections(
+	     nbd_server,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join connections.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	nbd_server_join_connections(
+	 nbd_server,
+	 1,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Joins the connection threads that have finished
+ * If join all is set all the connections are shut down and joined
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_server_join_connections(
+     nbd_server_t *nbd_server,
+     uint8_t join_all,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_server_join_connections";
+	int connection_index  = 0;
+	int result            = 1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	for( connection_index = 0;
+	     connection_index < NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS;
+	     connection_index++ )
+	{
+		if( nbd_server->connections[ connection_index ] == NULL )
+		{
+			continue;
+		}
+		if( ( join_all == 0 )
+		 && ( nbd_server->connections[ connection_index ]->is_finished == 0 ) )
+		{
+			continue;
+		}
+		/* Shutting down the socket makes a blocking read of the connection return
+		 */
+		shutdown(
+		 nbd_server->connections[ connection_index ]->socket_descriptor,
+		 SHUT_RDWR );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_join(
+		     &( nbd_server->connections[ connection_index ]->thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join connection: %d thread.",
+			 function,
+			 connection_index );
+
+			result = -1;
+		}
+#endif
+		if( nbd_connection_free(
+		     &( nbd_server->connections[ connection_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection: %d.",
+			 function,
+			 connection_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Creates a NBD connection
+ * Make sure the value nbd_connection is referencing, is set to NULL
+ * The connection takes over the socket descriptor if successful
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     nbd_server_t *nbd_server,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_connection = memory_allocate_structure(
+	                   nbd_connection_t );
+
+	if( *nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD connection.",
+		 function );
+
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+
+		return( -1 );
+	}
+	if( mount_handle_open_stream(
+	     nbd_server->mount_handle,
+	     &( ( *nbd_connection )->stream_identifier ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to open stream.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *nbd_connection )->write_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize write mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *nbd_connection )->server            = nbd_server;
+	( *nbd_connection )->socket_descriptor = socket_descriptor;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_connection != NULL )
+	{
+		if( ( *nbd_connection )->stream_identifier != 0 )
+		{
+			mount_handle_close_stream(
+			 nbd_server->mount_handle,
+			 ( *nbd_connection )->stream_identifier,
+			 NULL );
+		}
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *nbd_connection )->request_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *nbd_connection )->request_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join request thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *nbd_connection )->write_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( mount_handle_close_stream(
+		     ( *nbd_connection )->server->mount_handle,
+		     ( *nbd_connection )->stream_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to close stream.",
+			 function );
+
+			result = -1;
+		}
+		if( close(
+		     ( *nbd_connection )->socket_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( result );
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed before any data was read or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = recv(
+		              nbd_connection->socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+
+		if( read_count == 0 )
+		{
+			if( data_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: connection closed while reading data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		write_count = send(
+		               nbd_connection->socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               MSG_NOSIGNAL );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to write data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Writes an option reply to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_MAGIC_OPTION_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 data_size );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     data,
+		     (size_t) data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a simple reply without data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t handle,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t reply[ NBD_SIMPLE_REPLY_SIZE ];
+
+	static char *function = "nbd_connection_write_simple_reply";
+	int result            = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply[ 0 ] ),
+	 NBD_MAGIC_SIMPLE_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply[ 8 ] ),
+	 handle );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     nbd_connection->write_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab write mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = nbd_connection_write_data(
+	          nbd_connection,
+	          reply,
+	          NBD_SIMPLE_REPLY_SIZE,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write simple reply.",
+		 function );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     nbd_connection->write_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release write mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Negotiates the export with the client using the fixed newstyle handshake
+ * Returns 1 if the transmission phase was entered, 0 if the client aborted or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t export_data[ 134 ];
+	uint8_t information_data[ 14 ];
+	uint8_t option_data[ NBD_SERVER_MAXIMUM_OPTION_DATA_SIZE ];
+	uint8_t option_header[ 16 ];
+	uint8_t server_header[ 18 ];
+
+	static char *function       = "nbd_connection_negotiate";
+	size64_t media_size         = 0;
+	uint64_t magic              = 0;
+	uint32_t client_flags       = 0;
+	uint32_t name_length        = 0;
+	uint32_t option             = 0;
+	uint32_t option_data_size   = 0;
+	uint16_t transmission_flags = 0;
+	int result                  = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	media_size         = nbd_connection->server->mount_handle->media_size;
+	transmission_flags = NBD_FLAG_HAS_FLAGS
+	                   | NBD_FLAG_READ_ONLY
+	                   | NBD_FLAG_SEND_FLUSH
+	                   | NBD_FLAG_CAN_MULTI_CONN;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( server_header[ 0 ] ),
+	 NBD_MAGIC_INITIAL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( server_header[ 8 ] ),
+	 NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( server_header[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     server_header,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write server header.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_read_data(
+	          nbd_connection,
+	          option_header,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read client flags.",
+			 function );
+		}
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 option_header,
+	 client_flags );
+
+	if( ( client_flags & NBD_FLAG_CLIENT_NO_ZEROES ) != 0 )
+	{
+		nbd_connection->no_zeroes = 1;
+	}
+	while( nbd_connection->server->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          option_header,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option header.",
+				 function );
+			}
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_data_size );
+
+		if( magic != NBD_MAGIC_OPTION )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported option magic: 0x%08" PRIx64 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		if( option_data_size > NBD_SERVER_MAXIMUM_OPTION_DATA_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid option data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_data_size > 0 )
+		{
+			if( nbd_connection_read_data(
+			     nbd_connection,
+			     option_data,
+			     (size_t) option_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		switch( option )
+		{
+			case NBD_OPTION_EXPORT_NAME:
+				/* There is a single export, the export name is ignored
+				 */
+				if( memory_set(
+				     export_data,
+				     0,
+				     134 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear export data.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_copy_from_uint64_big_endian(
+				 &( export_data[ 0 ] ),
+				 media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_data[ 8 ] ),
+				 transmission_flags );
+
+				if( nbd_connection_write_data(
+				     nbd_connection,
+				     export_data,
+				     ( nbd_connection->no_zeroes != 0 ) ? 10 : 134,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export data.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_OPTION_ABORT:
+				if( nbd_connection_write_option_reply(
+				     nbd_connection,
+				     option,
+				     NBD_REPLY_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write abort reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case NBD_OPTION_LIST:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* The export has an empty name
+					 */
+					byte_stream_copy_from_uint32_big_endian(
+					 &( information_data[ 0 ] ),
+					 0 );
+
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REPLY_SERVER,
+					          information_data,
+					          4,
+					          error );
+
+					if( result == 1 )
+					{
+						result = nbd_connection_write_option_reply(
+						          nbd_connection,
+						          option,
+						          NBD_REPLY_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write list reply.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+
+			case NBD_OPTION_INFO:
+			case NBD_OPTION_GO:
+				if( option_data_size >= 6 )
+				{
+					byte_stream_copy_to_uint32_big_endian(
+					 &( option_data[ 0 ] ),
+					 name_length );
+				}
+				if( ( option_data_size < 6 )
+				 || ( name_length > ( option_data_size - 6 ) ) )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* There is a single export, the export name and the
+					 * requested information types are ignored
+					 */
+					byte_stream_copy_from_uint16_big_endian(
+					 &( information_data[ 0 ] ),
+					 NBD_INFO_EXPORT );
+
+					byte_stream_copy_from_uint64_big_endian(
+					 &( information_data[ 2 ] ),
+					 media_size );
+
+					byte_stream_copy_from_uint16_big_endian(
+					 &( information_data[ 10 ] ),
+					 transmission_flags );
+
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REPLY_INFO,
+					          information_data,
+					          12,
+					          error );
+
+					if( result == 1 )
+					{
+						byte_stream_copy_from_uint16_big_endian(
+						 &( information_data[ 0 ] ),
+						 NBD_INFO_BLOCK_SIZE );
+
+						byte_stream_copy_from_uint32_big_endian(
+						 &( information_data[ 2 ] ),
+						 1 );
+
+						byte_stream_copy_from_uint32_big_endian(
+						 &( information_data[ 6 ] ),
+						 NBD_SERVER_PREFERRED_REQUEST_SIZE );
+
+						byte_stream_copy_from_uint32_big_endian(
+						 &( information_data[ 10 ] ),
+						 NBD_SERVER_MAXIMUM_REQUEST_SIZE );
+
+						result = nbd_connection_write_option_reply(
+						          nbd_connection,
+						          option,
+						          NBD_REPLY_INFO,
+						          information_data,
+						          14,
+						          error );
+					}
+					if( result == 1 )
+					{
+						result = nbd_connection_write_option_reply(
+						          nbd_connection,
+						          option,
+						          NBD_REPLY_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+					if( ( result == 1 )
+					 && ( option == NBD_OPTION_GO ) )
+					{
+						return( 1 );
+					}
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write information reply.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+
+			default:
+				if( nbd_connection_write_option_reply(
+				     nbd_connection,
+				     option,
+				     NBD_REPLY_ERROR_UNSUPPORTED,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write unsupported option reply.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+		}
+	}
+	return( 0 );
+}
+
+/* Handles a read request
+ * The reply header and data are written to the connection as a single unit
+ * Callback function for the request thread pool, the request is freed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_read_request(
+     nbd_request_t *nbd_request,
+     nbd_connection_t *nbd_connection )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *reply_data      = NULL;
+	static char *function    = "nbd_connection_handle_read_request";
+	size_t data_offset       = 0;
+	ssize_t read_count       = 0;
+	uint32_t error_value     = 0;
+	int result               = 0;
+
+	if( nbd_request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD request.",
+		 function );
+
+		goto on_error;
+	}
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	reply_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * ( NBD_SIMPLE_REPLY_SIZE + (size_t) nbd_request->length ) );
+
+	if( reply_data == NULL )
+	{
+		error_value = NBD_ERROR_MEMORY;
+	}
+	while( ( error_value == 0 )
+	    && ( data_offset < (size_t) nbd_request->length ) )
+	{
+		read_count = mount_handle_read_buffer_at_offset(
+		              nbd_connection->server->mount_handle,
+		              nbd_connection->stream_identifier,
+		              &( reply_data[ NBD_SIMPLE_REPLY_SIZE + data_offset ] ),
+		              (size_t) nbd_request->length - data_offset,
+		              (off64_t) ( nbd_request->offset + data_offset ),
+		              &error );
+
+		if( read_count == -1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			error_value = NBD_ERROR_IO;
+		}
+		else if( read_count == 0 )
+		{
+			/* The request was validated against the media size
+			 * so this should not happen, fill the remainder with zero bytes
+			 */
+			if( memory_set(
+			     &( reply_data[ NBD_SIMPLE_REPLY_SIZE + data_offset ] ),
+			     0,
+			     (size_t) nbd_request->length - data_offset ) == NULL )
+			{
+				error_value = NBD_ERROR_IO;
+			}
+			break;
+		}
+		else
+		{
+			data_offset += (size_t) read_count;
+		}
+	}
+	if( error_value != 0 )
+	{
+		result = nbd_connection_write_simple_reply(
+		          nbd_connection,
+		          nbd_request->handle,
+		          error_value,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write error reply.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 NBD_MAGIC_SIMPLE_REPLY );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 4 ] ),
+		 0 );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 nbd_request->handle );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     nbd_connection->write_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab write mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = nbd_connection_write_data(
+		          nbd_connection,
+		          reply_data,
+		          NBD_SIMPLE_REPLY_SIZE + (size_t) nbd_request->length,
+		          &error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     nbd_connection->write_mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write read reply.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( reply_data != NULL )
+	{
+		memory_free(
+		 reply_data );
+	}
+	memory_free(
+	 nbd_request );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	/* The connection can no longer be used, make the request loop stop
+	 */
+	if( nbd_connection != NULL )
+	{
+		shutdown(
+		 nbd_connection->socket_descriptor,
+		 SHUT_RDWR );
+	}
+	if( reply_data != NULL )
+	{
+		memory_free(
+		 reply_data );
+	}
+	if( nbd_request != NULL )
+	{
+		memory_free(
+		 nbd_request );
+	}
+	return( -1 );
+}
+
+/* Handles the requests of the transmission phase
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_transmit(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t discard_data[ NBD_SERVER_MAXIMUM_OPTION_DATA_SIZE ];
+	uint8_t request_data[ NBD_REQUEST_SIZE ];
+
+	nbd_request_t *nbd_request = NULL;
+	static char *function      = "nbd_connection_transmit";
+	size64_t media_size        = 0;
+	size_t discard_size        = 0;
+	uint64_t handle            = 0;
+	uint64_t offset            = 0;
+	uint32_t length            = 0;
+	uint32_t magic             = 0;
+	uint16_t command           = 0;
+	int result                 = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	media_size = nbd_connection->server->mount_handle->media_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_create(
+	     &( nbd_connection->request_thread_pool ),
+	     NULL,
+	     NBD_SERVER_NUMBER_OF_REQUEST_THREADS,
+	     NBD_SERVER_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS,
+	     (int (*)(intptr_t *, void *)) &nbd_connection_handle_read_request,
+	     (void *) nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create request thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	while( nbd_connection->server->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          request_data,
+		          NBD_REQUEST_SIZE,
+		          error );
+
+		if( result == 0 )
+		{
+			break;
+		}
+		else if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_data[ 6 ] ),
+		 command );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 8 ] ),
+		 handle );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_data[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_data[ 24 ] ),
+		 length );
+
+		if( magic != NBD_MAGIC_REQUEST )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 magic );
+
+			goto on_error;
+		}
+		if( command == NBD_COMMAND_DISCONNECT )
+		{
+			break;
+		}
+		else if( command == NBD_COMMAND_READ )
+		{
+			if( ( length > NBD_SERVER_MAXIMUM_REQUEST_SIZE )
+			 || ( offset > media_size )
+			 || ( (size64_t) length > ( media_size - offset ) ) )
+			{
+				result = nbd_connection_write_simple_reply(
+				          nbd_connection,
+				          handle,
+				          NBD_ERROR_INVALID,
+				          error );
+			}
+			else
+			{
+				nbd_request = memory_allocate_structure(
+				               nbd_request_t );
+
+				if( nbd_request == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create request.",
+					 function );
+
+					goto on_error;
+				}
+				nbd_request->connection = nbd_connection;
+				nbd_request->handle     = handle;
+				nbd_request->offset     = offset;
+				nbd_request->length     = length;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+				if( libcthreads_thread_pool_push(
+				     nbd_connection->request_thread_pool,
+				     (intptr_t *) nbd_request,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push request onto request thread pool queue.",
+					 function );
+
+					goto on_error;
+				}
+				nbd_request = NULL;
+				result      = 1;
+#else
+				/* The request is freed by the handler
+				 */
+				result = nbd_connection_handle_read_request(
+				          nbd_request,
+				          nbd_connection );
+
+				nbd_request = NULL;
+#endif
+			}
+		}
+		else if( command == NBD_COMMAND_WRITE )
+		{
+			/* The export is read-only, the data that follows the request is discarded
+			 */
+			while( length > 0 )
+			{
+				discard_size = NBD_SERVER_MAXIMUM_OPTION_DATA_SIZE;
+
+				if( discard_size > (size_t) length )
+				{
+					discard_size = (size_t) length;
+				}
+				if( nbd_connection_read_data(
+				     nbd_connection,
+				     discard_data,
+				     discard_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read write request data.",
+					 function );
+
+					goto on_error;
+				}
+				length -= (uint32_t) discard_size;
+			}
+			result = nbd_connection_write_simple_reply(
+			          nbd_connection,
+			          handle,
+			          NBD_ERROR_PERMISSION,
+			          error );
+		}
+		else if( command == NBD_COMMAND_FLUSH )
+		{
+			result = nbd_connection_write_simple_reply(
+			          nbd_connection,
+			          handle,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_connection_write_simple_reply(
+			          nbd_connection,
+			          handle,
+			          NBD_ERROR_INVALID,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Joining the thread pool waits for the queued requests to be handled
+	 */
+	if( libcthreads_thread_pool_join(
+	     &( nbd_connection->request_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join request thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( nbd_request != NULL )
+	{
+		memory_free(
+		 nbd_request );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_connection->request_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( nbd_connection->request_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Runs a NBD connection
+ * Callback function for the connection thread
+ * Returns 1 if successful, 0 if the client aborted or -1 on error
+ */
+int nbd_connection_run(
+     nbd_connection_t *nbd_connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_run";
+	int result               = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	result = nbd_connection_negotiate(
+	          nbd_connection,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate export.",
+		 function );
+	}
+	else if( result == 1 )
+	{
+		result = nbd_connection_transmit(
+		          nbd_connection,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle requests.",
+			 function );
+		}
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	nbd_connection->is_finished = 1;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_NBD_SERVER_SUPPORT ) */
+
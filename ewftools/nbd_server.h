@@ -0,0 +1,311 @@
+/*
+ * Network block device (NBD) server
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_SERVER_H )
+#define _NBD_SERVER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
+#include "mount_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The NBD server requires POSIX Unix domain sockets
+ */
+#if !defined( WINAPI ) && !defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+#define HAVE_NBD_SERVER_SUPPORT
+#endif
+
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+
+/* The NBD protocol magic values
+ */
+#define NBD_MAGIC_INITIAL				0x4e42444d41474943ULL
+#define NBD_MAGIC_OPTION				0x49484156454f5054ULL
+#define NBD_MAGIC_OPTION_REPLY				0x0003e889045565a9ULL
+#define NBD_MAGIC_REQUEST				0x25609513UL
+#define NBD_MAGIC_SIMPLE_REPLY				0x67446698UL
+
+/* The NBD handshake flags
+ */
+#define NBD_FLAG_FIXED_NEWSTYLE				0x0001
+#define NBD_FLAG_NO_ZEROES				0x0002
+
+/* The NBD client flags
+ */
+#define NBD_FLAG_CLIENT_FIXED_NEWSTYLE			0x00000001UL
+#define NBD_FLAG_CLIENT_NO_ZEROES			0x00000002UL
+
+/* The NBD transmission flags
+ */
+#define NBD_FLAG_HAS_FLAGS				0x0001
+#define NBD_FLAG_READ_ONLY				0x0002
+#define NBD_FLAG_SEND_FLUSH				0x0004
+#define NBD_FLAG_CAN_MULTI_CONN				0x0100
+
+/* The NBD options
+ */
+#define NBD_OPTION_EXPORT_NAME				1
+#define NBD_OPTION_ABORT				2
+#define NBD_OPTION_LIST					3
+#define NBD_OPTION_INFO					6
+#define NBD_OPTION_GO					7
+
+/* The NBD option reply types
+ */
+#define NBD_REPLY_ACK					1
+#define NBD_REPLY_SERVER				2
+#define NBD_REPLY_INFO					3
+#define NBD_REPLY_ERROR_UNSUPPORTED			0x80000001UL
+#define NBD_REPLY_ERROR_INVALID				0x80000003UL
+
+/* The NBD information types
+ */
+#define NBD_INFO_EXPORT					0
+#define NBD_INFO_BLOCK_SIZE				3
+
+/* The NBD commands
+ */
+#define NBD_COMMAND_READ				0
+#define NBD_COMMAND_WRITE				1
+#define NBD_COMMAND_DISCONNECT				2
+#define NBD_COMMAND_FLUSH				3
+
+/* The NBD error values
+ */
+#define NBD_ERROR_PERMISSION				1
+#define NBD_ERROR_IO					5
+#define NBD_ERROR_MEMORY				12
+#define NBD_ERROR_INVALID				22
+
+/* The size of the NBD request
+ */
+#define NBD_REQUEST_SIZE				28
+
+/* The size of the NBD simple reply
+ */
+#define NBD_SIMPLE_REPLY_SIZE				16
+
+/* The maximum size of option data the server accepts
+ */
+#define NBD_SERVER_MAXIMUM_OPTION_DATA_SIZE		4096
+
+/* The maximum size of a read request, 32 MiB
+ */
+#define NBD_SERVER_MAXIMUM_REQUEST_SIZE			( 32 * 1024 * 1024 )
+
+/* The preferred size of a read request
+ */
+#define NBD_SERVER_PREFERRED_REQUEST_SIZE		( 128 * 1024 )
+
+/* The maximum number of concurrent connections
+ */
+#define NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS	16
+
+/* The number of threads per connection used to handle requests
+ */
+#define NBD_SERVER_NUMBER_OF_REQUEST_THREADS		4
+
+/* The maximum number of queued requests per connection
+ */
+#define NBD_SERVER_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS	64
+
+typedef struct nbd_server nbd_server_t;
+typedef struct nbd_connection nbd_connection_t;
+typedef struct nbd_request nbd_request_t;
+
+struct nbd_request
+{
+	/* The connection
+	 */
+	nbd_connection_t *connection;
+
+	/* The handle (cookie) of the request
+	 */
+	uint64_t handle;
+
+	/* The offset
+	 */
+	uint64_t offset;
+
+	/* The length
+	 */
+	uint32_t length;
+};
+
+struct nbd_connection
+{
+	/* The server
+	 */
+	nbd_server_t *server;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The stream identifier
+	 */
+	uint64_t stream_identifier;
+
+	/* Value to indicate the client does not want the zero padding
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate the connection has finished
+	 */
+	uint8_t is_finished;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The request thread pool
+	 */
+	libcthreads_thread_pool_t *request_thread_pool;
+
+	/* The write mutex
+	 */
+	libcthreads_mutex_t *write_mutex;
+#endif
+};
+
+struct nbd_server
+{
+	/* The mount handle
+	 * this value is not managed by the server
+	 */
+	mount_handle_t *mount_handle;
+
+	/* The socket path
+	 */
+	char *socket_path;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The connections
+	 */
+	nbd_connection_t *connections[ NBD_SERVER_MAXIMUM_NUMBER_OF_CONNECTIONS ];
+
+	/* Value to indicate the server should abort
+	 */
+	int abort;
+};
+
+int nbd_server_initialize(
+     nbd_server_t **nbd_server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
+int nbd_server_free(
+     nbd_server_t **nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_signal_abort(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_open(
+     nbd_server_t *nbd_server,
+     const char *socket_path,
+     size_t socket_path_length,
+     libcerror_error_t **error );
+
+int nbd_server_close(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_run(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int nbd_server_join_connections(
+     nbd_server_t *nbd_server,
+     uint8_t join_all,
+     libcerror_error_t **error );
+
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     nbd_server_t *nbd_server,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t handle,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_read_request(
+     nbd_request_t *nbd_request,
+     nbd_connection_t *nbd_connection );
+
+int nbd_connection_transmit(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_run(
+     nbd_connection_t *nbd_connection );
+
+#endif /* defined( HAVE_NBD_SERVER_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -402,6 +402,237 @@ ssize_t storage_media_buffer_read_from_handle(
 		storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
 	}
 	storage_media_buffer->requested_size = read_size;
+	storage_media_buffer->is_sparse      = 0;
+
+	return( read_count );
+}
+
+/* Reads a storage media buffer from the input handle at a specific offset
+ * The current offset of the input handle is not changed, hence multiple threads
+ * can read storage media buffers from the same input handle at the same time
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_read_from_handle_at_offset";
+	ssize_t read_count    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		read_count = libewf_handle_read_data_chunk_at_offset_concurrent(
+	                      handle,
+	                      storage_media_buffer->data_chunk,
+	                      storage_media_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	                      handle,
+	                      storage_media_buffer->raw_buffer,
+	                      read_size,
+	                      storage_media_offset,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 storage_media_offset,
+		 storage_media_offset );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	{
+		storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->is_sparse            = 0;
+
+	return( read_count );
+}
+
+/* Reads a storage media buffer from the input handle and determines if the data consists of zero-filled chunks
+ * If so the raw buffer is zero-filled instead of copying the chunk data, otherwise the data is read
+ * from the concurrent chunks cache that holds the chunks unpacked to determine the fill range,
+ * so that these chunks are not unpacked again, the current offset of the input handle is moved past the data
+ * Returns the number of bytes read, 0 if no data was read or -1 on error
+ */
+ssize_t storage_media_buffer_read_sparse_from_handle(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_read_sparse_from_handle";
+	size64_t range_size   = 0;
+	ssize_t read_count    = 0;
+	off64_t offset        = 0;
+	uint8_t fill_value    = 0;
+	int result            = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_offset(
+	     handle,
+	     &offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_handle_get_fill_range(
+	          handle,
+	          offset,
+	          (size64_t) read_size,
+	          &range_size,
+	          &fill_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fill range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( fill_value == 0 )
+	 && ( range_size >= (size64_t) read_size ) )
+	{
+		if( memory_set(
+		     storage_media_buffer->raw_buffer,
+		     0,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear raw buffer.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = (ssize_t) read_size;
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              storage_media_buffer->raw_buffer,
+		              read_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read storage media buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		result = 0;
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     offset + (off64_t) read_count,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset + (off64_t) read_count );
+
+		return( -1 );
+	}
+	storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->is_sparse            = (uint8_t) result;
 
 	return( read_count );
 }
@@ -73,6 +73,11 @@ struct storage_media_buffer
 	/* The processed size
 	 */
 	size_t processed_size;
+
+	/* Value to indicate the raw buffer contains a zero-filled range
+	 * that was not read from the input
+	 */
+	uint8_t is_sparse;
 };
 
 int storage_media_buffer_initialize(
@@ -103,6 +108,19 @@ ssize_t storage_media_buffer_read_from_handle(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
+ssize_t storage_media_buffer_read_sparse_from_handle(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_read_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
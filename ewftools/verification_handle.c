@@ -286,17 +286,17 @@ int verification_handle_free(
 
 			result = -1;
 		}
-		if( ( *verification_handle )->md5_context != NULL )
+		if( ( *verification_handle )->integrity_hash != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *verification_handle )->md5_context ),
+			if( integrity_hash_free(
+			     &( ( *verification_handle )->integrity_hash ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free integrity hash.",
 				 function );
 
 				result = -1;
@@ -312,22 +312,6 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_md5_hash_string );
 		}
-		if( ( *verification_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *verification_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *verification_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
@@ -338,22 +322,6 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha1_hash_string );
 		}
-		if( ( *verification_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *verification_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *verification_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -451,6 +419,32 @@ int verification_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_direct_io(
+     verification_handle_t *verification_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_direct_io";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->use_direct_io = use_direct_io;
+
+	return( 1 );
+}
+
 /* Opens the input of the verification handle
  * Returns 1 if successful or -1 on error
  */
@@ -463,6 +457,7 @@ int verification_handle_open_input(
 	libcstring_system_character_t **libewf_filenames = NULL;
 	static char *function                            = "verification_handle_open_input";
 	size_t first_filename_length                     = 0;
+	int access_flags                                 = LIBEWF_OPEN_READ;
 
 	if( verification_handle == NULL )
 	{
@@ -548,19 +543,23 @@ int verification_handle_open_input(
 			goto on_error;
 		}
 	}
+	if( verification_handle->use_direct_io != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+	}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     verification_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     verification_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -703,73 +702,35 @@ int verification_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
+	if( verification_handle->integrity_hash != NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( verification_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		verification_handle->md5_context_initialized = 1;
-	}
-	if( verification_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_initialize(
-		     &( verification_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - integrity hash value already set.",
+		 function );
 
-			goto on_error;
-		}
-		verification_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( verification_handle->calculate_sha256 != 0 )
+	if( integrity_hash_initialize(
+	     &( verification_handle->integrity_hash ),
+	     verification_handle->calculate_md5,
+	     verification_handle->calculate_sha1,
+	     verification_handle->calculate_sha256,
+	     (uint8_t) ( verification_handle->number_of_threads != 0 ),
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( verification_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create integrity hash.",
+		 function );
 
-			goto on_error;
-		}
-		verification_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( verification_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( verification_handle->sha1_context ),
-		 NULL );
-	}
-	if( verification_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( verification_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -794,83 +755,21 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( integrity_hash_update(
+	     verification_handle->integrity_hash,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update integrity hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     verification_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( verification_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     verification_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( verification_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_update(
-		     verification_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	return( 1 );
 }
 
@@ -881,10 +780,6 @@ int verification_handle_finalize_integrity_hash(
      verification_handle_t *verification_handle,
      libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
 	static char *function = "verification_handle_finalize_integrity_hash";
 
 	if( verification_handle == NULL )
@@ -898,186 +793,46 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
-	{
-		if( verification_handle->calculated_md5_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid verification handle - missing calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_md5_finalize(
-		     verification_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_md5_free(
-		     &( verification_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free MD5 context.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     verification_handle->calculated_md5_hash_string,
-		     33,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( verification_handle->calculate_sha1 != 0 )
+	if( integrity_hash_finalize(
+	     verification_handle->integrity_hash,
+	     verification_handle->calculated_md5_hash_string,
+	     33,
+	     verification_handle->calculated_sha1_hash_string,
+	     41,
+	     verification_handle->calculated_sha256_hash_string,
+	     65,
+	     error ) != 1 )
 	{
-		if( verification_handle->calculated_sha1_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid verification handle - missing calculated SHA1 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha1_finalize(
-		     verification_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha1_free(
-		     &( verification_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free SHA1 context.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     verification_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( verification_handle->calculate_sha256 != 0 )
+	if( integrity_hash_free(
+	     &( verification_handle->integrity_hash ),
+	     error ) != 1 )
 	{
-		if( verification_handle->calculated_sha256_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid verification handle - missing calculated SHA256 hash string.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha256_finalize(
-		     verification_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha256_free(
-		     &( verification_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free SHA256 context.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     verification_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free integrity hash.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	return( 1 );
 }
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Prepares a storage media buffer for verification
+/* Reads and prepares a storage media buffer for verification
+ * The storage media offset and requested size of the storage media buffer
+ * must be set before the buffer is pushed onto the process thread pool
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
  */
@@ -1088,6 +843,7 @@ int verification_handle_process_storage_media_buffer_callback(
         libcerror_error_t *error = NULL;
         static char *function    = "verification_handle_process_storage_media_buffer_callback";
 	ssize_t process_count    = 0;
+	ssize_t read_count       = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -1100,10 +856,36 @@ int verification_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
+	/* The (still compressed) chunks are read by the process threads
+	 * so that reading, decompressing and validating the checksums
+	 * of the chunks are done in parallel
+	 */
+	read_count = storage_media_buffer_read_from_handle_at_offset(
+	              storage_media_buffer,
+	              verification_handle->input_handle,
+	              storage_media_buffer->storage_media_offset,
+	              storage_media_buffer->requested_size,
+	              &error );
 
+	if( read_count > 0 )
+	{
+		process_count = storage_media_buffer_read_process(
+				 storage_media_buffer,
+				 &error );
+	}
+	else
+	{
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
+			 function );
+		}
+		process_count = -1;
+	}
 	if( process_count < 0 )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1116,14 +898,32 @@ int verification_handle_process_storage_media_buffer_callback(
 		libcerror_error_free(
 		 &error );
 
-		process_count = verification_handle->chunk_size;
+		/* Hash the data that could not be read as zero bytes so that
+		 * the output thread pool can continue with the next buffer
+		 */
+		if( memory_set(
+		     storage_media_buffer->raw_buffer,
+		     0,
+		     storage_media_buffer->requested_size ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->raw_buffer_data_size = storage_media_buffer->requested_size;
+		storage_media_buffer->processed_size       = storage_media_buffer->requested_size;
 
 		/* Append a read error
 		 */
 		if( verification_handle_append_read_error(
 		     verification_handle,
 		     storage_media_buffer->storage_media_offset,
-		     (size_t) verification_handle->chunk_size,
+		     storage_media_buffer->requested_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1875,42 +1675,17 @@ int verification_handle_verify_input(
 		{
 			read_size = (size_t) remaining_media_size;
 		}
-		read_count = storage_media_buffer_read_from_handle(
-		              storage_media_buffer,
-		              verification_handle->input_handle,
-		              read_size,
-		              error );
-
-		if( read_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data.",
-			 function );
-
-			goto on_error;
-		}
-		if( read_count == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unexpected end of data.",
-			 function );
-
-			goto on_error;
-		}
-		storage_media_buffer->storage_media_offset = storage_media_offset;
-
-		storage_media_offset += read_count;
-		remaining_media_size -= read_count;
-
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
+			/* The storage media buffer is read by the process thread pool
+			 */
+			storage_media_buffer->storage_media_offset = storage_media_offset;
+			storage_media_buffer->requested_size       = read_size;
+
+			storage_media_offset += read_size;
+			remaining_media_size -= read_size;
+
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -1930,6 +1705,39 @@ int verification_handle_verify_input(
 		else
 #endif
 		{
+			read_count = storage_media_buffer_read_from_handle(
+			              storage_media_buffer,
+			              verification_handle->input_handle,
+			              read_size,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data.",
+				 function );
+
+				goto on_error;
+			}
+			if( read_count == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unexpected end of data.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer->storage_media_offset = storage_media_offset;
+
+			storage_media_offset += read_count;
+			remaining_media_size -= read_count;
+
 			process_count = storage_media_buffer_read_process(
 			                 storage_media_buffer,
 		        	         error );
@@ -32,6 +32,7 @@
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "integrity_hash.h"
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
@@ -58,17 +59,13 @@ struct verification_handle
 	 */
 	int header_codepage;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
+	/* The integrity hash
 	 */
-	uint8_t calculate_md5;
+	integrity_hash_t *integrity_hash;
 
-	/* The MD5 digest context
-	 */
-	libhmac_md5_context_t *md5_context;
-
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -86,14 +83,6 @@ struct verification_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha1_hash_string;
@@ -110,14 +99,6 @@ struct verification_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha256_hash_string;
@@ -134,6 +115,10 @@ struct verification_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the segment files should be accessed using direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -214,6 +199,11 @@ int verification_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int verification_handle_set_direct_io(
+     verification_handle_t *verification_handle,
+     uint8_t use_direct_io,
+     libcerror_error_t **error );
+
 int verification_handle_open_input(
      verification_handle_t *verification_handle,
      libcstring_system_character_t * const * filenames,
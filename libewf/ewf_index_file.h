@@ -0,0 +1,220 @@
+/*
+ * EWF (chunk-offset) index file
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_INDEX_FILE_H )
+#define _EWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file header
+ * All values are stored in little-endian
+ */
+typedef struct ewf_index_file_header ewf_index_file_header_t;
+
+struct ewf_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "ewfindex"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of segments
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segments[ 4 ];
+
+	/* The size of the data that follows the header
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The Adler-32 checksum of the data that follows the header
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_checksum[ 4 ];
+
+	/* The Adler-32 checksum of all (previous) header data
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+/* The index file segment
+ * The segment is followed by the section offsets and the chunk groups
+ */
+typedef struct ewf_index_file_segment ewf_index_file_segment_t;
+
+struct ewf_index_file_segment
+{
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file type
+	 * Consists of 1 byte
+	 */
+	uint8_t segment_file_type;
+
+	/* The format major version
+	 * Consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The format minor version
+	 * Consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 * Consists of 1 byte
+	 */
+	uint8_t segment_file_flags;
+
+	/* The compression method
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* The index flags
+	 * Consists of 2 bytes
+	 */
+	uint8_t flags[ 2 ];
+
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment file modification time
+	 * Consists of 8 bytes
+	 */
+	uint8_t modification_time[ 8 ];
+
+	/* The set identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The device information section index
+	 * Consists of 4 bytes
+	 * Contains 0xffffffff if not set
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The last chunk filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+};
+
+/* The index file section
+ */
+typedef struct ewf_index_file_section ewf_index_file_section_t;
+
+struct ewf_index_file_section
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+};
+
+/* The index file chunk group
+ * A chunk group corresponds with a table section
+ */
+typedef struct ewf_index_file_chunk_group ewf_index_file_chunk_group_t;
+
+struct ewf_index_file_chunk_group
+{
+	/* The chunk group data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The chunk group data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* The storage media size of the chunk group
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_size[ 8 ];
+
+	/* The range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
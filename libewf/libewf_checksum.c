@@ -29,12 +29,14 @@
 
 #include "libewf_checksum.h"
 #include "libewf_libcerror.h"
+#include "libewf_simd.h"
 #include "libewf_types.h"
 
 #if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The SIMD implementation is used when supported by the CPU, otherwise zlib
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -45,6 +47,7 @@ int libewf_checksum_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_checksum_calculate_adler32";
+	int instruction_set   = 0;
 
 	if( checksum_value == NULL )
 	{
@@ -68,6 +71,29 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
+	instruction_set = libewf_simd_get_best_instruction_set();
+
+	if( instruction_set != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+	{
+		if( libewf_simd_calculate_adler32(
+		     checksum_value,
+		     buffer,
+		     size,
+		     initial_value,
+		     instruction_set,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate Adler-32.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	if( size > (size_t) UINT_MAX )
 	{
 		libcerror_error_set(
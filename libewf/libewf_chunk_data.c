@@ -33,21 +33,26 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_simd.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
 /* Creates chunk data
  * Make sure the value chunk_data is referencing, is set to NULL
+ * If a pool is provided the chunk data and its buffers are allocated from the pool
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *pool,
      size32_t chunk_size,
      uint8_t clear_data,
      libcerror_error_t **error )
 {
 	static char *function      = "libewf_chunk_data_initialize";
 	size_t allocated_data_size = 0;
+	int result                 = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -83,19 +88,42 @@ int libewf_chunk_data_initialize(
 
 		return( -1 );
 	}
-	*chunk_data = memory_allocate_structure(
-	               libewf_chunk_data_t );
+	if( pool != NULL )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          sizeof( libewf_chunk_data_t ),
+		          (uint8_t **) chunk_data,
+		          error );
+	}
+	else
+	{
+		*chunk_data = memory_allocate_structure(
+		               libewf_chunk_data_t );
+
+		if( *chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk data.",
+			 function );
 
-	if( *chunk_data == NULL )
+			return( -1 );
+		}
+		result = 1;
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 		 "%s: unable to create chunk data.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( memory_set(
 	     *chunk_data,
@@ -109,13 +137,10 @@ int libewf_chunk_data_initialize(
 		 "%s: unable to clear chunk data.",
 		 function );
 
-		memory_free(
-		 *chunk_data );
-
-		*chunk_data = NULL;
-
-		return( -1 );
+		goto on_error;
 	}
+	( *chunk_data )->pool = pool;
+
 	/* Reserve 4 bytes for the chunk checksum
 	 */
 	allocated_data_size = (size_t) chunk_size + 4;
@@ -128,10 +153,11 @@ int libewf_chunk_data_initialize(
 	}
 	allocated_data_size = ( allocated_data_size / 16 ) * 16;
 
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
-
-	if( ( *chunk_data )->data == NULL )
+	if( libewf_chunk_data_allocate_buffer(
+	     *chunk_data,
+	     allocated_data_size,
+	     &( ( *chunk_data )->data ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -169,13 +195,26 @@ on_error:
 	if( *chunk_data != NULL )
 	{
 		if( ( *chunk_data )->data != NULL )
+		{
+			libewf_chunk_data_free_buffer(
+			 *chunk_data,
+			 &( ( *chunk_data )->data ),
+			 allocated_data_size,
+			 NULL );
+		}
+		if( pool != NULL )
+		{
+			libewf_chunk_data_pool_release(
+			 pool,
+			 (uint8_t **) chunk_data,
+			 sizeof( libewf_chunk_data_t ),
+			 NULL );
+		}
+		else
 		{
 			memory_free(
-			 ( *chunk_data )->data );
+			 *chunk_data );
 		}
-		memory_free(
-		 *chunk_data );
-
 		*chunk_data = NULL;
 	}
 	return( -1 );
@@ -188,7 +227,9 @@ int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_free";
+	libewf_chunk_data_pool_t *pool = NULL;
+	static char *function          = "libewf_chunk_data_free";
+	int result                     = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -205,23 +246,65 @@ int libewf_chunk_data_free(
 	{
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->allocated_data_size,
+			     error ) != 1 )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_free_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->allocated_compressed_data_size,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			result = -1;
 		}
-		memory_free(
-		 *chunk_data );
+		pool = ( *chunk_data )->pool;
+
+		if( pool != NULL )
+		{
+			if( libewf_chunk_data_pool_release(
+			     pool,
+			     (uint8_t **) chunk_data,
+			     sizeof( libewf_chunk_data_t ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release chunk data to pool.",
+				 function );
 
+				result = -1;
+			}
+		}
+		else
+		{
+			memory_free(
+			 *chunk_data );
+		}
 		*chunk_data = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the chunk data
@@ -295,8 +378,10 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_data )->data            = NULL;
-	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->data                           = NULL;
+	( *destination_chunk_data )->compressed_data                = NULL;
+	( *destination_chunk_data )->allocated_compressed_data_size = source_chunk_data->compressed_data_size;
+	( *destination_chunk_data )->pool                           = NULL;
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -383,6 +468,156 @@ on_error:
 	return( -1 );
 }
 
+/* Allocates a buffer of the chunk data
+ * The buffer is allocated from the chunk data pool if available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_allocate_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->pool != NULL )
+	{
+		if( libewf_chunk_data_pool_allocate(
+		     chunk_data->pool,
+		     buffer_size,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate buffer from pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * buffer_size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees a buffer of the chunk data
+ * The buffer is released to the chunk data pool if available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_data->pool != NULL )
+	{
+		if( libewf_chunk_data_pool_release(
+		     chunk_data->pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release buffer to pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
 /* Reads chunk data into a buffer
  * Returns the number of bytes read or -1 on error
  */
@@ -566,6 +801,8 @@ int libewf_chunk_data_pack(
 	static char *function            = "libewf_chunk_data_pack";
 	size_t safe_compressed_data_size = 0;
 	uint64_t fill_pattern            = 0;
+	uint64_t start_time              = 0;
+	int8_t compression_level         = 0;
 	int result                       = 0;
 
 	if( chunk_data == NULL )
@@ -723,10 +960,11 @@ int libewf_chunk_data_pack(
 		{
 			chunk_data->compressed_data_size = 2 * chunk_data->chunk_size;
 		}
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
-
-		if( chunk_data->compressed_data == NULL )
+		if( libewf_chunk_data_allocate_buffer(
+		     chunk_data,
+		     chunk_data->compressed_data_size,
+		     &( chunk_data->compressed_data ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -737,6 +975,8 @@ int libewf_chunk_data_pack(
 
 			goto on_error;
 		}
+		chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size;
+
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 		 && ( chunk_data->data_size == (size_t) chunk_data->chunk_size ) )
 		{
@@ -801,23 +1041,48 @@ int libewf_chunk_data_pack(
 		else
 		{
 			/* If compression was forced but no compression level provided use the default
+			 * The IO handle is not changed since chunks can be packed in multiple threads
 			 */
-			if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			compression_level = io_handle->compression_level;
+
+			if( compression_level == LIBEWF_COMPRESSION_NONE )
 			{
-				io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
+			if( io_handle->statistics != NULL )
+			{
+				start_time = libewf_statistics_get_time();
+			}
 /* TODO add a light weight entropy test */
 			result = libewf_compress_data(
 				  chunk_data->compressed_data,
 				  &safe_compressed_data_size,
 				  io_handle->compression_method,
-				  io_handle->compression_level,
+				  compression_level,
 				  chunk_data->data,
 				  chunk_data->data_size,
 				  error );
 
+			if( io_handle->statistics != NULL )
+			{
+				if( libewf_statistics_add(
+				     io_handle->statistics,
+				     LIBEWF_STATISTIC_COMPRESSION_TIME,
+				     libewf_statistics_get_time() - start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update statistics.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -1006,14 +1271,29 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->allocated_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		chunk_data->data  = chunk_data->compressed_data;
-		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 
@@ -1022,11 +1302,13 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
+	chunk_data->allocated_compressed_data_size = 0;
 	chunk_data->compressed_data_size = 0;
 
 	return( -1 );
@@ -1043,7 +1325,9 @@ int libewf_chunk_data_unpack(
 {
 	static char *function        = "libewf_chunk_data_unpack";
 	size_t remaining_chunk_size  = 0;
+	uint64_t start_time          = 0;
 	uint32_t calculated_checksum = 0;
+	int result                   = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1109,8 +1393,11 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
-			chunk_data->compressed_data      = chunk_data->data;
-			chunk_data->compressed_data_size = chunk_data->data_size;
+			chunk_data->compressed_data                = chunk_data->data;
+			chunk_data->compressed_data_size           = chunk_data->data_size;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+
+			chunk_data->data = NULL;
 
 			/* Reserve 4 bytes for the checksum
 			 */
@@ -1124,10 +1411,11 @@ int libewf_chunk_data_unpack(
 			}
 			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
 
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
+			if( libewf_chunk_data_allocate_buffer(
+			     chunk_data,
+			     chunk_data->allocated_data_size,
+			     &( chunk_data->data ),
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1201,13 +1489,37 @@ int libewf_chunk_data_unpack(
 			}
 			else
 			{
-				if( libewf_decompress_data(
-				     chunk_data->compressed_data,
-				     chunk_data->compressed_data_size,
-				     io_handle->compression_method,
-				     chunk_data->data,
-				     &( chunk_data->data_size ),
-				     error ) != 1 )
+				if( io_handle->statistics != NULL )
+				{
+					start_time = libewf_statistics_get_time();
+				}
+				result = libewf_decompress_data(
+				          chunk_data->compressed_data,
+				          chunk_data->compressed_data_size,
+				          io_handle->compression_method,
+				          chunk_data->data,
+				          &( chunk_data->data_size ),
+				          error );
+
+				if( io_handle->statistics != NULL )
+				{
+					if( libewf_statistics_add(
+					     io_handle->statistics,
+					     LIBEWF_STATISTIC_DECOMPRESSION_TIME,
+					     libewf_statistics_get_time() - start_time,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to update statistics.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( result != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1232,6 +1544,25 @@ int libewf_chunk_data_unpack(
 
 					chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+					if( io_handle->statistics != NULL )
+					{
+						if( libewf_statistics_add(
+						     io_handle->statistics,
+						     LIBEWF_STATISTIC_CHECKSUM_FAILURES,
+						     1,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to update statistics.",
+							 function );
+
+							goto on_error;
+						}
+					}
 				}
 			}
 		}
@@ -1256,49 +1587,71 @@ int libewf_chunk_data_unpack(
 				 &( ( chunk_data->data )[ chunk_data->data_size ] ),
 				 chunk_data->checksum );
 			}
-			if( libewf_checksum_calculate_adler32(
-			     &calculated_checksum,
-			     chunk_data->data,
-			     chunk_data->data_size,
-			     1,
-			     error ) != 1 )
+			if( io_handle->verify_checksums != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to calculate checksum.",
-				 function );
+				if( libewf_checksum_calculate_adler32(
+				     &calculated_checksum,
+				     chunk_data->data,
+				     chunk_data->data_size,
+				     1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to calculate checksum.",
+					 function );
 
-				goto on_error;
-			}
-			if( chunk_data->checksum != calculated_checksum )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
-				 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
-				 function,
-				 chunk_data->checksum,
-				 calculated_checksum );
+					goto on_error;
+				}
+				if( chunk_data->checksum != calculated_checksum )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+					 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+					 function,
+					 chunk_data->checksum,
+					 calculated_checksum );
 
 #if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( ( error != NULL )
-					 && ( *error != NULL ) )
+					if( libcnotify_verbose != 0 )
 					{
-						libcnotify_print_error_backtrace(
-						 *error );
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
 					}
-				}
 #endif
-				libcerror_error_free(
-				 error );
+					libcerror_error_free(
+					 error );
+
+					chunk_data->data_size    = (size_t) chunk_data->chunk_size;
+					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 
-				chunk_data->data_size    = (size_t) chunk_data->chunk_size;
-				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+					if( io_handle->statistics != NULL )
+					{
+						if( libewf_statistics_add(
+						     io_handle->statistics,
+						     LIBEWF_STATISTIC_CHECKSUM_FAILURES,
+						     1,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to update statistics.",
+							 function );
+
+							goto on_error;
+						}
+					}
+				}
 			}
 		}
 		chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
@@ -1328,118 +1681,187 @@ on_error:
 	{
 		if( chunk_data->data != NULL )
 		{
-			memory_free(
-			 chunk_data->data );
+			libewf_chunk_data_free_buffer(
+			 chunk_data,
+			 &( chunk_data->data ),
+			 chunk_data->allocated_data_size,
+			 NULL );
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	return( -1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Restores the packed chunk data of chunk data that was unpacked
+ * Unpacking retains the compressed data and the checksum of uncompressed data
+ * which allows to write the chunk data without compressing it again
+ * Returns 1 if successful, 0 if the packed chunk data cannot be restored or -1 on error
  */
-int libewf_chunk_data_check_for_empty_block(
-     const uint8_t *data,
-     size_t data_size,
+int libewf_chunk_data_restore_packed(
+     libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	static char *function = "libewf_chunk_data_restore_packed";
 
-	if( data == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( chunk_data->data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size <= 1 )
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
 	{
-		return( 0 );
+		return( 1 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
-
-	data_size--;
-
-	/* Only optimize for data larger than the alignment
+	/* Corrupted chunk data could have been zeroed and the packed data is not valid
 	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	if( ( chunk_data->range_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		return( 0 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( chunk_data->compressed_data == NULL )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
+			return( 0 );
 		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( *data_start != *data_index )
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->allocated_data_size,
+			     error ) != 1 )
 			{
-				return( 0 );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				return( -1 );
 			}
-			data_index++;
-			data_size--;
 		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-		while( data_size > sizeof( libewf_aligned_t ) )
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
+	}
+	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) == 0 )
 		{
-			if( *aligned_data_start != *aligned_data_index )
+			if( ( chunk_data->data_size + 4 ) > chunk_data->allocated_data_size )
 			{
 				return( 0 );
 			}
-			aligned_data_index++;
+			byte_stream_copy_from_uint32_little_endian(
+			 &( ( chunk_data->data )[ chunk_data->data_size ] ),
+			 chunk_data->checksum );
 
-			data_size -= sizeof( libewf_aligned_t );
+			chunk_data->data_size += 4;
 		}
-		data_index = (uint8_t *) aligned_data_index;
 	}
-	while( data_size != 0 )
+	chunk_data->padding_size = 0;
+	chunk_data->range_flags &= LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
+ * Uses the fastest SIMD instruction set supported by the CPU
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_empty_block(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_check_for_empty_block";
+	uint64_t pattern      = 0;
+	int result            = 0;
+
+	if( data == NULL )
 	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_index++;
-		data_size--;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
 	}
-	return( 1 );
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size <= 1 )
+	{
+		return( 0 );
+	}
+	/* An empty-block is a 64-bit pattern of the first byte
+	 */
+	pattern = (uint64_t) data[ 0 ] * 0x0101010101010101ULL;
+
+	result = libewf_simd_check_for_64_bit_pattern_fill(
+	          data,
+	          data_size,
+	          pattern,
+	          libewf_simd_get_best_instruction_set(),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check for empty-block.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
 }
 
 /* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+ * Uses the fastest SIMD instruction set supported by the CPU
  * Returns 1 if a pattern was found, 0 if not or -1 on error
  */
 int libewf_chunk_data_check_for_64_bit_pattern_fill(
@@ -1448,11 +1870,9 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	static char *function = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint64_t data_pattern = 0;
+	int result            = 0;
 
 	if( data == NULL )
 	{
@@ -1492,69 +1912,33 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 	{
 		return( 0 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
+	byte_stream_copy_to_uint64_little_endian(
+	 data,
+	 data_pattern );
 
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
-	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
+	result = libewf_simd_check_for_64_bit_pattern_fill(
+	          &( data[ 8 ] ),
+	          data_size - 8,
+	          data_pattern,
+	          libewf_simd_get_best_instruction_set(),
+	          error );
 
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check for 64-bit pattern fill.",
+		 function );
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
+		return( -1 );
 	}
-	while( data_size != 0 )
+	else if( result != 0 )
 	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_start++;
-		data_index++;
-		data_size--;
+		*pattern = data_pattern;
 	}
-	byte_stream_copy_to_uint64_little_endian(
-	 data,
-	 *pattern );
-
-	return( 1 );
+	return( result );
 }
 
 /* Writes a chunk
@@ -1992,6 +2376,7 @@ int libewf_chunk_data_read_element_data(
 	}
 	if( libewf_chunk_data_initialize(
 	     &chunk_data,
+	     io_handle->chunk_data_pool,
 	     io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -2036,6 +2421,24 @@ int libewf_chunk_data_read_element_data(
 
 		goto on_error;
 	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     io_handle->statistics,
+		     LIBEWF_STATISTIC_CHUNKS_READ,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
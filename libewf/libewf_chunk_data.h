@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -59,6 +60,10 @@ struct libewf_chunk_data
 	 */
 	uint8_t *compressed_data;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The compressed data offset
 	 */
 	size_t compressed_data_offset;
@@ -86,10 +91,16 @@ struct libewf_chunk_data
 	/* The chunk IO flags
 	 */
 	int8_t chunk_io_flags;
+
+	/* The chunk data pool
+	 * the chunk data and its buffers are released to the pool when freed
+	 */
+	libewf_chunk_data_pool_t *pool;
 };
 
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *pool,
      size32_t chunk_size,
      uint8_t clear_data,
      libcerror_error_t **error );
@@ -103,6 +114,18 @@ int libewf_chunk_data_clone(
      libewf_chunk_data_t *source_chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_read_buffer(
          libewf_chunk_data_t *chunk_data,
          uint8_t *buffer,
@@ -128,6 +151,10 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libewf_chunk_data_restore_packed(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_check_for_empty_block(
      const uint8_t *data,
      size_t data_size,
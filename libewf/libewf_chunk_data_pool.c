@@ -0,0 +1,661 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk data pool
+ * Make sure the value pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **pool,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_initialize";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*pool = memory_allocate_structure(
+	         libewf_chunk_data_pool_t );
+
+	if( *pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pool,
+	     0,
+	     sizeof( libewf_chunk_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pool.",
+		 function );
+
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *pool )->maximum_size = maximum_size;
+
+	return( 1 );
+
+on_error:
+	if( *pool != NULL )
+	{
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk data pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_free";
+	int block_index       = 0;
+	int result            = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		if( ( *pool )->blocks != NULL )
+		{
+			for( block_index = 0;
+			     block_index < ( *pool )->number_of_blocks;
+			     block_index++ )
+			{
+				memory_free(
+				 ( *pool )->blocks[ block_index ] );
+			}
+			memory_free(
+			 ( *pool )->blocks );
+		}
+		if( ( *pool )->block_sizes != NULL )
+		{
+			memory_free(
+			 ( *pool )->block_sizes );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( result );
+}
+
+/* Allocates a memory block of a specific size
+ * A free memory block of the same size is reused from the pool if available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_allocate(
+     libewf_chunk_data_pool_t *pool,
+     size_t block_size,
+     uint8_t **block,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_allocate";
+	int block_index       = 0;
+	int last_block_index  = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Search from the most recently released memory block since it is
+	 * the most likely to be of the same size and still be in the CPU cache
+	 */
+	for( block_index = pool->number_of_blocks - 1;
+	     block_index >= 0;
+	     block_index-- )
+	{
+		if( pool->block_sizes[ block_index ] == block_size )
+		{
+			*block = pool->blocks[ block_index ];
+
+			last_block_index = pool->number_of_blocks - 1;
+
+			pool->blocks[ block_index ]      = pool->blocks[ last_block_index ];
+			pool->block_sizes[ block_index ] = pool->block_sizes[ last_block_index ];
+			pool->number_of_blocks          -= 1;
+			pool->pooled_size               -= block_size;
+
+			break;
+		}
+	}
+	if( *block != NULL )
+	{
+		pool->number_of_reuses += 1;
+	}
+	else
+	{
+		pool->number_of_allocations += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( *block == NULL )
+	{
+		*block = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * block_size );
+
+		if( *block == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+on_error:
+	if( *block != NULL )
+	{
+		memory_free(
+		 *block );
+
+		*block = NULL;
+	}
+	return( -1 );
+#endif
+}
+
+/* Releases a memory block of a specific size
+ * The memory block is kept in the pool for reuse unless this would exceed
+ * the maximum size of the pool, in which case it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release(
+     libewf_chunk_data_pool_t *pool,
+     uint8_t **block,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	void *reallocation          = NULL;
+	static char *function       = "libewf_chunk_data_pool_release";
+	int number_of_blocks        = 0;
+	int result                  = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		memory_free(
+		 *block );
+
+		*block = NULL;
+
+		return( -1 );
+	}
+#endif
+	if( ( block_size > 0 )
+	 && ( ( pool->pooled_size + block_size ) <= pool->maximum_size ) )
+	{
+		if( pool->number_of_blocks >= pool->number_of_allocated_blocks )
+		{
+			number_of_blocks = pool->number_of_allocated_blocks + LIBEWF_CHUNK_DATA_POOL_ALLOCATION_INCREMENT;
+
+			reallocation = memory_reallocate(
+			                pool->blocks,
+			                sizeof( uint8_t * ) * number_of_blocks );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize blocks.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				pool->blocks = (uint8_t **) reallocation;
+
+				reallocation = memory_reallocate(
+				                pool->block_sizes,
+				                sizeof( size_t ) * number_of_blocks );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize block sizes.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					pool->block_sizes                = (size_t *) reallocation;
+					pool->number_of_allocated_blocks = number_of_blocks;
+				}
+			}
+		}
+		if( result == 1 )
+		{
+			pool->blocks[ pool->number_of_blocks ]      = *block;
+			pool->block_sizes[ pool->number_of_blocks ] = block_size;
+			pool->number_of_blocks                     += 1;
+			pool->pooled_size                          += block_size;
+
+			*block = NULL;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( *block != NULL )
+	{
+		memory_free(
+		 *block );
+
+		*block = NULL;
+	}
+	return( result );
+}
+
+/* Sets the maximum size of the (free) memory blocks in the pool
+ * Free memory blocks are freed until the pool no longer exceeds the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_set_maximum_size(
+     libewf_chunk_data_pool_t *pool,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_set_maximum_size";
+	int block_index       = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	pool->maximum_size = maximum_size;
+
+	/* Free the least recently released memory blocks first
+	 */
+	while( ( pool->pooled_size > pool->maximum_size )
+	    && ( pool->number_of_blocks > 0 ) )
+	{
+		memory_free(
+		 pool->blocks[ 0 ] );
+
+		pool->pooled_size      -= pool->block_sizes[ 0 ];
+		pool->number_of_blocks -= 1;
+
+		for( block_index = 0;
+		     block_index < pool->number_of_blocks;
+		     block_index++ )
+		{
+			pool->blocks[ block_index ]      = pool->blocks[ block_index + 1 ];
+			pool->block_sizes[ block_index ] = pool->block_sizes[ block_index + 1 ];
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the pool statistics
+ * The statistics are the number of memory blocks allocated from the system,
+ * the number of memory blocks reused from the pool and the size of the (free)
+ * memory blocks currently in the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_statistics(
+     libewf_chunk_data_pool_t *pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     size64_t *pooled_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_get_statistics";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_allocations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reuses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reuses.",
+		 function );
+
+		return( -1 );
+	}
+	if( pooled_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pooled size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_allocations = pool->number_of_allocations;
+	*number_of_reuses      = pool->number_of_reuses;
+	*pooled_size           = pool->pooled_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,116 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_DATA_POOL_H )
+#define _LIBEWF_CHUNK_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_data_pool libewf_chunk_data_pool_t;
+
+struct libewf_chunk_data_pool
+{
+	/* The (free) memory blocks
+	 */
+	uint8_t **blocks;
+
+	/* The sizes of the (free) memory blocks
+	 */
+	size_t *block_sizes;
+
+	/* The number of (free) memory blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of allocated block entries
+	 */
+	int number_of_allocated_blocks;
+
+	/* The size of the (free) memory blocks in the pool
+	 */
+	size64_t pooled_size;
+
+	/* The maximum size of the (free) memory blocks in the pool
+	 */
+	size64_t maximum_size;
+
+	/* The number of memory blocks allocated from the system
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of memory blocks reused from the pool
+	 */
+	uint64_t number_of_reuses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **pool,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_allocate(
+     libewf_chunk_data_pool_t *pool,
+     size_t block_size,
+     uint8_t **block,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release(
+     libewf_chunk_data_pool_t *pool,
+     uint8_t **block,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_set_maximum_size(
+     libewf_chunk_data_pool_t *pool,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_statistics(
+     libewf_chunk_data_pool_t *pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     size64_t *pooled_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_DATA_POOL_H ) */
+
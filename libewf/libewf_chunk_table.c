@@ -31,10 +31,11 @@
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_lru_cache.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 /* Creates a chunk table
  * Make sure the value chunk_table is referencing, is set to NULL
@@ -384,7 +385,6 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 	return( 1 );
 }
 
-
 /* Retrieves a checksum error
  * Returns 1 if successful or -1 on error
  */
@@ -480,7 +480,7 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_table_t *chunk_table,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      uint32_t *segment_number,
      off64_t *segment_file_data_offset,
@@ -643,7 +643,7 @@ int libewf_chunk_table_chunk_exists_for_offset(
      uint64_t chunk_index,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      libcerror_error_t **error )
 {
@@ -737,38 +737,24 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	return( result );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Reads the (packed) chunk data of a specific chunk in a chunk group
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_read_chunk_data_by_index(
      libewf_chunk_table_t *chunk_table,
-     uint64_t chunk_index,
+     libewf_chunk_group_t *chunk_group,
+     int chunks_list_index,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
-     libewf_media_values_t *media_values,
-     libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
-     off64_t offset,
      libewf_chunk_data_t **chunk_data,
-     off64_t *chunk_data_offset,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *corrupted_chunk_data = NULL;
-	libewf_chunk_group_t *chunk_group         = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t chunk_offset                      = 0;
-	off64_t chunk_group_data_offset           = 0;
-	off64_t segment_file_data_offset          = 0;
-	size_t chunk_data_size                    = 0;
-	uint64_t start_sector                     = 0;
-	uint64_t number_of_sectors                = 0;
-	uint32_t segment_number                   = 0;
-	int chunk_groups_list_index               = 0;
-	int chunks_list_index                     = 0;
-	int result                                = 0;
+	static char *function      = "libewf_chunk_table_read_chunk_data_by_index";
+	off64_t chunk_data_offset  = 0;
+	size64_t chunk_data_size   = 0;
+	ssize_t read_count         = 0;
+	uint32_t chunk_data_flags  = 0;
+	int file_io_pool_entry     = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -781,24 +767,24 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( chunk_group == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid chunk group.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values == NULL )
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
@@ -814,217 +800,98 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( chunk_data_offset == NULL )
+	if( *chunk_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-		  chunk_table,
-		  file_io_pool,
-		  segment_table,
-		  chunk_groups_cache,
-		  offset,
-		  &segment_number,
-		  &segment_file_data_offset,
-		  &segment_file,
-		  &chunk_groups_list_index,
-		  &chunk_group_data_offset,
-		  &chunk_group,
-		  error );
-
-	if( result == -1 )
+	if( libfdata_list_get_element_by_index(
+	     chunk_group->chunks_list,
+	     chunks_list_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     &chunk_data_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 "%s: unable to retrieve chunks list element: %d.",
 		 function,
-		 offset );
+		 chunks_list_index );
 
 		goto on_error;
 	}
-	if( result != 0 )
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
 	{
-		if( chunk_group == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk group: %d.",
-			 function,
-			 chunk_groups_list_index );
-
-			goto on_error;
-		}
-		result = libfdata_list_get_element_value_at_offset(
-			  chunk_group->chunks_list,
-			  (intptr_t *) file_io_pool,
-			  chunks_cache,
-			  chunk_group_data_offset,
-			  &chunks_list_index,
-			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
-			  error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
-			 function,
-			 chunk_index,
-			 chunk_groups_list_index,
-			 segment_number,
-			 segment_file_data_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk data flags.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-	if( result != 0 )
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     io_handle->chunk_data_pool,
+	     io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
 	{
-		if( *chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			goto on_error;
-		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
 
-			goto on_error;
-		}
-		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			chunk_offset = offset - *chunk_data_offset;
-		}
+		goto on_error;
 	}
-	else
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+		      *chunk_data,
+		      file_io_pool,
+		      file_io_pool_entry,
+	              chunk_data_offset,
+		      chunk_data_size,
+		      chunk_data_flags,
+		      error );
+
+	if( read_count < 0 )
 	{
-/* TODO get chunk from chunk_table->corrupted_chunks_list */
-
-		chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
-		chunk_data_size = media_values->chunk_size;
-
-		if( (size64_t) ( chunk_offset + chunk_data_size ) > media_values->media_size )
-		{
-			chunk_data_size = (size_t) ( media_values->media_size - chunk_offset );
-		}
-		if( libewf_chunk_data_initialize(
-		     &corrupted_chunk_data,
-		     media_values->chunk_size,
-		     1,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			goto on_error;
-		}
-		if( corrupted_chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data: %" PRIu64 ".",
-			 function,
-			 chunk_index );
-
-			goto on_error;
-		}
-		corrupted_chunk_data->data_size    = chunk_data_size;
-		corrupted_chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
-
-		if( libfdata_list_cache_element_value(
-		     chunk_table->corrupted_chunks_list,
-		     chunks_cache,
-		     (int) chunk_index,
-		     (int) segment_number,
-		     chunk_offset,
-		     chunk_data_size,
-		     corrupted_chunk_data->range_flags,
-		     0,
-		     (intptr_t *) corrupted_chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to cache chunk: %" PRIu64 " data in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
-			 function,
-			 chunk_index,
-			 segment_number,
-			 chunk_offset );
-
-			return( -1 );
-		}
-		*chunk_data = corrupted_chunk_data;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data at offset: 0x%08" PRIx64 " in file IO pool entry: %d.",
+		 function,
+		 chunk_data_offset,
+		 file_io_pool_entry );
 
-		/* chunks_cache takes over management of chunk_data
-		 */
-		corrupted_chunk_data = NULL;
+		goto on_error;
 	}
-	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	if( io_handle->statistics != NULL )
 	{
-		/* Add checksum error
-		 */
-		start_sector      = chunk_offset / media_values->bytes_per_sector;
-		number_of_sectors = media_values->sectors_per_chunk;
-
-		if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
-		{
-			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
-		}
-		if( libcdata_range_list_insert_range(
-		     chunk_table->checksum_errors,
-		     start_sector,
-		     number_of_sectors,
-		     NULL,
-		     NULL,
-		     NULL,
+		if( libewf_statistics_add(
+		     io_handle->statistics,
+		     LIBEWF_STATISTIC_CHUNKS_READ,
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert checksum error in range list.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
 			 function );
 
 			goto on_error;
@@ -1033,39 +900,40 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 	return( 1 );
 
 on_error:
-	if( corrupted_chunk_data != NULL )
+	if( *chunk_data != NULL )
 	{
 		libewf_chunk_data_free(
-		 &corrupted_chunk_data,
+		 chunk_data,
 		 NULL );
 	}
-	*chunk_data = NULL;
-
 	return( -1 );
 }
 
-/* Sets the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
- * Returns 1 if successful or -1 on error
+/* Retrieves the storage range of a chunk at a specific offset
+ * Returns 1 if successful, 0 if the chunk is missing or -1 on error
  */
-int libewf_chunk_table_set_chunk_data_by_offset(
+int libewf_chunk_table_get_chunk_range_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
-     libewf_chunk_data_t *chunk_data,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
      libcerror_error_t **error )
 {
 	libewf_chunk_group_t *chunk_group   = NULL;
 	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_chunk_table_set_chunk_data_by_offset";
+	static char *function               = "libewf_chunk_table_get_chunk_range_by_offset";
 	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
 	off64_t segment_file_data_offset    = 0;
 	uint32_t segment_number             = 0;
 	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
 	int result                          = 0;
 
 	if( chunk_table == NULL )
@@ -1079,17 +947,6 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( chunk_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
-		 function );
-
-		return( -1 );
-	}
 	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 		  chunk_table,
 		  file_io_pool,
@@ -1104,7 +961,7 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 		  &chunk_group,
 		  error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1116,6 +973,10 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
 	if( chunk_group == NULL )
 	{
 		libcerror_error_set(
@@ -1128,23 +989,18 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_set_element_value_at_offset(
-		  chunk_group->chunks_list,
-		  (intptr_t *) file_io_pool,
-		  chunks_cache,
-		  chunk_group_data_offset,
-		  (intptr_t *) chunk_data,
-		  (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		  LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-		  error );
-
-	if( result != 1 )
+	if( libfdata_list_get_element_index_at_offset(
+	     chunk_group->chunks_list,
+	     chunk_group_data_offset,
+	     &chunks_list_index,
+	     &element_data_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
 		 function,
 		 chunk_index,
 		 chunk_groups_list_index,
@@ -1153,6 +1009,837 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
+	if( libfdata_list_get_element_by_index(
+	     chunk_group->chunks_list,
+	     chunks_list_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunks list element: %d.",
+		 function,
+		 chunks_list_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the chunk data of a chunk at a specific offset
+ * The chunk data is not unpacked, if the chunk is missing corrupted chunk data is created
+ * The chunk data is not cached and is owned by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libewf_lru_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_read_chunk_data_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t chunk_offset                = 0;
+	off64_t element_data_offset         = 0;
+	off64_t segment_file_data_offset    = 0;
+	size_t chunk_data_size              = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_element_index_at_offset(
+		     chunk_group->chunks_list,
+		     chunk_group_data_offset,
+		     &chunks_list_index,
+		     &element_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			goto on_error;
+		}
+		if( libewf_chunk_table_read_chunk_data_by_index(
+		     chunk_table,
+		     chunk_group,
+		     chunks_list_index,
+		     io_handle,
+		     file_io_pool,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+/* TODO get chunk from chunk_table->corrupted_chunks_list */
+
+		chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
+		chunk_data_size = media_values->chunk_size;
+
+		if( (size64_t) ( chunk_offset + chunk_data_size ) > media_values->media_size )
+		{
+			chunk_data_size = (size_t) ( media_values->media_size - chunk_offset );
+		}
+		if( libewf_chunk_data_initialize(
+		     chunk_data,
+		     io_handle->chunk_data_pool,
+		     media_values->chunk_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( *chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk data: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		( *chunk_data )->data_size    = chunk_data_size;
+		( *chunk_data )->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends a checksum error for the sectors of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_append_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_append_chunk_checksum_error";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector      = ( chunk_index * media_values->chunk_size ) / media_values->bytes_per_sector;
+	number_of_sectors = media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+	{
+		number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+	}
+	if( libcdata_range_list_insert_range(
+	     chunk_table->checksum_errors,
+	     start_sector,
+	     number_of_sectors,
+	     NULL,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * The chunk data is managed by the chunks cache and is only valid until the next change of the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libewf_lru_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *read_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset";
+	off64_t chunk_offset                 = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * media_values->chunk_size;
+
+	if( ( offset < chunk_offset )
+	 || ( offset >= ( chunk_offset + media_values->chunk_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_lru_cache_get_value(
+	          chunks_cache,
+	          chunk_index,
+	          (intptr_t **) chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_chunk_table_read_chunk_data_by_offset(
+		     chunk_table,
+		     chunk_index,
+		     io_handle,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     chunk_groups_cache,
+		     offset,
+		     &read_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		*chunk_data = read_chunk_data;
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_unpack(
+	     *chunk_data,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( read_chunk_data != NULL )
+	{
+		/* The chunks cache takes over management of the chunk data
+		 */
+		result = libewf_chunk_table_cache_chunk_data(
+		          chunk_table,
+		          chunks_cache,
+		          chunk_index,
+		          read_chunk_data,
+		          error );
+
+		read_chunk_data = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to cache chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	*chunk_data_offset = offset - chunk_offset;
+
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		if( libewf_chunk_table_append_chunk_checksum_error(
+		     chunk_table,
+		     chunk_index,
+		     media_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( read_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &read_chunk_data,
+		 NULL );
+	}
+	*chunk_data = NULL;
+
+	return( -1 );
+}
+
+/* Reads ahead the chunk data of the chunks starting at a specific offset
+ * The chunk data is read but not unpacked, chunks that are already in the chunks cache are skipped
+ * The chunk data stored in the chunks data array is owned by the caller
+ * Reading ahead stops at the end of the chunk group that contains the offset
+ * Returns 1 if successful, 0 if no chunk group was found or -1 on error
+ */
+int libewf_chunk_table_read_ahead_chunks_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libewf_lru_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunks_cache,
+     off64_t offset,
+     int maximum_number_of_chunks,
+     libewf_chunk_data_t **chunks_data,
+     uint64_t *chunk_indexes,
+     int *number_of_chunks_data,
+     int *number_of_chunks_read,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data     = NULL;
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_read_ahead_chunks_by_offset";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_data_iterator            = 0;
+	int chunks_list_index               = 0;
+	int number_of_elements              = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks read.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks_data = 0;
+	*number_of_chunks_read = 0;
+
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_group->chunks_list,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunks list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_element_index_at_offset(
+	     chunk_group->chunks_list,
+	     chunk_group_data_offset,
+	     &chunks_list_index,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number,
+		 segment_file_data_offset );
+
+		goto on_error;
+	}
+	while( ( *number_of_chunks_read < maximum_number_of_chunks )
+	    && ( chunks_list_index < number_of_elements ) )
+	{
+		result = libewf_lru_cache_has_value(
+		          chunks_cache,
+		          chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " data is cached.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libewf_chunk_table_read_chunk_data_by_index(
+			     chunk_table,
+			     chunk_group,
+			     chunks_list_index,
+			     io_handle,
+			     file_io_pool,
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 ".",
+				 function,
+				 chunk_index,
+				 chunk_groups_list_index,
+				 segment_number );
+
+				goto on_error;
+			}
+			chunks_data[ *number_of_chunks_data ]   = chunk_data;
+			chunk_indexes[ *number_of_chunks_data ] = chunk_index;
+
+			*number_of_chunks_data += 1;
+
+			chunk_data = NULL;
+		}
+		*number_of_chunks_read += 1;
+
+		chunk_index++;
+		chunks_list_index++;
+	}
+	return( 1 );
+
+on_error:
+	for( chunks_data_iterator = 0;
+	     chunks_data_iterator < *number_of_chunks_data;
+	     chunks_data_iterator++ )
+	{
+		libewf_chunk_data_free(
+		 &( chunks_data[ chunks_data_iterator ] ),
+		 NULL );
+	}
+	*number_of_chunks_data = 0;
+
+	return( -1 );
+}
+
+/* Stores the chunk data of a specific chunk in the chunks cache
+ * The chunks cache takes over management of the chunk data, also if storing fails
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_cache_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libewf_lru_cache_t *chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_cache_chunk_data";
+	size_t value_size     = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	value_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+	if( chunk_data->compressed_data != NULL )
+	{
+		value_size += chunk_data->compressed_data_size;
+	}
+	if( libewf_lru_cache_set_value(
+	     chunks_cache,
+	     chunk_index,
+	     (intptr_t *) chunk_data,
+	     value_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in cache.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
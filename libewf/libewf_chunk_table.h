@@ -29,8 +29,8 @@
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_lru_cache.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -99,7 +99,7 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_table_t *chunk_table,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      uint32_t *segment_number,
      off64_t *segment_file_data_offset,
@@ -114,10 +114,50 @@ int libewf_chunk_table_chunk_exists_for_offset(
      uint64_t chunk_index,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_read_chunk_data_by_index(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_group_t *chunk_group,
+     int chunks_list_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libewf_lru_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libewf_lru_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_append_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -125,21 +165,33 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunks_cache,
      off64_t offset,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
      libcerror_error_t **error );
 
-int libewf_chunk_table_set_chunk_data_by_offset(
+int libewf_chunk_table_read_ahead_chunks_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
-     libfcache_cache_t *chunk_groups_cache,
-     libfcache_cache_t *chunks_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunks_cache,
      off64_t offset,
+     int maximum_number_of_chunks,
+     libewf_chunk_data_t **chunks_data,
+     uint64_t *chunk_indexes,
+     int *number_of_chunks_data,
+     int *number_of_chunks_read,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_cache_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libewf_lru_cache_t *chunks_cache,
+     uint64_t chunk_index,
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
@@ -0,0 +1,181 @@
+/*
+ * Chunk view functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_view.h"
+#include "libewf_libcerror.h"
+#include "libewf_sharded_cache.h"
+#include "libewf_types.h"
+
+/* Creates a chunk view
+ * Make sure the value chunk_view is referencing, is set to NULL
+ * The chunk view takes over the pin of the chunk data in the chunks cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_initialize(
+     libewf_chunk_view_t **chunk_view,
+     libewf_sharded_cache_t *chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_initialize";
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_chunk_view = memory_allocate_structure(
+	                       libewf_internal_chunk_view_t );
+
+	if( internal_chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_chunk_view,
+	     0,
+	     sizeof( libewf_internal_chunk_view_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk view.",
+		 function );
+
+		memory_free(
+		 internal_chunk_view );
+
+		return( -1 );
+	}
+	internal_chunk_view->chunk_index  = chunk_index;
+	internal_chunk_view->chunks_cache = chunks_cache;
+	internal_chunk_view->chunk_data   = chunk_data;
+
+	*chunk_view = (libewf_chunk_view_t *) internal_chunk_view;
+
+	return( 1 );
+}
+
+/* Frees a chunk view
+ * This releases the chunk data, after which the data of the view is no longer valid
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_view_free(
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_chunk_view_free";
+	int result                                        = 1;
+
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		internal_chunk_view = (libewf_internal_chunk_view_t *) *chunk_view;
+		*chunk_view         = NULL;
+
+		/* The chunk data is managed by the chunks cache
+		 */
+		if( libewf_sharded_cache_unpin_value(
+		     internal_chunk_view->chunks_cache,
+		     internal_chunk_view->chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk: %" PRIu64 " data.",
+			 function,
+			 internal_chunk_view->chunk_index );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_chunk_view );
+	}
+	return( result );
+}
+
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -30,16 +31,30 @@
 #include <bzlib.h>
 #endif
 
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+#include <lz4frame.h>
+#include <lz4hc.h>
+#endif
+
 #if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 
+/* The maximum size of the uncompressed data compressed into a single lz4 block
+ */
+#define LIBEWF_LZ4_MAXIMUM_BLOCK_SIZE	65536
+
 /* Compresses data using the compression method
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
@@ -59,10 +74,24 @@ int libewf_compress_data(
 	unsigned int bzip2_compressed_data_size = 0;
 	int bzip2_compression_level             = 0;
 #endif
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+	LZ4F_preferences_t lz4_preferences;
+
+	LZ4F_cctx *lz4_context                  = NULL;
+	size_t lz4_compressed_data_offset       = 0;
+	size_t lz4_compressed_data_size         = 0;
+	size_t lz4_uncompressed_data_offset     = 0;
+	size_t lz4_uncompressed_data_size       = 0;
+#endif
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 	uLongf zlib_compressed_data_size        = 0;
 	int zlib_compression_level              = 0;
 #endif
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+	ZSTD_CCtx *zstd_context                 = NULL;
+	size_t zstd_compressed_data_size        = 0;
+	int zstd_compression_level              = 0;
+#endif
 
 	if( compressed_data == NULL )
 	{
@@ -350,6 +379,324 @@ int libewf_compress_data(
 
 		return( -1 );
 #endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+	{
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+		{
+			zstd_compression_level = ZSTD_CLEVEL_DEFAULT;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			zstd_compression_level = 1;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			zstd_compression_level = 19;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		zstd_context = ZSTD_createCCtx();
+
+		if( zstd_context == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create zstd compression context.",
+			 function );
+
+			return( -1 );
+		}
+		/* The zstd frame stores a checksum of the uncompressed data
+		 * since the EWF2 chunk table does not provide one for compressed chunks
+		 */
+		zstd_compressed_data_size = ZSTD_CCtx_setParameter(
+		                             zstd_context,
+		                             ZSTD_c_compressionLevel,
+		                             zstd_compression_level );
+
+		if( ZSTD_isError( zstd_compressed_data_size ) == 0 )
+		{
+			zstd_compressed_data_size = ZSTD_CCtx_setParameter(
+			                             zstd_context,
+			                             ZSTD_c_checksumFlag,
+			                             1 );
+		}
+		if( ZSTD_isError( zstd_compressed_data_size ) == 0 )
+		{
+			zstd_compressed_data_size = ZSTD_compress2(
+			                             zstd_context,
+			                             compressed_data,
+			                             *compressed_data_size,
+			                             uncompressed_data,
+			                             uncompressed_data_size );
+		}
+		ZSTD_freeCCtx(
+		 zstd_context );
+
+		if( ZSTD_isError( zstd_compressed_data_size ) == 0 )
+		{
+			*compressed_data_size = zstd_compressed_data_size;
+
+			result = 1;
+		}
+		else if( ZSTD_getErrorCode( zstd_compressed_data_size ) == ZSTD_error_dstSize_tooSmall )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+			 	"%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			*compressed_data_size = ZSTD_compressBound(
+			                         uncompressed_data_size );
+
+			result = 0;
+		}
+		else if( ZSTD_getErrorCode( zstd_compressed_data_size ) == ZSTD_error_memory_allocation )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to write compressed data: insufficient memory.",
+			 function );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: libzstd returned error: %s.",
+			 function,
+			 ZSTD_getErrorName( zstd_compressed_data_size ) );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for zstd compression.",
+		 function );
+
+		return( -1 );
+#endif /* defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL ) */
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_LZ4 )
+	{
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+		if( memory_set(
+		     &lz4_preferences,
+		     0,
+		     sizeof( LZ4F_preferences_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear lz4 preferences.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+		 || ( compression_level == LIBEWF_COMPRESSION_FAST ) )
+		{
+			lz4_preferences.compressionLevel = 0;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			lz4_preferences.compressionLevel = LZ4HC_CLEVEL_DEFAULT;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		/* The lz4 frame stores a checksum of the uncompressed data
+		 * since the EWF2 chunk table does not provide one for compressed chunks
+		 */
+		lz4_preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+		lz4_preferences.frameInfo.contentSize         = (unsigned long long) uncompressed_data_size;
+
+		/* The frame is compressed in parts so that the compressed data only has to fit
+		 * the compressed data buffer instead of the worst case compression bound
+		 */
+		lz4_preferences.autoFlush = 1;
+
+		lz4_compressed_data_size = LZ4F_createCompressionContext(
+		                            &lz4_context,
+		                            LZ4F_VERSION );
+
+		if( LZ4F_isError( lz4_compressed_data_size ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create lz4 compression context.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( *compressed_data_size < LZ4F_HEADER_SIZE_MAX )
+		{
+			result = 0;
+		}
+		else
+		{
+			lz4_compressed_data_size = LZ4F_compressBegin(
+			                            lz4_context,
+			                            compressed_data,
+			                            *compressed_data_size,
+			                            &lz4_preferences );
+
+			if( LZ4F_isError( lz4_compressed_data_size ) != 0 )
+			{
+				result = -1;
+			}
+			else
+			{
+				lz4_compressed_data_offset = lz4_compressed_data_size;
+			}
+		}
+		while( ( result == 1 )
+		    && ( lz4_uncompressed_data_offset < uncompressed_data_size ) )
+		{
+			lz4_uncompressed_data_size = uncompressed_data_size - lz4_uncompressed_data_offset;
+
+			if( lz4_uncompressed_data_size > LIBEWF_LZ4_MAXIMUM_BLOCK_SIZE )
+			{
+				lz4_uncompressed_data_size = LIBEWF_LZ4_MAXIMUM_BLOCK_SIZE;
+			}
+			/* Reduce the part until its compression bound fits the remaining buffer
+			 */
+			while( ( lz4_uncompressed_data_size > 0 )
+			    && ( LZ4F_compressBound( lz4_uncompressed_data_size, &lz4_preferences ) > ( *compressed_data_size - lz4_compressed_data_offset ) ) )
+			{
+				lz4_uncompressed_data_size /= 2;
+			}
+			if( lz4_uncompressed_data_size == 0 )
+			{
+				result = 0;
+
+				break;
+			}
+			lz4_compressed_data_size = LZ4F_compressUpdate(
+			                            lz4_context,
+			                            &( compressed_data[ lz4_compressed_data_offset ] ),
+			                            *compressed_data_size - lz4_compressed_data_offset,
+			                            &( uncompressed_data[ lz4_uncompressed_data_offset ] ),
+			                            lz4_uncompressed_data_size,
+			                            NULL );
+
+			if( LZ4F_isError( lz4_compressed_data_size ) != 0 )
+			{
+				result = -1;
+
+				break;
+			}
+			lz4_compressed_data_offset   += lz4_compressed_data_size;
+			lz4_uncompressed_data_offset += lz4_uncompressed_data_size;
+		}
+		if( result == 1 )
+		{
+			if( LZ4F_compressBound( 0, &lz4_preferences ) > ( *compressed_data_size - lz4_compressed_data_offset ) )
+			{
+				result = 0;
+			}
+			else
+			{
+				lz4_compressed_data_size = LZ4F_compressEnd(
+				                            lz4_context,
+				                            &( compressed_data[ lz4_compressed_data_offset ] ),
+				                            *compressed_data_size - lz4_compressed_data_offset,
+				                            NULL );
+
+				if( LZ4F_isError( lz4_compressed_data_size ) != 0 )
+				{
+					result = -1;
+				}
+				else
+				{
+					lz4_compressed_data_offset += lz4_compressed_data_size;
+				}
+			}
+		}
+		LZ4F_freeCompressionContext(
+		 lz4_context );
+
+		if( result == 1 )
+		{
+			*compressed_data_size = lz4_compressed_data_offset;
+		}
+		else if( result == 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+			 	"%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			*compressed_data_size = LZ4F_compressFrameBound(
+			                         uncompressed_data_size,
+			                         &lz4_preferences );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: liblz4 returned error: %s.",
+			 function,
+			 LZ4F_getErrorName( lz4_compressed_data_size ) );
+
+			*compressed_data_size = 0;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for lz4 compression.",
+		 function );
+
+		return( -1 );
+#endif /* defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL ) */
 	}
 	else
 	{
@@ -382,9 +729,18 @@ int libewf_decompress_data(
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 	unsigned int bzip2_uncompressed_data_size = 0;
 #endif
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+	LZ4F_dctx *lz4_context                    = NULL;
+	size_t lz4_compressed_data_size           = 0;
+	size_t lz4_result                         = 0;
+	size_t lz4_uncompressed_data_size         = 0;
+#endif
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
 	uLongf zlib_uncompressed_data_size        = 0;
 #endif
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+	size_t zstd_uncompressed_data_size        = 0;
+#endif
 
 	if( compressed_data == NULL )
 	{
@@ -656,6 +1012,171 @@ int libewf_decompress_data(
 
 		return( -1 );
 #endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+	{
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+		zstd_uncompressed_data_size = ZSTD_decompress(
+		                               uncompressed_data,
+		                               *uncompressed_data_size,
+		                               compressed_data,
+		                               compressed_data_size );
+
+		if( ZSTD_isError( zstd_uncompressed_data_size ) == 0 )
+		{
+			*uncompressed_data_size = zstd_uncompressed_data_size;
+
+			result = 1;
+		}
+		else if( ZSTD_getErrorCode( zstd_uncompressed_data_size ) == ZSTD_error_dstSize_tooSmall )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else if( ZSTD_getErrorCode( zstd_uncompressed_data_size ) == ZSTD_error_memory_allocation )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to read compressed data: insufficient memory.",
+			 function );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: libzstd returned error: %s.",
+			 function,
+			 ZSTD_getErrorName( zstd_uncompressed_data_size ) );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for zstd compression.",
+		 function );
+
+		return( -1 );
+#endif /* defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL ) */
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_LZ4 )
+	{
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+		lz4_result = LZ4F_createDecompressionContext(
+		              &lz4_context,
+		              LZ4F_VERSION );
+
+		if( LZ4F_isError( lz4_result ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create lz4 decompression context.",
+			 function );
+
+			return( -1 );
+		}
+		lz4_compressed_data_size   = compressed_data_size;
+		lz4_uncompressed_data_size = *uncompressed_data_size;
+
+		lz4_result = LZ4F_decompress(
+		              lz4_context,
+		              uncompressed_data,
+		              &lz4_uncompressed_data_size,
+		              compressed_data,
+		              &lz4_compressed_data_size,
+		              NULL );
+
+		LZ4F_freeDecompressionContext(
+		 lz4_context );
+
+		/* A result of 0 indicates that the frame, including its checksum,
+		 * was fully decoded
+		 */
+		if( lz4_result == 0 )
+		{
+			*uncompressed_data_size = lz4_uncompressed_data_size;
+
+			result = 1;
+		}
+		else if( ( LZ4F_isError( lz4_result ) == 0 )
+		      && ( lz4_uncompressed_data_size == *uncompressed_data_size ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else if( LZ4F_isError( lz4_result ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to read compressed data: truncated lz4 frame.",
+			 function );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: liblz4 returned error: %s.",
+			 function,
+			 LZ4F_getErrorName( lz4_result ) );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for lz4 compression.",
+		 function );
+
+		return( -1 );
+#endif /* defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL ) */
 	}
 	else
 	{
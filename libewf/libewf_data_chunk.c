@@ -208,6 +208,7 @@ int libewf_data_chunk_free(
 int libewf_internal_data_chunk_set_chunk_data(
      libewf_internal_data_chunk_t *internal_data_chunk,
      uint64_t chunk_index,
+     size_t data_size,
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error )
 {
@@ -281,6 +282,7 @@ int libewf_internal_data_chunk_set_chunk_data(
 		goto on_error;
 	}
 	internal_data_chunk->chunk_index = chunk_index;
+	internal_data_chunk->data_size   = data_size;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -508,6 +510,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	if( libewf_chunk_data_initialize(
 	     &( internal_data_chunk->chunk_data ),
+	     NULL,
 	     internal_data_chunk->io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -584,3 +587,253 @@ on_error:
 	return( -1 );
 }
 
+
+/* Packs the chunk data of the data chunk for writing
+ * The data chunk can be read from another handle, if the chunk data was read from an image
+ * with compatible chunk packing the packed chunk data is restored as-is,
+ * otherwise the chunk data is unpacked and packed again
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_data_chunk_pack_for_write(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_io_handle_t *read_io_handle = NULL;
+	static char *function              = "libewf_internal_data_chunk_pack_for_write";
+	uint8_t is_compatible              = 0;
+	int result                         = 0;
+
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_io_handle = internal_data_chunk->io_handle;
+
+	if( read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->chunk_data->chunk_size != io_handle->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data chunk - chunk size value does not match.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_io_handle == io_handle )
+	{
+		is_compatible = 1;
+	}
+	/* Only EWF version 1 chunk data is restored as-is since the version 2 format
+	 * uses alignment padding and pattern fill compression
+	 */
+	else if( ( read_io_handle->major_version == 1 )
+	      && ( io_handle->major_version == 1 )
+	      && ( read_io_handle->compression_method == io_handle->compression_method ) )
+	{
+		is_compatible = 1;
+
+		/* Do not store compressed chunk data if compression was disabled
+		 */
+		if( ( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( io_handle->compression_level == LIBEWF_COMPRESSION_NONE ) )
+		{
+			is_compatible = 0;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Chunk data read from another handle is validated by unpacking it,
+	 * which checks the checksum and retains the packed form
+	 */
+	if( ( read_io_handle != io_handle )
+	 && ( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 ) )
+	{
+		if( libewf_chunk_data_unpack(
+		     internal_data_chunk->chunk_data,
+		     read_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 internal_data_chunk->chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( is_compatible != 0 )
+	{
+		result = libewf_chunk_data_restore_packed(
+		          internal_data_chunk->chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to restore packed chunk: %" PRIu64 " data.",
+			 function,
+			 internal_data_chunk->chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+		{
+			if( libewf_chunk_data_unpack(
+			     internal_data_chunk->chunk_data,
+			     read_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 internal_data_chunk->chunk_index );
+
+				goto on_error;
+			}
+		}
+		/* The compressed data retained by unpack is replaced when packing
+		 */
+		if( internal_data_chunk->chunk_data->compressed_data != NULL )
+		{
+			if( libewf_chunk_data_free_buffer(
+			     internal_data_chunk->chunk_data,
+			     &( internal_data_chunk->chunk_data->compressed_data ),
+			     internal_data_chunk->chunk_data->allocated_compressed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compressed data.",
+				 function );
+
+				goto on_error;
+			}
+			internal_data_chunk->chunk_data->compressed_data_size           = 0;
+			internal_data_chunk->chunk_data->allocated_compressed_data_size = 0;
+		}
+		if( libewf_chunk_data_pack(
+		     internal_data_chunk->chunk_data,
+		     io_handle,
+		     write_io_handle->compressed_zero_byte_empty_block,
+		     write_io_handle->compressed_zero_byte_empty_block_size,
+		     write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 internal_data_chunk->chunk_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
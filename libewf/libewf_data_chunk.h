@@ -82,9 +82,16 @@ int libewf_data_chunk_free(
 int libewf_internal_data_chunk_set_chunk_data(
      libewf_internal_data_chunk_t *internal_data_chunk,
      uint64_t chunk_index,
+     size_t data_size,
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
+int libewf_internal_data_chunk_pack_for_write(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_data_chunk_read_buffer(
          libewf_data_chunk_t *data_chunk,
@@ -53,6 +53,16 @@ void libewf_debug_print_compression_method(
 			 "bzip2" );
 			break;
 
+		case LIBEWF_COMPRESSION_METHOD_ZSTD:
+			libcnotify_printf(
+			 "zstd" );
+			break;
+
+		case LIBEWF_COMPRESSION_METHOD_LZ4:
+			libcnotify_printf(
+			 "lz4" );
+			break;
+
 		default:
 			libcnotify_printf(
 			 "UNKNOWN" );
@@ -26,6 +26,7 @@
 
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
+#include "libewf_simd.h"
 
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
@@ -117,9 +118,14 @@ int libewf_deflate_huffman_table_construct(
 
 	static char *function = "libewf_deflate_huffman_table_construct";
 	uint16_t code_size    = 0;
+	uint16_t lookup_entry = 0;
 	uint8_t bit_index     = 0;
+	int code_index        = 0;
 	int code_offset       = 0;
+	int huffman_code      = 0;
 	int left_value        = 0;
+	int lookup_index      = 0;
+	int reversed_code     = 0;
 	int symbol            = 0;
 
 	if( table == NULL )
@@ -199,6 +205,20 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     &( table->lookup_table ),
+	     0,
+	     LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE * sizeof( uint16_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
 	     symbol++ )
@@ -290,6 +310,40 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Fill the lookup table with the canonical codes that fit in the lookup table bits
+	 * The bit stream stores the Huffman codes most significant bit first,
+	 * hence the lookup table is indexed by the reversed code
+	 */
+	for( bit_index = 1;
+	     bit_index <= LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS;
+	     bit_index++ )
+	{
+		for( code_offset = 0;
+		     code_offset < table->code_counts_array[ bit_index ];
+		     code_offset++ )
+		{
+			reversed_code = 0;
+
+			for( lookup_index = 0;
+			     lookup_index < (int) bit_index;
+			     lookup_index++ )
+			{
+				reversed_code <<= 1;
+				reversed_code  |= ( huffman_code >> lookup_index ) & 0x00000001UL;
+			}
+			lookup_entry = (uint16_t) ( ( table->codes_array[ code_index ] << 4 ) | bit_index );
+
+			for( lookup_index = reversed_code;
+			     lookup_index < LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE;
+			     lookup_index += 1 << bit_index )
+			{
+				table->lookup_table[ lookup_index ] = lookup_entry;
+			}
+			huffman_code++;
+			code_index++;
+		}
+		huffman_code <<= 1;
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -317,6 +371,7 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 {
 	static char *function  = "libewf_deflate_bit_stream_get_huffman_encoded_value";
 	uint32_t bit_buffer    = 0;
+	uint16_t lookup_entry  = 0;
 	uint8_t bit_index      = 0;
 	uint8_t number_of_bits = 0;
 	int code_size_count    = 0;
@@ -380,6 +435,21 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 	{
 		number_of_bits = bit_stream->bit_buffer_size;
 	}
+	/* Try the lookup table first, codes that are larger than the lookup table bits
+	 * are decoded one bit at a time
+	 */
+	lookup_entry = table->lookup_table[ bit_stream->bit_buffer & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_MASK ];
+
+	if( ( lookup_entry != 0 )
+	 && ( (uint8_t) ( lookup_entry & 0x000f ) <= number_of_bits ) )
+	{
+		*value_32bit = (uint32_t) ( lookup_entry >> 4 );
+
+		bit_stream->bit_buffer     >>= lookup_entry & 0x000f;
+		bit_stream->bit_buffer_size -= (uint8_t) ( lookup_entry & 0x000f );
+
+		return( 1 );
+	}
 	bit_buffer = bit_stream->bit_buffer;
 
 	for( bit_index = 1;
@@ -775,6 +845,8 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 }
 
 /* Decodes a Huffman compressed block
+ * Literal and length codes are decoded with the lookup table of the literals table,
+ * consecutive literals are decoded from the bit buffer without refilling it
  * Returns 1 on success or -1 on error
  */
 int libewf_deflate_decode_huffman(
@@ -786,20 +858,20 @@ int libewf_deflate_decode_huffman(
      size_t *uncompressed_data_offset,
      libcerror_error_t **error )
 {
-	uint16_t literal_codes_base[ 29 ] = {
+	static const uint16_t literal_codes_base[ 29 ] = {
 		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
 		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
 
-	uint16_t literal_codes_number_of_extra_bits[ 29 ] = {
+	static const uint16_t literal_codes_number_of_extra_bits[ 29 ] = {
 		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
 		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
 
-	uint16_t distance_codes_base[ 30 ] = {
+	static const uint16_t distance_codes_base[ 30 ] = {
 		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
 		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
 		12289, 16385, 24577};
 
-	uint16_t distance_codes_number_of_extra_bits[ 30 ] = {
+	static const uint16_t distance_codes_number_of_extra_bits[ 30 ] = {
 		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
 
@@ -809,8 +881,32 @@ int libewf_deflate_decode_huffman(
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
+	uint16_t lookup_entry         = 0;
 	uint16_t number_of_extra_bits = 0;
+	uint8_t code_size             = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
 
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -848,22 +944,42 @@ int libewf_deflate_decode_huffman(
 
 	do
 	{
-		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
+		/* Fill the bit buffer with whole bytes up to 32 bits, which is sufficient
+		 * to decode at least 2 codes using the lookup table
+		 */
+		while( ( bit_stream->bit_buffer_size <= 24 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			bit_stream->bit_buffer      |= (uint32_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ] << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size += 8;
+		}
+		lookup_entry = literals_table->lookup_table[ bit_stream->bit_buffer & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_MASK ];
+		code_size    = (uint8_t) ( lookup_entry & 0x000f );
+
+		if( ( lookup_entry != 0 )
+		 && ( code_size <= bit_stream->bit_buffer_size ) )
+		{
+			code_value = (uint32_t) ( lookup_entry >> 4 );
+
+			bit_stream->bit_buffer     >>= code_size;
+			bit_stream->bit_buffer_size -= code_size;
+		}
+		else if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+		          bit_stream,
+		          literals_table,
+		          &code_value,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve listeral value from bit stream.",
+			 "%s: unable to retrieve literal value from bit stream.",
 			 function );
 
 			return( -1 );
 		}
-		if( code_value < 256 )
+		while( code_value < 256 )
 		{
 			if( data_offset >= uncompressed_data_size )
 			{
@@ -877,6 +993,25 @@ int libewf_deflate_decode_huffman(
 				return( -1 );
 			}
 			uncompressed_data[ data_offset++ ] = (uint8_t) code_value;
+
+			/* Decode the next code from the remaining bits in the bit buffer
+			 */
+			lookup_entry = literals_table->lookup_table[ bit_stream->bit_buffer & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_MASK ];
+			code_size    = (uint8_t) ( lookup_entry & 0x000f );
+
+			if( ( lookup_entry == 0 )
+			 || ( code_size > bit_stream->bit_buffer_size ) )
+			{
+				break;
+			}
+			code_value = (uint32_t) ( lookup_entry >> 4 );
+
+			bit_stream->bit_buffer     >>= code_size;
+			bit_stream->bit_buffer_size -= code_size;
+		}
+		if( code_value < 256 )
+		{
+			continue;
 		}
 		else if( ( code_value > 256 )
 		      && ( code_value < 286 ) )
@@ -917,6 +1052,18 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			if( code_value >= 30 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value: %" PRIu32 " out of bounds.",
+				 function,
+				 code_value );
+
+				return( -1 );
+			}
 			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
 
 			if( libewf_deflate_bit_stream_get_value(
@@ -958,12 +1105,26 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			/* Non-overlapping matches can be copied at once
+			 */
+			if( compression_offset >= compression_size )
+			{
+				memory_copy(
+				 &( uncompressed_data[ data_offset ] ),
+				 &( uncompressed_data[ data_offset - compression_offset ] ),
+				 (size_t) compression_size );
+
+				data_offset += compression_size;
+			}
+			else
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				while( compression_size > 0 )
+				{
+					uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
 
-				data_offset++;
-				compression_size--;
+					data_offset++;
+					compression_size--;
+				}
 			}
 		}
 		else if( code_value != 256 )
@@ -972,7 +1133,7 @@ int libewf_deflate_decode_huffman(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: invalid code value: %" PRIu16 ".",
+			 "%s: invalid code value: %" PRIu32 ".",
 			 function,
 			 code_value );
 
@@ -998,239 +1159,24 @@ int libewf_deflate_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_deflate_calculate_adler32";
-	size_t buffer_offset  = 0;
-	uint32_t lower_word   = 0;
-	uint32_t upper_word   = 0;
-	uint32_t value_32bit  = 0;
-	int block_index       = 0;
-
-	if( checksum_value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid checksum value.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
 
-		return( -1 );
-	}
-	if( size > (size_t) SSIZE_MAX )
+	if( libewf_simd_calculate_adler32(
+	     checksum_value,
+	     buffer,
+	     size,
+	     initial_value,
+	     libewf_simd_get_best_instruction_set(),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate Adler-32.",
 		 function );
 
 		return( -1 );
 	}
-	lower_word = initial_value & 0xffff;
-	upper_word = ( initial_value >> 16 ) & 0xffff;
-
-	while( size >= 0x15b0 )
-	{
-		/* The modulo calculation is needed per 5552 (0x15b0) bytes
-		 * 5552 / 16 = 347
-		 */
-		for( block_index = 0;
-		     block_index < 347;
-		     block_index++ )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-		size -= 0x15b0;
-	}
-	if( size > 0 )
-	{
-		while( size > 16 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size -= 16;
-		}
-		while( size > 0 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size--;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-	}
-	*checksum_value = ( upper_word << 16 ) | lower_word;
-
 	return( 1 );
 }
 
@@ -1355,10 +1301,8 @@ int libewf_deflate_decompress(
 		 preset_dictionary_identifier );
 
 		compressed_data_offset += 4;
-		compressed_data_size   -= 4;
 	}
 	compressed_data_offset += 2;
-	compressed_data_size   -= 2;
 
 	if( compression_method != 8 )
 	{
@@ -1419,8 +1363,10 @@ int libewf_deflate_decompress(
 		return( -1 );
 	}
 
-/* TODO find optimized solution to read bit stream from bytes */
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	/* The Huffman decoder reads whole bytes ahead into the bit buffer
+	 */
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size >= 3 ) )
 	{
 		if( libewf_deflate_bit_stream_get_value(
 		     &bit_stream,
@@ -1466,21 +1412,29 @@ int libewf_deflate_decompress(
 						return( -1 );
 					}
 				}
-				if( libewf_deflate_bit_stream_get_value(
-				     &bit_stream,
-				     32,
-				     &block_size,
-				     error ) != 1 )
+				/* The bit buffer can contain whole bytes that were read ahead
+				 */
+				bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size / 8;
+				bit_stream.bit_buffer          = 0;
+				bit_stream.bit_buffer_size     = 0;
+
+				if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) < 4 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve value from bit stream.",
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: invalid compressed data value too small.",
 					 function );
 
 					return( -1 );
 				}
+				byte_stream_copy_to_uint32_little_endian(
+				 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
+				 block_size );
+
+				bit_stream.byte_stream_offset += 4;
+
 				block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 				block_size     &= 0x0000ffffUL;
 
@@ -1615,6 +1569,10 @@ int libewf_deflate_decompress(
 			break;
 		}
 	}
+	/* The bit buffer can contain whole bytes of the checksum that were read ahead
+	 */
+	bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size / 8;
+
 	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
 	{
 		byte_stream_copy_to_uint32_big_endian(
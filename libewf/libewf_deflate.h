@@ -31,6 +31,12 @@
 extern "C" {
 #endif
 
+/* The number of bits used to index the Huffman lookup table
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS	9
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE	( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS )
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_MASK	( LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE - 1 )
+
 /* The block types
  */
 enum LIBEWF_DEFLATE_BLOCK_TYPES
@@ -86,6 +92,12 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The lookup table, indexed by the next bits in the bit stream
+	 * An entry contains the symbol in the upper 12 bits and the code size in the lower 4 bits
+	 * An entry of 0 indicates a code that is larger than the lookup table bits
+	 */
+	uint16_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ];
 };
 
 int libewf_deflate_bit_stream_get_value(
@@ -0,0 +1,2094 @@
+/*
+ * Direct IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_direct_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcstring.h"
+
+#if defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT )
+
+/* Creates a direct IO handle
+ * Make sure the value direct_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_initialize(
+     libewf_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_initialize";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*direct_io_handle = memory_allocate_structure(
+	                     libewf_direct_io_handle_t );
+
+	if( *direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *direct_io_handle,
+	     0,
+	     sizeof( libewf_direct_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *direct_io_handle )->file_descriptor  = -1;
+	( *direct_io_handle )->last_read_offset = -1;
+
+	return( 1 );
+
+on_error:
+	if( *direct_io_handle != NULL )
+	{
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Initializes a file IO handle that uses direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_direct_io_handle_t *direct_io_handle = NULL;
+	static char *function                       = "libewf_direct_io_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_io_handle_initialize(
+	     &direct_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_direct_io_handle_set_name(
+	     direct_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) direct_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_direct_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_direct_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_direct_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_direct_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_direct_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_direct_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_direct_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( direct_io_handle != NULL )
+	{
+		libewf_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a direct IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_free(
+     libewf_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_free";
+	int result            = 1;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		if( ( *direct_io_handle )->file_descriptor != -1 )
+		{
+			if( libewf_direct_io_handle_close(
+			     *direct_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *direct_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *direct_io_handle )->name );
+		}
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the direct IO handle and its attributes
+ * The clone is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_clone(
+     libewf_direct_io_handle_t **destination_direct_io_handle,
+     libewf_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_clone";
+
+	if( destination_direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination direct IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_direct_io_handle == NULL )
+	{
+		*destination_direct_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_direct_io_handle_initialize(
+	     destination_direct_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_direct_io_handle->name != NULL )
+	{
+		if( libewf_direct_io_handle_set_name(
+		     *destination_direct_io_handle,
+		     source_direct_io_handle->name,
+		     source_direct_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination direct IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_direct_io_handle != NULL )
+	{
+		libewf_direct_io_handle_free(
+		 destination_direct_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_set_name(
+     libewf_direct_io_handle_t *direct_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_set_name";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle - file descriptor already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->name != NULL )
+	{
+		memory_free(
+		 direct_io_handle->name );
+
+		direct_io_handle->name      = NULL;
+		direct_io_handle->name_size = 0;
+	}
+	direct_io_handle->name = libcstring_narrow_string_allocate(
+	                          name_length + 1 );
+
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcstring_narrow_string_copy(
+	     direct_io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 direct_io_handle->name );
+
+		direct_io_handle->name = NULL;
+
+		return( -1 );
+	}
+	direct_io_handle->name[ name_length ] = 0;
+
+	direct_io_handle->name_size = name_length + 1;
+
+	return( 1 );
+}
+
+/* Opens the direct IO handle
+ * The file is opened with O_DIRECT if the file system supports it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_open(
+     libewf_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_io_handle_open";
+	int buffer_index      = 0;
+	int file_io_flags     = 0;
+	int result            = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle - file descriptor already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* A partially written block is read before it is written
+	 * hence write access always requires read access
+	 */
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		file_io_flags = O_RDWR | O_CREAT;
+
+		if( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+		{
+			file_io_flags |= O_TRUNC;
+		}
+	}
+	else if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+	{
+		file_io_flags = O_RDONLY;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
+#if defined( O_CLOEXEC )
+	file_io_flags |= O_CLOEXEC;
+#endif
+	direct_io_handle->is_direct = 0;
+
+#if defined( O_DIRECT )
+	direct_io_handle->file_descriptor = open(
+	                                     direct_io_handle->name,
+	                                     file_io_flags | O_DIRECT,
+	                                     0644 );
+
+	/* Not all file systems support O_DIRECT, in which case the file
+	 * is accessed using the aligned buffers without O_DIRECT
+	 */
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		direct_io_handle->is_direct = 1;
+	}
+	else if( errno == EINVAL )
+#endif
+	{
+		direct_io_handle->file_descriptor = open(
+		                                     direct_io_handle->name,
+		                                     file_io_flags,
+		                                     0644 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 direct_io_handle->name );
+
+		return( -1 );
+	}
+	if( fstat(
+	     direct_io_handle->file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	result = posix_memalign(
+	          (void **) &( direct_io_handle->buffers_data ),
+	          LIBEWF_DIRECT_IO_BLOCK_SIZE,
+	          LIBEWF_DIRECT_IO_BUFFER_SIZE * LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS );
+
+	if( result != 0 )
+	{
+		direct_io_handle->buffers_data = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers data.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		direct_io_handle->buffers[ buffer_index ].data          = &( direct_io_handle->buffers_data[ buffer_index * LIBEWF_DIRECT_IO_BUFFER_SIZE ] );
+		direct_io_handle->buffers[ buffer_index ].offset        = -1;
+		direct_io_handle->buffers[ buffer_index ].data_size     = 0;
+		direct_io_handle->buffers[ buffer_index ].transfer_size = 0;
+		direct_io_handle->buffers[ buffer_index ].state         = LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY;
+		direct_io_handle->buffers[ buffer_index ].error_code    = 0;
+		direct_io_handle->buffers[ buffer_index ].last_used     = 0;
+	}
+#if defined( HAVE_LIBURING )
+	/* If the kernel does not support io_uring the buffers
+	 * are read and written synchronously
+	 */
+	if( io_uring_queue_init(
+	     LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS,
+	     &( direct_io_handle->ring ),
+	     0 ) == 0 )
+	{
+		direct_io_handle->ring_initialized = 1;
+	}
+#endif
+	direct_io_handle->access_flags     = access_flags;
+	direct_io_handle->file_size        = (size64_t) file_statistics.st_size;
+	direct_io_handle->current_offset   = 0;
+	direct_io_handle->access_counter   = 0;
+	direct_io_handle->last_read_offset = -1;
+	direct_io_handle->data_written     = 0;
+
+	return( 1 );
+
+on_error:
+	if( direct_io_handle->buffers_data != NULL )
+	{
+		free(
+		 direct_io_handle->buffers_data );
+
+		direct_io_handle->buffers_data = NULL;
+	}
+	close(
+	 direct_io_handle->file_descriptor );
+
+	direct_io_handle->file_descriptor = -1;
+
+	return( -1 );
+}
+
+/* Closes the direct IO handle
+ * Writes the buffered data and sets the file to its logical size
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_direct_io_handle_close(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_close";
+	int result            = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_io_handle_flush(
+	     direct_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush direct IO handle.",
+		 function );
+
+		result = -1;
+	}
+	/* The last block was written padded to the block size
+	 */
+	if( direct_io_handle->data_written != 0 )
+	{
+		if( ftruncate(
+		     direct_io_handle->file_descriptor,
+		     (off_t) direct_io_handle->file_size ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_RESIZE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to truncate file to size: %" PRIu64 ".",
+			 function,
+			 direct_io_handle->file_size );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBURING )
+	if( direct_io_handle->ring_initialized != 0 )
+	{
+		io_uring_queue_exit(
+		 &( direct_io_handle->ring ) );
+
+		direct_io_handle->ring_initialized = 0;
+	}
+#endif
+	if( close(
+	     direct_io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	direct_io_handle->file_descriptor = -1;
+	direct_io_handle->data_written    = 0;
+
+	if( direct_io_handle->buffers_data != NULL )
+	{
+		free(
+		 direct_io_handle->buffers_data );
+
+		direct_io_handle->buffers_data = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBURING )
+
+/* Waits for an asynchronous operation to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_complete_operation(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_direct_io_buffer_t *buffer = NULL;
+	struct io_uring_cqe *cqe          = NULL;
+	static char *function             = "libewf_direct_io_handle_complete_operation";
+	int result                        = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = io_uring_wait_cqe(
+		          &( direct_io_handle->ring ),
+		          &cqe );
+	}
+	while( result == -EINTR );
+
+	if( result != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) -result,
+		 "%s: unable to wait for completion.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (libewf_direct_io_buffer_t *) io_uring_cqe_get_data(
+	                                        cqe );
+
+	result = cqe->res;
+
+	io_uring_cqe_seen(
+	 &( direct_io_handle->ring ),
+	 cqe );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+	{
+		if( result < 0 )
+		{
+			buffer->error_code = -result;
+			buffer->data_size  = 0;
+			buffer->state      = LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY;
+		}
+		else
+		{
+			buffer->data_size = (size_t) result;
+
+			if( (size64_t) buffer->offset >= direct_io_handle->file_size )
+			{
+				buffer->data_size = 0;
+			}
+			else if( (size64_t) buffer->data_size > ( direct_io_handle->file_size - buffer->offset ) )
+			{
+				buffer->data_size = (size_t) ( direct_io_handle->file_size - buffer->offset );
+			}
+			buffer->state = LIBEWF_DIRECT_IO_BUFFER_STATE_VALID;
+		}
+	}
+	else if( buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING )
+	{
+		/* Keep the buffer dirty on error so that its data is not lost
+		 */
+		if( result < 0 )
+		{
+			buffer->error_code = -result;
+			buffer->state      = LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY;
+		}
+		else if( (size_t) result != buffer->transfer_size )
+		{
+			buffer->error_code = EIO;
+			buffer->state      = LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY;
+		}
+		else
+		{
+			buffer->state = LIBEWF_DIRECT_IO_BUFFER_STATE_VALID;
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBURING ) */
+
+/* Submits a buffer to be read or written
+ * The state must be either LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING or LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING
+ * If io_uring is not available the buffer is read or written synchronously
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_submit_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libewf_direct_io_buffer_t *buffer,
+     uint8_t state,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBURING )
+	struct io_uring_sqe *sqe = NULL;
+#endif
+	static char *function    = "libewf_direct_io_handle_submit_buffer";
+	size_t transfer_count    = 0;
+	ssize_t result           = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+	{
+		buffer->transfer_size = LIBEWF_DIRECT_IO_BUFFER_SIZE;
+	}
+	else if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING )
+	{
+		buffer->transfer_size = buffer->data_size;
+
+		/* O_DIRECT requires the size to be a multiple of the block size
+		 * the padding is removed when the file is closed
+		 */
+		if( direct_io_handle->is_direct != 0 )
+		{
+			if( ( buffer->transfer_size % LIBEWF_DIRECT_IO_BLOCK_SIZE ) != 0 )
+			{
+				buffer->transfer_size += LIBEWF_DIRECT_IO_BLOCK_SIZE
+				                       - ( buffer->transfer_size % LIBEWF_DIRECT_IO_BLOCK_SIZE );
+			}
+			if( memory_set(
+			     &( buffer->data[ buffer->data_size ] ),
+			     0,
+			     buffer->transfer_size - buffer->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer padding.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		direct_io_handle->data_written = 1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported state.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->error_code = 0;
+
+#if defined( HAVE_LIBURING )
+	if( direct_io_handle->ring_initialized != 0 )
+	{
+		sqe = io_uring_get_sqe(
+		       &( direct_io_handle->ring ) );
+
+		if( sqe == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve submission queue entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+		{
+			io_uring_prep_read(
+			 sqe,
+			 direct_io_handle->file_descriptor,
+			 buffer->data,
+			 (unsigned int) buffer->transfer_size,
+			 (uint64_t) buffer->offset );
+		}
+		else
+		{
+			io_uring_prep_write(
+			 sqe,
+			 direct_io_handle->file_descriptor,
+			 buffer->data,
+			 (unsigned int) buffer->transfer_size,
+			 (uint64_t) buffer->offset );
+		}
+		io_uring_sqe_set_data(
+		 sqe,
+		 buffer );
+
+		buffer->state = state;
+
+		result = (ssize_t) io_uring_submit(
+		                    &( direct_io_handle->ring ) );
+
+		if( result < 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 (uint32_t) -result,
+			 "%s: unable to submit buffer at offset: %" PRIi64 ".",
+			 function,
+			 buffer->offset );
+
+			buffer->state = ( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING ) ? LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY : LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY;
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	while( transfer_count < buffer->transfer_size )
+	{
+		if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+		{
+			result = pread(
+			          direct_io_handle->file_descriptor,
+			          &( buffer->data[ transfer_count ] ),
+			          buffer->transfer_size - transfer_count,
+			          (off_t) ( buffer->offset + transfer_count ) );
+		}
+		else
+		{
+			result = pwrite(
+			          direct_io_handle->file_descriptor,
+			          &( buffer->data[ transfer_count ] ),
+			          buffer->transfer_size - transfer_count,
+			          (off_t) ( buffer->offset + transfer_count ) );
+		}
+		if( result < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 ( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING ) ? LIBCERROR_IO_ERROR_READ_FAILED : LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to %s buffer at offset: %" PRIi64 ".",
+			 function,
+			 ( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING ) ? "read" : "write",
+			 buffer->offset );
+
+			if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+			{
+				buffer->data_size = 0;
+				buffer->state     = LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY;
+			}
+			return( -1 );
+		}
+		/* A short read indicates the end of the file
+		 */
+		if( result == 0 )
+		{
+			break;
+		}
+		transfer_count += (size_t) result;
+	}
+	if( state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+	{
+		buffer->data_size = transfer_count;
+
+		if( (size64_t) buffer->offset >= direct_io_handle->file_size )
+		{
+			buffer->data_size = 0;
+		}
+		else if( (size64_t) buffer->data_size > ( direct_io_handle->file_size - buffer->offset ) )
+		{
+			buffer->data_size = (size_t) ( direct_io_handle->file_size - buffer->offset );
+		}
+	}
+	else if( transfer_count != buffer->transfer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 ".",
+		 function,
+		 buffer->offset );
+
+		return( -1 );
+	}
+	buffer->state = LIBEWF_DIRECT_IO_BUFFER_STATE_VALID;
+
+	return( 1 );
+}
+
+/* Waits for a pending read or write of a buffer to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_wait_for_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libewf_direct_io_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_wait_for_buffer";
+	int error_code        = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBURING )
+	while( ( buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING )
+	    || ( buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING ) )
+	{
+		if( libewf_direct_io_handle_complete_operation(
+		     direct_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to complete operation.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( buffer->error_code != 0 )
+	{
+		error_code         = buffer->error_code;
+		buffer->error_code = 0;
+
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) error_code,
+		 "%s: unable to read or write buffer at offset: %" PRIi64 ".",
+		 function,
+		 buffer->offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes all dirty buffers and waits for all pending operations to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_flush(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_flush";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( direct_io_handle->buffers[ buffer_index ].state == LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY )
+		{
+			if( libewf_direct_io_handle_submit_buffer(
+			     direct_io_handle,
+			     &( direct_io_handle->buffers[ buffer_index ] ),
+			     LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer: %d.",
+				 function,
+				 buffer_index );
+
+				result = -1;
+			}
+		}
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( libewf_direct_io_handle_wait_for_buffer(
+		     direct_io_handle,
+		     &( direct_io_handle->buffers[ buffer_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to wait for buffer: %d.",
+			 function,
+			 buffer_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the buffer that contains a specific (buffer aligned) offset
+ * If the buffer is not cached the least recently used buffer is reused
+ * and its data is read unless it is beyond the end of the file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_get_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     off64_t offset,
+     uint8_t for_writing,
+     libewf_direct_io_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	libewf_direct_io_buffer_t *safe_buffer = NULL;
+	static char *function                  = "libewf_direct_io_handle_get_buffer";
+	int buffer_index                       = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % LIBEWF_DIRECT_IO_BUFFER_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( ( direct_io_handle->buffers[ buffer_index ].state != LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY )
+		 && ( direct_io_handle->buffers[ buffer_index ].offset == offset ) )
+		{
+			safe_buffer = &( direct_io_handle->buffers[ buffer_index ] );
+
+			break;
+		}
+	}
+	if( safe_buffer == NULL )
+	{
+		/* Empty buffers have not been used and are reused first
+		 */
+		safe_buffer = &( direct_io_handle->buffers[ 0 ] );
+
+		for( buffer_index = 1;
+		     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( direct_io_handle->buffers[ buffer_index ].last_used < safe_buffer->last_used )
+			{
+				safe_buffer = &( direct_io_handle->buffers[ buffer_index ] );
+			}
+		}
+		if( libewf_direct_io_handle_wait_for_buffer(
+		     direct_io_handle,
+		     safe_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to wait for buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( safe_buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY )
+		{
+			if( libewf_direct_io_handle_submit_buffer(
+			     direct_io_handle,
+			     safe_buffer,
+			     LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_direct_io_handle_wait_for_buffer(
+			     direct_io_handle,
+			     safe_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to wait for buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		safe_buffer->offset    = offset;
+		safe_buffer->data_size = 0;
+		safe_buffer->state     = LIBEWF_DIRECT_IO_BUFFER_STATE_VALID;
+
+		/* Data beyond the end of the file does not need to be read
+		 */
+		if( (size64_t) offset < direct_io_handle->file_size )
+		{
+			if( libewf_direct_io_handle_submit_buffer(
+			     direct_io_handle,
+			     safe_buffer,
+			     LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	/* Data cannot be modified while it is being transferred
+	 */
+	if( ( for_writing != 0 )
+	 || ( safe_buffer->state == LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING ) )
+	{
+		if( libewf_direct_io_handle_wait_for_buffer(
+		     direct_io_handle,
+		     safe_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to wait for buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	direct_io_handle->access_counter += 1;
+
+	safe_buffer->last_used = direct_io_handle->access_counter;
+
+	*buffer = safe_buffer;
+
+	return( 1 );
+}
+
+/* Reads ahead the buffers that follow a specific (buffer aligned) offset
+ * Only clean buffers are reused to read ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_read_ahead(
+     libewf_direct_io_handle_t *direct_io_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_direct_io_buffer_t *safe_buffer = NULL;
+	static char *function                  = "libewf_direct_io_handle_read_ahead";
+	off64_t read_ahead_offset              = 0;
+	int buffer_index                       = 0;
+	int read_ahead_index                   = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_ahead_index = 1;
+	     read_ahead_index <= LIBEWF_DIRECT_IO_READ_AHEAD_DEPTH;
+	     read_ahead_index++ )
+	{
+		read_ahead_offset = offset + ( (off64_t) read_ahead_index * LIBEWF_DIRECT_IO_BUFFER_SIZE );
+
+		if( (size64_t) read_ahead_offset >= direct_io_handle->file_size )
+		{
+			break;
+		}
+		safe_buffer = NULL;
+
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( direct_io_handle->buffers[ buffer_index ].state != LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY )
+			 && ( direct_io_handle->buffers[ buffer_index ].offset == read_ahead_offset ) )
+			{
+				break;
+			}
+			if( ( direct_io_handle->buffers[ buffer_index ].state == LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY )
+			 || ( direct_io_handle->buffers[ buffer_index ].state == LIBEWF_DIRECT_IO_BUFFER_STATE_VALID ) )
+			{
+				if( ( safe_buffer == NULL )
+				 || ( direct_io_handle->buffers[ buffer_index ].last_used < safe_buffer->last_used ) )
+				{
+					safe_buffer = &( direct_io_handle->buffers[ buffer_index ] );
+				}
+			}
+		}
+		/* The buffer is already cached
+		 */
+		if( buffer_index < LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS )
+		{
+			continue;
+		}
+		/* Do not replace the buffers that were used most recently
+		 */
+		if( safe_buffer == NULL )
+		{
+			break;
+		}
+		if( ( safe_buffer->state != LIBEWF_DIRECT_IO_BUFFER_STATE_EMPTY )
+		 && ( ( safe_buffer->last_used + LIBEWF_DIRECT_IO_READ_AHEAD_DEPTH ) > direct_io_handle->access_counter ) )
+		{
+			break;
+		}
+		direct_io_handle->access_counter += 1;
+
+		safe_buffer->offset    = read_ahead_offset;
+		safe_buffer->data_size = 0;
+		safe_buffer->last_used = direct_io_handle->access_counter;
+
+		if( libewf_direct_io_handle_submit_buffer(
+		     direct_io_handle,
+		     safe_buffer,
+		     LIBEWF_DIRECT_IO_BUFFER_STATE_READ_PENDING,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ahead buffer at offset: %" PRIi64 ".",
+			 function,
+			 read_ahead_offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a buffer from the direct IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_direct_io_handle_read(
+         libewf_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	libewf_direct_io_buffer_t *direct_io_buffer = NULL;
+	static char *function                       = "libewf_direct_io_handle_read";
+	off64_t buffer_offset                       = 0;
+	size64_t available_size                     = 0;
+	size_t data_offset                          = 0;
+	size_t read_count                           = 0;
+	size_t read_size                            = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) direct_io_handle->current_offset >= direct_io_handle->file_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( direct_io_handle->file_size - direct_io_handle->current_offset ) )
+	{
+		size = (size_t) ( direct_io_handle->file_size - direct_io_handle->current_offset );
+	}
+	while( read_count < size )
+	{
+		data_offset   = (size_t) ( direct_io_handle->current_offset % LIBEWF_DIRECT_IO_BUFFER_SIZE );
+		buffer_offset = direct_io_handle->current_offset - data_offset;
+
+		if( libewf_direct_io_handle_get_buffer(
+		     direct_io_handle,
+		     buffer_offset,
+		     0,
+		     &direct_io_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to retrieve buffer at offset: %" PRIi64 ".",
+			 function,
+			 buffer_offset );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBURING )
+		/* Read ahead when the buffers are read sequentially
+		 */
+		if( ( direct_io_handle->ring_initialized != 0 )
+		 && ( buffer_offset == ( direct_io_handle->last_read_offset + LIBEWF_DIRECT_IO_BUFFER_SIZE ) ) )
+		{
+			if( libewf_direct_io_handle_read_ahead(
+			     direct_io_handle,
+			     buffer_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read ahead.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+		direct_io_handle->last_read_offset = buffer_offset;
+
+		if( data_offset < direct_io_buffer->data_size )
+		{
+			read_size = direct_io_buffer->data_size - data_offset;
+
+			if( read_size > ( size - read_count ) )
+			{
+				read_size = size - read_count;
+			}
+			if( memory_copy(
+			     &( buffer[ read_count ] ),
+			     &( direct_io_buffer->data[ data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			/* The data between the end of the buffer data and the end
+			 * of the file was not written and reads as zero bytes
+			 */
+			available_size = direct_io_handle->file_size - buffer_offset;
+
+			if( available_size > LIBEWF_DIRECT_IO_BUFFER_SIZE )
+			{
+				available_size = LIBEWF_DIRECT_IO_BUFFER_SIZE;
+			}
+			read_size = (size_t) available_size - data_offset;
+
+			if( read_size > ( size - read_count ) )
+			{
+				read_size = size - read_count;
+			}
+			if( memory_set(
+			     &( buffer[ read_count ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		read_count                       += read_size;
+		direct_io_handle->current_offset += read_size;
+	}
+	return( (ssize_t) read_count );
+}
+
+/* Writes a buffer to the direct IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_direct_io_handle_write(
+         libewf_direct_io_handle_t *direct_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	libewf_direct_io_buffer_t *direct_io_buffer = NULL;
+	static char *function                       = "libewf_direct_io_handle_write";
+	off64_t buffer_offset                       = 0;
+	size_t data_offset                          = 0;
+	size_t write_count                          = 0;
+	size_t write_size                           = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( direct_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid direct IO handle - not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( write_count < size )
+	{
+		data_offset   = (size_t) ( direct_io_handle->current_offset % LIBEWF_DIRECT_IO_BUFFER_SIZE );
+		buffer_offset = direct_io_handle->current_offset - data_offset;
+
+		if( libewf_direct_io_handle_get_buffer(
+		     direct_io_handle,
+		     buffer_offset,
+		     1,
+		     &direct_io_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to retrieve buffer at offset: %" PRIi64 ".",
+			 function,
+			 buffer_offset );
+
+			return( -1 );
+		}
+		write_size = LIBEWF_DIRECT_IO_BUFFER_SIZE - data_offset;
+
+		if( write_size > ( size - write_count ) )
+		{
+			write_size = size - write_count;
+		}
+		/* Fill the gap when writing beyond the end of the data
+		 */
+		if( data_offset > direct_io_buffer->data_size )
+		{
+			if( memory_set(
+			     &( direct_io_buffer->data[ direct_io_buffer->data_size ] ),
+			     0,
+			     data_offset - direct_io_buffer->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( memory_copy(
+		     &( direct_io_buffer->data[ data_offset ] ),
+		     &( buffer[ write_count ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( data_offset + write_size ) > direct_io_buffer->data_size )
+		{
+			direct_io_buffer->data_size = data_offset + write_size;
+		}
+		direct_io_buffer->state = LIBEWF_DIRECT_IO_BUFFER_STATE_DIRTY;
+
+		write_count                      += write_size;
+		direct_io_handle->current_offset += write_size;
+
+		if( (size64_t) direct_io_handle->current_offset > direct_io_handle->file_size )
+		{
+			direct_io_handle->file_size = (size64_t) direct_io_handle->current_offset;
+		}
+#if defined( HAVE_LIBURING )
+		/* Write a completely filled buffer asynchronously
+		 */
+		if( ( direct_io_handle->ring_initialized != 0 )
+		 && ( direct_io_buffer->data_size == LIBEWF_DIRECT_IO_BUFFER_SIZE ) )
+		{
+			if( libewf_direct_io_handle_submit_buffer(
+			     direct_io_handle,
+			     direct_io_buffer,
+			     LIBEWF_DIRECT_IO_BUFFER_STATE_WRITE_PENDING,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer at offset: %" PRIi64 ".",
+				 function,
+				 buffer_offset );
+
+				return( -1 );
+			}
+		}
+#endif
+	}
+	return( (ssize_t) write_count );
+}
+
+/* Seeks a certain offset within the direct IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_direct_io_handle_seek_offset(
+         libewf_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_seek_offset";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += direct_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) direct_io_handle->file_size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	direct_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_direct_io_handle_exists(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_io_handle_exists";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     direct_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) errno,
+		 "%s: unable to determine if file: %s exists.",
+		 function,
+		 direct_io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the direct IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_direct_io_handle_is_open(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_io_handle_is_open";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the (logical) file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_io_handle_get_size(
+     libewf_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_io_handle_get_size";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		*size = direct_io_handle->file_size;
+
+		return( 1 );
+	}
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     direct_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) errno,
+		 "%s: unable to retrieve file statistics of: %s.",
+		 function,
+		 direct_io_handle->name );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT ) */
+
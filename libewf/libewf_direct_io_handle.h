@@ -0,0 +1,253 @@
+/*
+ * Direct IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DIRECT_IO_HANDLE_H )
+#define _LIBEWF_DIRECT_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING )
+#include <liburing.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The direct IO handle requires the POSIX positional read and write
+ * functions and aligned memory allocation
+ */
+#if !defined( WINAPI ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && defined( HAVE_STAT )
+#define HAVE_LIBEWF_DIRECT_IO_SUPPORT
+#endif
+
+#if defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT )
+
+typedef struct libewf_direct_io_buffer libewf_direct_io_buffer_t;
+
+struct libewf_direct_io_buffer
+{
+	/* The (aligned) data
+	 */
+	uint8_t *data;
+
+	/* The offset of the data in the file
+	 * this value is aligned to the buffer size
+	 */
+	off64_t offset;
+
+	/* The size of the valid data
+	 */
+	size_t data_size;
+
+	/* The size of the data that is being transferred
+	 */
+	size_t transfer_size;
+
+	/* The state
+	 */
+	uint8_t state;
+
+	/* The system error code of the last (asynchronous) operation
+	 */
+	int error_code;
+
+	/* The value of the access counter when the buffer was last used
+	 */
+	uint64_t last_used;
+};
+
+typedef struct libewf_direct_io_handle libewf_direct_io_handle_t;
+
+struct libewf_direct_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file was opened with O_DIRECT
+	 */
+	uint8_t is_direct;
+
+	/* Value to indicate data was written
+	 */
+	uint8_t data_written;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The (logical) file size
+	 */
+	size64_t file_size;
+
+	/* The data of all the buffers
+	 */
+	uint8_t *buffers_data;
+
+	/* The buffers
+	 */
+	libewf_direct_io_buffer_t buffers[ LIBEWF_DIRECT_IO_NUMBER_OF_BUFFERS ];
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The offset of the last buffer that was read
+	 */
+	off64_t last_read_offset;
+
+#if defined( HAVE_LIBURING )
+	/* The io_uring
+	 */
+	struct io_uring ring;
+
+	/* Value to indicate the io_uring was initialized
+	 */
+	uint8_t ring_initialized;
+#endif
+};
+
+int libewf_direct_io_handle_initialize(
+     libewf_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_free(
+     libewf_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_clone(
+     libewf_direct_io_handle_t **destination_direct_io_handle,
+     libewf_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_set_name(
+     libewf_direct_io_handle_t *direct_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_open(
+     libewf_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_close(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBURING )
+
+int libewf_direct_io_handle_complete_operation(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+#endif
+
+int libewf_direct_io_handle_submit_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libewf_direct_io_buffer_t *buffer,
+     uint8_t state,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_wait_for_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libewf_direct_io_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_flush(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_get_buffer(
+     libewf_direct_io_handle_t *direct_io_handle,
+     off64_t offset,
+     uint8_t for_writing,
+     libewf_direct_io_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_read_ahead(
+     libewf_direct_io_handle_t *direct_io_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t libewf_direct_io_handle_read(
+         libewf_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_direct_io_handle_write(
+         libewf_direct_io_handle_t *direct_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_direct_io_handle_seek_offset(
+         libewf_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_direct_io_handle_exists(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_is_open(
+     libewf_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_io_handle_get_size(
+     libewf_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DIRECT_IO_HANDLE_H ) */
+
@@ -33,6 +33,7 @@
 #include "libewf_libcthreads.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_file_tree.h"
+#include "libewf_single_files.h"
 #include "libewf_types.h"
 
 /* Creates a file entry
@@ -2090,26 +2091,14 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 	{
 		read_size = 1;
 	}
-	if( libewf_handle_seek_offset(
-	     (libewf_handle_t *) internal_file_entry->internal_handle,
-	     data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 ".",
-		 function,
-		 data_offset );
-
-		return( -1 );
-	}
-	read_count = libewf_handle_read_buffer(
+	/* The current offset of the handle is not used so that different file entries
+	 * of the same handle can be read at the same time
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
 		      (libewf_handle_t *) internal_file_entry->internal_handle,
 		      buffer,
 		      read_size,
+		      data_offset,
 		      error );
 
 	if( read_count <= -1 )
@@ -2118,8 +2107,9 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 data_offset );
 
 		return( -1 );
 	}
@@ -2673,20 +2663,37 @@ int libewf_file_entry_get_number_of_sub_file_entries(
 		return( -1 );
 	}
 #endif
-	result = libcdata_tree_node_get_number_of_sub_nodes(
+	result = libewf_single_files_read_sub_file_entries(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
-	          number_of_sub_file_entries,
 	          error );
 
 	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
 		 function );
 	}
+	else
+	{
+		result = libcdata_tree_node_get_number_of_sub_nodes(
+		          internal_file_entry->file_entry_tree_node,
+		          number_of_sub_file_entries,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub file entries.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_file_entry->read_write_lock,
@@ -2779,6 +2786,20 @@ int libewf_file_entry_get_sub_file_entry(
 		return( -1 );
 	}
 #endif
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_tree_node_get_sub_node_by_index(
 	     internal_file_entry->file_entry_tree_node,
              sub_file_entry_index,
@@ -2923,6 +2944,20 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_name(
 		return( -1 );
 	}
 #endif
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		goto on_error;
+	}
 	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 	          internal_file_entry->file_entry_tree_node,
 	          utf8_string,
@@ -3152,6 +3187,20 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_path(
 
 			goto on_error;
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_file_entry->internal_handle->single_files,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			goto on_error;
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 			  node,
 			  utf8_string_segment,
@@ -3298,6 +3347,20 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_name(
 		return( -1 );
 	}
 #endif
+	if( libewf_single_files_read_sub_file_entries(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		goto on_error;
+	}
 	result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 	          internal_file_entry->file_entry_tree_node,
 	          utf16_string,
@@ -3527,6 +3590,20 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_path(
 
 			goto on_error;
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_file_entry->internal_handle->single_files,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries.",
+			 function );
+
+			goto on_error;
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 			  node,
 			  utf16_string_segment,
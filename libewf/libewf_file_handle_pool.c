@@ -0,0 +1,1955 @@
+/*
+ * File handle pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_RESOURCE_H )
+#include <sys/resource.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_file_handle_pool.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+
+/* Creates a file handle pool
+ * The opens and closes of the underlying file IO handles are added to the statistics if set
+ * Make sure the value pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_initialize(
+     libewf_file_handle_pool_t **pool,
+     int maximum_number_of_open_handles,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_initialize";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*pool = memory_allocate_structure(
+	         libewf_file_handle_pool_t );
+
+	if( *pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pool,
+	     0,
+	     sizeof( libewf_file_handle_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pool.",
+		 function );
+
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+
+		return( -1 );
+	}
+	if( libewf_file_handle_pool_get_descriptor_budget(
+	     &( ( *pool )->descriptor_budget ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve descriptor budget.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *pool )->window_number = 1;
+	( *pool )->statistics    = statistics;
+
+	if( libewf_file_handle_pool_set_maximum_number_of_open_handles(
+	     *pool,
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of open handles.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *pool != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *pool )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file handle pool
+ * The files that are still part of the pool are detached from the pool
+ * but remain owned by their file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_free(
+     libewf_file_handle_pool_t **pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_free";
+	int file_index        = 0;
+	int result            = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool != NULL )
+	{
+		if( ( *pool )->files != NULL )
+		{
+			for( file_index = 0;
+			     file_index < ( *pool )->number_of_files;
+			     file_index++ )
+			{
+				( *pool )->files[ file_index ]->pool       = NULL;
+				( *pool )->files[ file_index ]->file_index = -1;
+				( *pool )->files[ file_index ]->open_index = -1;
+			}
+			memory_free(
+			 ( *pool )->files );
+		}
+		if( ( *pool )->open_files != NULL )
+		{
+			memory_free(
+			 ( *pool )->open_files );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *pool );
+
+		*pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of file descriptors the pool can use
+ * This is half of the (soft) limit of the number of open file descriptors of the process
+ * if available, the other half is left for the rest of the process
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_get_descriptor_budget(
+     int *descriptor_budget,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_GETRLIMIT )
+	struct rlimit limit_data;
+#endif
+
+	static char *function = "libewf_file_handle_pool_get_descriptor_budget";
+
+	if( descriptor_budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor budget.",
+		 function );
+
+		return( -1 );
+	}
+	*descriptor_budget = LIBEWF_FILE_HANDLE_POOL_DEFAULT_DESCRIPTOR_BUDGET;
+
+#if defined( HAVE_GETRLIMIT )
+	if( getrlimit(
+	     RLIMIT_NOFILE,
+	     &limit_data ) == 0 )
+	{
+		if( limit_data.rlim_cur > (rlim_t) INT_MAX )
+		{
+			limit_data.rlim_cur = (rlim_t) INT_MAX;
+		}
+		*descriptor_budget = (int) ( limit_data.rlim_cur / 2 );
+	}
+#endif
+	if( *descriptor_budget < LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES )
+	{
+		*descriptor_budget = LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES;
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of open handles
+ * A value of LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC sizes the pool
+ * to the observed working set within the descriptor budget, a value of 0 represents no limit
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_set_maximum_number_of_open_handles(
+     libewf_file_handle_pool_t *pool,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_set_maximum_number_of_open_handles";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_open_handles < 0 )
+	 && ( maximum_number_of_open_handles != LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( maximum_number_of_open_handles == LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC )
+	{
+		/* Until a working set has been observed the whole budget is available
+		 */
+		pool->automatic                      = 1;
+		pool->maximum_number_of_open_handles = pool->descriptor_budget;
+	}
+	else
+	{
+		pool->automatic                      = 0;
+		pool->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the open handles statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_get_statistics(
+     libewf_file_handle_pool_t *pool,
+     int *number_of_open_handles,
+     int *maximum_number_of_open_handles,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_get_statistics";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_open_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_opens == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of opens.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_closes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of closes.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_open_handles         = pool->number_of_open_files;
+	*maximum_number_of_open_handles = pool->maximum_number_of_open_handles;
+	*number_of_opens                = pool->number_of_opens;
+	*number_of_closes               = pool->number_of_closes;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Appends a file to the pool
+ * The file IO handle is replaced by a file IO handle that opens and closes
+ * the underlying file IO handle on demand, the pool takes over its management
+ * The file IO handle should not be open
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_append_file(
+     libewf_file_handle_pool_t *pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *pool_file_io_handle = NULL;
+	libewf_file_handle_pool_file_t *file  = NULL;
+	void *reallocation                    = NULL;
+	static char *function                 = "libewf_file_handle_pool_append_file";
+	int number_of_files                   = 0;
+	int result                            = 1;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_file_handle_pool_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		return( -1 );
+	}
+	file->file_io_handle = *file_io_handle;
+
+	if( libbfio_handle_initialize(
+	     &pool_file_io_handle,
+	     (intptr_t *) file,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_file_handle_pool_file_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_file_handle_pool_file_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_file_handle_pool_file_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_file_handle_pool_file_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_file_handle_pool_file_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_file_handle_pool_file_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_file_handle_pool_file_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_file_handle_pool_file_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_file_handle_pool_file_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_file_handle_pool_file_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pool file IO handle.",
+		 function );
+
+		file->file_io_handle = NULL;
+
+		libewf_file_handle_pool_file_free(
+		 &file,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( pool->number_of_files >= pool->number_of_allocated_files )
+	{
+		number_of_files = pool->number_of_allocated_files + LIBEWF_FILE_HANDLE_POOL_ALLOCATION_INCREMENT;
+
+		reallocation = memory_reallocate(
+		                pool->files,
+		                sizeof( libewf_file_handle_pool_file_t * ) * number_of_files );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize files.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			pool->files                     = (libewf_file_handle_pool_file_t **) reallocation;
+			pool->number_of_allocated_files = number_of_files;
+		}
+	}
+	if( result == 1 )
+	{
+		file->pool       = pool;
+		file->file_index = pool->number_of_files;
+
+		pool->files[ pool->number_of_files ] = file;
+		pool->number_of_files               += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	*file_io_handle = pool_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( file->pool != NULL )
+	{
+		libewf_file_handle_pool_remove_file(
+		 pool,
+		 file,
+		 NULL );
+	}
+	/* The caller retains the underlying file IO handle on error
+	 */
+	file->file_io_handle = NULL;
+
+	libbfio_handle_free(
+	 &pool_file_io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Removes a file from the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_remove_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	libewf_file_handle_pool_file_t *last_file = NULL;
+	static char *function                     = "libewf_file_handle_pool_remove_file";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( file->open_index >= 0 )
+	 && ( file->open_index < pool->number_of_open_files ) )
+	{
+		last_file = pool->open_files[ pool->number_of_open_files - 1 ];
+
+		pool->open_files[ file->open_index ] = last_file;
+		last_file->open_index                = file->open_index;
+		pool->number_of_open_files          -= 1;
+	}
+	if( ( file->file_index >= 0 )
+	 && ( file->file_index < pool->number_of_files ) )
+	{
+		last_file = pool->files[ pool->number_of_files - 1 ];
+
+		pool->files[ file->file_index ] = last_file;
+		last_file->file_index           = file->file_index;
+		pool->number_of_files          -= 1;
+	}
+	file->pool       = NULL;
+	file->file_index = -1;
+	file->open_index = -1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Ends the current access window
+ * The access frequencies of the files are aged and, if the maximum number of open handles
+ * is determined automatically, the maximum is sized to twice the observed working set
+ * The caller is expected to hold the mutex of the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_end_window(
+     libewf_file_handle_pool_t *pool,
+     libcerror_error_t **error )
+{
+	static char *function              = "libewf_file_handle_pool_end_window";
+	int file_index                     = 0;
+	int maximum_number_of_open_handles = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	for( file_index = 0;
+	     file_index < pool->number_of_files;
+	     file_index++ )
+	{
+		pool->files[ file_index ]->frequency >>= 1;
+	}
+	if( pool->automatic != 0 )
+	{
+		if( pool->working_set_size > ( pool->descriptor_budget / 2 ) )
+		{
+			maximum_number_of_open_handles = pool->descriptor_budget;
+		}
+		else
+		{
+			maximum_number_of_open_handles = pool->working_set_size * 2;
+		}
+		if( maximum_number_of_open_handles < LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES )
+		{
+			maximum_number_of_open_handles = LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES;
+		}
+		pool->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+	pool->window_number            += 1;
+	pool->number_of_window_accesses = 0;
+	pool->working_set_size          = 0;
+
+	return( 1 );
+}
+
+/* Opens the underlying file IO handle of a file
+ * If the maximum number of open handles has been reached the least valuable
+ * open file is closed first, which is the least frequently and of those
+ * the least recently accessed file
+ * The caller is expected to hold the mutex of the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_open_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	libewf_file_handle_pool_file_t *candidate_file = NULL;
+	libewf_file_handle_pool_file_t *victim_file    = NULL;
+	void *reallocation                             = NULL;
+	static char *function                          = "libewf_file_handle_pool_open_file";
+	int number_of_open_files                       = 0;
+	int open_index                                 = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->open_index != -1 )
+	{
+		return( 1 );
+	}
+	while( ( pool->maximum_number_of_open_handles > 0 )
+	    && ( pool->number_of_open_files >= pool->maximum_number_of_open_handles ) )
+	{
+		victim_file = NULL;
+
+		for( open_index = 0;
+		     open_index < pool->number_of_open_files;
+		     open_index++ )
+		{
+			candidate_file = pool->open_files[ open_index ];
+
+			if( ( victim_file == NULL )
+			 || ( candidate_file->frequency < victim_file->frequency )
+			 || ( ( candidate_file->frequency == victim_file->frequency )
+			  &&  ( candidate_file->last_access < victim_file->last_access ) ) )
+			{
+				victim_file = candidate_file;
+			}
+		}
+		if( victim_file == NULL )
+		{
+			break;
+		}
+		if( libewf_file_handle_pool_close_file(
+		     pool,
+		     victim_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close least valuable file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( pool->number_of_open_files >= pool->number_of_allocated_open_files )
+	{
+		number_of_open_files = pool->number_of_allocated_open_files + LIBEWF_FILE_HANDLE_POOL_ALLOCATION_INCREMENT;
+
+		reallocation = memory_reallocate(
+		                pool->open_files,
+		                sizeof( libewf_file_handle_pool_file_t * ) * number_of_open_files );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize open files.",
+			 function );
+
+			return( -1 );
+		}
+		pool->open_files                     = (libewf_file_handle_pool_file_t **) reallocation;
+		pool->number_of_allocated_open_files = number_of_open_files;
+	}
+	if( libbfio_handle_open(
+	     file->file_io_handle,
+	     file->access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure a file opened for truncation is not truncated when it is reopened
+	 */
+	file->access_flags &= ~( LIBBFIO_ACCESS_FLAG_TRUNCATE );
+
+	if( file->current_offset != 0 )
+	{
+		if( libbfio_handle_seek_offset(
+		     file->file_io_handle,
+		     file->current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO handle.",
+			 function,
+			 file->current_offset,
+			 file->current_offset );
+
+			libbfio_handle_close(
+			 file->file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	file->open_index = pool->number_of_open_files;
+
+	pool->open_files[ pool->number_of_open_files ] = file;
+	pool->number_of_open_files                    += 1;
+	pool->number_of_opens                         += 1;
+
+	if( pool->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     pool->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILE_OPENS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the underlying file IO handle of a file
+ * The caller is expected to hold the mutex of the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_close_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	libewf_file_handle_pool_file_t *last_file = NULL;
+	static char *function                     = "libewf_file_handle_pool_close_file";
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->open_index == -1 )
+	{
+		return( 1 );
+	}
+	if( ( file->open_index < 0 )
+	 || ( file->open_index >= pool->number_of_open_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file - open index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     file->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	last_file = pool->open_files[ pool->number_of_open_files - 1 ];
+
+	pool->open_files[ file->open_index ] = last_file;
+	last_file->open_index                = file->open_index;
+	pool->number_of_open_files          -= 1;
+	pool->number_of_closes              += 1;
+
+	file->open_index = -1;
+
+	if( pool->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     pool->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates a file
+ * Make sure the value file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_initialize(
+     libewf_file_handle_pool_file_t **file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_initialize";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file = memory_allocate_structure(
+	         libewf_file_handle_pool_file_t );
+
+	if( *file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *file,
+	     0,
+	     sizeof( libewf_file_handle_pool_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file.",
+		 function );
+
+		memory_free(
+		 *file );
+
+		*file = NULL;
+
+		return( -1 );
+	}
+	( *file )->file_index = -1;
+	( *file )->open_index = -1;
+
+	return( 1 );
+}
+
+/* Frees a file
+ * The file is removed from its pool and the underlying file IO handle is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_free(
+     libewf_file_handle_pool_file_t **file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_free";
+	int result            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file != NULL )
+	{
+		if( ( *file )->pool != NULL )
+		{
+			if( libewf_file_handle_pool_remove_file(
+			     ( *file )->pool,
+			     *file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove file from pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *file )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *file );
+
+		*file = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the file
+ * The destination file is not part of a pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_clone(
+     libewf_file_handle_pool_file_t **destination_file,
+     libewf_file_handle_pool_file_t *source_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_clone";
+
+	if( destination_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_file_handle_pool_file_initialize(
+	     destination_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_clone(
+	     &( ( *destination_file )->file_io_handle ),
+	     source_file->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_file )->access_flags = source_file->access_flags;
+	( *destination_file )->size         = source_file->size;
+	( *destination_file )->size_set     = source_file->size_set;
+
+	return( 1 );
+
+on_error:
+	if( *destination_file != NULL )
+	{
+		libewf_file_handle_pool_file_free(
+		 destination_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_open(
+     libewf_file_handle_pool_file_t *file,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_open";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - already open.",
+		 function );
+
+		return( -1 );
+	}
+	file->access_flags   = access_flags;
+	file->current_offset = 0;
+	file->size_set       = 0;
+	file->is_open        = 1;
+
+	/* The underlying file IO handle is opened directly
+	 * so that errors like a missing file are reported on open
+	 */
+	if( libewf_file_handle_pool_file_access(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		file->is_open = 0;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the file
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_close(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	libewf_file_handle_pool_t *pool = NULL;
+	static char *function           = "libewf_file_handle_pool_file_close";
+	int result                      = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	pool = file->pool;
+
+	if( pool == NULL )
+	{
+		result = libbfio_handle_is_open(
+		          file->file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libbfio_handle_close(
+			     file->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		result = 0;
+	}
+	else
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( libewf_file_handle_pool_close_file(
+		     pool,
+		     file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file in pool.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+	}
+	if( result == 0 )
+	{
+		file->is_open = 0;
+	}
+	return( result );
+}
+
+/* Registers an access of the file and makes sure the underlying file IO handle is open
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_access(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	libewf_file_handle_pool_t *pool = NULL;
+	static char *function           = "libewf_file_handle_pool_file_access";
+	int result                      = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - not open.",
+		 function );
+
+		return( -1 );
+	}
+	pool = file->pool;
+
+	if( pool == NULL )
+	{
+		result = libbfio_handle_is_open(
+		          file->file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     file->file_io_handle,
+			     file->access_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle.",
+				 function );
+
+				return( -1 );
+			}
+			file->access_flags &= ~( LIBBFIO_ACCESS_FLAG_TRUNCATE );
+
+			if( libbfio_handle_seek_offset(
+			     file->file_io_handle,
+			     file->current_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO handle.",
+				 function,
+				 file->current_offset,
+				 file->current_offset );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	pool->access_counter += 1;
+	file->last_access     = pool->access_counter;
+
+	if( file->frequency < (uint32_t) UINT32_MAX )
+	{
+		file->frequency += 1;
+	}
+	if( file->window_number != pool->window_number )
+	{
+		file->window_number     = pool->window_number;
+		pool->working_set_size += 1;
+	}
+	pool->number_of_window_accesses += 1;
+
+	if( pool->number_of_window_accesses >= LIBEWF_FILE_HANDLE_POOL_WINDOW_SIZE )
+	{
+		if( libewf_file_handle_pool_end_window(
+		     pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to end access window.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_file_handle_pool_open_file(
+		     pool,
+		     file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file in pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a buffer from the file
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_file_handle_pool_file_read(
+         libewf_file_handle_pool_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_read";
+	ssize_t read_count    = 0;
+
+	if( libewf_file_handle_pool_file_access(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to access file.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the file
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_file_handle_pool_file_write(
+         libewf_file_handle_pool_file_t *file,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_write";
+	ssize_t write_count   = 0;
+
+	if( libewf_file_handle_pool_file_access(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to access file.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file->file_io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file->current_offset += (off64_t) write_count;
+	file->size_set        = 0;
+
+	return( write_count );
+}
+
+/* Seeks a certain offset within the file
+ * If the underlying file IO handle is closed an absolute or relative offset
+ * is only stored and applied when the file is accessed
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_file_handle_pool_file_seek_offset(
+         libewf_file_handle_pool_file_t *file,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_seek_offset";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file->pool != NULL )
+	 && ( file->open_index == -1 )
+	 && ( whence != SEEK_END ) )
+	{
+		if( whence == SEEK_CUR )
+		{
+			offset += file->current_offset;
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		file->current_offset = offset;
+
+		return( offset );
+	}
+	if( libewf_file_handle_pool_file_access(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to access file.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libbfio_handle_seek_offset(
+	          file->file_io_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if the file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_file_handle_pool_file_exists(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_exists";
+	int result            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          file->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file IO handle exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the file is open
+ * The file remains open while the underlying file IO handle is temporarily closed by the pool
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_file_handle_pool_file_is_open(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_is_open";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * The size is cached until the file is written to or reopened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_handle_pool_file_get_size(
+     libewf_file_handle_pool_file_t *file,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_handle_pool_file_get_size";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file->size_set == 0 )
+	{
+		if( file->is_open != 0 )
+		{
+			if( libewf_file_handle_pool_file_access(
+			     file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to access file.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbfio_handle_get_size(
+		     file->file_io_handle,
+		     &( file->size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		file->size_set = 1;
+	}
+	*size = file->size;
+
+	return( 1 );
+}
+
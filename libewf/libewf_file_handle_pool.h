@@ -0,0 +1,283 @@
+/*
+ * File handle pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_FILE_HANDLE_POOL_H )
+#define _LIBEWF_FILE_HANDLE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_file_handle_pool libewf_file_handle_pool_t;
+
+typedef struct libewf_file_handle_pool_file libewf_file_handle_pool_file_t;
+
+struct libewf_file_handle_pool_file
+{
+	/* The file handle pool
+	 * the value is NULL if the file is not part of a pool
+	 */
+	libewf_file_handle_pool_t *pool;
+
+	/* The index of the file in the pool
+	 */
+	int file_index;
+
+	/* The index of the file in the open files of the pool
+	 * the value is -1 if the underlying file IO handle is closed
+	 */
+	int open_index;
+
+	/* The underlying file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file is (logically) open
+	 */
+	uint8_t is_open;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* Value to indicate the size was set
+	 */
+	uint8_t size_set;
+
+	/* The value of the access counter of the pool when the file was last accessed
+	 */
+	uint64_t last_access;
+
+	/* The (aged) number of accesses
+	 */
+	uint32_t frequency;
+
+	/* The number of the access window in which the file was last accessed
+	 */
+	uint64_t window_number;
+};
+
+struct libewf_file_handle_pool
+{
+	/* The files
+	 */
+	libewf_file_handle_pool_file_t **files;
+
+	/* The number of files
+	 */
+	int number_of_files;
+
+	/* The number of allocated files
+	 */
+	int number_of_allocated_files;
+
+	/* The files of which the underlying file IO handle is open
+	 */
+	libewf_file_handle_pool_file_t **open_files;
+
+	/* The number of open files
+	 */
+	int number_of_open_files;
+
+	/* The number of allocated open files
+	 */
+	int number_of_allocated_open_files;
+
+	/* The maximum number of open handles
+	 * a value of 0 represents no limit
+	 */
+	int maximum_number_of_open_handles;
+
+	/* Value to indicate the maximum number of open handles
+	 * is determined automatically
+	 */
+	uint8_t automatic;
+
+	/* The number of file descriptors available to the pool
+	 */
+	int descriptor_budget;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The number of the current access window
+	 */
+	uint64_t window_number;
+
+	/* The number of accesses in the current access window
+	 */
+	int number_of_window_accesses;
+
+	/* The number of distinct files accessed in the current access window
+	 */
+	int working_set_size;
+
+	/* The number of times an underlying file IO handle was opened
+	 */
+	uint64_t number_of_opens;
+
+	/* The number of times an underlying file IO handle was closed
+	 */
+	uint64_t number_of_closes;
+
+	/* The statistics
+	 * the statistics are not managed by the pool
+	 */
+	libewf_statistics_t *statistics;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_file_handle_pool_initialize(
+     libewf_file_handle_pool_t **pool,
+     int maximum_number_of_open_handles,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_free(
+     libewf_file_handle_pool_t **pool,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_get_descriptor_budget(
+     int *descriptor_budget,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_set_maximum_number_of_open_handles(
+     libewf_file_handle_pool_t *pool,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_get_statistics(
+     libewf_file_handle_pool_t *pool,
+     int *number_of_open_handles,
+     int *maximum_number_of_open_handles,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_append_file(
+     libewf_file_handle_pool_t *pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_remove_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_end_window(
+     libewf_file_handle_pool_t *pool,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_open_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_close_file(
+     libewf_file_handle_pool_t *pool,
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_initialize(
+     libewf_file_handle_pool_file_t **file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_free(
+     libewf_file_handle_pool_file_t **file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_clone(
+     libewf_file_handle_pool_file_t **destination_file,
+     libewf_file_handle_pool_file_t *source_file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_open(
+     libewf_file_handle_pool_file_t *file,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_close(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_access(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+ssize_t libewf_file_handle_pool_file_read(
+         libewf_file_handle_pool_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_file_handle_pool_file_write(
+         libewf_file_handle_pool_file_t *file,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_file_handle_pool_file_seek_offset(
+         libewf_file_handle_pool_file_t *file,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_exists(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_is_open(
+     libewf_file_handle_pool_file_t *file,
+     libcerror_error_t **error );
+
+int libewf_file_handle_pool_file_get_size(
+     libewf_file_handle_pool_file_t *file,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_FILE_HANDLE_POOL_H ) */
+
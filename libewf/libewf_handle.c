@@ -20,19 +20,30 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
+#include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_chunk_view.h"
 #include "libewf_compression.h"
 #include "libewf_data_chunk.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
+#include "libewf_direct_io_handle.h"
 #include "libewf_file_entry.h"
+#include "libewf_file_handle_pool.h"
 #include "libewf_hash_sections.h"
 #include "libewf_handle.h"
 #include "libewf_header_sections.h"
@@ -47,6 +58,8 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_lru_cache.h"
+#include "libewf_memory_map.h"
 #include "libewf_metadata.h"
 #include "libewf_restart_data.h"
 #include "libewf_sector_range.h"
@@ -138,6 +151,21 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_statistics_initialize(
+	     &( internal_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->statistics = internal_handle->statistics;
+
 	if( libewf_media_values_initialize(
 	     &( internal_handle->media_values ),
 	     error ) != 1 )
@@ -206,9 +234,51 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->chunk_table_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->read_ahead_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read-ahead mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_handle->read_ahead_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read-ahead condition.",
+		 function );
+
+		goto on_error;
+	}
 #endif
-	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
-	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->date_format                     = LIBEWF_DATE_FORMAT_CTIME;
+	internal_handle->maximum_number_of_open_handles  = LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC;
+	internal_handle->maximum_chunk_groups_cache_size = LIBEWF_DEFAULT_CHUNK_GROUPS_CACHE_SIZE;
+	internal_handle->maximum_chunks_cache_size       = LIBEWF_DEFAULT_CHUNKS_CACHE_SIZE;
+	internal_handle->maximum_chunk_data_pool_size    = LIBEWF_DEFAULT_CHUNK_DATA_POOL_SIZE;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -217,6 +287,26 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_ahead_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->read_ahead_mutex ),
+			 NULL );
+		}
+		if( internal_handle->chunk_table_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->chunk_table_mutex ),
+			 NULL );
+		}
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -244,6 +334,12 @@ on_error:
 			 &( internal_handle->media_values ),
 			 NULL );
 		}
+		if( internal_handle->statistics != NULL )
+		{
+			libewf_statistics_free(
+			 &( internal_handle->statistics ),
+			 NULL );
+		}
 		if( internal_handle->io_handle != NULL )
 		{
 			libewf_io_handle_free(
@@ -301,6 +397,45 @@ int libewf_handle_free(
 		*handle = NULL;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libewf_internal_handle_free_read_ahead_thread_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( internal_handle->read_ahead_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->read_ahead_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead mutex.",
+			 function );
+
+			result = -1;
+		}
 		if( libcthreads_read_write_lock_free(
 		     &( internal_handle->read_write_lock ),
 		     error ) != 1 )
@@ -314,6 +449,19 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->chunk_table_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libewf_io_handle_free(
 		     &( internal_handle->io_handle ),
@@ -328,6 +476,19 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libewf_statistics_free(
+		     &( internal_handle->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
 		if( libewf_media_values_free(
 		     &( internal_handle->media_values ),
 		     error ) != 1 )
@@ -383,6 +544,22 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->index_file != NULL )
+		{
+			if( libewf_index_file_free(
+			     &( internal_handle->index_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_handle );
 	}
@@ -400,6 +577,10 @@ int libewf_handle_clone(
 	libewf_internal_handle_t *internal_destination_handle = NULL;
 	libewf_internal_handle_t *internal_source_handle      = NULL;
 	static char *function                                 = "libewf_handle_clone";
+	uint64_t number_of_closes                             = 0;
+	uint64_t number_of_opens                              = 0;
+	int maximum_number_of_open_handles                    = 0;
+	int number_of_open_handles                            = 0;
 
 	if( destination_handle == NULL )
 	{
@@ -574,6 +755,44 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 		internal_destination_handle->file_io_pool_created_in_library = 1;
+
+		/* The cloned segment files are not part of the file handle pool of the source
+		 * hence the number of open handles is limited by the destination file IO pool
+		 */
+		if( internal_source_handle->file_handle_pool != NULL )
+		{
+			if( libewf_file_handle_pool_get_statistics(
+			     internal_source_handle->file_handle_pool,
+			     &number_of_open_handles,
+			     &maximum_number_of_open_handles,
+			     &number_of_opens,
+			     &number_of_closes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve maximum number of open handles from source file handle pool.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_pool_set_maximum_number_of_open_handles(
+			     internal_destination_handle->file_io_pool,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in destination file IO pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 	if( internal_source_handle->read_io_handle != NULL )
 	{
@@ -642,7 +861,7 @@ int libewf_handle_clone(
 	}
 	if( internal_source_handle->chunk_groups_cache != NULL )
 	{
-		if( libfcache_cache_clone(
+		if( libewf_lru_cache_clone(
 		     &( internal_destination_handle->chunk_groups_cache ),
 		     internal_source_handle->chunk_groups_cache,
 		     error ) != 1 )
@@ -659,7 +878,7 @@ int libewf_handle_clone(
 	}
 	if( internal_source_handle->chunks_cache != NULL )
 	{
-		if( libfcache_cache_clone(
+		if( libewf_lru_cache_clone(
 		     &( internal_destination_handle->chunks_cache ),
 		     internal_source_handle->chunks_cache,
 		     error ) != 1 )
@@ -674,6 +893,56 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
+	if( internal_source_handle->concurrent_chunks_cache != NULL )
+	{
+		if( libewf_sharded_cache_clone(
+		     &( internal_destination_handle->concurrent_chunks_cache ),
+		     internal_source_handle->concurrent_chunks_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination concurrent chunks cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_source_handle->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_initialize(
+		     &( internal_destination_handle->chunk_data_pool ),
+		     internal_source_handle->maximum_chunk_data_pool_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk data pool.",
+			 function );
+
+			goto on_error;
+		}
+		internal_destination_handle->io_handle->chunk_data_pool = internal_destination_handle->chunk_data_pool;
+	}
+	if( libewf_statistics_initialize(
+	     &( internal_destination_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination statistics.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_handle->io_handle->statistics = internal_destination_handle->statistics;
+
 	if( internal_source_handle->hash_sections != NULL )
 	{
 		if( libewf_hash_sections_clone(
@@ -727,8 +996,14 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
-	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
-	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+	internal_destination_handle->maximum_number_of_open_handles  = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->maximum_chunk_groups_cache_size = internal_source_handle->maximum_chunk_groups_cache_size;
+	internal_destination_handle->maximum_chunks_cache_size       = internal_source_handle->maximum_chunks_cache_size;
+	internal_destination_handle->maximum_chunk_data_pool_size    = internal_source_handle->maximum_chunk_data_pool_size;
+	internal_destination_handle->read_ahead_depth                = internal_source_handle->read_ahead_depth;
+	internal_destination_handle->read_ahead_number_of_threads    = internal_source_handle->read_ahead_number_of_threads;
+	internal_destination_handle->lazy_open                       = internal_source_handle->lazy_open;
+	internal_destination_handle->date_format                     = internal_source_handle->date_format;
 
 	return( 1 );
 
@@ -753,15 +1028,21 @@ on_error:
 			 &( internal_destination_handle->hash_sections ),
 			 NULL );
 		}
+		if( internal_destination_handle->concurrent_chunks_cache != NULL )
+		{
+			libewf_sharded_cache_free(
+			 &( internal_destination_handle->concurrent_chunks_cache ),
+			 NULL );
+		}
 		if( internal_destination_handle->chunks_cache != NULL )
 		{
-			libfcache_cache_free(
+			libewf_lru_cache_free(
 			 &( internal_destination_handle->chunks_cache ),
 			 NULL );
 		}
 		if( internal_destination_handle->chunk_groups_cache != NULL )
 		{
-			libfcache_cache_free(
+			libewf_lru_cache_free(
 			 &( internal_destination_handle->chunk_groups_cache ),
 			 NULL );
 		}
@@ -822,6 +1103,18 @@ on_error:
 			 &( internal_destination_handle->media_values ),
 			 NULL );
 		}
+		if( internal_destination_handle->chunk_data_pool != NULL )
+		{
+			libewf_chunk_data_pool_free(
+			 &( internal_destination_handle->chunk_data_pool ),
+			 NULL );
+		}
+		if( internal_destination_handle->statistics != NULL )
+		{
+			libewf_statistics_free(
+			 &( internal_destination_handle->statistics ),
+			 NULL );
+		}
 		if( internal_destination_handle->io_handle != NULL )
 		{
 			libewf_io_handle_free(
@@ -885,17 +1178,24 @@ int libewf_handle_open(
      int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	char *first_segment_filename              = NULL;
-	static char *function                     = "libewf_handle_open";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle            = NULL;
+	libbfio_pool_t *file_io_pool                = NULL;
+	libcdata_array_t *memory_maps               = NULL;
+	libewf_file_handle_pool_t *file_handle_pool = NULL;
+	libewf_internal_handle_t *internal_handle   = NULL;
+	libewf_memory_map_t *memory_map             = NULL;
+	libewf_segment_table_t *segment_table       = NULL;
+	char *first_segment_filename                = NULL;
+	static char *function                       = "libewf_handle_open";
+	size_t filename_length                      = 0;
+	int file_io_pool_entry                      = 0;
+	int filename_index                          = 0;
+	int maximum_number_of_open_handles          = 0;
+	int result                                  = 0;
+
+#if defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+	int memory_map_entry                        = 0;
+#endif
 
 	if( handle == NULL )
 	{
@@ -932,6 +1232,32 @@ int libewf_handle_open(
 
 		return( -1 );
 	}
+#if !defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO is not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if !defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped IO is not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -964,10 +1290,27 @@ int libewf_handle_open(
 		return( -1 );
 	}
 #endif
+	/* The number of open segment files is managed by the file handle pool
+	 */
+	if( libewf_file_handle_pool_initialize(
+	     &file_handle_pool,
+	     maximum_number_of_open_handles,
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file handle pool.",
+		 function );
+
+		goto on_error;
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     0,
-	     maximum_number_of_open_handles,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1003,9 +1346,23 @@ int libewf_handle_open(
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+#if defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+			{
+				result = libewf_direct_io_file_initialize(
+				          &file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else
+#endif
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1032,17 +1389,34 @@ int libewf_handle_open(
 				goto on_error;
 			}
 #endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) == 0 )
+			{
+				if( libbfio_file_set_name(
+				     file_io_handle,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set name in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libewf_file_handle_pool_append_file(
+			     file_handle_pool,
+			     &file_io_handle,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to file handle pool.",
 				 function );
 
 				goto on_error;
@@ -1065,7 +1439,77 @@ int libewf_handle_open(
 			}
 			file_io_handle = NULL;
 
-#if defined( HAVE_DEBUG_OUTPUT )
+#if defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+			{
+				if( memory_maps == NULL )
+				{
+					if( libcdata_array_initialize(
+					     &memory_maps,
+					     0,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create memory maps array.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				/* If the file cannot be memory mapped its chunks are read
+				 * using the file IO pool, a NULL memory map is appended
+				 */
+				if( libewf_memory_map_initialize(
+				     &memory_map,
+				     filenames[ filename_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create memory map of file: %s.",
+					 function,
+					 filenames[ filename_index ] );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+				}
+				/* The memory maps are appended in the same order as the file IO pool entries
+				 */
+				if( libcdata_array_append_entry(
+				     memory_maps,
+				     &memory_map_entry,
+				     (intptr_t *) memory_map,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append memory map to array.",
+					 function );
+
+					goto on_error;
+				}
+				memory_map = NULL;
+			}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
@@ -1174,6 +1618,9 @@ int libewf_handle_open(
 		goto on_error;
 	}
 #endif
+	internal_handle->file_handle_pool            = file_handle_pool;
+	internal_handle->io_handle->file_handle_pool = file_handle_pool;
+
 	result = libewf_internal_handle_open_file_io_pool(
 	          internal_handle,
 	          file_io_pool,
@@ -1189,10 +1636,18 @@ int libewf_handle_open(
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
 		 "%s: unable to open handle using a file IO pool.",
 		 function );
+
+		internal_handle->file_handle_pool            = NULL;
+		internal_handle->io_handle->file_handle_pool = NULL;
 	}
 	else
 	{
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		file_handle_pool = NULL;
+
+		internal_handle->memory_maps = memory_maps;
+		memory_maps                  = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	result = libcthreads_read_write_lock_release_for_write(
@@ -1216,6 +1671,19 @@ int libewf_handle_open(
 	return( 1 );
 
 on_error:
+	if( memory_map != NULL )
+	{
+		libewf_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	if( memory_maps != NULL )
+	{
+		libcdata_array_free(
+		 &memory_maps,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_memory_map_free,
+		 NULL );
+	}
 	if( segment_table != NULL )
 	{
 		libewf_segment_table_free(
@@ -1234,6 +1702,12 @@ on_error:
 		 &file_io_pool,
 		 NULL );
 	}
+	if( file_handle_pool != NULL )
+	{
+		libewf_file_handle_pool_free(
+		 &file_handle_pool,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -1251,17 +1725,18 @@ int libewf_handle_open_wide(
      int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	wchar_t *first_segment_filename           = NULL;
-	static char *function                     = "libewf_handle_open_wide";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	libbfio_handle_t *file_io_handle            = NULL;
+	libbfio_pool_t *file_io_pool                = NULL;
+	libewf_file_handle_pool_t *file_handle_pool = NULL;
+	libewf_internal_handle_t *internal_handle   = NULL;
+	libewf_segment_table_t *segment_table       = NULL;
+	wchar_t *first_segment_filename             = NULL;
+	static char *function                       = "libewf_handle_open_wide";
+	size_t filename_length                      = 0;
+	int file_io_pool_entry                      = 0;
+	int filename_index                          = 0;
+	int maximum_number_of_open_handles          = 0;
+	int result                                  = 0;
 
 	if( handle == NULL )
 	{
@@ -1298,6 +1773,28 @@ int libewf_handle_open_wide(
 
 		return( -1 );
 	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO is not supported for wide character filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped IO is not supported for wide character filenames.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -1330,10 +1827,27 @@ int libewf_handle_open_wide(
 		return( -1 );
 	}
 #endif
+	/* The number of open segment files is managed by the file handle pool
+	 */
+	if( libewf_file_handle_pool_initialize(
+	     &file_handle_pool,
+	     maximum_number_of_open_handles,
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file handle pool.",
+		 function );
+
+		goto on_error;
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     0,
-	     maximum_number_of_open_handles,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1413,6 +1927,20 @@ int libewf_handle_open_wide(
 
 				goto on_error;
 			}
+			if( libewf_file_handle_pool_append_file(
+			     file_handle_pool,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to file handle pool.",
+				 function );
+
+				goto on_error;
+			}
 			if( libbfio_pool_append_handle(
 			     file_io_pool,
 			     &file_io_pool_entry,
@@ -1540,6 +2068,9 @@ int libewf_handle_open_wide(
 		goto on_error;
 	}
 #endif
+	internal_handle->file_handle_pool            = file_handle_pool;
+	internal_handle->io_handle->file_handle_pool = file_handle_pool;
+
 	result = libewf_internal_handle_open_file_io_pool(
 	          internal_handle,
 	          file_io_pool,
@@ -1555,10 +2086,15 @@ int libewf_handle_open_wide(
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
 		 "%s: unable to open handle using a file IO pool.",
 		 function );
+
+		internal_handle->file_handle_pool            = NULL;
+		internal_handle->io_handle->file_handle_pool = NULL;
 	}
 	else
 	{
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		file_handle_pool = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	result = libcthreads_read_write_lock_release_for_write(
@@ -1600,6 +2136,12 @@ on_error:
 		 &file_io_pool,
 		 NULL );
 	}
+	if( file_handle_pool != NULL )
+	{
+		libewf_file_handle_pool_free(
+		 &file_handle_pool,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -2930,14 +3472,19 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	static char *function                           = "libewf_internal_handle_open_read_segment_files";
+	size64_t maximum_segment_size                   = 0;
+	size64_t segment_file_size                      = 0;
+	size64_t storage_media_size                     = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_number                         = 0;
+	uint32_t last_segment_number                    = 0;
+	int file_io_pool_entry                          = 0;
+	int last_segment_file                           = 0;
+	int map_on_demand                               = 0;
+	int read_section_data                           = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3008,10 +3555,51 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
+	last_segment_number = number_of_segments - 1;
+
+	/* When the segments are mapped on demand only the first and last segment files
+	 * are read, these contain the media and hash metadata, the other segment files
+	 * are read the first time the storage media data they contain is accessed
+	 */
+	if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND ) != 0 )
+	{
+		if( number_of_segments > 2 )
+		{
+			map_on_demand = 1;
+		}
+		else
+		{
+			segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND );
+		}
+	}
 	for( segment_number = 0;
 	     segment_number < number_of_segments;
 	     segment_number++ )
 	{
+		if( ( map_on_demand != 0 )
+		 && ( segment_number > 0 )
+		 && ( segment_number < last_segment_number ) )
+		{
+			/* Unmapped segments have no storage media size until they are mapped
+			 */
+			if( libewf_segment_table_set_segment_storage_media_size_by_index(
+			     segment_table,
+			     segment_number,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+			continue;
+		}
 		if( libewf_segment_table_get_segment_by_index(
 		     segment_table,
 		     segment_number,
@@ -3175,27 +3763,69 @@ int libewf_internal_handle_open_read_segment_files(
 		{
 			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
+		read_section_data = 1;
+
+		if( internal_handle->io_handle->index_file != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+			if( libewf_index_file_get_segment_by_index(
+			     internal_handle->io_handle->index_file,
+			     (int) segment_number,
+			     &index_file_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
+				 function,
+				 segment_number );
 
-			return( -1 );
+				return( -1 );
+			}
+			/* Segment files without metadata sections only contain chunk data
+			 * and tables which were read from the index file
+			 */
+			if( ( index_file_segment != NULL )
+			 && ( ( index_file_segment->flags & LIBEWF_INDEX_FILE_SEGMENT_FLAG_HAS_METADATA ) == 0 ) )
+			{
+				read_section_data = 0;
+			}
+		}
+		if( read_section_data != 0 )
+		{
+			if( libewf_internal_handle_open_read_segment_file_section_data(
+			     internal_handle,
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section data from segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
+		/* The segments are mapped in order, hence the last segment
+		 * is mapped after all the preceding segments were mapped
+		 */
+		storage_media_size = segment_file->storage_media_size;
+
+		if( ( map_on_demand != 0 )
+		 && ( segment_number == last_segment_number ) )
+		{
+			storage_media_size = 0;
 		}
 		if( libewf_segment_table_set_segment_storage_media_size_by_index(
 		     segment_table,
 		     segment_number,
-		     segment_file->storage_media_size,
+		     storage_media_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -3211,6 +3841,14 @@ int libewf_internal_handle_open_read_segment_files(
 		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
 		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
+	if( map_on_demand != 0 )
+	{
+		segment_table->number_of_mapped_segments = 1;
+	}
+	else
+	{
+		segment_table->number_of_mapped_segments = number_of_segments;
+	}
 	if( last_segment_file == 0 )
 	{
 		libcerror_error_set(
@@ -3239,24 +3877,27 @@ int libewf_internal_handle_open_read_segment_files(
 	return( 1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns 1 if successful or -1 on error
+/* Validates the index file against the segment files
+ * The index file is stale if the number of segment files, or the size or modification time
+ * of a segment file differ from the values stored in the index file
+ * Returns 1 if the index file is valid, 0 if stale or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
+int libewf_internal_handle_validate_index_file(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
-     int access_flags,
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	libbfio_handle_t *file_io_handle                = NULL;
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	static char *function                           = "libewf_internal_handle_validate_index_file";
+	size64_t segment_file_size                      = 0;
+	int64_t modification_time                       = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_number                         = 0;
+	int file_io_pool_entry                          = 0;
+	int number_of_index_file_segments               = 0;
+	int result                                      = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3269,75 +3910,282 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->index_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 "%s: invalid handle - missing index file.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( libewf_index_file_get_number_of_segments(
+	     internal_handle->index_file,
+	     &number_of_index_file_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from index file.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( number_of_segments != (uint32_t) number_of_index_file_segments )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
-		 function );
-
-		return( -1 );
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: number of segments mismatch ( index file: %d, segment files: %" PRIu32 " ).\n",
+			 function,
+			 number_of_index_file_segments,
+			 number_of_segments );
+		}
+#endif
+		return( 0 );
 	}
-	if( internal_handle->single_files != NULL )
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
 	{
-		libcerror_error_set(
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_index_file_get_segment_by_index(
+		     internal_handle->index_file,
+		     (int) segment_number,
+		     &index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( index_file_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing index file segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		result = libewf_index_file_get_modification_time(
+		          file_io_handle,
+		          &modification_time,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve modification time of segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( ( index_file_segment->segment_file_size != segment_file_size )
+		 || ( index_file_segment->modification_time != modification_time ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: segment: %" PRIu32 " was modified after the index file was written.\n",
+				 function,
+				 segment_number );
+			}
+#endif
+			return( 0 );
+		}
+		index_file_segment->file_io_pool_entry = file_io_pool_entry;
+	}
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+	int result                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->concurrent_chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - concurrent chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
@@ -3357,9 +4205,11 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_DIRECT_IO | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) ) != 0 )
 	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	  &&  ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_DIRECT_IO ) ) != 0 ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -3417,9 +4267,10 @@ int libewf_internal_handle_open_file_io_pool(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
+	if( libewf_lru_cache_initialize(
 	     &( internal_handle->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
+	     internal_handle->maximum_chunk_groups_cache_size,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -3431,9 +4282,10 @@ int libewf_internal_handle_open_file_io_pool(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
+	if( libewf_lru_cache_initialize(
 	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+	     internal_handle->maximum_chunks_cache_size,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -3445,6 +4297,52 @@ int libewf_internal_handle_open_file_io_pool(
 
 		goto on_error;
 	}
+	if( libewf_chunk_data_pool_initialize(
+	     &( internal_handle->chunk_data_pool ),
+	     internal_handle->maximum_chunk_data_pool_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->chunk_data_pool = internal_handle->chunk_data_pool;
+	internal_handle->io_handle->statistics      = internal_handle->statistics;
+
+	if( libewf_statistics_reset(
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_sharded_cache_initialize(
+	     &( internal_handle->concurrent_chunks_cache ),
+	     LIBEWF_CONCURRENT_CHUNKS_CACHE_NUMBER_OF_SHARDS,
+	     internal_handle->maximum_chunks_cache_size,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create concurrent chunks cache.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_header_values_initialize(
 	     &( internal_handle->header_values ),
 	     error ) != 1 )
@@ -3529,29 +4427,49 @@ int libewf_internal_handle_open_file_io_pool(
 	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
 	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
-		     error ) != 1 )
+		/* The file handle pool counts the opens of the segment files itself
+		 */
+		if( internal_handle->file_handle_pool == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
-			 function );
+			if( libbfio_pool_get_number_of_handles(
+			     file_io_pool,
+			     &number_of_file_io_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve the number of handles in the pool.",
+				 function );
 
-			goto on_error;
-		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				goto on_error;
+			}
+			if( libewf_statistics_add(
+			     internal_handle->statistics,
+			     LIBEWF_STATISTIC_SEGMENT_FILE_OPENS,
+			     (uint64_t) number_of_file_io_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 			 "%s: unable to create segment file.",
 			 function );
 
@@ -3662,6 +4580,72 @@ int libewf_internal_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		if( internal_handle->index_file != NULL )
+		{
+			result = 0;
+
+			/* The index file is only used to open segment files for reading
+			 * The modification time of segment files opened with direct IO
+			 * cannot be determined hence the index file cannot be validated
+			 */
+			if( ( access_flags & ( LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_DIRECT_IO ) ) == 0 )
+			{
+				result = libewf_internal_handle_validate_index_file(
+				          internal_handle,
+				          file_io_pool,
+				          segment_table,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to validate index file.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( result != 0 )
+			{
+				internal_handle->io_handle->index_file = internal_handle->index_file;
+			}
+			else
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: index file is stale and will be ignored.\n",
+					 function );
+				}
+#endif
+				if( libewf_index_file_free(
+				     &( internal_handle->index_file ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free index file.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		/* A valid index file already provides all the segment file sections
+		 */
+		if( ( internal_handle->lazy_open != 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+		 && ( internal_handle->io_handle->index_file == NULL ) )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND;
+		}
 		if( libewf_internal_handle_open_read_segment_files(
 		     internal_handle,
 		     file_io_pool,
@@ -3774,6 +4758,8 @@ int libewf_internal_handle_open_file_io_pool(
 	return( 1 );
 
 on_error:
+	internal_handle->io_handle->index_file = NULL;
+
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -3798,15 +4784,21 @@ on_error:
 		 &( internal_handle->header_values ),
 		 NULL );
 	}
+	if( internal_handle->concurrent_chunks_cache != NULL )
+	{
+		libewf_sharded_cache_free(
+		 &( internal_handle->concurrent_chunks_cache ),
+		 NULL );
+	}
 	if( internal_handle->chunks_cache != NULL )
 	{
-		libfcache_cache_free(
+		libewf_lru_cache_free(
 		 &( internal_handle->chunks_cache ),
 		 NULL );
 	}
 	if( internal_handle->chunk_groups_cache != NULL )
 	{
-		libfcache_cache_free(
+		libewf_lru_cache_free(
 		 &( internal_handle->chunk_groups_cache ),
 		 NULL );
 	}
@@ -3828,6 +4820,14 @@ on_error:
 		 &( internal_handle->read_io_handle ),
 		 error );
 	}
+	internal_handle->io_handle->chunk_data_pool = NULL;
+
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &( internal_handle->chunk_data_pool ),
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -3946,19 +4946,21 @@ on_error:
 	return( -1 );
 }
 
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
+/* Reads a (chunk-offset) index file
+ * The index file is used by the next open to open the segment files without reading
+ * their section descriptors and table sections
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_close(
-     libewf_handle_t *handle,
+int libewf_internal_handle_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
+	libewf_index_file_t *index_file = NULL;
+	static char *function           = "libewf_internal_handle_read_index_file";
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3969,360 +4971,263 @@ int libewf_handle_close(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	if( libewf_index_file_initialize(
+	     &index_file,
+	     error ) != 1 )
 	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
+	if( libewf_index_file_read_file_io_handle(
+	     index_file,
+	     file_io_handle,
+	     error ) != 1 )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file.",
+		 function );
 
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
+		goto on_error;
+	}
+	if( internal_handle->index_file != NULL )
+	{
+		if( libewf_index_file_free(
+		     &( internal_handle->index_file ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
+			 "%s: unable to free index file.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-		internal_handle->file_io_pool_created_in_library = 0;
 	}
-	internal_handle->file_io_pool = NULL;
+	internal_handle->index_file = index_file;
 
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
+	return( 1 );
+
+on_error:
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a (chunk-offset) index file
+ * The index file must be read before the handle is opened and is only used
+ * if it is not stale
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_read_index_file(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_index_file";
+	size_t filename_length                    = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = libcstring_narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %s.",
+		 function,
+		 filename );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
-	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->segment_table != NULL )
-	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->segment_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment table.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunk_groups_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunks_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunks_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks cache.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->hash_sections != NULL )
-	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->header_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->hash_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->single_files != NULL )
-	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
-			 function );
+#endif
+	result = libewf_internal_handle_read_index_file(
+	          internal_handle,
+	          file_io_handle,
+	          error );
 
-			result = -1;
-		}
-	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
-		 function );
-
-		result = -1;
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file: %s.",
+		 function,
+		 filename );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		result = -1;
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+#endif
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file: %s.",
+		 function,
+		 filename );
 
 		result = -1;
 	}
-/* TODO clear IO handle, segment tables */
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
 		result = -1;
 	}
-#endif
 	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Reads a (chunk-offset) index file
+ * The index file must be read before the handle is opened and is only used
+ * if it is not stale
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_read_index_file_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
-	ssize_t total_read_count        = 0;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_index_file_wide";
+	size_t filename_length                    = 0;
+	int result                                = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4333,203 +5238,171 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	filename_length = libcstring_wide_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values == NULL )
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %ls.",
+		 function,
+		 filename );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
-	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer == NULL )
+#endif
+	result = libewf_internal_handle_read_index_file(
+	          internal_handle,
+	          file_io_handle,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file: %ls.",
+		 function,
+		 filename );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+#endif
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file: %ls.",
+		 function,
+		 filename );
+
+		result = -1;
 	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	return( result );
 
-	while( buffer_size > 0 )
+on_error:
+	if( file_io_handle != NULL )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     chunk_index,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
-
-		internal_handle->current_offset += (off64_t) read_size;
-
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	return( total_read_count );
+	return( -1 );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes a (chunk-offset) index file of the segment files that are opened for reading
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
+	libbfio_handle_t *segment_file_io_handle        = NULL;
+	libewf_index_file_t *index_file                 = NULL;
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	static char *function                           = "libewf_internal_handle_write_index_file";
+	size64_t segment_file_size                      = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_number                         = 0;
+	int file_io_pool_entry                          = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4540,8 +5413,6 @@ ssize_t libewf_handle_read_buffer(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
@@ -4553,192 +5424,234 @@ ssize_t libewf_handle_read_buffer(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_handle->read_io_handle == NULL )
+	 || ( internal_handle->write_io_handle != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - index file can only be written when opened for reading.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		read_count = -1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - index file cannot be written when opened with direct IO.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-}
-
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libewf_index_file_initialize(
+	     &index_file,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-		return( -1 );
-	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+			goto on_error;
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     internal_handle->file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-		goto on_error;
-	}
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              buffer,
-	              buffer_size,
-	              error );
+			goto on_error;
+		}
+		if( libewf_index_file_segment_initialize(
+		     &index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index file segment.",
+			 function );
 
-	if( read_count == -1 )
+			goto on_error;
+		}
+		if( libewf_segment_file_copy_to_index_file_segment(
+		     segment_file,
+		     internal_handle->file_io_pool,
+		     index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to copy segment file: %" PRIu32 " to index file segment.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     &segment_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libewf_index_file_get_modification_time(
+		     segment_file_io_handle,
+		     &( index_file_segment->modification_time ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve modification time of segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		index_file_segment->segment_file_size = segment_file_size;
+
+		if( libewf_index_file_append_segment(
+		     index_file,
+		     index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %" PRIu32 " to index file.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		index_file_segment = NULL;
+	}
+	if( libewf_index_file_write_file_io_handle(
+	     index_file,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_index_file_free(
+	     &index_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( read_count );
+	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
+	if( index_file_segment != NULL )
+	{
+		libewf_index_file_segment_free(
+		 &index_file_segment,
+		 NULL );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Writes a (chunk-offset) index file
+ * The handle must be opened for reading, an existing file is overwritten
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_write_index_file(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
 {
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	off64_t chunk_data_offset = 0;
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_index_file";
+	size_t filename_length                    = 0;
+	int result                                = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4749,687 +5662,828 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+	filename_length = libcstring_narrow_string_length(
+	                   filename );
 
-			return( -1 );
-		}
-	}
-	if( internal_handle->media_values == NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %s.",
+		 function,
+		 filename );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+#endif
+	result = libewf_internal_handle_write_index_file(
+	          internal_handle,
+	          file_io_handle,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file: %s.",
+		 function,
+		 filename );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file: %s.",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes a (chunk-offset) index file
+ * The handle must be opened for reading, an existing file is overwritten
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_write_index_file_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_index_file_wide";
+	size_t filename_length                    = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	filename_length = libcstring_wide_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libewf_internal_handle_write_index_file(
+	          internal_handle,
+	          file_io_handle,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file: %ls.",
+		 function,
+		 filename );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file: %ls.",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	uint64_t statistic_values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_close";
+	ssize_t write_count                       = 0;
+	int number_of_pins                        = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+#endif
+	/* The chunk data of a chunk view is pinned in the concurrent chunks cache
+	 * and would no longer be valid after the cache is freed
+	 */
+	if( internal_handle->concurrent_chunks_cache != NULL )
 	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libewf_sharded_cache_get_number_of_pins(
+		     internal_handle->concurrent_chunks_cache,
+		     &number_of_pins,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already set.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of pins of concurrent chunks cache.",
+			 function );
 
-				return( -1 );
-			}
+			number_of_pins = -1;
 		}
-		if( internal_handle->chunk_data == NULL )
+		else if( number_of_pins != 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: unable to close handle with %d chunk views that have not been freed.",
 			 function,
-			 chunk_index );
-
+			 number_of_pins );
+		}
+		if( number_of_pins != 0 )
+		{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+#endif
 			return( -1 );
 		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+	}
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	{
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
+
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
 			 function );
 
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
-
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
+			result = -1;
 		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
+	}
+	if( internal_handle->file_io_pool_created_in_library != 0 )
+	{
+		/* Closing the file IO pool closes the segment files that are still open
+		 * the file handle pool counts these closes itself
+		 */
+		if( libewf_statistics_get_values(
+		     internal_handle->statistics,
+		     statistic_values,
+		     LIBEWF_NUMBER_OF_STATISTICS,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics.",
 			 function );
 
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
-
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
+			result = -1;
 		}
-		if( write_chunk != 0 )
+		else if( ( internal_handle->file_handle_pool == NULL )
+		      && ( statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILE_OPENS ] > statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES ] ) )
 		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
-
-				return( -1 );
-			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
+			if( libewf_statistics_add(
+			     internal_handle->statistics,
+			     LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES,
+			     statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILE_OPENS ] - statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES ],
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
 				 function );
 
-				return( -1 );
+				result = -1;
 			}
 		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
-
-		internal_handle->current_offset += (off64_t) write_size;
-
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
 		}
-		if( internal_handle->io_handle->abort != 0 )
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
 		}
+		internal_handle->file_io_pool_created_in_library = 0;
 	}
-	return( (ssize_t) buffer_offset );
-}
-
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	internal_handle->file_io_pool = NULL;
 
-	if( handle == NULL )
+	if( internal_handle->file_handle_pool != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_file_handle_pool_free(
+		     &( internal_handle->file_handle_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file handle pool.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
 
-		return( -1 );
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	if( internal_handle->index_file != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		if( libewf_index_file_free(
+		     &( internal_handle->index_file ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	return( write_count );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
-
-	if( handle == NULL )
+	if( internal_handle->read_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->write_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* Free the chunk data if it was not written
+	 */
+	if( internal_handle->chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	if( internal_handle->segment_table != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		if( libewf_segment_table_free(
+		     &( internal_handle->segment_table ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment table.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( internal_handle->chunk_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
-		 function );
+		if( libewf_lru_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->chunks_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( libewf_lru_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#endif
-	return( write_count );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Retrieves a (media) data chunk
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_get_data_chunk(
-     libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
-
-	if( handle == NULL )
+	if( internal_handle->concurrent_chunks_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_sharded_cache_free(
+		     &( internal_handle->concurrent_chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free concurrent chunks cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->memory_maps != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libcdata_array_free(
+		     &( internal_handle->memory_maps ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_memory_map_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory maps array.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( data_chunk == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
+	internal_handle->verified_mapped_chunk_index     = 0;
+	internal_handle->verified_mapped_chunk_index_set = 0;
 
-		return( -1 );
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
+
+			result = -1;
+		}
 	}
-	if( *data_chunk != NULL )
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		result = -1;
+	}
+	/* The chunk data pool is freed last since the chunk data freed above
+	 * is released to it
+	 */
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_free(
+		     &( internal_handle->chunk_data_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data pool.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_data_chunk_initialize(
-	     data_chunk,
-	     internal_handle->io_handle,
-	     internal_handle->write_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data chunk.",
-		 function );
-
-		goto on_error;
-	}
+/* TODO clear IO handle, segment tables */
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -5442,284 +6496,379 @@ int libewf_handle_get_data_chunk(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
-	return( 1 );
+	return( result );
+}
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
+/* Unpacks read-ahead chunk data
+ * Errors are not propagated, the chunk data is read again when it is needed
+ * Returns 1 if successful or 0 if not
+ */
+int libewf_internal_handle_read_ahead_unpack_chunk_data(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle )
+{
+	libcerror_error_t *error = NULL;
+
+	if( libewf_chunk_data_unpack(
+	     chunk_data,
+	     io_handle,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
 #endif
-	return( -1 );
+		libcerror_error_free(
+		 &error );
+
+		return( 0 );
+	}
+	return( 1 );
 }
 
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Unpacks a read-ahead chunk
+ * Callback function for the read-ahead thread pool
+ * The result is stored in the read-ahead chunk and the number of pending chunks is decremented
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_internal_handle_read_ahead_unpack_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_internal_handle_t *internal_handle )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	ssize_t read_count              = 0;
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_internal_handle_read_ahead_unpack_callback";
 
-	if( internal_handle == NULL )
+	if( read_ahead_chunk == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	read_ahead_chunk->result = libewf_internal_handle_read_ahead_unpack_chunk_data(
+	                            read_ahead_chunk->chunk_data,
+	                            internal_handle->io_handle );
+
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read-ahead mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->current_offset < 0 )
+	internal_handle->read_ahead_number_of_pending_chunks -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     internal_handle->read_ahead_condition,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast read-ahead condition.",
 		 function );
 
-		return( -1 );
+		libcthreads_mutex_release(
+		 internal_handle->read_ahead_mutex,
+		 NULL );
+
+		goto on_error;
 	}
-	if( internal_handle->media_values == NULL )
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read-ahead mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Unpacks read-ahead chunks using the read-ahead thread pool
+ * The thread pool is created on first use and reused by subsequent read-aheads
+ * This function waits until all the chunks have been unpacked
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_unpack_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libewf_read_ahead_chunk_t *read_ahead_chunks,
+     int number_of_read_ahead_chunks,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_read_ahead_unpack_chunks";
+	int number_of_pushed_chunks  = 0;
+	int read_ahead_chunk_index   = 0;
+	int result                   = 1;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+	if( read_ahead_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid read-ahead chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	if( ( internal_handle->read_ahead_thread_pool != NULL )
+	 && ( internal_handle->read_ahead_thread_pool_number_of_threads != internal_handle->read_ahead_number_of_threads ) )
 	{
-		return( 0 );
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
-
-	if( libewf_chunk_table_get_chunk_data_by_offset(
-	     internal_handle->chunk_table,
-	     internal_handle->current_chunk_index,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->chunk_groups_cache,
-	     internal_handle->chunks_cache,
-	     internal_handle->current_offset,
-	     &chunk_data,
-	     &chunk_data_offset,
-	     error ) != 1 )
+		if( libewf_internal_handle_free_read_ahead_thread_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->read_ahead_thread_pool == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->read_ahead_thread_pool ),
+		     NULL,
+		     internal_handle->read_ahead_number_of_threads,
+		     LIBEWF_MAXIMUM_READ_AHEAD_DEPTH,
+		     (int (*)(intptr_t *, void *)) &libewf_internal_handle_read_ahead_unpack_callback,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead thread pool.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		internal_handle->read_ahead_thread_pool_number_of_threads = internal_handle->read_ahead_number_of_threads;
 	}
-	if( chunk_data == NULL )
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read-ahead mutex.",
+		 function );
 
 		return( -1 );
 	}
-	read_count = (ssize_t) chunk_data->data_size;
+	internal_handle->read_ahead_number_of_pending_chunks = number_of_read_ahead_chunks;
 
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     internal_handle->current_chunk_index,
-	     chunk_data,
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 "%s: unable to release read-ahead mutex.",
+		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset += read_count;
-
-	internal_handle->current_chunk_index++;
+	for( read_ahead_chunk_index = 0;
+	     read_ahead_chunk_index < number_of_read_ahead_chunks;
+	     read_ahead_chunk_index++ )
+	{
+		read_ahead_chunks[ read_ahead_chunk_index ].result = 0;
 
-	return( read_count );
-}
+		if( libcthreads_thread_pool_push(
+		     internal_handle->read_ahead_thread_pool,
+		     (intptr_t *) &( read_ahead_chunks[ read_ahead_chunk_index ] ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read-ahead chunk: %d onto queue.",
+			 function,
+			 read_ahead_chunk_index );
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+			result = -1;
 
-	if( handle == NULL )
+			break;
+		}
+		number_of_pushed_chunks++;
+	}
+	/* Wait for the chunks that were pushed onto the queue, the chunk data
+	 * must not be released while a worker thread is still unpacking it
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read-ahead mutex.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	internal_handle->read_ahead_number_of_pending_chunks -= number_of_read_ahead_chunks - number_of_pushed_chunks;
 
-	if( internal_handle->file_io_pool == NULL )
+	while( internal_handle->read_ahead_number_of_pending_chunks > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+		if( libcthreads_condition_wait(
+		     internal_handle->read_ahead_condition,
+		     internal_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for read-ahead condition.",
+			 function );
 
-		return( -1 );
+			libcthreads_mutex_release(
+			 internal_handle->read_ahead_mutex,
+			 NULL );
+
+			return( -1 );
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read-ahead mutex.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
+	return( result );
+}
 
-	if( read_count < 0 )
+/* Frees the read-ahead thread pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_free_read_ahead_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_free_read_ahead_thread_pool";
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->read_ahead_thread_pool != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->read_ahead_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read-ahead thread pool.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		internal_handle->read_ahead_thread_pool_number_of_threads = 0;
 	}
-#endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Writes a (media) data chunk at the current offset
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads ahead chunks if the (media) data is read sequentially
+ * The chunks are read, unpacked, using multiple threads if available, and stored in the chunks cache
  * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ * Returns 1 if chunks were read ahead, 0 if not or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_internal_handle_read_ahead_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size      = 0;
-	ssize_t write_count   = 0;
-	int chunk_exists      = 0;
+	libewf_chunk_data_t **chunks_data          = NULL;
+	libewf_read_ahead_chunk_t *read_ahead_chunks = NULL;
+	uint64_t *chunk_indexes                    = NULL;
+	static char *function                      = "libewf_internal_handle_read_ahead_from_file_io_pool";
+	uint64_t end_chunk_index                   = 0;
+	int chunks_data_index                      = 0;
+	int maximum_number_of_chunks               = 0;
+	int number_of_chunks_data                  = 0;
+	int number_of_chunks_read                  = 0;
+	int result                                 = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5743,189 +6892,297 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( ( internal_handle->read_ahead_depth <= 0 )
+	 || ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		return( 0 );
+	}
+	if( ( chunk_index != internal_handle->read_ahead_last_chunk_index )
+	 && ( chunk_index != ( internal_handle->read_ahead_last_chunk_index + 1 ) ) )
+	{
+		/* The access is not sequential restart the read-ahead
+		 */
+		internal_handle->read_ahead_last_chunk_index = chunk_index;
+		internal_handle->read_ahead_end_chunk_index  = chunk_index;
 
-		return( -1 );
+		return( 0 );
 	}
-	if( internal_handle->media_values == NULL )
+	internal_handle->read_ahead_last_chunk_index = chunk_index;
+
+	if( internal_handle->read_ahead_end_chunk_index < chunk_index )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		internal_handle->read_ahead_end_chunk_index = chunk_index;
+	}
+	/* Only read ahead once half of the read-ahead chunks have been consumed
+	 */
+	if( ( internal_handle->read_ahead_end_chunk_index - chunk_index ) > (uint64_t) ( internal_handle->read_ahead_depth / 2 ) )
+	{
+		return( 0 );
+	}
+	end_chunk_index = chunk_index + internal_handle->read_ahead_depth;
 
-		return( -1 );
+	if( end_chunk_index > internal_handle->media_values->number_of_chunks )
+	{
+		end_chunk_index = internal_handle->media_values->number_of_chunks;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->read_ahead_end_chunk_index >= end_chunk_index )
+	{
+		return( 0 );
+	}
+	maximum_number_of_chunks = (int) ( end_chunk_index - internal_handle->read_ahead_end_chunk_index );
+
+	chunks_data = (libewf_chunk_data_t **) memory_allocate(
+	                                        sizeof( libewf_chunk_data_t * ) * maximum_number_of_chunks );
+
+	if( chunks_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle == NULL )
+	chunk_indexes = (uint64_t *) memory_allocate(
+	                              sizeof( uint64_t ) * maximum_number_of_chunks );
+
+	if( chunk_indexes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk indexes.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_data_chunk == NULL )
+	read_ahead_chunks = (libewf_read_ahead_chunk_t *) memory_allocate(
+	                                                   sizeof( libewf_read_ahead_chunk_t ) * maximum_number_of_chunks );
+
+	if( read_ahead_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead chunks.",
 		 function );
 
-		return( -1 );
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
+		goto on_error;
 	}
-	data_size = internal_data_chunk->data_size;
+	result = libewf_chunk_table_read_ahead_chunks_by_offset(
+	          internal_handle->chunk_table,
+	          internal_handle->read_ahead_end_chunk_index,
+	          internal_handle->io_handle,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          internal_handle->chunks_cache,
+	          (off64_t) internal_handle->read_ahead_end_chunk_index * internal_handle->media_values->chunk_size,
+	          maximum_number_of_chunks,
+	          chunks_data,
+	          chunk_indexes,
+	          &number_of_chunks_data,
+	          &number_of_chunks_read,
+	          error );
 
-	if( internal_handle->media_values->media_size != 0 )
+	if( result == -1 )
 	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		/* Errors are not propagated since the chunks are read again when needed
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+	}
+	/* Make sure the read-ahead progresses if no chunks could be read
+	 */
+	if( number_of_chunks_read == 0 )
+	{
+		number_of_chunks_read = 1;
+	}
+	internal_handle->read_ahead_end_chunk_index += number_of_chunks_read;
+
+	for( chunks_data_index = 0;
+	     chunks_data_index < number_of_chunks_data;
+	     chunks_data_index++ )
+	{
+		read_ahead_chunks[ chunks_data_index ].chunk_data = chunks_data[ chunks_data_index ];
+		read_ahead_chunks[ chunks_data_index ].result     = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->read_ahead_number_of_threads > 1 )
+	 && ( number_of_chunks_data > 1 ) )
+	{
+		if( libewf_internal_handle_read_ahead_unpack_chunks(
+		     internal_handle,
+		     read_ahead_chunks,
+		     number_of_chunks_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack read-ahead chunks.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
+	else
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+	{
+		for( chunks_data_index = 0;
+		     chunks_data_index < number_of_chunks_data;
+		     chunks_data_index++ )
+		{
+			read_ahead_chunks[ chunks_data_index ].result = libewf_internal_handle_read_ahead_unpack_chunk_data(
+			                                                 chunks_data[ chunks_data_index ],
+			                                                 internal_handle->io_handle );
+		}
+	}
+	for( chunks_data_index = 0;
+	     chunks_data_index < number_of_chunks_data;
+	     chunks_data_index++ )
+	{
+		/* Chunk data that could not be unpacked is not cached
+		 * so that the chunk is read again when it is needed
+		 */
+		if( read_ahead_chunks[ chunks_data_index ].result != 1 )
+		{
+			if( libewf_chunk_data_free(
+			     &( chunks_data[ chunks_data_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_indexes[ chunks_data_index ] );
 
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
+				goto on_error;
+			}
+			continue;
+		}
+		/* The chunks cache takes over management of the chunk data
+		 */
+		result = libewf_chunk_table_cache_chunk_data(
+		          internal_handle->chunk_table,
+		          internal_handle->chunks_cache,
+		          chunk_indexes[ chunks_data_index ],
+		          chunks_data[ chunks_data_index ],
+		          error );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 internal_handle->current_chunk_index,
-		 data_size );
+		chunks_data[ chunks_data_index ] = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to cache chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_indexes[ chunks_data_index ] );
+
+			goto on_error;
+		}
 	}
-#endif
-	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-	                internal_handle->chunk_table,
-	                internal_handle->current_chunk_index,
-	                file_io_pool,
-	                internal_handle->segment_table,
-	                internal_handle->chunk_groups_cache,
-	                internal_handle->current_offset,
-			error );
+	memory_free(
+	 read_ahead_chunks );
 
-	if( chunk_exists == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+	memory_free(
+	 chunk_indexes );
 
-		return( -1 );
+	memory_free(
+	 chunks_data );
+
+	return( 1 );
+
+on_error:
+	if( read_ahead_chunks != NULL )
+	{
+		memory_free(
+		 read_ahead_chunks );
 	}
-	else if( chunk_exists != 0 )
+	if( chunks_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 internal_handle->current_chunk_index );
-
-		return( -1 );
+		for( chunks_data_index = 0;
+		     chunks_data_index < number_of_chunks_data;
+		     chunks_data_index++ )
+		{
+			if( chunks_data[ chunks_data_index ] != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( chunks_data[ chunks_data_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 chunks_data );
 	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               internal_handle->current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
+	if( chunk_indexes != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
-
-		return( -1 );
+		memory_free(
+		 chunk_indexes );
 	}
-	internal_handle->current_offset += (off64_t) data_size;
-
-	return( write_count );
+	return( -1 );
 }
 
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Reads (media) data of an uncompressed chunk directly from the memory mapped segment file
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk cannot be read from a memory map or -1 on error
  */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_internal_handle_read_mapped_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_count,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
+	libewf_memory_map_t *memory_map = NULL;
+	const uint8_t *mapped_data      = NULL;
+	static char *function           = "libewf_internal_handle_read_mapped_chunk_data";
+	size64_t chunk_data_size        = 0;
+	off64_t chunk_data_offset       = 0;
+	off64_t chunk_offset            = 0;
+	size_t read_size                = 0;
+	uint32_t calculated_checksum    = 0;
+	uint32_t chunk_data_flags       = 0;
+	uint32_t stored_checksum        = 0;
+	int file_io_pool_entry          = 0;
+	int number_of_memory_maps       = 0;
+	int result                      = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5936,145 +7193,326 @@ ssize_t libewf_handle_write_data_chunk(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
-
-	if( write_count < 0 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
-		write_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( read_count == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( write_count );
-}
+	*read_count = 0;
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libcerror_error_t **error )
-{
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int chunk_exists                    = 0;
-	int file_io_pool_entry              = -1;
+	if( ( internal_handle->memory_maps == NULL )
+	 || ( internal_handle->io_handle->is_encrypted != 0 ) )
+	{
+		return( 0 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
 
-	if( internal_handle == NULL )
+	if( ( internal_handle->current_offset < chunk_offset )
+	 || ( internal_handle->current_offset >= ( chunk_offset + internal_handle->media_values->chunk_size ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          internal_handle->current_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	else if( result == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		return( 0 );
+	}
+	/* Only uncompressed chunks can be copied directly from the memory map
+	 */
+	if( ( chunk_data_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != 0 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->memory_maps,
+	     &number_of_memory_maps,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of memory maps.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= number_of_memory_maps ) )
 	{
-		if( internal_handle->chunk_data != NULL )
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_handle->memory_maps,
+	     file_io_pool_entry,
+	     (intptr_t **) &memory_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve memory map: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( memory_map == NULL )
+	{
+		return( 0 );
+	}
+	result = libewf_memory_map_get_data(
+	          memory_map,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          &mapped_data,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from memory map: %d.",
+			 function,
+			 chunk_index,
+			 file_io_pool_entry );
+		}
+		return( result );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( chunk_data_size < 4 )
+		{
+			return( 0 );
+		}
+		chunk_data_size -= 4;
 
-			return( -1 );
+		if( ( internal_handle->io_handle->verify_checksums != 0 )
+		 && ( ( internal_handle->verified_mapped_chunk_index_set == 0 )
+		  ||  ( internal_handle->verified_mapped_chunk_index != chunk_index ) ) )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( mapped_data[ chunk_data_size ] ),
+			 stored_checksum );
+
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     mapped_data,
+			     (size_t) chunk_data_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			/* Let the regular read path handle the checksum mismatch
+			 */
+			if( stored_checksum != calculated_checksum )
+			{
+				return( 0 );
+			}
+			internal_handle->verified_mapped_chunk_index     = chunk_index;
+			internal_handle->verified_mapped_chunk_index_set = 1;
 		}
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( chunk_data_size > (size64_t) internal_handle->media_values->chunk_size )
+	{
+		return( 0 );
+	}
+	chunk_offset = internal_handle->current_offset - chunk_offset;
+
+	if( (size64_t) chunk_offset >= chunk_data_size )
+	{
+		return( 0 );
+	}
+	read_size = (size_t) ( chunk_data_size - chunk_offset );
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	if( memory_copy(
+	     buffer,
+	     &( mapped_data[ chunk_offset ] ),
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_offset == 0 )
+	{
+		if( internal_handle->statistics != NULL )
+		{
+			if( libewf_statistics_add(
+			     internal_handle->statistics,
+			     LIBEWF_STATISTIC_CHUNKS_READ,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	*read_count = read_size;
+
+	return( 1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	uint64_t chunk_index            = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	ssize_t total_read_count        = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -6101,425 +7539,5972 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
+	if( buffer == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
 	{
 		return( 0 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
 
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-				internal_handle->chunk_table,
-				chunk_index,
-				file_io_pool,
-				internal_handle->segment_table,
-				internal_handle->chunk_groups_cache,
-				internal_handle->current_offset,
-				error );
+	while( buffer_size > 0 )
+	{
+		result = libewf_internal_handle_read_mapped_chunk_data(
+		          internal_handle,
+		          file_io_pool,
+		          chunk_index,
+		          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		          buffer_size,
+		          &read_size,
+		          error );
 
-		if( chunk_exists == -1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " from memory map.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		if( chunk_exists != 0 )
+		else if( result != 0 )
+		{
+			buffer_offset    += read_size;
+			buffer_size      -= read_size;
+			total_read_count += (ssize_t) read_size;
+			chunk_index      += 1;
+
+			internal_handle->current_offset += (off64_t) read_size;
+
+			if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			continue;
+		}
+		if( libewf_internal_handle_read_ahead_from_file_io_pool(
+		     internal_handle,
+		     file_io_pool,
+		     chunk_index,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ahead from chunk: %" PRIu64 ".",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
+		if( libewf_chunk_table_get_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     chunk_index,
 		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->chunk_groups_cache,
+		     internal_handle->chunks_cache,
+		     internal_handle->current_offset,
+		     &chunk_data,
+		     &chunk_data_offset,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
+		if( chunk_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
 			return( -1 );
 		}
-		write_finalize_count += write_count;
-
-		if( libfcache_cache_set_value_by_index(
-		     internal_handle->chunks_cache,
-		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-		     0,
-		     internal_handle->current_offset,
-		     0,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		/* chunks_cache takes over management of chunk_data
-		 */
-		internal_handle->chunk_data = NULL;
-	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
-	{
-		return( write_finalize_count );
-	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
-		 function );
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
 
-		return( -1 );
-	}
-	if( number_of_segments == 0 )
-	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
+		if( read_size > buffer_size )
 		{
-			return( write_finalize_count );
+			read_size = buffer_size;
 		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
+		if( read_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
 
 			return( -1 );
 		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		chunk_index      += 1;
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+		internal_handle->current_offset += (off64_t) read_size;
 
-			return( -1 );
+		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+		{
+			break;
 		}
-		write_finalize_count += write_count;
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+		chunk_data        = NULL;
+		chunk_data_offset = 0;
 	}
-	else
+	if( internal_handle->statistics != NULL )
 	{
-		segment_number = number_of_segments - 1;
-
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
+		if( libewf_statistics_add(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTIC_BYTES_READ,
+		     (uint64_t) total_read_count,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
 
 			return( -1 );
 		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+	}
+	return( total_read_count );
+}
 
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
 
-			return( -1 );
-		}
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
 
-			return( -1 );
-		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               segment_file,
-			               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads and unpacks chunk data for concurrent access
+ * The chunk table is only accessed while holding the chunk table mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_chunk_data_concurrent(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_internal_handle_read_chunk_data_concurrent";
+	int result                           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libewf_chunk_table_read_chunk_data_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->io_handle,
+	          file_io_pool,
+	          internal_handle->media_values,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &safe_chunk_data,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* Unpack outside the chunk table mutex so that chunks are unpacked in parallel
+	 */
+	if( libewf_chunk_data_unpack(
+	     safe_chunk_data,
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libewf_chunk_table_append_chunk_checksum_error(
+		          internal_handle->chunk_table,
+		          chunk_index,
+		          internal_handle->media_values,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+			 function,
+			 chunk_index );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The current offset is not used nor changed, the chunks are cached in the concurrent chunks cache
+ * The chunk table, chunk groups cache and file IO pool are only accessed while holding
+ * the chunk table mutex, unpacking and copying the chunk data is done without it
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_at_offset_concurrent";
+	off64_t chunk_data_offset       = 0;
+	uint64_t chunk_index            = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	size_t value_size               = 0;
+	ssize_t total_read_count        = 0;
+	uint8_t chunk_is_cached         = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: concurrent reads not supported in write mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->concurrent_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing concurrent chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+
+	while( buffer_size > 0 )
+	{
+		chunk_data_offset = offset - ( (off64_t) chunk_index * internal_handle->media_values->chunk_size );
+
+		result = libewf_sharded_cache_grab_value(
+		          internal_handle->concurrent_chunks_cache,
+		          chunk_index,
+		          (intptr_t **) &chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		chunk_is_cached = (uint8_t) result;
+
+		if( chunk_is_cached == 0 )
+		{
+			if( libewf_internal_handle_read_chunk_data_concurrent(
+			     internal_handle,
+			     file_io_pool,
+			     chunk_index,
+			     offset,
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( read_size > 0 )
+		{
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( chunk_is_cached != 0 )
+		{
+			chunk_data      = NULL;
+			chunk_is_cached = 0;
+
+			if( libewf_sharded_cache_release_value(
+			     internal_handle->concurrent_chunks_cache,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk: %" PRIu64 " data in cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			value_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+			if( chunk_data->compressed_data != NULL )
+			{
+				value_size += chunk_data->compressed_data_size;
+			}
+			/* The concurrent chunks cache takes over management of the chunk data
+			 */
+			result = libewf_sharded_cache_set_value(
+			          internal_handle->concurrent_chunks_cache,
+			          chunk_index,
+			          (intptr_t *) chunk_data,
+			          value_size,
+			          error );
+
+			chunk_data = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to cache chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		offset           += (off64_t) read_size;
+		chunk_index      += 1;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTIC_BYTES_READ,
+		     (uint64_t) total_read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( total_read_count );
+
+on_error:
+	if( chunk_is_cached != 0 )
+	{
+		libewf_sharded_cache_release_value(
+		 internal_handle->concurrent_chunks_cache,
+		 chunk_index,
+		 NULL );
+	}
+	else if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset
+ * Unlike libewf_handle_read_buffer_at_offset the current offset is not changed and
+ * multiple threads can read from the same handle at the same time
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset_concurrent";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_concurrent(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Compares two vectored read segments by their chunk index
+ * If the chunk indexes are equal the buffer indexes are compared
+ * Returns -1 if the first is less than the second, 0 if equal or 1 if greater
+ */
+int libewf_read_vector_segment_compare(
+     const libewf_read_vector_segment_t *first_segment,
+     const libewf_read_vector_segment_t *second_segment )
+{
+	if( first_segment->chunk_index < second_segment->chunk_index )
+	{
+		return( -1 );
+	}
+	else if( first_segment->chunk_index > second_segment->chunk_index )
+	{
+		return( 1 );
+	}
+	if( first_segment->buffer_index < second_segment->buffer_index )
+	{
+		return( -1 );
+	}
+	else if( first_segment->buffer_index > second_segment->buffer_index )
+	{
+		return( 1 );
+	}
+	if( first_segment->buffer_offset < second_segment->buffer_offset )
+	{
+		return( -1 );
+	}
+	else if( first_segment->buffer_offset > second_segment->buffer_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads and unpacks the chunk data of a vectored read chunk
+ * Callback function for the thread pool, errors are not propagated
+ * since the chunk data is read again by the calling thread when missing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_vector_chunk_callback(
+     libewf_read_vector_chunk_t *vector_chunk,
+     void *arguments LIBEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+
+	LIBEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( vector_chunk == NULL )
+	{
+		return( -1 );
+	}
+	if( vector_chunk->internal_handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_internal_handle_read_chunk_data_concurrent(
+	     vector_chunk->internal_handle,
+	     vector_chunk->file_io_pool,
+	     vector_chunk->chunk_index,
+	     (off64_t) vector_chunk->chunk_index * vector_chunk->internal_handle->media_values->chunk_size,
+	     &( vector_chunk->chunk_data ),
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of the chunks of a vectored read
+ * The chunk data is pinned in the concurrent chunks cache, chunks that are not cached
+ * are read and unpacked, using multiple threads if available, and added to the cache
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_vector_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_read_vector_chunk_t *vector_chunks,
+     int number_of_vector_chunks,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_vector_chunks";
+	size_t value_size               = 0;
+	int number_of_uncached_chunks   = 0;
+	int result                      = 0;
+	int vector_chunk_index          = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( vector_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector chunks.",
+		 function );
+
+		return( -1 );
+	}
+	for( vector_chunk_index = 0;
+	     vector_chunk_index < number_of_vector_chunks;
+	     vector_chunk_index++ )
+	{
+		result = libewf_sharded_cache_pin_value(
+		          internal_handle->concurrent_chunks_cache,
+		          vector_chunks[ vector_chunk_index ].chunk_index,
+		          (intptr_t **) &( vector_chunks[ vector_chunk_index ].chunk_data ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pin chunk: %" PRIu64 " data in cache.",
+			 function,
+			 vector_chunks[ vector_chunk_index ].chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			vector_chunks[ vector_chunk_index ].is_pinned = 1;
+		}
+		else
+		{
+			vector_chunks[ vector_chunk_index ].chunk_data = NULL;
+
+			number_of_uncached_chunks++;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > number_of_uncached_chunks )
+	{
+		number_of_threads = number_of_uncached_chunks;
+	}
+	if( number_of_threads > 1 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_uncached_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_internal_handle_read_vector_chunk_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( vector_chunk_index = 0;
+		     vector_chunk_index < number_of_vector_chunks;
+		     vector_chunk_index++ )
+		{
+			if( vector_chunks[ vector_chunk_index ].is_pinned != 0 )
+			{
+				continue;
+			}
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( vector_chunks[ vector_chunk_index ] ),
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " onto queue.",
+				 function,
+				 vector_chunks[ vector_chunk_index ].chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	for( vector_chunk_index = 0;
+	     vector_chunk_index < number_of_vector_chunks;
+	     vector_chunk_index++ )
+	{
+		if( vector_chunks[ vector_chunk_index ].is_pinned != 0 )
+		{
+			continue;
+		}
+		if( vector_chunks[ vector_chunk_index ].chunk_data == NULL )
+		{
+			if( libewf_internal_handle_read_chunk_data_concurrent(
+			     internal_handle,
+			     file_io_pool,
+			     vector_chunks[ vector_chunk_index ].chunk_index,
+			     (off64_t) vector_chunks[ vector_chunk_index ].chunk_index * internal_handle->media_values->chunk_size,
+			     &( vector_chunks[ vector_chunk_index ].chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 vector_chunks[ vector_chunk_index ].chunk_index );
+
+				goto on_error;
+			}
+		}
+		chunk_data = vector_chunks[ vector_chunk_index ].chunk_data;
+
+		value_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+		if( chunk_data->compressed_data != NULL )
+		{
+			value_size += chunk_data->compressed_data_size;
+		}
+		/* The concurrent chunks cache takes over management of the chunk data
+		 */
+		result = libewf_sharded_cache_set_and_pin_value(
+		          internal_handle->concurrent_chunks_cache,
+		          vector_chunks[ vector_chunk_index ].chunk_index,
+		          (intptr_t **) &( vector_chunks[ vector_chunk_index ].chunk_data ),
+		          value_size,
+		          error );
+
+		if( result != 1 )
+		{
+			vector_chunks[ vector_chunk_index ].chunk_data = NULL;
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to cache chunk: %" PRIu64 " data.",
+			 function,
+			 vector_chunks[ vector_chunk_index ].chunk_index );
+
+			goto on_error;
+		}
+		vector_chunks[ vector_chunk_index ].is_pinned = 1;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Reads (media) data at multiple offsets into multiple buffers using a Basic File IO (bfio) pool
+ * The reads are split into segments per chunk and sorted by chunk, so that every chunk
+ * is read and unpacked only once and the chunks are read in order
+ * The current offset is not used nor changed, the chunks are cached in the concurrent chunks cache
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         int number_of_buffers,
+         int number_of_threads,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                = NULL;
+	libewf_read_vector_chunk_t *vector_chunks      = NULL;
+	libewf_read_vector_segment_t *segments         = NULL;
+	static char *function                          = "libewf_internal_handle_read_vector";
+	size64_t chunk_size                            = 0;
+	size_t buffer_offset                           = 0;
+	size_t read_size                               = 0;
+	size_t size                                    = 0;
+	ssize_t total_read_count                       = 0;
+	uint64_t chunk_index                           = 0;
+	uint64_t last_chunk_index                      = 0;
+	uint64_t number_of_segments                    = 0;
+	off64_t offset                                 = 0;
+	int buffer_index                               = 0;
+	int number_of_vector_chunks                    = 0;
+	int segment_index                              = 0;
+	int first_segment_index                        = 0;
+	int vector_chunk_index                         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: vectored reads not supported in write mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->concurrent_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing concurrent chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size = internal_handle->media_values->chunk_size;
+
+	/* Determine the number of segments
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		offset = offsets[ buffer_index ];
+		size   = buffer_sizes[ buffer_index ];
+
+		if( size == 0 )
+		{
+			continue;
+		}
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid offset: %d value less than zero.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
+		{
+			continue;
+		}
+		if( (size64_t) size > ( internal_handle->media_values->media_size - offset ) )
+		{
+			size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+		chunk_index      = (uint64_t) offset / chunk_size;
+		last_chunk_index = ( (uint64_t) offset + size - 1 ) / chunk_size;
+
+		number_of_segments += last_chunk_index - chunk_index + 1;
+	}
+	if( number_of_segments == 0 )
+	{
+		return( 0 );
+	}
+	if( ( number_of_segments > (uint64_t) INT_MAX )
+	 || ( number_of_segments > (uint64_t) ( SSIZE_MAX / sizeof( libewf_read_vector_segment_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segments value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	segments = (libewf_read_vector_segment_t *) memory_allocate(
+	                                             sizeof( libewf_read_vector_segment_t ) * (size_t) number_of_segments );
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	vector_chunks = (libewf_read_vector_chunk_t *) memory_allocate(
+	                                                sizeof( libewf_read_vector_chunk_t ) * LIBEWF_READ_VECTOR_MAXIMUM_NUMBER_OF_CHUNKS );
+
+	if( vector_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create vector chunks.",
+		 function );
+
+		goto on_error;
+	}
+	/* Split the buffers into segments per chunk
+	 */
+	segment_index = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		offset = offsets[ buffer_index ];
+		size   = buffer_sizes[ buffer_index ];
+
+		if( ( size == 0 )
+		 || ( (size64_t) offset >= internal_handle->media_values->media_size ) )
+		{
+			continue;
+		}
+		if( (size64_t) size > ( internal_handle->media_values->media_size - offset ) )
+		{
+			size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+		buffer_offset = 0;
+
+		while( size > 0 )
+		{
+			chunk_index = (uint64_t) offset / chunk_size;
+
+			segments[ segment_index ].chunk_index       = chunk_index;
+			segments[ segment_index ].chunk_data_offset = (size_t) ( (uint64_t) offset - ( chunk_index * chunk_size ) );
+			segments[ segment_index ].buffer_index      = buffer_index;
+			segments[ segment_index ].buffer_offset     = buffer_offset;
+
+			read_size = (size_t) ( chunk_size - segments[ segment_index ].chunk_data_offset );
+
+			if( read_size > size )
+			{
+				read_size = size;
+			}
+			segments[ segment_index ].size = read_size;
+
+			buffer_offset += read_size;
+			offset        += (off64_t) read_size;
+			size          -= read_size;
+
+			segment_index++;
+		}
+	}
+	qsort(
+	 segments,
+	 (size_t) number_of_segments,
+	 sizeof( libewf_read_vector_segment_t ),
+	 (int (*)(const void *, const void *)) &libewf_read_vector_segment_compare );
+
+	segment_index = 0;
+
+	while( segment_index < (int) number_of_segments )
+	{
+		/* Determine the next set of chunks
+		 */
+		first_segment_index     = segment_index;
+		number_of_vector_chunks = 0;
+
+		while( segment_index < (int) number_of_segments )
+		{
+			if( ( number_of_vector_chunks == 0 )
+			 || ( segments[ segment_index ].chunk_index != vector_chunks[ number_of_vector_chunks - 1 ].chunk_index ) )
+			{
+				if( number_of_vector_chunks >= LIBEWF_READ_VECTOR_MAXIMUM_NUMBER_OF_CHUNKS )
+				{
+					break;
+				}
+				vector_chunks[ number_of_vector_chunks ].internal_handle = internal_handle;
+				vector_chunks[ number_of_vector_chunks ].file_io_pool    = file_io_pool;
+				vector_chunks[ number_of_vector_chunks ].chunk_index     = segments[ segment_index ].chunk_index;
+				vector_chunks[ number_of_vector_chunks ].chunk_data      = NULL;
+				vector_chunks[ number_of_vector_chunks ].is_pinned       = 0;
+
+				number_of_vector_chunks++;
+			}
+			segment_index++;
+		}
+		if( libewf_internal_handle_read_vector_chunks(
+		     internal_handle,
+		     file_io_pool,
+		     vector_chunks,
+		     number_of_vector_chunks,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks.",
+			 function );
+
+			goto on_error;
+		}
+		/* Copy the chunk data of the segments into the buffers
+		 */
+		vector_chunk_index = 0;
+
+		while( first_segment_index < segment_index )
+		{
+			while( vector_chunks[ vector_chunk_index ].chunk_index != segments[ first_segment_index ].chunk_index )
+			{
+				vector_chunk_index++;
+			}
+			chunk_data = vector_chunks[ vector_chunk_index ].chunk_data;
+
+			read_size = 0;
+
+			if( segments[ first_segment_index ].chunk_data_offset < chunk_data->data_size )
+			{
+				read_size = chunk_data->data_size - segments[ first_segment_index ].chunk_data_offset;
+
+				if( read_size > segments[ first_segment_index ].size )
+				{
+					read_size = segments[ first_segment_index ].size;
+				}
+			}
+			if( read_size > 0 )
+			{
+				buffer_index = segments[ first_segment_index ].buffer_index;
+
+				if( memory_copy(
+				     &( ( (uint8_t *) buffers[ buffer_index ] )[ segments[ first_segment_index ].buffer_offset ] ),
+				     &( ( chunk_data->data )[ segments[ first_segment_index ].chunk_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer: %d.",
+					 function,
+					 segments[ first_segment_index ].chunk_index,
+					 buffer_index );
+
+					goto on_error;
+				}
+			}
+			total_read_count += (ssize_t) read_size;
+
+			first_segment_index++;
+		}
+		for( vector_chunk_index = 0;
+		     vector_chunk_index < number_of_vector_chunks;
+		     vector_chunk_index++ )
+		{
+			vector_chunks[ vector_chunk_index ].chunk_data = NULL;
+			vector_chunks[ vector_chunk_index ].is_pinned  = 0;
+
+			if( libewf_sharded_cache_unpin_value(
+			     internal_handle->concurrent_chunks_cache,
+			     vector_chunks[ vector_chunk_index ].chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to unpin chunk: %" PRIu64 " data in cache.",
+				 function,
+				 vector_chunks[ vector_chunk_index ].chunk_index );
+
+				goto on_error;
+			}
+		}
+		number_of_vector_chunks = 0;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTIC_BYTES_READ,
+		     (uint64_t) total_read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 vector_chunks );
+
+	memory_free(
+	 segments );
+
+	return( total_read_count );
+
+on_error:
+	if( vector_chunks != NULL )
+	{
+		for( vector_chunk_index = 0;
+		     vector_chunk_index < number_of_vector_chunks;
+		     vector_chunk_index++ )
+		{
+			if( vector_chunks[ vector_chunk_index ].is_pinned != 0 )
+			{
+				libewf_sharded_cache_unpin_value(
+				 internal_handle->concurrent_chunks_cache,
+				 vector_chunks[ vector_chunk_index ].chunk_index,
+				 NULL );
+			}
+			else if( vector_chunks[ vector_chunk_index ].chunk_data != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( vector_chunks[ vector_chunk_index ].chunk_data ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 vector_chunks );
+	}
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at multiple offsets into multiple buffers
+ * Unlike libewf_handle_read_buffer_at_offset the current offset is not changed and
+ * multiple threads can read from the same handle at the same time
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         void **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         int number_of_buffers,
+         int number_of_threads,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_vector";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_vector(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffers,
+	              buffer_sizes,
+	              offsets,
+	              number_of_buffers,
+	              number_of_threads,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vector.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Determines if a chunk is filled with the same byte value
+ * The chunk is only unpacked if it uses pattern fill or has a small compressed size
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns 1 if the chunk is filled, 0 if not or -1 on error
+ */
+int libewf_internal_handle_get_chunk_fill_value(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *fill_value,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data   = NULL;
+	static char *function             = "libewf_internal_handle_get_chunk_fill_value";
+	size64_t chunk_data_size          = 0;
+	size64_t maximum_compressed_size  = 0;
+	size_t value_size                 = 0;
+	off64_t chunk_data_offset         = 0;
+	off64_t chunk_offset              = 0;
+	uint32_t chunk_data_flags         = 0;
+	uint8_t chunk_is_pinned           = 0;
+	int file_io_pool_entry            = 0;
+	int result                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill value.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( ( chunk_data_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != 0 )
+	{
+		return( 0 );
+	}
+	/* A chunk filled with the same byte value either uses pattern fill
+	 * or compresses to a fraction of the chunk size
+	 */
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	{
+		if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+		{
+			return( 0 );
+		}
+		maximum_compressed_size = LIBEWF_FILL_CHUNK_MAXIMUM_COMPRESSED_SIZE_OVERHEAD
+		                        + ( internal_handle->media_values->chunk_size / LIBEWF_FILL_CHUNK_MINIMUM_COMPRESSION_RATIO );
+
+		if( chunk_data_size > maximum_compressed_size )
+		{
+			return( 0 );
+		}
+	}
+	result = libewf_sharded_cache_pin_value(
+	          internal_handle->concurrent_chunks_cache,
+	          chunk_index,
+	          (intptr_t **) &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pin chunk: %" PRIu64 " data in cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_internal_handle_read_chunk_data_concurrent(
+		     internal_handle,
+		     file_io_pool,
+		     chunk_index,
+		     chunk_offset,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		value_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+		if( chunk_data->compressed_data != NULL )
+		{
+			value_size += chunk_data->compressed_data_size;
+		}
+		/* The concurrent chunks cache takes over management of the chunk data
+		 */
+		if( libewf_sharded_cache_set_and_pin_value(
+		     internal_handle->concurrent_chunks_cache,
+		     chunk_index,
+		     (intptr_t **) &chunk_data,
+		     value_size,
+		     error ) != 1 )
+		{
+			chunk_data = NULL;
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to cache chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	chunk_is_pinned = 1;
+
+	result = 0;
+
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+	 && ( chunk_data->data_size > 0 ) )
+	{
+		result = libewf_chunk_data_check_for_empty_block(
+		          chunk_data->data,
+		          chunk_data->data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk: %" PRIu64 " data is filled.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			*fill_value = chunk_data->data[ 0 ];
+		}
+	}
+	chunk_data      = NULL;
+	chunk_is_pinned = 0;
+
+	if( libewf_sharded_cache_unpin_value(
+	     internal_handle->concurrent_chunks_cache,
+	     chunk_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unpin chunk: %" PRIu64 " data in cache.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	if( chunk_is_pinned != 0 )
+	{
+		libewf_sharded_cache_unpin_value(
+		 internal_handle->concurrent_chunks_cache,
+		 chunk_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the range of (media) data at a specific offset that consists either
+ * of chunks filled with the same byte value or of chunks that are not
+ * The chunk table is used to determine which chunks are likely filled, only those
+ * chunks are unpacked and cached in the concurrent chunks cache
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns 1 if the range is filled, 0 if not or -1 on error
+ */
+int libewf_internal_handle_get_fill_range(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t size,
+     size64_t *range_size,
+     uint8_t *fill_value,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_get_fill_range";
+	size64_t chunk_size        = 0;
+	size64_t safe_range_size   = 0;
+	uint64_t chunk_index       = 0;
+	uint8_t chunk_fill_value   = 0;
+	uint8_t safe_fill_value    = 0;
+	int is_filled              = 0;
+	int result                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: fill ranges not supported in write mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->concurrent_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing concurrent chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill value.",
+		 function );
+
+		return( -1 );
+	}
+	*range_size = 0;
+
+	if( ( size == 0 )
+	 || ( (size64_t) offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( size > ( internal_handle->media_values->media_size - offset ) )
+	{
+		size = internal_handle->media_values->media_size - offset;
+	}
+	chunk_size  = internal_handle->media_values->chunk_size;
+	chunk_index = (uint64_t) offset / chunk_size;
+
+	is_filled = libewf_internal_handle_get_chunk_fill_value(
+	             internal_handle,
+	             file_io_pool,
+	             chunk_index,
+	             &safe_fill_value,
+	             error );
+
+	if( is_filled == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " is filled.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	safe_range_size = ( ( chunk_index + 1 ) * chunk_size ) - (size64_t) offset;
+
+	while( safe_range_size < size )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+		chunk_index++;
+
+		result = libewf_internal_handle_get_chunk_fill_value(
+		          internal_handle,
+		          file_io_pool,
+		          chunk_index,
+		          &chunk_fill_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " is filled.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( result != is_filled )
+		{
+			break;
+		}
+		if( ( is_filled != 0 )
+		 && ( chunk_fill_value != safe_fill_value ) )
+		{
+			break;
+		}
+		safe_range_size += chunk_size;
+	}
+	if( safe_range_size > size )
+	{
+		safe_range_size = size;
+	}
+	*range_size = safe_range_size;
+
+	if( is_filled != 0 )
+	{
+		*fill_value = safe_fill_value;
+	}
+	return( is_filled );
+}
+
+/* Retrieves the range of (media) data at a specific offset that consists either
+ * of chunks filled with the same byte value or of chunks that are not
+ * Returns 1 if the range is filled, 0 if not or -1 on error
+ */
+int libewf_handle_get_fill_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     size64_t *range_size,
+     uint8_t *fill_value,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_fill_range";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_fill_range(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          offset,
+	          size,
+	          range_size,
+	          fill_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fill range at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a view of the (media) data of a specific chunk using a Basic File IO (bfio) pool
+ * The chunk data is pinned in the concurrent chunks cache until the view is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_chunk_view(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_get_chunk_view";
+	size_t value_size               = 0;
+	uint8_t chunk_is_pinned         = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: chunk views not supported in write mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->concurrent_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing concurrent chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= internal_handle->media_values->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_sharded_cache_pin_value(
+	          internal_handle->concurrent_chunks_cache,
+	          chunk_index,
+	          (intptr_t **) &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pin chunk: %" PRIu64 " data in cache.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_internal_handle_read_chunk_data_concurrent(
+		     internal_handle,
+		     file_io_pool,
+		     chunk_index,
+		     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		value_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+		if( chunk_data->compressed_data != NULL )
+		{
+			value_size += chunk_data->compressed_data_size;
+		}
+		/* The concurrent chunks cache takes over management of the chunk data
+		 * if another thread cached the same chunk in the mean time that chunk data is returned
+		 */
+		result = libewf_sharded_cache_set_and_pin_value(
+		          internal_handle->concurrent_chunks_cache,
+		          chunk_index,
+		          (intptr_t **) &chunk_data,
+		          value_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to cache chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	chunk_is_pinned = 1;
+
+	if( libewf_chunk_view_initialize(
+	     chunk_view,
+	     internal_handle->concurrent_chunks_cache,
+	     chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk view.",
+		 function );
+
+		goto on_error;
+	}
+	*data      = chunk_data->data;
+	*data_size = chunk_data->data_size;
+
+	return( 1 );
+
+on_error:
+	if( chunk_is_pinned != 0 )
+	{
+		libewf_sharded_cache_unpin_value(
+		 internal_handle->concurrent_chunks_cache,
+		 chunk_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a view of the (media) data of a specific chunk
+ * Unlike libewf_handle_read_buffer the data is not copied, the view references
+ * the (decompressed) chunk data in the chunks cache, which remains valid until
+ * the view is freed by libewf_chunk_view_free
+ * Chunk views must be freed before the handle is closed
+ * Multiple threads can retrieve chunk views from the same handle at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_view";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_chunk_view(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          chunk_index,
+	          data,
+	          data_size,
+	          chunk_view,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " view.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes the chunks pending to be packed using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_pending_chunks_to_file_io_pool";
+	ssize_t write_count   = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_pending_chunks(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	off64_t chunk_data_offset = 0;
+	size_t buffer_offset      = 0;
+	size_t input_data_size    = 0;
+	size_t write_size         = 0;
+	ssize_t write_count       = 0;
+	uint64_t chunk_index      = 0;
+	int result                = 0;
+	int write_chunk           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		if( chunk_index < ( internal_handle->write_io_handle->number_of_chunks_written + internal_handle->write_io_handle->number_of_pending_chunks ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already set.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->chunk_data_pool,
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+		if( ( write_chunk != 0 )
+		 && ( internal_handle->write_io_handle->maximum_number_of_pending_chunks > 0 ) )
+		{
+			/* The write IO handle takes over management of the chunk data
+			 */
+			result = libewf_write_io_handle_append_pending_chunk(
+			          internal_handle->write_io_handle,
+			          chunk_index,
+			          internal_handle->chunk_data,
+			          internal_handle->chunk_data->data_size,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk: %" PRIu64 " to pending chunks.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			internal_handle->chunk_data = NULL;
+
+			if( internal_handle->write_io_handle->number_of_pending_chunks >= internal_handle->write_io_handle->maximum_number_of_pending_chunks )
+			{
+				write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+				               internal_handle,
+				               file_io_pool,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write pending chunks.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		else if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+
+			if( libewf_chunk_data_pack(
+			     internal_handle->chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               internal_handle->chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTIC_BYTES_WRITTEN,
+		     (uint64_t) buffer_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_data_chunk_initialize(
+	     data_chunk,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	ssize_t read_count              = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->current_chunk_index,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     internal_handle->current_offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	read_count = (ssize_t) chunk_data->data_size;
+
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     internal_handle->current_chunk_index,
+	     (size_t) read_count,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += read_count;
+
+	internal_handle->current_chunk_index++;
+
+	return( read_count );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads a (media) data chunk at a specific offset using a Basic File IO (bfio) pool
+ * The current offset is not used nor changed, the chunk data is not cached
+ * The chunk table, chunk groups cache and file IO pool are only accessed while holding
+ * the chunk table mutex, unpacking the data chunk is left to the caller
+ * This function is multi-thread safe with other concurrent reads, acquire read lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_at_offset_concurrent";
+	size64_t data_size              = 0;
+	uint64_t chunk_index            = 0;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: concurrent reads not supported in write mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+	offset      = (off64_t) chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_table_read_chunk_data_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->io_handle,
+	          file_io_pool,
+	          internal_handle->media_values,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &chunk_data,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = (ssize_t) chunk_data->data_size;
+
+	/* The chunk data is not unpacked, determine the size of the media data in the chunk
+	 */
+	data_size = internal_handle->media_values->media_size - (size64_t) offset;
+
+	if( data_size > (size64_t) internal_handle->media_values->chunk_size )
+	{
+		data_size = (size64_t) internal_handle->media_values->chunk_size;
+	}
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     chunk_index,
+	     (size_t) data_size,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at a specific offset
+ * Unlike libewf_handle_read_data_chunk the current offset is not changed and
+ * multiple threads can read from the same handle at the same time
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk_at_offset_concurrent(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk_at_offset_concurrent";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_at_offset_concurrent(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+	int chunk_exists      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 internal_handle->current_chunk_index,
+		 data_size );
+	}
+#endif
+	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+	                internal_handle->chunk_table,
+	                internal_handle->current_chunk_index,
+	                file_io_pool,
+	                internal_handle->segment_table,
+	                internal_handle->chunk_groups_cache,
+	                internal_handle->current_offset,
+			error );
+
+	if( chunk_exists == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	else if( chunk_exists != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	/* A data chunk read from another handle is packed for this handle,
+	 * compatible packed chunk data is written without compressing it again
+	 */
+	if( libewf_internal_data_chunk_pack_for_write(
+	     internal_data_chunk,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               internal_handle->current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTIC_BYTES_WRITTEN,
+		     (uint64_t) data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int chunk_exists                    = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+	/* The pending chunks precede the remaining chunk data
+	 */
+	write_count = libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+	               internal_handle,
+	               file_io_pool,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+	write_finalize_count += write_count;
+
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+				internal_handle->chunk_table,
+				chunk_index,
+				file_io_pool,
+				internal_handle->segment_table,
+				internal_handle->chunk_groups_cache,
+				internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_WRITE_FAILED,
 				 "%s: unable to write chunks section end.",
 				 function );
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
-		}
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * A value of LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC sizes the number of open
+ * segment files to the observed working set within the limit of the number of open file descriptors
+ * A value of 0 represents no limit
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int file_io_pool_maximum                  = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( maximum_number_of_open_handles < 0 )
+	 && ( maximum_number_of_open_handles != LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_handle_pool != NULL )
+	{
+		result = libewf_file_handle_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_handle_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file handle pool.",
+			 function );
+		}
+	}
+	else if( internal_handle->file_io_pool != NULL )
+	{
+		/* A file IO pool that was not created inside the library is not sized
+		 * automatically, hence it is limited to the descriptor budget
+		 */
+		file_io_pool_maximum = maximum_number_of_open_handles;
+
+		if( maximum_number_of_open_handles == LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC )
+		{
+			result = libewf_file_handle_pool_get_descriptor_budget(
+			          &file_io_pool_maximum,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve descriptor budget.",
+				 function );
+			}
+		}
+		if( result == 1 )
+		{
+			result = libbfio_pool_set_maximum_number_of_open_handles(
+			          internal_handle->file_io_pool,
+			          file_io_pool_maximum,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in file IO handle.",
+				 function );
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the open file handles statistics
+ * The number of opens and closes are the number of times segment files were (re)opened and closed
+ * The statistics are only available if the segment files were opened by the library
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_open_handles_statistics(
+     libewf_handle_t *handle,
+     int *number_of_open_handles,
+     int *maximum_number_of_open_handles,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_open_handles_statistics";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file handle pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_file_handle_pool_get_statistics(
+	          internal_handle->file_handle_pool,
+	          number_of_open_handles,
+	          maximum_number_of_open_handles,
+	          number_of_opens,
+	          number_of_closes,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file handle pool statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the read-ahead
+ * The read-ahead depth is the number of chunks to read ahead when the (media) data
+ * is read sequentially, a depth of 0 disables the read-ahead
+ * The number of threads is the number of threads used to unpack the read-ahead chunks,
+ * a value of 0 or 1 unpacks the chunks in the calling thread
+ * The read-ahead thread pool is kept until the number of threads changes or the handle is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int read_ahead_depth,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( read_ahead_depth < 0 )
+	 || ( read_ahead_depth > LIBEWF_MAXIMUM_READ_AHEAD_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read-ahead depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+	internal_handle->read_ahead_depth             = read_ahead_depth;
+	internal_handle->read_ahead_number_of_threads = number_of_threads;
+	internal_handle->read_ahead_last_chunk_index  = 0;
+	internal_handle->read_ahead_end_chunk_index   = 0;
 
-		if( write_count == -1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead_thread_pool_number_of_threads != number_of_threads )
+	{
+		if( libewf_internal_handle_free_read_ahead_thread_pool(
+		     internal_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead thread pool.",
 			 function );
 
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+
 			return( -1 );
 		}
-		write_finalize_count += write_count;
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+/* Sets the lazy open
+ * When enabled a set of segment files opened for reading only has the first and last
+ * segment file read on open, the other segment files are read the first time
+ * (media) data is read from them
+ * This takes effect the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_lazy_open(
+     libewf_handle_t *handle,
+     uint8_t lazy_open,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_lazy_open";
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( lazy_open != 0 )
+	{
+		internal_handle->lazy_open = 1;
+	}
+	else
+	{
+		internal_handle->lazy_open = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the chunks cache
+ * The size is the (estimated) number of bytes of the cached chunks,
+ * least recently used chunks are evicted when the cache exceeds this size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunks_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunks_cache_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( cache_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunks_cache != NULL )
+	{
+		result = libewf_lru_cache_set_maximum_size(
+		          internal_handle->chunks_cache,
+		          cache_size,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of chunks cache.",
 			 function );
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_handle->concurrent_chunks_cache != NULL ) )
+	{
+		result = libewf_sharded_cache_set_maximum_size(
+		          internal_handle->concurrent_chunks_cache,
+		          cache_size,
+		          error );
 
-			return( -1 );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of concurrent chunks cache.",
+			 function );
 		}
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+	if( result == 1 )
+	{
+		internal_handle->maximum_chunks_cache_size = cache_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Retrieves the chunks cache statistics
+ * The statistics are the number of cache hits, misses and evictions since the handle was opened,
+ * including those of the chunks cache used by concurrent reads
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_get_chunks_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_chunks_cache_statistics";
+	uint64_t concurrent_number_of_evictions   = 0;
+	uint64_t concurrent_number_of_hits        = 0;
+	uint64_t concurrent_number_of_misses      = 0;
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6534,19 +13519,19 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->chunks_cache == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing chunks cache.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6554,30 +13539,55 @@ ssize_t libewf_handle_write_finalize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
+	if( libewf_lru_cache_get_statistics(
+	     internal_handle->chunks_cache,
+	     number_of_hits,
+	     number_of_misses,
+	     number_of_evictions,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunks cache statistics.",
 		 function );
 
-		write_count = -1;
+		result = -1;
+	}
+	else if( internal_handle->concurrent_chunks_cache != NULL )
+	{
+		if( libewf_sharded_cache_get_statistics(
+		     internal_handle->concurrent_chunks_cache,
+		     &concurrent_number_of_hits,
+		     &concurrent_number_of_misses,
+		     &concurrent_number_of_evictions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve concurrent chunks cache statistics.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			*number_of_hits      += concurrent_number_of_hits;
+			*number_of_misses    += concurrent_number_of_misses;
+			*number_of_evictions += concurrent_number_of_evictions;
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6585,28 +13595,30 @@ ssize_t libewf_handle_write_finalize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the maximum size of the chunk data pool
+ * The pool keeps freed chunk data and chunk buffers for reuse up to this size,
+ * a size of 0 disables the pool
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_chunk_data_pool_size(
+     libewf_handle_t *handle,
+     size64_t pool_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_data_pool_size";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6617,96 +13629,176 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( pool_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pool size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	if( internal_handle->chunk_data_pool != NULL )
+	{
+		result = libewf_chunk_data_pool_set_maximum_size(
+		          internal_handle->chunk_data_pool,
+		          pool_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of chunk data pool.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_chunk_data_pool_size = pool_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#endif
+	return( result );
+}
+
+/* Retrieves the chunk data pool statistics
+ * The statistics are the number of chunk data and chunk buffer allocations,
+ * the number of these reused from the pool since the handle was opened and
+ * the size of the memory currently kept in the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     size64_t *pooled_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_data_pool_statistics";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk data pool.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
 #endif
-	if( offset < 0 )
+	if( libewf_chunk_data_pool_get_statistics(
+	     internal_handle->chunk_data_pool,
+	     number_of_allocations,
+	     number_of_reuses,
+	     pooled_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data pool statistics.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	internal_handle->current_offset = offset;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-	return( offset );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the maximum size of the chunk groups cache
+ * The size is the (estimated) number of bytes of the cached chunk groups,
+ * least recently used chunk groups are evicted when the cache exceeds this size
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_set_chunk_groups_cache_size";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6721,13 +13813,13 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( cache_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -6744,23 +13836,29 @@ off64_t libewf_handle_seek_offset(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
-	}
-#endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		result = libewf_lru_cache_set_maximum_size(
+		          internal_handle->chunk_groups_cache,
+		          cache_size,
+		          error );
 
-	if( offset == -1 )
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of chunk groups cache.",
+			 function );
+		}
+	}
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		internal_handle->maximum_chunk_groups_cache_size = cache_size;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6777,19 +13875,23 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Retrieves the chunk groups cache statistics
+ * The statistics are the number of cache hits, misses and evictions since the handle was opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_get_chunk_groups_cache_statistics(
      libewf_handle_t *handle,
-     off64_t *offset,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_get_chunk_groups_cache_statistics";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6804,13 +13906,13 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( internal_handle->chunk_groups_cache == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk groups cache.",
 		 function );
 
 		return( -1 );
@@ -6830,8 +13932,22 @@ int libewf_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	if( libewf_lru_cache_get_statistics(
+	     internal_handle->chunk_groups_cache,
+	     number_of_hits,
+	     number_of_misses,
+	     number_of_evictions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk groups cache statistics.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -6847,19 +13963,28 @@ int libewf_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Retrieves the handle statistics
+ * The values are stored in order of the LIBEWF_STATISTIC_ definitions,
+ * up to number of values or LIBEWF_NUMBER_OF_STATISTICS whichever is smaller
+ * The statistics are counted since the handle was opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_get_statistics(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     uint64_t *values,
+     int number_of_values,
      libcerror_error_t **error )
 {
+	uint64_t statistic_values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	static char *function                     = "libewf_handle_get_statistics";
+	uint64_t number_of_evictions              = 0;
+	uint64_t number_of_hits                   = 0;
+	uint64_t number_of_misses                 = 0;
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -6875,8 +14000,30 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6884,35 +14031,116 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
+	if( libewf_statistics_get_values(
+	     internal_handle->statistics,
+	     statistic_values,
+	     LIBEWF_NUMBER_OF_STATISTICS,
+	     error ) != 1 )
 	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
 
-		if( result != 1 )
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		/* The segment table counts every segment file lookup as a hit
+		 */
+		if( statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_HITS ] > statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_MISSES ] )
+		{
+			statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_HITS ] -= statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_MISSES ];
+		}
+		else
+		{
+			statistic_values[ LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_HITS ] = 0;
+		}
+		if( internal_handle->chunks_cache != NULL )
+		{
+			if( libewf_lru_cache_get_statistics(
+			     internal_handle->chunks_cache,
+			     &number_of_hits,
+			     &number_of_misses,
+			     &number_of_evictions,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunks cache statistics.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				statistic_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_HITS ]   += number_of_hits;
+				statistic_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ] += number_of_misses;
+			}
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_handle->concurrent_chunks_cache != NULL ) )
+	{
+		if( libewf_sharded_cache_get_statistics(
+		     internal_handle->concurrent_chunks_cache,
+		     &number_of_hits,
+		     &number_of_misses,
+		     &number_of_evictions,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve concurrent chunks cache statistics.",
 			 function );
+
+			result = -1;
+		}
+		else
+		{
+			statistic_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_HITS ]   += number_of_hits;
+			statistic_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ] += number_of_misses;
 		}
 	}
-	if( result == 1 )
+	if( ( result == 1 )
+	 && ( internal_handle->chunk_groups_cache != NULL ) )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		if( libewf_lru_cache_get_statistics(
+		     internal_handle->chunk_groups_cache,
+		     &number_of_hits,
+		     &number_of_misses,
+		     &number_of_evictions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk groups cache statistics.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			statistic_values[ LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_HITS ]   += number_of_hits;
+			statistic_values[ LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_MISSES ] += number_of_misses;
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6920,13 +14148,35 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( number_of_values > LIBEWF_NUMBER_OF_STATISTICS )
+	{
+		number_of_values = LIBEWF_NUMBER_OF_STATISTICS;
+	}
+	if( memory_copy(
+	     values,
+	     statistic_values,
+	     sizeof( uint64_t ) * (size_t) number_of_values ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Determine if the segment files are corrupted
@@ -7742,6 +14992,92 @@ int libewf_handle_set_maximum_segment_size(
 	return( result );
 }
 
+/* Sets the number of threads used to pack (compress) chunks when writing
+ * The chunks are packed in parallel and written in order, a value of 0 or 1
+ * packs the chunks in the calling thread, which is the default
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_compression_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: number of compression threads cannot be changed.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_write_io_handle_set_number_of_compression_threads(
+	          internal_handle->write_io_handle,
+	          number_of_threads,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of compression threads.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the filename size of the segment file of the current chunk
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
@@ -8189,6 +15525,7 @@ int libewf_internal_handle_get_file_io_handle(
 	result = libewf_segment_table_get_segment_at_offset(
 	          internal_handle->segment_table,
 	          internal_handle->current_offset,
+	          internal_handle->file_io_pool,
 	          &file_io_pool_entry,
 	          &segment_file_size,
 	          error );
@@ -8355,8 +15692,11 @@ int libewf_internal_handle_get_media_values(
 	sector_data_size  = internal_handle->media_values->number_of_sectors;
 	sector_data_size *= internal_handle->media_values->bytes_per_sector;
 
+	/* Reading the last chunk would require all segments to be mapped
+	 */
 	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+	 && ( ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND ) == 0 ) )
 	{
 		if( internal_handle->media_values->number_of_chunks > 0 )
 		{
@@ -8876,6 +16216,20 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_handle->single_files,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read single file sub entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
 			  node,
 			  utf8_string_segment,
@@ -9161,6 +16515,20 @@ int libewf_internal_handle_get_file_entry_by_utf16_path(
 
 			return( -1 );
 		}
+		if( libewf_single_files_read_sub_file_entries(
+		     internal_handle->single_files,
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read single file sub entries.",
+			 function );
+
+			return( -1 );
+		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
 			  node,
 			  utf16_string_segment,
@@ -26,11 +26,14 @@
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
+#include "libewf_file_handle_pool.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -39,10 +42,14 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
+#include "libewf_lru_cache.h"
 #include "libewf_media_values.h"
+#include "libewf_memory_map.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
+#include "libewf_sharded_cache.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
 
@@ -94,6 +101,11 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The file handle pool that keeps the frequently used segment files open
+	 * the file handle pool is only used if the file IO pool was created inside the library
+	 */
+	libewf_file_handle_pool_t *file_handle_pool;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -112,11 +124,64 @@ struct libewf_internal_handle
 
 	/* The chunk groups cache
 	 */
-	libfcache_cache_t *chunk_groups_cache;
+	libewf_lru_cache_t *chunk_groups_cache;
+
+	/* The maximum size of the chunk groups cache
+	 */
+	size64_t maximum_chunk_groups_cache_size;
 
 	/* The chunks cache
 	 */
-	libfcache_cache_t *chunks_cache;
+	libewf_lru_cache_t *chunks_cache;
+
+	/* The maximum size of the chunks cache
+	 */
+	size64_t maximum_chunks_cache_size;
+
+	/* The chunk data pool
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The maximum size of the chunk data pool
+	 */
+	size64_t maximum_chunk_data_pool_size;
+
+	/* The chunks cache used by concurrent reads
+	 */
+	libewf_sharded_cache_t *concurrent_chunks_cache;
+
+	/* The statistics
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The memory maps of the segment files, indexed by file IO pool entry
+	 * an entry is NULL if the segment file could not be memory mapped
+	 */
+	libcdata_array_t *memory_maps;
+
+	/* The index of the last memory mapped chunk of which the checksum was verified
+	 */
+	uint64_t verified_mapped_chunk_index;
+
+	/* Value to indicate the verified memory mapped chunk index is set
+	 */
+	uint8_t verified_mapped_chunk_index_set;
+
+	/* The read-ahead depth, the number of chunks to read ahead
+	 */
+	int read_ahead_depth;
+
+	/* The number of threads used to unpack the read-ahead chunks
+	 */
+	int read_ahead_number_of_threads;
+
+	/* The index of the last chunk read, used to detect sequential access
+	 */
+	uint64_t read_ahead_last_chunk_index;
+
+	/* The index of the chunk after the last read-ahead chunk
+	 */
+	uint64_t read_ahead_end_chunk_index;
 
 	/* The current chunk data
 	 */
@@ -150,13 +215,116 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The (chunk-offset) index file used by the next open
+	 */
+	libewf_index_file_t *index_file;
+
+	/* Value to indicate the segment files should be read on demand when opened for reading
+	 */
+	uint8_t lazy_open;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex that serializes the chunk table, chunk groups cache
+	 * and file IO pool access of concurrent reads
+	 */
+	libcthreads_mutex_t *chunk_table_mutex;
+
+	/* The read-ahead thread pool, created the first time chunks are unpacked in parallel
+	 */
+	libcthreads_thread_pool_t *read_ahead_thread_pool;
+
+	/* The number of threads of the read-ahead thread pool
+	 */
+	int read_ahead_thread_pool_number_of_threads;
+
+	/* The mutex that protects the number of pending read-ahead chunks
+	 */
+	libcthreads_mutex_t *read_ahead_mutex;
+
+	/* The condition that is signalled when a read-ahead chunk has been unpacked
+	 */
+	libcthreads_condition_t *read_ahead_condition;
+
+	/* The number of read-ahead chunks that are queued or being unpacked
+	 */
+	int read_ahead_number_of_pending_chunks;
 #endif
 };
 
+typedef struct libewf_read_ahead_chunk libewf_read_ahead_chunk_t;
+
+/* A chunk that is unpacked by the read-ahead
+ */
+struct libewf_read_ahead_chunk
+{
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The result of unpacking the chunk data
+	 * 1 if successful or 0 if not
+	 */
+	int result;
+};
+
+typedef struct libewf_read_vector_segment libewf_read_vector_segment_t;
+
+/* A segment of a vectored read that is contained in a single chunk
+ */
+struct libewf_read_vector_segment
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset of the segment in the chunk data
+	 */
+	size_t chunk_data_offset;
+
+	/* The index of the buffer
+	 */
+	int buffer_index;
+
+	/* The offset of the segment in the buffer
+	 */
+	size_t buffer_offset;
+
+	/* The size of the segment
+	 */
+	size_t size;
+};
+
+typedef struct libewf_read_vector_chunk libewf_read_vector_chunk_t;
+
+/* A chunk of a vectored read
+ */
+struct libewf_read_vector_chunk
+{
+	/* The internal handle
+	 */
+	libewf_internal_handle_t *internal_handle;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* Value to indicate the chunk data is pinned in the concurrent chunks cache
+	 */
+	uint8_t is_pinned;
+};
+
 LIBEWF_EXTERN \
 int libewf_handle_initialize(
      libewf_handle_t **handle,
@@ -211,6 +379,12 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_internal_handle_validate_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_file_io_pool(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -225,11 +399,90 @@ int libewf_handle_open_file_io_pool(
      int access_flags,
      libcerror_error_t **error );
 
+int libewf_internal_handle_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_index_file(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_read_index_file_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_internal_handle_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_write_index_file(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_write_index_file_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_read_ahead_unpack_chunk_data(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_read_ahead_unpack_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_read_ahead_unpack_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libewf_read_ahead_chunk_t *read_ahead_chunks,
+     int number_of_read_ahead_chunks,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_free_read_ahead_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_internal_handle_read_ahead_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_mapped_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_count,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -252,6 +505,114 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_chunk_data_concurrent(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libewf_read_vector_segment_compare(
+     const libewf_read_vector_segment_t *first_segment,
+     const libewf_read_vector_segment_t *second_segment );
+
+int libewf_internal_handle_read_vector_chunk_callback(
+     libewf_read_vector_chunk_t *vector_chunk,
+     void *arguments );
+
+int libewf_internal_handle_read_vector_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_read_vector_chunk_t *vector_chunks,
+     int number_of_vector_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         int number_of_buffers,
+         int number_of_threads,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         void **buffers,
+         const size_t *buffer_sizes,
+         const off64_t *offsets,
+         int number_of_buffers,
+         int number_of_threads,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_fill_value(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *fill_value,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_fill_range(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t size,
+     size64_t *range_size,
+     uint8_t *fill_value,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_fill_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     size64_t *range_size,
+     uint8_t *fill_value,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_view(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_pending_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -292,6 +653,20 @@ ssize_t libewf_handle_read_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_data_chunk_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_data_chunk_at_offset_concurrent(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -339,6 +714,77 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_open_handles_statistics(
+     libewf_handle_t *handle,
+     int *number_of_open_handles,
+     int *maximum_number_of_open_handles,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int read_ahead_depth,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_lazy_open(
+     libewf_handle_t *handle,
+     uint8_t lazy_open,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunks_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunks_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_data_pool_size(
+     libewf_handle_t *handle,
+     size64_t pool_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     size64_t *pooled_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_groups_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -403,6 +849,12 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -0,0 +1,1688 @@
+/*
+ * (Chunk-offset) index file functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_index_file.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcstring.h"
+#include "libewf_unused.h"
+
+#include "ewf_index_file.h"
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 'e', 'w', 'f', 'i', 'n', 'd', 'e', 'x' };
+
+/* Creates an index file segment
+ * Make sure the value index_file_segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_initialize(
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_segment_initialize";
+
+	if( index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file_segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file_segment = memory_allocate_structure(
+	                       libewf_index_file_segment_t );
+
+	if( *index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file_segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file segment.",
+		 function );
+
+		goto on_error;
+	}
+	( *index_file_segment )->device_information_section_index = -1;
+	( *index_file_segment )->last_chunk_filled                = -1;
+	( *index_file_segment )->file_io_pool_entry               = -1;
+
+	return( 1 );
+
+on_error:
+	if( *index_file_segment != NULL )
+	{
+		memory_free(
+		 *index_file_segment );
+
+		*index_file_segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_free(
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_segment_free";
+
+	if( index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file_segment != NULL )
+	{
+		if( ( *index_file_segment )->section_offsets != NULL )
+		{
+			memory_free(
+			 ( *index_file_segment )->section_offsets );
+		}
+		if( ( *index_file_segment )->chunk_groups != NULL )
+		{
+			memory_free(
+			 ( *index_file_segment )->chunk_groups );
+		}
+		memory_free(
+		 *index_file_segment );
+
+		*index_file_segment = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the section offsets and chunk groups of an index file segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_resize(
+     libewf_index_file_segment_t *index_file_segment,
+     int number_of_sections,
+     int number_of_chunk_groups,
+     libcerror_error_t **error )
+{
+	libewf_index_file_chunk_group_t *chunk_groups = NULL;
+	off64_t *section_offsets                      = NULL;
+	static char *function                         = "libewf_index_file_segment_resize";
+
+	if( index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sections < 0 )
+	 || ( (size_t) number_of_sections > ( (size_t) LIBEWF_INDEX_FILE_MAXIMUM_DATA_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sections value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunk_groups < 0 )
+	 || ( (size_t) number_of_chunk_groups > ( (size_t) LIBEWF_INDEX_FILE_MAXIMUM_DATA_SIZE / sizeof( libewf_index_file_chunk_group_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sections > 0 )
+	{
+		section_offsets = (off64_t *) memory_allocate(
+		                               sizeof( off64_t ) * number_of_sections );
+
+		if( section_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create section offsets.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_chunk_groups > 0 )
+	{
+		chunk_groups = (libewf_index_file_chunk_group_t *) memory_allocate(
+		                                                    sizeof( libewf_index_file_chunk_group_t ) * number_of_chunk_groups );
+
+		if( chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( index_file_segment->section_offsets != NULL )
+	{
+		memory_free(
+		 index_file_segment->section_offsets );
+	}
+	if( index_file_segment->chunk_groups != NULL )
+	{
+		memory_free(
+		 index_file_segment->chunk_groups );
+	}
+	index_file_segment->section_offsets        = section_offsets;
+	index_file_segment->number_of_sections     = number_of_sections;
+	index_file_segment->chunk_groups           = chunk_groups;
+	index_file_segment->number_of_chunk_groups = number_of_chunk_groups;
+
+	return( 1 );
+
+on_error:
+	if( section_offsets != NULL )
+	{
+		memory_free(
+		 section_offsets );
+	}
+	return( -1 );
+}
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *index_file )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+	int result            = 1;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *index_file )->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     int *number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_number_of_segments";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     int segment_index,
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_segment_by_index";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_file->segments_array,
+	     segment_index,
+	     (intptr_t **) index_file_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d from segments array.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the segment of a specific file IO pool entry
+ * The file IO pool entries are set when the index file is validated against the segment files
+ * Returns 1 if successful, 0 if no such segment or -1 on error
+ */
+int libewf_index_file_get_segment_by_file_io_pool_entry(
+     libewf_index_file_t *index_file,
+     int file_io_pool_entry,
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t *safe_index_file_segment = NULL;
+	static char *function                                = "libewf_index_file_get_segment_by_file_io_pool_entry";
+	int number_of_segments                               = 0;
+	int segment_index                                    = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &safe_index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( ( safe_index_file_segment != NULL )
+		 && ( safe_index_file_segment->file_io_pool_entry == file_io_pool_entry ) )
+		{
+			*index_file_segment = safe_index_file_segment;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Appends a segment
+ * The index file takes over management of the segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *index_file_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_append_segment";
+	int entry_index       = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     index_file->segments_array,
+	     &entry_index,
+	     (intptr_t *) index_file_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment to array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t file_header;
+
+	libewf_index_file_chunk_group_t *chunk_group    = NULL;
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	uint8_t *index_file_data                        = NULL;
+	static char *function                           = "libewf_index_file_read_file_io_handle";
+	size64_t file_size                              = 0;
+	size64_t data_size                              = 0;
+	size_t data_offset                              = 0;
+	ssize_t read_count                              = 0;
+	uint32_t calculated_checksum                    = 0;
+	uint32_t format_version                         = 0;
+	uint32_t number_of_chunk_groups                 = 0;
+	uint32_t number_of_sections                     = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_index                          = 0;
+	uint32_t stored_checksum                        = 0;
+	uint32_t value_32bit                            = 0;
+	uint64_t value_64bit                            = 0;
+	int entry_index                                 = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              (uint8_t *) &file_header,
+	              sizeof( ewf_index_file_header_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( ewf_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header.signature,
+	     ewf_index_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &file_header,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate file header checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: file header checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.number_of_segments,
+	 number_of_segments );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header.data_size,
+	 data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.data_checksum,
+	 stored_checksum );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: number of segments\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_segments );
+
+		libcnotify_printf(
+		 "%s: data size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index file format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size64_t) LIBEWF_INDEX_FILE_MAXIMUM_DATA_SIZE )
+	 || ( data_size != ( file_size - sizeof( ewf_index_file_header_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	index_file_data = (uint8_t *) memory_allocate(
+	                               (size_t) data_size );
+
+	if( index_file_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The index file data is read at once to keep the open a single sequential read
+	 */
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              index_file_data,
+	              (size_t) data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_file_data,
+	     (size_t) data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( sizeof( ewf_index_file_segment_t ) > ( (size_t) data_size - data_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " data size value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_sections,
+		 number_of_sections );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_chunk_groups,
+		 number_of_chunk_groups );
+
+		if( ( (uint64_t) number_of_sections * sizeof( ewf_index_file_section_t ) )
+		  + ( (uint64_t) number_of_chunk_groups * sizeof( ewf_index_file_chunk_group_t ) )
+		  > (uint64_t) ( (size_t) data_size - data_offset - sizeof( ewf_index_file_segment_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " number of sections or chunk groups value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libewf_index_file_segment_initialize(
+		     &index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index file segment.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_index_file_segment_resize(
+		     index_file_segment,
+		     (int) number_of_sections,
+		     (int) number_of_chunk_groups,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize index file segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_number,
+		 index_file_segment->segment_number );
+
+		index_file_segment->segment_file_type  = ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_type;
+		index_file_segment->major_version      = ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->major_version;
+		index_file_segment->minor_version      = ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->minor_version;
+		index_file_segment->segment_file_flags = ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_flags;
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->compression_method,
+		 index_file_segment->compression_method );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->flags,
+		 index_file_segment->flags );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_size,
+		 index_file_segment->segment_file_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->modification_time,
+		 value_64bit );
+
+		index_file_segment->modification_time = (int64_t) value_64bit;
+
+		if( memory_copy(
+		     index_file_segment->set_identifier,
+		     ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->set_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy set identifier.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->last_section_offset,
+		 value_64bit );
+
+		index_file_segment->last_section_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->device_information_section_index,
+		 value_32bit );
+
+		if( value_32bit == 0xffffffffUL )
+		{
+			index_file_segment->device_information_section_index = -1;
+		}
+		else if( value_32bit < number_of_sections )
+		{
+			index_file_segment->device_information_section_index = (int) value_32bit;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " device information section index value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->storage_media_size,
+		 index_file_segment->storage_media_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_chunks,
+		 index_file_segment->number_of_chunks );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->last_chunk_filled,
+		 value_64bit );
+
+		index_file_segment->last_chunk_filled = (int64_t) value_64bit;
+
+		data_offset += sizeof( ewf_index_file_segment_t );
+
+		for( entry_index = 0;
+		     entry_index < index_file_segment->number_of_sections;
+		     entry_index++ )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewf_index_file_section_t *) &( index_file_data[ data_offset ] ) )->offset,
+			 value_64bit );
+
+			index_file_segment->section_offsets[ entry_index ] = (off64_t) value_64bit;
+
+			data_offset += sizeof( ewf_index_file_section_t );
+		}
+		for( entry_index = 0;
+		     entry_index < index_file_segment->number_of_chunk_groups;
+		     entry_index++ )
+		{
+			chunk_group = &( index_file_segment->chunk_groups[ entry_index ] );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->offset,
+			 value_64bit );
+
+			chunk_group->offset = (off64_t) value_64bit;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->size,
+			 chunk_group->size );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->mapped_size,
+			 chunk_group->mapped_size );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->range_flags,
+			 chunk_group->range_flags );
+
+			data_offset += sizeof( ewf_index_file_chunk_group_t );
+		}
+		if( index_file_segment->segment_number != ( segment_index + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 index_file_segment->segment_number,
+			 segment_index + 1 );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     index_file->segments_array,
+		     &entry_index,
+		     (intptr_t *) index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %" PRIu32 " to array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		index_file_segment = NULL;
+	}
+	if( data_offset != (size_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: trailing data in index file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 index_file_data );
+
+	return( 1 );
+
+on_error:
+	if( index_file_segment != NULL )
+	{
+		libewf_index_file_segment_free(
+		 &index_file_segment,
+		 NULL );
+	}
+	if( index_file_data != NULL )
+	{
+		memory_free(
+		 index_file_data );
+	}
+	libcdata_array_empty(
+	 index_file->segments_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Writes an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t file_header;
+
+	libewf_index_file_chunk_group_t *chunk_group    = NULL;
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	uint8_t *index_file_data                        = NULL;
+	static char *function                           = "libewf_index_file_write_file_io_handle";
+	size_t data_offset                              = 0;
+	size_t data_size                                = 0;
+	ssize_t write_count                             = 0;
+	uint32_t calculated_checksum                    = 0;
+	int entry_index                                 = 0;
+	int number_of_segments                          = 0;
+	int segment_index                               = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_segments == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( index_file_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		data_size += sizeof( ewf_index_file_segment_t )
+		           + ( sizeof( ewf_index_file_section_t ) * index_file_segment->number_of_sections )
+		           + ( sizeof( ewf_index_file_chunk_group_t ) * index_file_segment->number_of_chunk_groups );
+	}
+	if( data_size > (size_t) LIBEWF_INDEX_FILE_MAXIMUM_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	index_file_data = (uint8_t *) memory_allocate(
+	                               data_size );
+
+	if( index_file_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     index_file_data,
+	     0,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file data.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_file_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d from segments array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_number,
+		 index_file_segment->segment_number );
+
+		( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_type  = index_file_segment->segment_file_type;
+		( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->major_version      = index_file_segment->major_version;
+		( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->minor_version      = index_file_segment->minor_version;
+		( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_flags = index_file_segment->segment_file_flags;
+
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->compression_method,
+		 index_file_segment->compression_method );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->flags,
+		 index_file_segment->flags );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->segment_file_size,
+		 index_file_segment->segment_file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->modification_time,
+		 (uint64_t) index_file_segment->modification_time );
+
+		if( memory_copy(
+		     ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->set_identifier,
+		     index_file_segment->set_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy set identifier.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->last_section_offset,
+		 (uint64_t) index_file_segment->last_section_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->device_information_section_index,
+		 (uint32_t) index_file_segment->device_information_section_index );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_sections,
+		 (uint32_t) index_file_segment->number_of_sections );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->storage_media_size,
+		 index_file_segment->storage_media_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_chunks,
+		 index_file_segment->number_of_chunks );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->last_chunk_filled,
+		 (uint64_t) index_file_segment->last_chunk_filled );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) &( index_file_data[ data_offset ] ) )->number_of_chunk_groups,
+		 (uint32_t) index_file_segment->number_of_chunk_groups );
+
+		data_offset += sizeof( ewf_index_file_segment_t );
+
+		for( entry_index = 0;
+		     entry_index < index_file_segment->number_of_sections;
+		     entry_index++ )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewf_index_file_section_t *) &( index_file_data[ data_offset ] ) )->offset,
+			 (uint64_t) index_file_segment->section_offsets[ entry_index ] );
+
+			data_offset += sizeof( ewf_index_file_section_t );
+		}
+		for( entry_index = 0;
+		     entry_index < index_file_segment->number_of_chunk_groups;
+		     entry_index++ )
+		{
+			chunk_group = &( index_file_segment->chunk_groups[ entry_index ] );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->offset,
+			 (uint64_t) chunk_group->offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->size,
+			 chunk_group->size );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->mapped_size,
+			 chunk_group->mapped_size );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 ( (ewf_index_file_chunk_group_t *) &( index_file_data[ data_offset ] ) )->range_flags,
+			 chunk_group->range_flags );
+
+			data_offset += sizeof( ewf_index_file_chunk_group_t );
+		}
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_file_data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &file_header,
+	     0,
+	     sizeof( ewf_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     file_header.signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.number_of_segments,
+	 (uint32_t) number_of_segments );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header.data_size,
+	 (uint64_t) data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.data_checksum,
+	 calculated_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &file_header,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate file header checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.checksum,
+	 calculated_checksum );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &file_header,
+	               sizeof( ewf_index_file_header_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewf_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               index_file_data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 index_file_data );
+
+	return( 1 );
+
+on_error:
+	if( index_file_data != NULL )
+	{
+		memory_free(
+		 index_file_data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the modification time of the file of a file IO handle
+ * The modification time is used to detect if a segment file changed after
+ * the index file was written
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_index_file_get_modification_time(
+     libbfio_handle_t *file_io_handle,
+     int64_t *modification_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI ) && defined( HAVE_WIDE_CHARACTER_TYPE )
+	WIN32_FILE_ATTRIBUTE_DATA file_attribute_data;
+
+	wchar_t *filename     = NULL;
+	size_t filename_size  = 0;
+#elif defined( HAVE_STAT )
+	struct stat file_statistics;
+
+	char *filename        = NULL;
+	size_t filename_size  = 0;
+#endif
+	static char *function = "libewf_index_file_get_modification_time";
+	int result            = 0;
+
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	*modification_time = 0;
+
+#if defined( WINAPI ) && defined( HAVE_WIDE_CHARACTER_TYPE )
+	/* The file IO handle is not necessarily a file
+	 */
+	if( libbfio_file_get_name_size_wide(
+	     file_io_handle,
+	     &filename_size,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	filename = libcstring_wide_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( GetFileAttributesExW(
+	     filename,
+	     GetFileExInfoStandard,
+	     &file_attribute_data ) != 0 )
+	{
+		*modification_time = ( (int64_t) file_attribute_data.ftLastWriteTime.dwHighDateTime << 32 )
+		                   | file_attribute_data.ftLastWriteTime.dwLowDateTime;
+
+		result = 1;
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+
+#elif defined( HAVE_STAT )
+	/* The file IO handle is not necessarily a file
+	 */
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &filename_size,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	filename = libcstring_narrow_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( stat(
+	     filename,
+	     &file_statistics ) == 0 )
+	{
+		*modification_time = (int64_t) file_statistics.st_mtime;
+
+		result = 1;
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+
+#else
+	LIBEWF_UNREFERENCED_PARAMETER( file_io_handle )
+
+	return( result );
+#endif
+}
+
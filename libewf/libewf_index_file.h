@@ -0,0 +1,218 @@
+/*
+ * (Chunk-offset) index file functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewf_index_file_signature[ 8 ];
+
+typedef struct libewf_index_file_chunk_group libewf_index_file_chunk_group_t;
+
+struct libewf_index_file_chunk_group
+{
+	/* The chunk group data offset
+	 */
+	off64_t offset;
+
+	/* The chunk group data size
+	 */
+	size64_t size;
+
+	/* The storage media size of the chunk group
+	 */
+	size64_t mapped_size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+};
+
+typedef struct libewf_index_file_segment libewf_index_file_segment_t;
+
+struct libewf_index_file_segment
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The segment file type
+	 */
+	uint8_t segment_file_type;
+
+	/* The format major version
+	 */
+	uint8_t major_version;
+
+	/* The format minor version
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 */
+	uint8_t segment_file_flags;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment file modification time
+	 */
+	int64_t modification_time;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The device information section index
+	 */
+	int device_information_section_index;
+
+	/* The storage media size
+	 */
+	size64_t storage_media_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The last chunk filled
+	 */
+	int64_t last_chunk_filled;
+
+	/* The section (descriptor) offsets
+	 */
+	off64_t *section_offsets;
+
+	/* The number of sections
+	 */
+	int number_of_sections;
+
+	/* The chunk groups
+	 */
+	libewf_index_file_chunk_group_t *chunk_groups;
+
+	/* The number of chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* The file IO pool entry of the segment file
+	 * this value is not stored in the index file
+	 */
+	int file_io_pool_entry;
+
+	/* Flags
+	 */
+	uint16_t flags;
+};
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+struct libewf_index_file
+{
+	/* The segments array
+	 */
+	libcdata_array_t *segments_array;
+};
+
+int libewf_index_file_segment_initialize(
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_segment_free(
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_segment_resize(
+     libewf_index_file_segment_t *index_file_segment,
+     int number_of_sections,
+     int number_of_chunk_groups,
+     libcerror_error_t **error );
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     int *number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     int segment_index,
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_file_io_pool_entry(
+     libewf_index_file_t *index_file,
+     int file_io_pool_entry,
+     libewf_index_file_segment_t **index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_modification_time(
+     libbfio_handle_t *file_io_handle,
+     int64_t *modification_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
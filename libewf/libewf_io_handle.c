@@ -95,6 +95,7 @@ int libewf_io_handle_initialize(
 	( *io_handle )->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
 	( *io_handle )->compression_level  = LIBEWF_COMPRESSION_NONE;
 	( *io_handle )->zero_on_error      = 1;
+	( *io_handle )->verify_checksums   = 1;
 	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
 	return( 1 );
@@ -195,6 +196,7 @@ int libewf_io_handle_clear(
 	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
 	io_handle->compression_level  = LIBEWF_COMPRESSION_NONE;
 	io_handle->zero_on_error      = 1;
+	io_handle->verify_checksums   = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
 	return( 1 );
@@ -266,7 +268,11 @@ int libewf_io_handle_clone(
 
 		goto on_error;
 	}
-	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->zero_on_error    = source_io_handle->zero_on_error;
+	( *destination_io_handle )->index_file       = NULL;
+	( *destination_io_handle )->chunk_data_pool  = NULL;
+	( *destination_io_handle )->statistics       = NULL;
+	( *destination_io_handle )->file_handle_pool = NULL;
 
 	return( 1 );
 
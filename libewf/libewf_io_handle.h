@@ -25,7 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
+#include "libewf_file_handle_pool.h"
+#include "libewf_index_file.h"
 #include "libewf_libcerror.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -79,6 +83,10 @@ struct libewf_io_handle
 	 */
 	uint8_t zero_on_error;
 
+	/* A value to indicate if the chunk data checksums should be verified
+	 */
+	uint8_t verify_checksums;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -86,6 +94,26 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The (chunk-offset) index file used to open the segment files
+	 * the index file is not managed by the IO handle
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The chunk data pool
+	 * the chunk data pool is not managed by the IO handle
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The statistics
+	 * the statistics are not managed by the IO handle
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The file handle pool used for the segment files created by the library
+	 * the file handle pool is not managed by the IO handle
+	 */
+	libewf_file_handle_pool_t *file_handle_pool;
 };
 
 int libewf_io_handle_initialize(
@@ -0,0 +1,1044 @@
+/*
+ * Least recently used (LRU) cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_lru_cache.h"
+
+/* Determines the hash bucket of an identifier
+ */
+#define libewf_lru_cache_get_bucket_index( cache, identifier ) \
+	( (int) ( ( ( identifier ) * 0x9e3779b97f4a7c15ULL ) >> 32 ) & ( ( cache )->number_of_buckets - 1 ) )
+
+/* Creates a cache
+ * Make sure the value cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_initialize(
+     libewf_lru_cache_t **cache,
+     size64_t maximum_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_initialize";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( free_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid free value function.",
+		 function );
+
+		return( -1 );
+	}
+	*cache = memory_allocate_structure(
+	          libewf_lru_cache_t );
+
+	if( *cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cache,
+	     0,
+	     sizeof( libewf_lru_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cache.",
+		 function );
+
+		memory_free(
+		 *cache );
+
+		*cache = NULL;
+
+		return( -1 );
+	}
+	( *cache )->number_of_buckets = LIBEWF_LRU_CACHE_NUMBER_OF_BUCKETS;
+
+	( *cache )->buckets = (libewf_lru_cache_entry_t **) memory_allocate(
+	                                                     sizeof( libewf_lru_cache_entry_t * ) * ( *cache )->number_of_buckets );
+
+	if( ( *cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *cache )->buckets,
+	     0,
+	     sizeof( libewf_lru_cache_entry_t * ) * ( *cache )->number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *cache )->maximum_size = maximum_size;
+	( *cache )->free_value   = free_value;
+
+	return( 1 );
+
+on_error:
+	if( *cache != NULL )
+	{
+		if( ( *cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *cache )->buckets );
+		}
+		memory_free(
+		 *cache );
+
+		*cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_free(
+     libewf_lru_cache_t **cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_free";
+	int result            = 1;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache != NULL )
+	{
+		if( libewf_lru_cache_empty(
+		     *cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty cache.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *cache )->buckets );
+
+		memory_free(
+		 *cache );
+
+		*cache = NULL;
+	}
+	return( result );
+}
+
+/* Clones the cache
+ * The cached values are not cloned, the destination cache is empty
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_clone(
+     libewf_lru_cache_t **destination_cache,
+     libewf_lru_cache_t *source_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_clone";
+
+	if( destination_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_cache == NULL )
+	{
+		*destination_cache = NULL;
+
+		return( 1 );
+	}
+	if( libewf_lru_cache_initialize(
+	     destination_cache,
+	     source_cache->maximum_size,
+	     source_cache->free_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Empties the cache and frees the cached values, including pinned values
+ * The caller must make sure no pinned values are still in use,
+ * refer to libewf_lru_cache_get_number_of_pins
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_empty(
+     libewf_lru_cache_t *cache,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "libewf_lru_cache_empty";
+	int result                            = 1;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	while( cache->first_entry != NULL )
+	{
+		cache_entry        = cache->first_entry;
+		cache->first_entry = cache_entry->next_entry;
+
+		if( cache->free_value(
+		     &( cache_entry->value ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free value: %" PRIu64 ".",
+			 function,
+			 cache_entry->identifier );
+
+			result = -1;
+		}
+		memory_free(
+		 cache_entry );
+	}
+	if( memory_set(
+	     cache->buckets,
+	     0,
+	     sizeof( libewf_lru_cache_entry_t * ) * cache->number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		result = -1;
+	}
+	cache->last_entry        = NULL;
+	cache->number_of_entries = 0;
+	cache->number_of_pins    = 0;
+	cache->current_size      = 0;
+
+	return( result );
+}
+
+/* Removes an entry from the hash bucket and the recently used list
+ */
+void libewf_lru_cache_unlink_entry(
+      libewf_lru_cache_t *cache,
+      libewf_lru_cache_entry_t *cache_entry )
+{
+	libewf_lru_cache_entry_t *bucket_entry = NULL;
+	int bucket_index                       = 0;
+
+	bucket_index = libewf_lru_cache_get_bucket_index(
+	                cache,
+	                cache_entry->identifier );
+
+	if( cache->buckets[ bucket_index ] == cache_entry )
+	{
+		cache->buckets[ bucket_index ] = cache_entry->next_bucket_entry;
+	}
+	else
+	{
+		bucket_entry = cache->buckets[ bucket_index ];
+
+		while( bucket_entry != NULL )
+		{
+			if( bucket_entry->next_bucket_entry == cache_entry )
+			{
+				bucket_entry->next_bucket_entry = cache_entry->next_bucket_entry;
+
+				break;
+			}
+			bucket_entry = bucket_entry->next_bucket_entry;
+		}
+	}
+	if( cache_entry->previous_entry != NULL )
+	{
+		cache_entry->previous_entry->next_entry = cache_entry->next_entry;
+	}
+	else
+	{
+		cache->first_entry = cache_entry->next_entry;
+	}
+	if( cache_entry->next_entry != NULL )
+	{
+		cache_entry->next_entry->previous_entry = cache_entry->previous_entry;
+	}
+	else
+	{
+		cache->last_entry = cache_entry->previous_entry;
+	}
+	cache_entry->previous_entry    = NULL;
+	cache_entry->next_entry        = NULL;
+	cache_entry->next_bucket_entry = NULL;
+
+	cache->number_of_entries -= 1;
+	cache->current_size      -= cache_entry->value_size;
+}
+
+/* Moves an entry to the front of the recently used list
+ */
+void libewf_lru_cache_touch_entry(
+      libewf_lru_cache_t *cache,
+      libewf_lru_cache_entry_t *cache_entry )
+{
+	if( cache->first_entry == cache_entry )
+	{
+		return;
+	}
+	cache_entry->previous_entry->next_entry = cache_entry->next_entry;
+
+	if( cache_entry->next_entry != NULL )
+	{
+		cache_entry->next_entry->previous_entry = cache_entry->previous_entry;
+	}
+	else
+	{
+		cache->last_entry = cache_entry->previous_entry;
+	}
+	cache_entry->previous_entry        = NULL;
+	cache_entry->next_entry            = cache->first_entry;
+	cache->first_entry->previous_entry = cache_entry;
+	cache->first_entry                 = cache_entry;
+}
+
+/* Retrieves the entry of an identifier
+ * Returns the entry or NULL if not available
+ */
+libewf_lru_cache_entry_t *libewf_lru_cache_get_entry(
+                           libewf_lru_cache_t *cache,
+                           uint64_t identifier )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	int bucket_index                      = 0;
+
+	bucket_index = libewf_lru_cache_get_bucket_index(
+	                cache,
+	                identifier );
+
+	cache_entry = cache->buckets[ bucket_index ];
+
+	while( cache_entry != NULL )
+	{
+		if( cache_entry->identifier == identifier )
+		{
+			break;
+		}
+		cache_entry = cache_entry->next_bucket_entry;
+	}
+	return( cache_entry );
+}
+
+/* Evicts the least recently used entries until the cache no longer exceeds its maximum size
+ * The most recently used entry and pinned entries are never evicted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_evict_entries(
+     libewf_lru_cache_t *cache,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry    = NULL;
+	libewf_lru_cache_entry_t *previous_entry = NULL;
+	static char *function                    = "libewf_lru_cache_evict_entries";
+	int result                               = 1;
+
+	cache_entry = cache->last_entry;
+
+	while( ( cache->current_size > cache->maximum_size )
+	    && ( cache_entry != NULL )
+	    && ( cache_entry != cache->first_entry ) )
+	{
+		previous_entry = cache_entry->previous_entry;
+
+		if( cache_entry->pin_count > 0 )
+		{
+			cache_entry = previous_entry;
+
+			continue;
+		}
+		libewf_lru_cache_unlink_entry(
+		 cache,
+		 cache_entry );
+
+		if( cache->free_value(
+		     &( cache_entry->value ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free value: %" PRIu64 ".",
+			 function,
+			 cache_entry->identifier );
+
+			result = -1;
+		}
+		memory_free(
+		 cache_entry );
+
+		cache->number_of_evictions += 1;
+
+		cache_entry = previous_entry;
+	}
+	return( result );
+}
+
+/* Retrieves a cached value
+ * The value remains managed by the cache and is only valid until the next change of the cache
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_lru_cache_get_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "libewf_lru_cache_get_value";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = libewf_lru_cache_get_entry(
+	               cache,
+	               identifier );
+
+	if( cache_entry == NULL )
+	{
+		cache->number_of_misses += 1;
+
+		*value = NULL;
+
+		return( 0 );
+	}
+	libewf_lru_cache_touch_entry(
+	 cache,
+	 cache_entry );
+
+	cache->number_of_hits += 1;
+
+	*value = cache_entry->value;
+
+	return( 1 );
+}
+
+/* Pins a cached value
+ * A pinned value is not evicted and remains valid until it is unpinned
+ * by libewf_lru_cache_unpin_value or the cache is emptied
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_lru_cache_pin_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "libewf_lru_cache_pin_value";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = libewf_lru_cache_get_entry(
+	               cache,
+	               identifier );
+
+	if( cache_entry == NULL )
+	{
+		cache->number_of_misses += 1;
+
+		*value = NULL;
+
+		return( 0 );
+	}
+	if( ( cache_entry->pin_count == INT_MAX )
+	 || ( cache->number_of_pins == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cache entry: %" PRIu64 " - pin count value out of bounds.",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	libewf_lru_cache_touch_entry(
+	 cache,
+	 cache_entry );
+
+	cache_entry->pin_count += 1;
+	cache->number_of_pins  += 1;
+
+	cache->number_of_hits += 1;
+
+	*value = cache_entry->value;
+
+	return( 1 );
+}
+
+/* Unpins a value pinned by libewf_lru_cache_pin_value
+ * Least recently used values are evicted when the cache exceeds its maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_unpin_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "libewf_lru_cache_unpin_value";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = libewf_lru_cache_get_entry(
+	               cache,
+	               identifier );
+
+	if( ( cache_entry == NULL )
+	 || ( cache_entry->pin_count <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing pinned cache entry: %" PRIu64 ".",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	cache_entry->pin_count -= 1;
+	cache->number_of_pins  -= 1;
+
+	if( libewf_lru_cache_evict_entries(
+	     cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to evict entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if a value is cached
+ * This function does not change the cache statistics or the recently used order
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libewf_lru_cache_has_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_has_value";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_lru_cache_get_entry(
+	     cache,
+	     identifier ) == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Sets a value in the cache
+ * The cache takes over management of the value, also on error, any previously
+ * cached value with the same identifier is freed unless it is pinned, in which
+ * case the value is freed instead
+ * Least recently used values are evicted when the cache exceeds its maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_set_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "libewf_lru_cache_set_value";
+	int bucket_index                      = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = libewf_lru_cache_get_entry(
+	               cache,
+	               identifier );
+
+	if( ( cache_entry != NULL )
+	 && ( cache_entry->pin_count > 0 ) )
+	{
+		libewf_lru_cache_touch_entry(
+		 cache,
+		 cache_entry );
+
+		if( cache_entry->value != value )
+		{
+			if( cache->free_value(
+			     &value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+	if( cache_entry != NULL )
+	{
+		libewf_lru_cache_unlink_entry(
+		 cache,
+		 cache_entry );
+
+		if( cache_entry->value != value )
+		{
+			if( cache->free_value(
+			     &( cache_entry->value ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				memory_free(
+				 cache_entry );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		cache_entry = memory_allocate_structure(
+		               libewf_lru_cache_entry_t );
+
+		if( cache_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create cache entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     cache_entry,
+		     0,
+		     sizeof( libewf_lru_cache_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cache entry.",
+			 function );
+
+			memory_free(
+			 cache_entry );
+
+			goto on_error;
+		}
+		cache_entry->identifier = identifier;
+	}
+	cache_entry->value      = value;
+	cache_entry->value_size = value_size;
+
+	bucket_index = libewf_lru_cache_get_bucket_index(
+	                cache,
+	                identifier );
+
+	cache_entry->next_bucket_entry = cache->buckets[ bucket_index ];
+	cache->buckets[ bucket_index ] = cache_entry;
+
+	cache_entry->next_entry = cache->first_entry;
+
+	if( cache->first_entry != NULL )
+	{
+		cache->first_entry->previous_entry = cache_entry;
+	}
+	else
+	{
+		cache->last_entry = cache_entry;
+	}
+	cache->first_entry = cache_entry;
+
+	cache->number_of_entries += 1;
+	cache->current_size      += value_size;
+
+	if( libewf_lru_cache_evict_entries(
+	     cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to evict entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	cache->free_value(
+	 &value,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sets the maximum size of the cached values
+ * Least recently used values are evicted when the cache exceeds the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_set_maximum_size(
+     libewf_lru_cache_t *cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_set_maximum_size";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	cache->maximum_size = maximum_size;
+
+	if( libewf_lru_cache_evict_entries(
+	     cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to evict entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_get_statistics(
+     libewf_lru_cache_t *cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_get_statistics";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of evictions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits      = cache->number_of_hits;
+	*number_of_misses    = cache->number_of_misses;
+	*number_of_evictions = cache->number_of_evictions;
+
+	return( 1 );
+}
+
+/* Retrieves the number of pins of the cached values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_lru_cache_get_number_of_pins(
+     libewf_lru_cache_t *cache,
+     int *number_of_pins,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_lru_cache_get_number_of_pins";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pins == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pins.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_pins = cache->number_of_pins;
+
+	return( 1 );
+}
+
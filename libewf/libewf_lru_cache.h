@@ -0,0 +1,211 @@
+/*
+ * Least recently used (LRU) cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_LRU_CACHE_H )
+#define _LIBEWF_LRU_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_lru_cache_entry libewf_lru_cache_entry_t;
+
+struct libewf_lru_cache_entry
+{
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The (allocated) size of the value
+	 */
+	size_t value_size;
+
+	/* The number of times the entry is pinned
+	 * pinned entries are not evicted
+	 */
+	int pin_count;
+
+	/* The previous (more recently used) entry
+	 */
+	libewf_lru_cache_entry_t *previous_entry;
+
+	/* The next (less recently used) entry
+	 */
+	libewf_lru_cache_entry_t *next_entry;
+
+	/* The next entry in the same hash bucket
+	 */
+	libewf_lru_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_lru_cache libewf_lru_cache_t;
+
+struct libewf_lru_cache
+{
+	/* The hash buckets
+	 */
+	libewf_lru_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The most recently used entry
+	 */
+	libewf_lru_cache_entry_t *first_entry;
+
+	/* The least recently used entry
+	 */
+	libewf_lru_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of pins, the sum of the pin counts of the entries
+	 */
+	int number_of_pins;
+
+	/* The maximum size of the cached values
+	 */
+	size64_t maximum_size;
+
+	/* The current size of the cached values
+	 */
+	size64_t current_size;
+
+	/* The value free function
+	 */
+	int (*free_value)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The number of evicted values
+	 */
+	uint64_t number_of_evictions;
+};
+
+int libewf_lru_cache_initialize(
+     libewf_lru_cache_t **cache,
+     size64_t maximum_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libewf_lru_cache_free(
+     libewf_lru_cache_t **cache,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_clone(
+     libewf_lru_cache_t **destination_cache,
+     libewf_lru_cache_t *source_cache,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_empty(
+     libewf_lru_cache_t *cache,
+     libcerror_error_t **error );
+
+void libewf_lru_cache_unlink_entry(
+      libewf_lru_cache_t *cache,
+      libewf_lru_cache_entry_t *cache_entry );
+
+void libewf_lru_cache_touch_entry(
+      libewf_lru_cache_t *cache,
+      libewf_lru_cache_entry_t *cache_entry );
+
+libewf_lru_cache_entry_t *libewf_lru_cache_get_entry(
+                           libewf_lru_cache_t *cache,
+                           uint64_t identifier );
+
+int libewf_lru_cache_evict_entries(
+     libewf_lru_cache_t *cache,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_get_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_pin_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_unpin_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_has_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_set_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_set_maximum_size(
+     libewf_lru_cache_t *cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_get_statistics(
+     libewf_lru_cache_t *cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+int libewf_lru_cache_get_number_of_pins(
+     libewf_lru_cache_t *cache,
+     int *number_of_pins,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_LRU_CACHE_H ) */
+
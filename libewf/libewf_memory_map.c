@@ -0,0 +1,367 @@
+/*
+ * Memory mapped (segment) file functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_memory_map.h"
+
+/* Creates a memory map of a file
+ * The file is mapped read-only in its entirety, the file descriptor is not kept open
+ * Make sure the value memory_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_map_initialize(
+     libewf_memory_map_t **memory_map,
+     const char *filename,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+	struct stat file_statistics;
+
+	void *mapped_data     = NULL;
+	int file_descriptor   = -1;
+	int file_io_flags     = O_RDONLY;
+#endif
+	static char *function = "libewf_memory_map_initialize";
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+	*memory_map = memory_allocate_structure(
+	               libewf_memory_map_t );
+
+	if( *memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *memory_map,
+	     0,
+	     sizeof( libewf_memory_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear memory map.",
+		 function );
+
+		memory_free(
+		 *memory_map );
+
+		*memory_map = NULL;
+
+		return( -1 );
+	}
+#if defined( O_CLOEXEC )
+	file_io_flags |= O_CLOEXEC;
+#endif
+	file_descriptor = open(
+	                   filename,
+	                   file_io_flags );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+#if SIZEOF_SIZE_T <= 4
+	if( (size64_t) file_statistics.st_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid file size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* An empty file cannot be mapped
+	 */
+	if( file_statistics.st_size > 0 )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) file_statistics.st_size,
+		               PROT_READ,
+		               MAP_SHARED,
+		               file_descriptor,
+		               0 );
+
+		if( mapped_data == MAP_FAILED )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 (uint32_t) errno,
+			 "%s: unable to map file: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		( *memory_map )->data      = (uint8_t *) mapped_data;
+		( *memory_map )->data_size = (size64_t) file_statistics.st_size;
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( *memory_map != NULL )
+	{
+		if( ( *memory_map )->data != NULL )
+		{
+			munmap(
+			 ( *memory_map )->data,
+			 (size_t) ( *memory_map )->data_size );
+		}
+		memory_free(
+		 *memory_map );
+
+		*memory_map = NULL;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: memory mapped files are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT ) */
+}
+
+/* Frees a memory map
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_map_free(
+     libewf_memory_map_t **memory_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_map_free";
+	int result            = 1;
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_map != NULL )
+	{
+#if defined( HAVE_LIBEWF_MEMORY_MAP_SUPPORT )
+		if( ( *memory_map )->data != NULL )
+		{
+			if( munmap(
+			     ( *memory_map )->data,
+			     (size_t) ( *memory_map )->data_size ) != 0 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 (uint32_t) errno,
+				 "%s: unable to unmap file.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *memory_map );
+
+		*memory_map = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a pointer to the mapped data of a specific range
+ * The data remains valid until the memory map is freed
+ * Returns 1 if successful, 0 if the range is not mapped or -1 on error
+ */
+int libewf_memory_map_get_data(
+     libewf_memory_map_t *memory_map,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_map_get_data";
+
+	if( memory_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (size64_t) offset > memory_map->data_size )
+	 || ( size > ( memory_map->data_size - (size64_t) offset ) ) )
+	{
+		return( 0 );
+	}
+	*data = &( ( memory_map->data )[ offset ] );
+
+	return( 1 );
+}
+
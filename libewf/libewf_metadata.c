@@ -956,7 +956,9 @@ int libewf_handle_set_compression_method(
 		return( -1 );
 	}
 	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_ZSTD )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_LZ4 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -994,7 +996,7 @@ int libewf_handle_set_compression_method(
 
 		goto on_error;
 	}
-	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
 	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
 	{
@@ -3177,6 +3179,84 @@ int libewf_handle_set_read_zero_chunk_on_error(
 	return( 1 );
 }
 
+/* Sets the read verify checksums
+ * When disabled the checksum of uncompressed chunks is not verified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_verify_checksums(
+     libewf_handle_t *handle,
+     uint8_t verify_checksums,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_verify_checksums";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( verify_checksums != 0 )
+	{
+		internal_handle->io_handle->verify_checksums = 1;
+	}
+	else
+	{
+		internal_handle->io_handle->verify_checksums = 0;
+	}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
 /* Copies the media values from the source to the destination handle
  * Returns 1 if successful or -1 on error
  */
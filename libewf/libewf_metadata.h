@@ -210,6 +210,12 @@ int libewf_handle_set_read_zero_chunk_on_error(
      uint8_t zero_on_error,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_read_verify_checksums(
+     libewf_handle_t *handle,
+     uint8_t verify_checksums,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_copy_media_values(
      libewf_handle_t *destination_handle,
@@ -0,0 +1,513 @@
+/*
+ * Name hash table functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libuna.h"
+#include "libewf_name_hash_table.h"
+
+/* Adds an Unicode character to the (32-bit FNV-1a) name hash
+ */
+#define libewf_name_hash_table_add_character( name_hash, unicode_character ) \
+	( ( ( name_hash ) ^ (uint32_t) ( unicode_character ) ) * 0x01000193UL )
+
+/* Creates a name hash table
+ * Make sure the value name_hash_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_name_hash_table_initialize(
+     libewf_name_hash_table_t **name_hash_table,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_name_hash_table_initialize";
+	size_t entries_size        = 0;
+	uint32_t number_of_entries = LIBEWF_NAME_HASH_TABLE_MINIMUM_NUMBER_OF_ENTRIES;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_hash_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid name hash table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_nodes < 0 )
+	 || ( maximum_number_of_nodes > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the load factor at or below 0.5 so that probe sequences remain short
+	 */
+	while( number_of_entries < ( 2 * (uint32_t) maximum_number_of_nodes ) )
+	{
+		number_of_entries <<= 1;
+	}
+	if( (size_t) number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libewf_name_hash_table_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	entries_size = sizeof( libewf_name_hash_table_entry_t ) * number_of_entries;
+
+	*name_hash_table = memory_allocate_structure(
+	                    libewf_name_hash_table_t );
+
+	if( *name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name hash table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *name_hash_table,
+	     0,
+	     sizeof( libewf_name_hash_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name hash table.",
+		 function );
+
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+
+		return( -1 );
+	}
+	( *name_hash_table )->entries = (libewf_name_hash_table_entry_t *) memory_allocate(
+	                                                                    entries_size );
+
+	if( ( *name_hash_table )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *name_hash_table )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *name_hash_table )->number_of_entries = number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *name_hash_table != NULL )
+	{
+		if( ( *name_hash_table )->entries != NULL )
+		{
+			memory_free(
+			 ( *name_hash_table )->entries );
+		}
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a name hash table
+ * The nodes are not freed since they are owned by the tree
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_name_hash_table_free(
+     libewf_name_hash_table_t **name_hash_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_name_hash_table_free";
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_hash_table != NULL )
+	{
+		if( ( *name_hash_table )->entries != NULL )
+		{
+			memory_free(
+			 ( *name_hash_table )->entries );
+		}
+		memory_free(
+		 *name_hash_table );
+
+		*name_hash_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-8 formatted name
+ * The hash is calculated over the Unicode characters up to the first end-of-string character
+ * so that the UTF-8 and UTF-16 formatted forms of a name have the same hash
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_name_hash_table_get_utf8_name_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_name_hash_table_get_utf8_name_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_string_index                     = 0;
+	uint32_t safe_name_hash                      = 0x811c9dc5UL;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		safe_name_hash = libewf_name_hash_table_add_character(
+		                  safe_name_hash,
+		                  unicode_character );
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-16 formatted name
+ * The hash is calculated over the Unicode characters up to the first end-of-string character
+ * so that the UTF-8 and UTF-16 formatted forms of a name have the same hash
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_name_hash_table_get_utf16_name_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_name_hash_table_get_utf16_name_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf16_string_index                    = 0;
+	uint32_t safe_name_hash                      = 0x811c9dc5UL;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		safe_name_hash = libewf_name_hash_table_add_character(
+		                  safe_name_hash,
+		                  unicode_character );
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Inserts a node in the name hash table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_name_hash_table_insert_node(
+     libewf_name_hash_table_t *name_hash_table,
+     uint32_t name_hash,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_name_hash_table_insert_node";
+	uint32_t entry_index  = 0;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( 2 * ( name_hash_table->number_of_nodes + 1 ) ) > name_hash_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name hash table - number of nodes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = name_hash & ( name_hash_table->number_of_entries - 1 );
+
+	while( name_hash_table->entries[ entry_index ].node != NULL )
+	{
+		entry_index = ( entry_index + 1 ) & ( name_hash_table->number_of_entries - 1 );
+	}
+	name_hash_table->entries[ entry_index ].name_hash = name_hash;
+	name_hash_table->entries[ entry_index ].node      = node;
+
+	name_hash_table->number_of_nodes += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the next node with a specific name hash
+ * The probe index should be set to 0 to retrieve the first node, it is
+ * updated so that successive calls return the other nodes with the same hash
+ * Returns 1 if successful, 0 if no such node or -1 on error
+ */
+int libewf_name_hash_table_get_node_by_name_hash(
+     libewf_name_hash_table_t *name_hash_table,
+     uint32_t name_hash,
+     uint32_t *probe_index,
+     libcdata_tree_node_t **node,
+     libcerror_error_t **error )
+{
+	libewf_name_hash_table_entry_t *entry = NULL;
+	static char *function                 = "libewf_name_hash_table_get_node_by_name_hash";
+	uint32_t entry_index                  = 0;
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( probe_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid probe index.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	while( *probe_index < name_hash_table->number_of_entries )
+	{
+		entry_index = ( name_hash + *probe_index ) & ( name_hash_table->number_of_entries - 1 );
+		entry       = &( name_hash_table->entries[ entry_index ] );
+
+		*probe_index += 1;
+
+		/* An unused entry terminates the probe sequence
+		 */
+		if( entry->node == NULL )
+		{
+			break;
+		}
+		if( entry->name_hash == name_hash )
+		{
+			*node = entry->node;
+
+			return( 1 );
+		}
+	}
+	*probe_index = name_hash_table->number_of_entries;
+	*node        = NULL;
+
+	return( 0 );
+}
+
@@ -0,0 +1,105 @@
+/*
+ * Name hash table functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_NAME_HASH_TABLE_H )
+#define _LIBEWF_NAME_HASH_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_name_hash_table_entry libewf_name_hash_table_entry_t;
+
+struct libewf_name_hash_table_entry
+{
+	/* The name hash
+	 */
+	uint32_t name_hash;
+
+	/* The (tree) node
+	 * NULL if the entry is not used
+	 */
+	libcdata_tree_node_t *node;
+};
+
+typedef struct libewf_name_hash_table libewf_name_hash_table_t;
+
+struct libewf_name_hash_table
+{
+	/* The entries
+	 */
+	libewf_name_hash_table_entry_t *entries;
+
+	/* The number of entries, this value is a power of 2
+	 */
+	uint32_t number_of_entries;
+
+	/* The number of nodes
+	 */
+	uint32_t number_of_nodes;
+};
+
+int libewf_name_hash_table_initialize(
+     libewf_name_hash_table_t **name_hash_table,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libewf_name_hash_table_free(
+     libewf_name_hash_table_t **name_hash_table,
+     libcerror_error_t **error );
+
+int libewf_name_hash_table_get_utf8_name_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_name_hash_table_get_utf16_name_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_name_hash_table_insert_node(
+     libewf_name_hash_table_t *name_hash_table,
+     uint32_t name_hash,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_name_hash_table_get_node_by_name_hash(
+     libewf_name_hash_table_t *name_hash_table,
+     uint32_t name_hash,
+     uint32_t *probe_index,
+     libcdata_tree_node_t **node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_NAME_HASH_TABLE_H ) */
+
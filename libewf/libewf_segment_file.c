@@ -40,6 +40,7 @@
 #include "libewf_device_information.h"
 #include "libewf_hash_values.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -49,10 +50,12 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfguid.h"
 #include "libewf_libfvalue.h"
+#include "libewf_lru_cache.h"
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_unused.h"
 
 #include "ewf_file_header.h"
@@ -4162,6 +4165,25 @@ ssize_t libewf_segment_file_write_chunk_data(
 	}
 	segment_file->current_offset += write_count;
 
+	if( segment_file->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     segment_file->io_handle->statistics,
+		     LIBEWF_STATISTIC_CHUNKS_WRITTEN,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+
 	return( write_count );
 }
 
@@ -5087,6 +5109,26 @@ ssize_t libewf_segment_file_write_close(
 	}
 	segment_file->flags &= ~( LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN );
 
+	if( ( segment_file->io_handle->statistics != NULL )
+	 && ( segment_file->io_handle->file_handle_pool == NULL ) )
+	{
+		if( libewf_statistics_add(
+		     segment_file->io_handle->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+
 	return( total_write_count );
 
 on_error:
@@ -5795,6 +5837,25 @@ int libewf_segment_file_write_sections_correction(
 
 			goto on_error;
 		}
+		if( ( segment_file->io_handle->statistics != NULL )
+		 && ( segment_file->io_handle->file_handle_pool == NULL ) )
+		{
+			if( libewf_statistics_add(
+			     segment_file->io_handle->statistics,
+			     LIBEWF_STATISTIC_SEGMENT_FILE_CLOSES,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 	else
 	{
@@ -5876,207 +5937,741 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Copies the segment file values to an index file segment
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_copy_to_index_file_segment(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *segment_file_cache,
-     int file_io_pool_entry,
-     off64_t segment_file_offset,
-     size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libewf_index_file_segment_t *index_file_segment,
      libcerror_error_t **error )
 {
-	libfcache_cache_t *sections_cache   = NULL;
-	libewf_section_t *section           = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_segment_file_read_element_data";
-	off64_t section_data_offset         = 0;
-	ssize_t read_count                  = 0;
-	int element_index                   = 0;
-	int last_section                    = 0;
-	int number_of_sections              = 0;
-	int result                          = 0;
-	int section_index                   = 0;
+	libewf_index_file_chunk_group_t *chunk_group = NULL;
+	libewf_section_t *section                    = NULL;
+	libfcache_cache_t *sections_cache            = NULL;
+	static char *function                        = "libewf_segment_file_copy_to_index_file_segment";
+	size64_t element_size                        = 0;
+	uint32_t element_flags                       = 0;
+	int element_file_io_pool_entry               = 0;
+	int element_index                            = 0;
+	int number_of_chunk_groups                   = 0;
+	int number_of_sections                       = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
 
-	if( io_handle == NULL )
+		return( -1 );
+	}
+	if( index_file_segment == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid index file segment.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libewf_segment_file_read_file_header(
-		      segment_file,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      error );
-
-/* TODO deal with corrupted header ? */
-	if( read_count == -1 )
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment file header.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of chunk groups in the chunk groups list.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	if( libewf_index_file_segment_resize(
+	     index_file_segment,
+	     number_of_sections,
+	     number_of_chunk_groups,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported segment file type.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index file segment.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
 	{
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
 	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
+	index_file_segment->segment_number                   = segment_file->segment_number;
+	index_file_segment->segment_file_type                = segment_file->type;
+	index_file_segment->major_version                    = segment_file->major_version;
+	index_file_segment->minor_version                    = segment_file->minor_version;
+	index_file_segment->segment_file_flags               = segment_file->flags;
+	index_file_segment->compression_method               = segment_file->compression_method;
+	index_file_segment->last_section_offset              = segment_file->last_section_offset;
+	index_file_segment->device_information_section_index = segment_file->device_information_section_index;
+	index_file_segment->storage_media_size               = segment_file->storage_media_size;
+	index_file_segment->number_of_chunks                 = segment_file->number_of_chunks;
+	index_file_segment->last_chunk_filled                = segment_file->last_chunk_filled;
+	index_file_segment->flags                            = 0;
+
+	if( memory_copy(
+	     index_file_segment->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_INPUT,
-		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-		 "%s: segment file type value mismatch.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
 		 function );
 
 		goto on_error;
 	}
-	if( segment_file->major_version == 2 )
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
 	{
-		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     element_index,
+		     &element_file_io_pool_entry,
+		     &( index_file_segment->section_offsets[ element_index ] ),
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported compression method.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 element_index );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	/* Read the section descriptors:
-	 * EWF version 1 read from front to back
-	 * EWF version 2 read from back to front
-	 */
-	if( segment_file->major_version == 1 )
-	{
-		segment_file_offset = (off64_t) read_count;
-	}
-	else if( segment_file->major_version == 2 )
-	{
-		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
-	}
-	last_section = 0;
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     sections_cache,
+		     element_index,
+		     (intptr_t **) &section,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 element_index );
 
-	if( libewf_section_initialize(
-	     &section,
+			goto on_error;
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		/* The sections that contain metadata are still read from the segment file
+		 * when the index file is used
+		 */
+		if( ( section->type == LIBEWF_SECTION_TYPE_SECTOR_DATA )
+		 || ( section->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+		 || ( section->type == LIBEWF_SECTION_TYPE_NEXT )
+		 || ( section->type == LIBEWF_SECTION_TYPE_DONE ) )
+		{
+			continue;
+		}
+		if( segment_file->major_version == 1 )
+		{
+			if( ( section->type_string_length == 6 )
+			 && ( memory_compare(
+			       (void *) section->type_string,
+			       (void *) "table2",
+			       6 ) == 0 ) )
+			{
+				continue;
+			}
+			/* The data section in the first segment file contains the media values
+			 */
+			if( ( segment_file->segment_number > 1 )
+			 && ( section->type_string_length == 4 )
+			 && ( memory_compare(
+			       (void *) section->type_string,
+			       (void *) "data",
+			       4 ) == 0 ) )
+			{
+				continue;
+			}
+		}
+		index_file_segment->flags |= LIBEWF_INDEX_FILE_SEGMENT_FLAG_HAS_METADATA;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create section.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
 		 function );
 
 		goto on_error;
 	}
-	while( ( segment_file_offset > 0 )
-	    && ( (size64_t) segment_file_offset < segment_file_size ) )
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
 	{
-		read_count = libewf_section_descriptor_read(
-			      section,
-			      file_io_pool,
-			      file_io_pool_entry,
-			      segment_file_offset,
-			      segment_file->major_version,
-			      error );
+		chunk_group = &( index_file_segment->chunk_groups[ element_index ] );
 
-		if( read_count == -1 )
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &element_file_io_pool_entry,
+		     &( chunk_group->offset ),
+		     &( chunk_group->size ),
+		     &( chunk_group->range_flags ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section descriptor.",
-			 function );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
-
-			segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 element_index );
 
-			break;
+			goto on_error;
 		}
-		segment_file->current_offset = segment_file_offset + read_count;
-
-		if( segment_file->major_version == 1 )
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &( chunk_group->mapped_size ),
+		     error ) != 1 )
 		{
-			if( section->type == LIBEWF_SECTION_TYPE_NEXT )
-			{
-				last_section = 1;
-			}
-			else if( section->type == LIBEWF_SECTION_TYPE_DONE )
-			{
-				last_section = 1;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size of element: %d from chunk groups list.",
+			 function,
+			 element_index );
 
-				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_LAST;
-			}
-			segment_file->last_section_offset = segment_file_offset;
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Copies the segment file values from an index file segment
+ * This replaces reading the section descriptors and table sections from the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_copy_from_index_file_segment(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_segment_t *index_file_segment,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_index_file_chunk_group_t *chunk_group = NULL;
+	static char *function                        = "libewf_segment_file_copy_from_index_file_segment";
+	size64_t section_descriptor_size             = 0;
+	int element_index                            = 0;
+	int entry_index                              = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file_segment->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( index_file_segment->major_version == 2 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu8 ".",
+		 function,
+		 index_file_segment->major_version );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < index_file_segment->number_of_sections;
+	     entry_index++ )
+	{
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     index_file_segment->section_offsets[ entry_index ],
+		     section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section to sections list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < index_file_segment->number_of_chunk_groups;
+	     entry_index++ )
+	{
+		chunk_group = &( index_file_segment->chunk_groups[ entry_index ] );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     chunk_group->offset,
+		     chunk_group->size,
+		     chunk_group->range_flags,
+		     chunk_group->mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     segment_file->set_identifier,
+	     index_file_segment->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file->segment_number                   = index_file_segment->segment_number;
+	segment_file->type                             = index_file_segment->segment_file_type;
+	segment_file->major_version                    = index_file_segment->major_version;
+	segment_file->minor_version                    = index_file_segment->minor_version;
+	segment_file->flags                            = index_file_segment->segment_file_flags;
+	segment_file->compression_method               = index_file_segment->compression_method;
+	segment_file->last_section_offset              = index_file_segment->last_section_offset;
+	segment_file->device_information_section_index = index_file_segment->device_information_section_index;
+	segment_file->storage_media_size               = index_file_segment->storage_media_size;
+	segment_file->number_of_chunks                 = index_file_segment->number_of_chunks;
+	segment_file->last_chunk_filled                = index_file_segment->last_chunk_filled;
+
+	return( 1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t *index_file_segment = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	libewf_section_t *section                       = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	static char *function                           = "libewf_segment_file_read_element_data";
+	off64_t section_data_offset                     = 0;
+	ssize_t read_count                              = 0;
+	int element_index                               = 0;
+	int last_section                                = 0;
+	int number_of_sections                          = 0;
+	int result                                      = 0;
+	int section_index                               = 0;
+
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add(
+		     io_handle->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_MISSES,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( io_handle->index_file != NULL )
+	{
+		result = libewf_index_file_get_segment_by_file_io_pool_entry(
+		          io_handle->index_file,
+		          file_io_pool_entry,
+		          &index_file_segment,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index file segment of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( index_file_segment->segment_file_size == segment_file_size ) )
+		{
+			/* The section descriptors and table sections were read when the index file was written
+			 */
+			if( libewf_segment_file_copy_from_index_file_segment(
+			     segment_file,
+			     index_file_segment,
+			     file_io_pool_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to copy segment file values from index file segment.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+			 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+			{
+				segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+			}
+			if( libfdata_list_element_set_element_value(
+			     element,
+			     (intptr_t *) file_io_pool,
+			     segment_file_cache,
+			     (intptr_t *) segment_file,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_free,
+			     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file as element value.",
+				 function );
+
+				goto on_error;
+			}
+			return( 1 );
+		}
+		result = 0;
+	}
+	read_count = libewf_segment_file_read_file_header(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+/* TODO deal with corrupted header ? */
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment file type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( io_handle->segment_file_type != segment_file->type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file type value mismatch.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file->major_version == 2 )
+	{
+		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_ZSTD )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_LZ4 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression method: 0x%04" PRIx16 ".",
+			 function,
+			 segment_file->compression_method );
+
+			return( -1 );
+		}
+		/* Fail early instead of reporting every compressed chunk as corrupted
+		 */
+#if !defined( HAVE_LIBZSTD ) && !defined( ZSTD_DLL )
+		if( segment_file->compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression method: zstd - libewf was built without zstd support.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+#if !defined( HAVE_LIBLZ4 ) && !defined( LZ4_DLL )
+		if( segment_file->compression_method == LIBEWF_COMPRESSION_METHOD_LZ4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression method: lz4 - libewf was built without lz4 support.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	/* Read the section descriptors:
+	 * EWF version 1 read from front to back
+	 * EWF version 2 read from back to front
+	 */
+	if( segment_file->major_version == 1 )
+	{
+		segment_file_offset = (off64_t) read_count;
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
+	}
+	last_section = 0;
+
+	if( libewf_section_initialize(
+	     &section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( segment_file_offset > 0 )
+	    && ( (size64_t) segment_file_offset < segment_file_size ) )
+	{
+		read_count = libewf_section_descriptor_read(
+			      section,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      segment_file_offset,
+			      segment_file->major_version,
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section descriptor.",
+			 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+
+			break;
+		}
+		segment_file->current_offset = segment_file_offset + read_count;
+
+		if( segment_file->major_version == 1 )
+		{
+			if( section->type == LIBEWF_SECTION_TYPE_NEXT )
+			{
+				last_section = 1;
+			}
+			else if( section->type == LIBEWF_SECTION_TYPE_DONE )
+			{
+				last_section = 1;
+
+				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_LAST;
+			}
+			segment_file->last_section_offset = segment_file_offset;
 
 			if( libfdata_list_append_element(
 			     segment_file->sections_list,
@@ -6566,39 +7161,31 @@ on_error:
 }
 
 /* Reads a chunk group
- * Callback function for the chunk groups list
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_chunk_group_element_data(
+int libewf_segment_file_read_chunk_group(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *cache,
      int file_io_pool_entry,
      off64_t chunk_group_data_offset,
      size64_t chunk_group_data_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group = NULL;
-	libewf_section_t *section         = NULL;
-	uint8_t *section_data             = NULL;
-	uint8_t *table_entries_data       = NULL;
-	static char *function             = "libewf_segment_file_read_chunk_group_element_data";
-	off64_t storage_media_offset      = 0;
-	size_t section_data_size          = 0;
-	size_t table_entries_data_size    = 0;
-	ssize_t read_count                = 0;
-	uint64_t base_offset              = 0;
-	uint64_t chunk_index              = 0;
-	uint64_t first_chunk_index        = 0;
-	uint32_t number_of_entries        = 0;
-	uint8_t entries_corrupted         = 0;
-	int result                        = 0;
-
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+	libewf_section_t *section      = NULL;
+	uint8_t *section_data          = NULL;
+	uint8_t *table_entries_data    = NULL;
+	static char *function          = "libewf_segment_file_read_chunk_group";
+	off64_t storage_media_offset   = 0;
+	size_t section_data_size       = 0;
+	size_t table_entries_data_size = 0;
+	ssize_t read_count             = 0;
+	uint64_t base_offset           = 0;
+	uint64_t chunk_index           = 0;
+	uint64_t first_chunk_index     = 0;
+	uint32_t number_of_entries     = 0;
+	uint8_t entries_corrupted      = 0;
+	int result                     = 0;
 
 	if( segment_file == NULL )
 	{
@@ -6644,6 +7231,28 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		return( -1 );
 	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk group value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_section_initialize(
 	     &section,
 	     error ) != 1 )
@@ -6771,7 +7380,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 		goto on_error;
 	}
 	if( libewf_chunk_group_initialize(
-	     &chunk_group,
+	     chunk_group,
 	     segment_file->io_handle,
 	     error ) != 1 )
 	{
@@ -6786,7 +7395,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 	}
 /* TODO set mapped offset in chunks list ?
 	if( libfdata_list_get_mapped_offset(
-	     chunk_group->chunks_list,
+	     ( *chunk_group )->chunks_list,
 	     &storage_media_offset,
 	     error ) != 1 )
 	{
@@ -6805,7 +7414,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 	if( segment_file->major_version == 1 )
 	{
 		result = libewf_chunk_group_fill_v1(
-			  chunk_group,
+			  *chunk_group,
 			  chunk_index,
 			  segment_file->io_handle->chunk_size,
 			  file_io_pool_entry,
@@ -6820,7 +7429,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 	else if( segment_file->major_version == 2 )
 	{
 		result = libewf_chunk_group_fill_v2(
-			  chunk_group,
+			  *chunk_group,
 			  chunk_index,
 			  segment_file->io_handle->chunk_size,
 			  file_io_pool_entry,
@@ -6866,7 +7475,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 		if( segment_file->major_version == 1 )
 		{
 			result = libewf_chunk_group_correct_v1(
-				  chunk_group,
+				  *chunk_group,
 			          chunk_index,
 			          segment_file->io_handle->chunk_size,
 				  file_io_pool_entry,
@@ -6891,6 +7500,69 @@ int libewf_segment_file_read_chunk_group_element_data(
 		}
 	}
 */
+	return( 1 );
+
+on_error:
+	if( *chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 chunk_group,
+		 NULL );
+	}
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a chunk group
+ * Callback function for the chunk groups list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_chunk_group_element_data(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     size64_t chunk_group_data_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_segment_file_read_chunk_group_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( libewf_segment_file_read_chunk_group(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     chunk_group_data_offset,
+	     chunk_group_data_size,
+	     &chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk group.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6904,7 +7576,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set section as element value.",
+		 "%s: unable to set chunk group as element value.",
 		 function );
 
 		goto on_error;
@@ -6918,35 +7590,32 @@ on_error:
 		 &chunk_group,
 		 NULL );
 	}
-	if( section_data != NULL )
-	{
-		memory_free(
-		 section_data );
-	}
-	if( section != NULL )
-	{
-		libewf_section_free(
-		 &section,
-		 NULL );
-	}
 	return( -1 );
 }
 
 /* Retrieves the chunk group at a specific offset
+ * The chunk group is managed by the chunk groups cache and is only valid until the next change of the cache
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int libewf_segment_file_get_chunk_group_by_offset(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      int *chunk_group_index,
      off64_t *chunk_group_data_offset,
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_file_get_chunk_group_by_offset";
-	int result            = 0;
+	libewf_chunk_group_t *read_chunk_group = NULL;
+	static char *function                  = "libewf_segment_file_get_chunk_group_by_offset";
+	off64_t element_offset                 = 0;
+	size64_t element_size                  = 0;
+	uint64_t cache_identifier              = 0;
+	uint32_t element_flags                 = 0;
+	int file_io_pool_entry                 = 0;
+	int number_of_chunks                   = 0;
+	int result                             = 0;
 
 	if( segment_file == NULL )
 	{
@@ -6959,15 +7628,37 @@ int libewf_segment_file_get_chunk_group_by_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_value_at_offset(
+	if( chunk_group_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_element_at_offset(
 		  segment_file->chunk_groups_list,
-		  (intptr_t *) file_io_pool,
-		  chunk_groups_cache,
 		  offset,
 		  chunk_group_index,
 		  chunk_group_data_offset,
-		  (intptr_t **) chunk_group,
-		  0,
+		  &file_io_pool_entry,
+		  &element_offset,
+		  &element_size,
+		  &element_flags,
 		  error );
 
 	if( result == -1 )
@@ -6976,12 +7667,111 @@ int libewf_segment_file_get_chunk_group_by_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunks list at offset: 0x%08" PRIx64 ".",
+		 "%s: unable to retrieve chunk group element at offset: 0x%08" PRIx64 ".",
 		 function,
 		 offset );
 
-		return( -1 );
+		goto on_error;
 	}
-	return( result );
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The chunk groups of all segment files share the cache
+	 */
+	cache_identifier = ( (uint64_t) file_io_pool_entry << 32 ) | (uint32_t) *chunk_group_index;
+
+	result = libewf_lru_cache_get_value(
+	          chunk_groups_cache,
+	          cache_identifier,
+	          (intptr_t **) chunk_group,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group: %d from cache.",
+		 function,
+		 *chunk_group_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_file_read_chunk_group(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     element_offset,
+	     element_size,
+	     &read_chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk group: %d.",
+		 function,
+		 *chunk_group_index );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     read_chunk_group->chunks_list,
+	     &number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunks list.",
+		 function );
+
+		goto on_error;
+	}
+	*chunk_group = read_chunk_group;
+
+	/* The chunk groups cache takes over management of the chunk group
+	 */
+	result = libewf_lru_cache_set_value(
+	          chunk_groups_cache,
+	          cache_identifier,
+	          (intptr_t *) read_chunk_group,
+	          sizeof( libewf_chunk_group_t ) + ( (size_t) number_of_chunks * LIBEWF_CHUNK_GROUP_ENTRY_SIZE ),
+	          error );
+
+	read_chunk_group = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk group: %d in cache.",
+		 function,
+		 *chunk_group_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( read_chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &read_chunk_group,
+		 NULL );
+	}
+	*chunk_group = NULL;
+
+	return( -1 );
 }
 
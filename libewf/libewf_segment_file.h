@@ -37,6 +37,7 @@
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -44,6 +45,7 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_lru_cache.h"
 #include "libewf_media_values.h"
 #include "libewf_section.h"
 #include "libewf_single_files.h"
@@ -371,6 +373,18 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_copy_to_index_file_segment(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libewf_index_file_segment_t *index_file_segment,
+     libcerror_error_t **error );
+
+int libewf_segment_file_copy_from_index_file_segment(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_segment_t *index_file_segment,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -395,6 +409,15 @@ int libewf_segment_file_read_section_element_data(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     size64_t chunk_group_data_size,
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_chunk_group_element_data(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
@@ -410,7 +433,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 int libewf_segment_file_get_chunk_group_by_offset(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfcache_cache_t *chunk_groups_cache,
+     libewf_lru_cache_t *chunk_groups_cache,
      off64_t offset,
      int *chunk_group_index,
      off64_t *chunk_group_data_offset,
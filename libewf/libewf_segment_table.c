@@ -33,6 +33,7 @@
 #include "libewf_libuna.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 /* Creates a segment table
  * Make sure the value segment_table is referencing, is set to NULL
@@ -360,7 +361,9 @@ int libewf_segment_table_clone(
 
 		goto on_error;
 	}
-	( *destination_segment_table )->maximum_segment_size = source_segment_table->maximum_segment_size;
+	( *destination_segment_table )->maximum_segment_size      = source_segment_table->maximum_segment_size;
+	( *destination_segment_table )->number_of_mapped_segments = source_segment_table->number_of_mapped_segments;
+	( *destination_segment_table )->flags                     = source_segment_table->flags;
 
 	return( 1 );
 
@@ -440,7 +443,9 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
-	segment_table->number_of_segments = 0;
+	segment_table->number_of_segments        = 0;
+	segment_table->number_of_mapped_segments = 0;
+	segment_table->flags                    &= ~( LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND );
 
 	return( result );
 }
@@ -1527,11 +1532,13 @@ int libewf_segment_table_get_segment_by_index(
 }
 
 /* Retrieves a segment at a specific offset from the segment table
+ * If the segments are mapped on demand, segments are mapped until one contains the offset
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int libewf_segment_table_get_segment_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
+     libbfio_pool_t *file_io_pool,
      int *file_io_pool_entry,
      size64_t *segment_file_size,
      libcerror_error_t **error )
@@ -1554,29 +1561,54 @@ int libewf_segment_table_get_segment_at_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_at_offset(
-	          segment_table->segment_files_list,
-	          offset,
-	          &segment_number,
-	          &segment_file_data_offset,
-	          file_io_pool_entry,
-	          &element_offset,
-	          segment_file_size,
-	          &element_flags,
-	          error );
-
-	if( result == -1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
-		 function,
-		 offset );
+		result = libfdata_list_get_element_at_offset(
+		          segment_table->segment_files_list,
+		          offset,
+		          &segment_number,
+		          &segment_file_data_offset,
+		          file_io_pool_entry,
+		          &element_offset,
+		          segment_file_size,
+		          &element_flags,
+		          error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+		result = libewf_segment_table_map_next_segment(
+		          segment_table,
+		          file_io_pool,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to map next segment.",
+			 function );
+
+			return( -1 );
+		}
 	}
+	while( result != 0 );
+
 	return( result );
 }
 
@@ -1746,10 +1778,171 @@ int libewf_segment_table_get_segment_file_by_index(
 
 		return( -1 );
 	}
+	if( ( *segment_file != NULL )
+	 && ( ( *segment_file )->io_handle != NULL )
+	 && ( ( *segment_file )->io_handle->statistics != NULL ) )
+	{
+		/* The segment file lookups are counted as hits,
+		 * the misses are counted when the segment file is read
+		 */
+		if( libewf_statistics_add(
+		     ( *segment_file )->io_handle->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_HITS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Maps the next unmapped segment to the storage media
+ * This reads the sections of the corresponding segment file
+ * Returns 1 if successful, 0 if no unmapped segments remain or -1 on error
+ */
+int libewf_segment_table_map_next_segment(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_table_map_next_segment";
+	uint32_t segment_number             = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_MAP_ON_DEMAND ) == 0 )
+	{
+		return( 0 );
+	}
+	if( segment_table->number_of_mapped_segments >= segment_table->number_of_segments )
+	{
+		return( 0 );
+	}
+	segment_number = segment_table->number_of_mapped_segments;
+
+	if( libewf_segment_table_get_segment_file_by_index(
+	     segment_table,
+	     segment_number,
+	     file_io_pool,
+	     &segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file: %" PRIu32 " - missing IO handle.",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( segment_file->segment_number != ( segment_number + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+		 function,
+		 segment_file->segment_number,
+		 segment_number + 1 );
+
+		return( -1 );
+	}
+	if( ( segment_file->major_version != segment_file->io_handle->major_version )
+	 || ( segment_file->minor_version != segment_file->io_handle->minor_version ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file format version value mismatch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->major_version == 2 )
+	 && ( segment_file->compression_method != segment_file->io_handle->compression_method ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file compression method value mismatch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	}
+	if( libewf_segment_table_set_segment_storage_media_size_by_index(
+	     segment_table,
+	     segment_number,
+	     segment_file->storage_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set mapped range of segment: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	segment_table->number_of_mapped_segments += 1;
+
 	return( 1 );
 }
 
 /* Retrieves a segment file at a specific offset from the segment table
+ * If the segments are mapped on demand, segments are mapped until one contains the offset
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int libewf_segment_table_get_segment_file_at_offset(
@@ -1787,30 +1980,55 @@ int libewf_segment_table_get_segment_file_at_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_value_at_offset(
-	          segment_table->segment_files_list,
-	          (intptr_t *) file_io_pool,
-	          segment_table->segment_files_cache,
-	          offset,
-	          &segment_files_list_index,
-	          segment_file_data_offset,
-	          (intptr_t **) segment_file,
-	          0,
-	          error );
-
-	if( result == -1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
-		 function,
-		 offset );
+		result = libfdata_list_get_element_value_at_offset(
+		          segment_table->segment_files_list,
+		          (intptr_t *) file_io_pool,
+		          segment_table->segment_files_cache,
+		          offset,
+		          &segment_files_list_index,
+		          segment_file_data_offset,
+		          (intptr_t **) segment_file,
+		          0,
+		          error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+		result = libewf_segment_table_map_next_segment(
+		          segment_table,
+		          file_io_pool,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to map next segment.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	else if( result != 0 )
+	while( result != 0 );
+
+	if( result != 0 )
 	{
 #if SIZEOF_INT <= 4
 		if( segment_files_list_index < 0 )
@@ -1829,6 +2047,30 @@ int libewf_segment_table_get_segment_file_at_offset(
 			return( -1 );
 		}
 		*segment_number = (uint32_t) segment_files_list_index;
+
+		if( ( *segment_file != NULL )
+		 && ( ( *segment_file )->io_handle != NULL )
+		 && ( ( *segment_file )->io_handle->statistics != NULL ) )
+		{
+			/* The segment file lookups are counted as hits,
+			 * the misses are counted when the segment file is read
+			 */
+			if( libewf_statistics_add(
+			     ( *segment_file )->io_handle->statistics,
+			     LIBEWF_STATISTIC_SEGMENT_FILES_CACHE_HITS,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
 	}
 	return( result );
 }
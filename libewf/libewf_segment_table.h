@@ -61,6 +61,11 @@ struct libewf_segment_table
 	 */
 	uint32_t number_of_segments;
 
+	/* The number of segments that are mapped to the storage media
+	 * if the segments are mapped on demand the segments are mapped in order
+	 */
+	uint32_t number_of_mapped_segments;
+
 	/* The segment files cache
 	 */
 	libfcache_cache_t *segment_files_cache;
@@ -147,6 +152,7 @@ int libewf_segment_table_get_segment_by_index(
 int libewf_segment_table_get_segment_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
+     libbfio_pool_t *file_io_pool,
      int *file_io_pool_entry,
      size64_t *segment_file_size,
      libcerror_error_t **error );
@@ -170,6 +176,11 @@ int libewf_segment_table_get_segment_file_by_index(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+int libewf_segment_table_map_next_segment(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_file_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
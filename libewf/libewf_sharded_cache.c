@@ -0,0 +1,1171 @@
+/*
+ * Sharded cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_lru_cache.h"
+#include "libewf_sharded_cache.h"
+
+/* Creates a cache
+ * Make sure the value cache is referencing, is set to NULL
+ * The maximum size is divided evenly over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_initialize(
+     libewf_sharded_cache_t **cache,
+     int number_of_shards,
+     size64_t maximum_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_initialize";
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of shards value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*cache = memory_allocate_structure(
+	          libewf_sharded_cache_t );
+
+	if( *cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cache,
+	     0,
+	     sizeof( libewf_sharded_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cache.",
+		 function );
+
+		memory_free(
+		 *cache );
+
+		*cache = NULL;
+
+		return( -1 );
+	}
+	( *cache )->shards = (libewf_lru_cache_t **) memory_allocate(
+	                                              sizeof( libewf_lru_cache_t * ) * number_of_shards );
+
+	if( ( *cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *cache )->shards,
+	     0,
+	     sizeof( libewf_lru_cache_t * ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *cache )->mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                sizeof( libcthreads_mutex_t * ) * number_of_shards );
+
+	if( ( *cache )->mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *cache )->mutexes,
+	     0,
+	     sizeof( libcthreads_mutex_t * ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mutexes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libewf_lru_cache_initialize(
+		     &( ( *cache )->shards[ shard_index ] ),
+		     maximum_size / number_of_shards,
+		     free_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( ( *cache )->mutexes[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *cache != NULL )
+	{
+		libewf_sharded_cache_free(
+		 cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_free(
+     libewf_sharded_cache_t **cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_free";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache != NULL )
+	{
+		if( ( *cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *cache )->number_of_shards;
+			     shard_index++ )
+			{
+				if( ( *cache )->shards[ shard_index ] == NULL )
+				{
+					continue;
+				}
+				if( libewf_lru_cache_free(
+				     &( ( *cache )->shards[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *cache )->shards );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *cache )->mutexes != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *cache )->number_of_shards;
+			     shard_index++ )
+			{
+				if( ( *cache )->mutexes[ shard_index ] == NULL )
+				{
+					continue;
+				}
+				if( libcthreads_mutex_free(
+				     &( ( *cache )->mutexes[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free mutex: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *cache )->mutexes );
+		}
+#endif
+		memory_free(
+		 *cache );
+
+		*cache = NULL;
+	}
+	return( result );
+}
+
+/* Clones the cache
+ * The cached values are not cloned, the destination cache is empty
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_clone(
+     libewf_sharded_cache_t **destination_cache,
+     libewf_sharded_cache_t *source_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_clone";
+
+	if( destination_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_cache == NULL )
+	{
+		*destination_cache = NULL;
+
+		return( 1 );
+	}
+	if( libewf_sharded_cache_initialize(
+	     destination_cache,
+	     source_cache->number_of_shards,
+	     source_cache->shards[ 0 ]->maximum_size * source_cache->number_of_shards,
+	     source_cache->shards[ 0 ]->free_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a value from the cache and grabs the shard that contains it
+ * The value remains valid until the shard is released by libewf_sharded_cache_release_value,
+ * which must be called if a value was retrieved
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libewf_sharded_cache_grab_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_grab_value";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_lru_cache_get_value(
+	          cache->shards[ shard_index ],
+	          identifier,
+	          value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value: %" PRIu64 " from shard: %d.",
+		 function,
+		 identifier,
+		 shard_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( result != 1 )
+	{
+		if( libcthreads_mutex_release(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Releases the shard that contains a value retrieved by libewf_sharded_cache_grab_value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_release_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_release_value";
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets a value in the cache
+ * The cache takes over management of the value, also on error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_set_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_set_value";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		cache->shards[ shard_index ]->free_value(
+		 &value,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_lru_cache_set_value(
+	          cache->shards[ shard_index ],
+	          identifier,
+	          value,
+	          value_size,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value: %" PRIu64 " in shard: %d.",
+		 function,
+		 identifier,
+		 shard_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Pins a value in the cache
+ * A pinned value is not evicted and remains valid until it is unpinned
+ * by libewf_sharded_cache_unpin_value, unlike libewf_sharded_cache_grab_value
+ * the shard is not held
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libewf_sharded_cache_pin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_pin_value";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_lru_cache_pin_value(
+	          cache->shards[ shard_index ],
+	          identifier,
+	          value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pin value: %" PRIu64 " in shard: %d.",
+		 function,
+		 identifier,
+		 shard_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets a value in the cache and pins it
+ * The cache takes over management of the value, also on error
+ * If a pinned value with the same identifier is already cached that value
+ * is pinned and returned instead and the value is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_set_and_pin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_set_and_pin_value";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		cache->shards[ shard_index ]->free_value(
+		 value,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_lru_cache_set_value(
+	          cache->shards[ shard_index ],
+	          identifier,
+	          *value,
+	          value_size,
+	          error );
+
+	*value = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value: %" PRIu64 " in shard: %d.",
+		 function,
+		 identifier,
+		 shard_index );
+	}
+	else
+	{
+		/* The value was set as the most recently used entry and cannot have been evicted
+		 */
+		result = libewf_lru_cache_pin_value(
+		          cache->shards[ shard_index ],
+		          identifier,
+		          value,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pin value: %" PRIu64 " in shard: %d.",
+			 function,
+			 identifier,
+			 shard_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Unpins a value pinned by libewf_sharded_cache_pin_value or libewf_sharded_cache_set_and_pin_value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_unpin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_unpin_value";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( identifier % cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_lru_cache_unpin_value(
+	          cache->shards[ shard_index ],
+	          identifier,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unpin value: %" PRIu64 " in shard: %d.",
+		 function,
+		 identifier,
+		 shard_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum size of the cached values
+ * The maximum size is divided evenly over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_set_maximum_size(
+     libewf_sharded_cache_t *cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_cache_set_maximum_size";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libewf_lru_cache_set_maximum_size(
+		     cache->shards[ shard_index ],
+		     maximum_size / cache->number_of_shards,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the cache statistics, the sum of the statistics of the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_get_statistics(
+     libewf_sharded_cache_t *cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
+{
+	static char *function              = "libewf_sharded_cache_get_statistics";
+	uint64_t shard_number_of_evictions = 0;
+	uint64_t shard_number_of_hits      = 0;
+	uint64_t shard_number_of_misses    = 0;
+	int result                         = 1;
+	int shard_index                    = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of evictions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits      = 0;
+	*number_of_misses    = 0;
+	*number_of_evictions = 0;
+
+	for( shard_index = 0;
+	     shard_index < cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		result = libewf_lru_cache_get_statistics(
+		          cache->shards[ shard_index ],
+		          &shard_number_of_hits,
+		          &shard_number_of_misses,
+		          &shard_number_of_evictions,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics of shard: %d.",
+			 function,
+			 shard_index );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		*number_of_hits      += shard_number_of_hits;
+		*number_of_misses    += shard_number_of_misses;
+		*number_of_evictions += shard_number_of_evictions;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of pins of the cached values, the sum of the number of pins of the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_cache_get_number_of_pins(
+     libewf_sharded_cache_t *cache,
+     int *number_of_pins,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_sharded_cache_get_number_of_pins";
+	int result               = 1;
+	int shard_index          = 0;
+	int shard_number_of_pins = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pins == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pins.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_pins = 0;
+
+	for( shard_index = 0;
+	     shard_index < cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		result = libewf_lru_cache_get_number_of_pins(
+		          cache->shards[ shard_index ],
+		          &shard_number_of_pins,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of pins of shard: %d.",
+			 function,
+			 shard_index );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		*number_of_pins += shard_number_of_pins;
+	}
+	return( 1 );
+}
+
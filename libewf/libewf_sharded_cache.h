@@ -0,0 +1,131 @@
+/*
+ * Sharded cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARDED_CACHE_H )
+#define _LIBEWF_SHARDED_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_lru_cache.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_sharded_cache libewf_sharded_cache_t;
+
+struct libewf_sharded_cache
+{
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards, a least recently used cache per shard
+	 */
+	libewf_lru_cache_t **shards;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutexes, one per shard
+	 */
+	libcthreads_mutex_t **mutexes;
+#endif
+};
+
+int libewf_sharded_cache_initialize(
+     libewf_sharded_cache_t **cache,
+     int number_of_shards,
+     size64_t maximum_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_free(
+     libewf_sharded_cache_t **cache,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_clone(
+     libewf_sharded_cache_t **destination_cache,
+     libewf_sharded_cache_t *source_cache,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_grab_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_release_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_set_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_pin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_set_and_pin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     size_t value_size,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_unpin_value(
+     libewf_sharded_cache_t *cache,
+     uint64_t identifier,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_set_maximum_size(
+     libewf_sharded_cache_t *cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_get_statistics(
+     libewf_sharded_cache_t *cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+int libewf_sharded_cache_get_number_of_pins(
+     libewf_sharded_cache_t *cache,
+     int *number_of_pins,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARDED_CACHE_H ) */
+
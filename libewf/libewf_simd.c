@@ -0,0 +1,979 @@
+/*
+ * SIMD (Single Instruction Multiple Data) functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_simd.h"
+
+#if defined( LIBEWF_SIMD_HAVE_SSE2 ) || defined( LIBEWF_SIMD_HAVE_AVX2 )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+#include <arm_neon.h>
+#endif
+
+#if defined( LIBEWF_SIMD_HAVE_X86_ATTRIBUTES )
+#define LIBEWF_SIMD_TARGET_SSE2	__attribute__((target("sse2")))
+#define LIBEWF_SIMD_TARGET_AVX2	__attribute__((target("avx2")))
+#else
+#define LIBEWF_SIMD_TARGET_SSE2
+#define LIBEWF_SIMD_TARGET_AVX2
+#endif
+
+/* The supported instruction sets, -1 if not yet determined
+ * Concurrent callers determine and store the same value
+ */
+static int libewf_simd_supported_instruction_sets = -1;
+
+/* Retrieves the instruction sets supported by both the build and the CPU
+ * Returns a bitmask of LIBEWF_SIMD_INSTRUCTION_SET values
+ */
+int libewf_simd_get_supported_instruction_sets(
+     void )
+{
+	int instruction_sets = LIBEWF_SIMD_INSTRUCTION_SET_NONE;
+
+#if defined( _MSC_VER ) && defined( LIBEWF_SIMD_HAVE_AVX2 )
+	int cpu_information[ 4 ];
+#endif
+
+	if( libewf_simd_supported_instruction_sets != -1 )
+	{
+		return( libewf_simd_supported_instruction_sets );
+	}
+#if defined( LIBEWF_SIMD_HAVE_X86_ATTRIBUTES )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "sse2" ) )
+	{
+		instruction_sets |= LIBEWF_SIMD_INSTRUCTION_SET_SSE2;
+	}
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		instruction_sets |= LIBEWF_SIMD_INSTRUCTION_SET_AVX2;
+	}
+#elif defined( _MSC_VER ) && defined( LIBEWF_SIMD_HAVE_AVX2 )
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] >= 1 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		if( ( cpu_information[ 3 ] & ( 1 << 26 ) ) != 0 )
+		{
+			instruction_sets |= LIBEWF_SIMD_INSTRUCTION_SET_SSE2;
+		}
+		/* AVX2 requires OSXSAVE, AVX and the operating system to save the YMM registers
+		 */
+		if( ( ( cpu_information[ 2 ] & ( 1 << 27 ) ) != 0 )
+		 && ( ( cpu_information[ 2 ] & ( 1 << 28 ) ) != 0 )
+		 && ( ( _xgetbv( 0 ) & 0x06 ) == 0x06 ) )
+		{
+			__cpuidex(
+			 cpu_information,
+			 7,
+			 0 );
+
+			if( ( cpu_information[ 1 ] & ( 1 << 5 ) ) != 0 )
+			{
+				instruction_sets |= LIBEWF_SIMD_INSTRUCTION_SET_AVX2;
+			}
+		}
+	}
+#elif defined( LIBEWF_SIMD_HAVE_NEON )
+	/* NEON is part of the target architecture when it is available at compile time
+	 */
+	instruction_sets |= LIBEWF_SIMD_INSTRUCTION_SET_NEON;
+#endif
+	libewf_simd_supported_instruction_sets = instruction_sets;
+
+	return( instruction_sets );
+}
+
+/* Retrieves the fastest instruction set supported by both the build and the CPU
+ * Returns a LIBEWF_SIMD_INSTRUCTION_SET value
+ */
+int libewf_simd_get_best_instruction_set(
+     void )
+{
+	int instruction_sets = libewf_simd_get_supported_instruction_sets();
+
+	if( ( instruction_sets & LIBEWF_SIMD_INSTRUCTION_SET_AVX2 ) != 0 )
+	{
+		return( LIBEWF_SIMD_INSTRUCTION_SET_AVX2 );
+	}
+	if( ( instruction_sets & LIBEWF_SIMD_INSTRUCTION_SET_SSE2 ) != 0 )
+	{
+		return( LIBEWF_SIMD_INSTRUCTION_SET_SSE2 );
+	}
+	if( ( instruction_sets & LIBEWF_SIMD_INSTRUCTION_SET_NEON ) != 0 )
+	{
+		return( LIBEWF_SIMD_INSTRUCTION_SET_NEON );
+	}
+	return( LIBEWF_SIMD_INSTRUCTION_SET_NONE );
+}
+
+/* Determines if the data consists of a repeating 64-bit pattern using 64-bit words
+ * The pattern data contains the pattern repeated 4 times (32 bytes)
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+int libewf_simd_check_for_64_bit_pattern_fill_generic(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data )
+{
+	const uint64_t *aligned_data_index = NULL;
+	const uint8_t *data_index          = NULL;
+	uint64_t aligned_pattern           = 0;
+	size_t data_offset                 = 0;
+
+	data_index = data;
+
+	/* Align the data index, the pattern is shifted by the number of bytes
+	 * needed to align the data index
+	 */
+	while( ( data_size > 0 )
+	    && ( ( (intptr_t) data_index % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( *data_index != pattern_data[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_offset++;
+		data_size--;
+	}
+	if( data_size >= sizeof( uint64_t ) )
+	{
+		memory_copy(
+		 &aligned_pattern,
+		 &( pattern_data[ data_offset % 8 ] ),
+		 sizeof( uint64_t ) );
+
+		aligned_data_index = (const uint64_t *) data_index;
+
+		while( data_size >= sizeof( uint64_t ) )
+		{
+			if( *aligned_data_index != aligned_pattern )
+			{
+				return( 0 );
+			}
+			aligned_data_index++;
+
+			data_size -= sizeof( uint64_t );
+		}
+		data_index = (const uint8_t *) aligned_data_index;
+	}
+	while( data_size > 0 )
+	{
+		if( *data_index != pattern_data[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_offset++;
+		data_size--;
+	}
+	return( 1 );
+}
+
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+
+/* Determines if the data consists of a repeating 64-bit pattern using SSE2
+ * The pattern data contains the pattern repeated 4 times (32 bytes)
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+LIBEWF_SIMD_TARGET_SSE2
+int libewf_simd_check_for_64_bit_pattern_fill_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data )
+{
+	__m128i pattern_vector = _mm_loadu_si128(
+	                          (const __m128i *) pattern_data );
+
+	__m128i difference_vector1;
+	__m128i difference_vector2;
+	__m128i difference_vector3;
+	__m128i difference_vector4;
+
+	/* Compare 64 bytes per iteration, since 64 is a multiple of 8
+	 * the pattern remains aligned with the data
+	 */
+	while( data_size >= 64 )
+	{
+		difference_vector1 = _mm_xor_si128(
+		                      _mm_loadu_si128( (const __m128i *) data ),
+		                      pattern_vector );
+		difference_vector2 = _mm_xor_si128(
+		                      _mm_loadu_si128( (const __m128i *) &( data[ 16 ] ) ),
+		                      pattern_vector );
+		difference_vector3 = _mm_xor_si128(
+		                      _mm_loadu_si128( (const __m128i *) &( data[ 32 ] ) ),
+		                      pattern_vector );
+		difference_vector4 = _mm_xor_si128(
+		                      _mm_loadu_si128( (const __m128i *) &( data[ 48 ] ) ),
+		                      pattern_vector );
+
+		difference_vector1 = _mm_or_si128(
+		                      _mm_or_si128( difference_vector1, difference_vector2 ),
+		                      _mm_or_si128( difference_vector3, difference_vector4 ) );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( difference_vector1, _mm_setzero_si128() ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data      += 64;
+		data_size -= 64;
+	}
+	return( libewf_simd_check_for_64_bit_pattern_fill_generic(
+	         data,
+	         data_size,
+	         pattern_data ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+
+/* Determines if the data consists of a repeating 64-bit pattern using AVX2
+ * The pattern data contains the pattern repeated 4 times (32 bytes)
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+LIBEWF_SIMD_TARGET_AVX2
+int libewf_simd_check_for_64_bit_pattern_fill_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data )
+{
+	__m256i pattern_vector = _mm256_loadu_si256(
+	                          (const __m256i *) pattern_data );
+
+	__m256i difference_vector1;
+	__m256i difference_vector2;
+	__m256i difference_vector3;
+	__m256i difference_vector4;
+
+	/* Compare 128 bytes per iteration, since 128 is a multiple of 8
+	 * the pattern remains aligned with the data
+	 */
+	while( data_size >= 128 )
+	{
+		difference_vector1 = _mm256_xor_si256(
+		                      _mm256_loadu_si256( (const __m256i *) data ),
+		                      pattern_vector );
+		difference_vector2 = _mm256_xor_si256(
+		                      _mm256_loadu_si256( (const __m256i *) &( data[ 32 ] ) ),
+		                      pattern_vector );
+		difference_vector3 = _mm256_xor_si256(
+		                      _mm256_loadu_si256( (const __m256i *) &( data[ 64 ] ) ),
+		                      pattern_vector );
+		difference_vector4 = _mm256_xor_si256(
+		                      _mm256_loadu_si256( (const __m256i *) &( data[ 96 ] ) ),
+		                      pattern_vector );
+
+		difference_vector1 = _mm256_or_si256(
+		                      _mm256_or_si256( difference_vector1, difference_vector2 ),
+		                      _mm256_or_si256( difference_vector3, difference_vector4 ) );
+
+		if( _mm256_testz_si256( difference_vector1, difference_vector1 ) == 0 )
+		{
+			return( 0 );
+		}
+		data      += 128;
+		data_size -= 128;
+	}
+	return( libewf_simd_check_for_64_bit_pattern_fill_generic(
+	         data,
+	         data_size,
+	         pattern_data ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+
+/* Determines if the data consists of a repeating 64-bit pattern using NEON
+ * The pattern data contains the pattern repeated 4 times (32 bytes)
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+int libewf_simd_check_for_64_bit_pattern_fill_neon(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data )
+{
+	uint8x16_t pattern_vector = vld1q_u8(
+	                             pattern_data );
+
+	uint8x16_t difference_vector1;
+	uint8x16_t difference_vector2;
+	uint8x16_t difference_vector3;
+	uint8x16_t difference_vector4;
+	uint64x2_t difference_words;
+
+	/* Compare 64 bytes per iteration, since 64 is a multiple of 8
+	 * the pattern remains aligned with the data
+	 */
+	while( data_size >= 64 )
+	{
+		difference_vector1 = veorq_u8(
+		                      vld1q_u8( data ),
+		                      pattern_vector );
+		difference_vector2 = veorq_u8(
+		                      vld1q_u8( &( data[ 16 ] ) ),
+		                      pattern_vector );
+		difference_vector3 = veorq_u8(
+		                      vld1q_u8( &( data[ 32 ] ) ),
+		                      pattern_vector );
+		difference_vector4 = veorq_u8(
+		                      vld1q_u8( &( data[ 48 ] ) ),
+		                      pattern_vector );
+
+		difference_vector1 = vorrq_u8(
+		                      vorrq_u8( difference_vector1, difference_vector2 ),
+		                      vorrq_u8( difference_vector3, difference_vector4 ) );
+
+		difference_words = vreinterpretq_u64_u8(
+		                    difference_vector1 );
+
+		if( ( vgetq_lane_u64( difference_words, 0 ) | vgetq_lane_u64( difference_words, 1 ) ) != 0 )
+		{
+			return( 0 );
+		}
+		data      += 64;
+		data_size -= 64;
+	}
+	return( libewf_simd_check_for_64_bit_pattern_fill_generic(
+	         data,
+	         data_size,
+	         pattern_data ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_NEON ) */
+
+/* Determines if the data consists of a repeating 64-bit pattern
+ * The pattern is stored in little-endian, the data size does not need to be a multiple of 8
+ * The instruction set should be supported, LIBEWF_SIMD_INSTRUCTION_SET_NONE uses 64-bit words
+ * Returns 1 if the data consists of the pattern, 0 if not or -1 on error
+ */
+int libewf_simd_check_for_64_bit_pattern_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern,
+     int instruction_set,
+     libcerror_error_t **error )
+{
+	uint8_t pattern_data[ 32 ];
+
+	static char *function = "libewf_simd_check_for_64_bit_pattern_fill";
+	int result            = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( instruction_set != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+	 && ( ( libewf_simd_get_supported_instruction_sets() & instruction_set ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported instruction set: 0x%02x.",
+		 function,
+		 instruction_set );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 pattern_data,
+	 pattern );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( pattern_data[ 8 ] ),
+	 pattern );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( pattern_data[ 16 ] ),
+	 pattern );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( pattern_data[ 24 ] ),
+	 pattern );
+
+	switch( instruction_set )
+	{
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+		case LIBEWF_SIMD_INSTRUCTION_SET_AVX2:
+			result = libewf_simd_check_for_64_bit_pattern_fill_avx2(
+			          data,
+			          data_size,
+			          pattern_data );
+			break;
+#endif
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+		case LIBEWF_SIMD_INSTRUCTION_SET_SSE2:
+			result = libewf_simd_check_for_64_bit_pattern_fill_sse2(
+			          data,
+			          data_size,
+			          pattern_data );
+			break;
+#endif
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+		case LIBEWF_SIMD_INSTRUCTION_SET_NEON:
+			result = libewf_simd_check_for_64_bit_pattern_fill_neon(
+			          data,
+			          data_size,
+			          pattern_data );
+			break;
+#endif
+		case LIBEWF_SIMD_INSTRUCTION_SET_NONE:
+			result = libewf_simd_check_for_64_bit_pattern_fill_generic(
+			          data,
+			          data_size,
+			          pattern_data );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported instruction set: 0x%02x.",
+			 function,
+			 instruction_set );
+
+			return( -1 );
+	}
+	return( result );
+}
+
+/* Calculates the Adler-32 of a buffer one byte at a time
+ * The modulo calculation is needed per LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE bytes
+ * to prevent the upper word from overflowing
+ * Returns the Adler-32
+ */
+uint32_t libewf_simd_calculate_adler32_generic(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	size_t block_size   = 0;
+	uint32_t lower_word = initial_value & 0x0000ffffUL;
+	uint32_t upper_word = ( initial_value >> 16 ) & 0x0000ffffUL;
+
+	while( size > 0 )
+	{
+		if( size > LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		else
+		{
+			block_size = size;
+		}
+		size -= block_size;
+
+		while( block_size >= 8 )
+		{
+			lower_word += buffer[ 0 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 1 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 2 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 3 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 4 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 5 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 6 ];
+			upper_word += lower_word;
+			lower_word += buffer[ 7 ];
+			upper_word += lower_word;
+
+			buffer     += 8;
+			block_size -= 8;
+		}
+		while( block_size > 0 )
+		{
+			lower_word += *buffer;
+			upper_word += lower_word;
+
+			buffer++;
+			block_size--;
+		}
+		lower_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+		upper_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+
+/* Calculates the Adler-32 of a buffer using SSE2
+ * Every block of 16 bytes adds 16 times the lower word to the upper word,
+ * this is accumulated separately and multiplied once per maximum block size
+ * Returns the Adler-32
+ */
+LIBEWF_SIMD_TARGET_SSE2
+uint32_t libewf_simd_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i data_vector;
+	__m128i lower_sum_vector;
+	__m128i previous_lower_sum_vector;
+	__m128i upper_sum_vector;
+
+	__m128i upper_weights_vector = _mm_setr_epi16(
+	                                16, 15, 14, 13, 12, 11, 10, 9 );
+
+	__m128i lower_weights_vector = _mm_setr_epi16(
+	                                8, 7, 6, 5, 4, 3, 2, 1 );
+
+	__m128i zero_vector          = _mm_setzero_si128();
+	size_t number_of_blocks      = 0;
+	uint32_t lower_word          = initial_value & 0x0000ffffUL;
+	uint32_t upper_word          = ( initial_value >> 16 ) & 0x0000ffffUL;
+
+	while( size >= 16 )
+	{
+		number_of_blocks = size / 16;
+
+		if( number_of_blocks > ( LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 16 ) )
+		{
+			number_of_blocks = LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 16;
+		}
+		size       -= number_of_blocks * 16;
+		upper_word += lower_word * (uint32_t) ( number_of_blocks * 16 );
+
+		lower_sum_vector          = _mm_setzero_si128();
+		previous_lower_sum_vector = _mm_setzero_si128();
+		upper_sum_vector          = _mm_setzero_si128();
+
+		while( number_of_blocks > 0 )
+		{
+			data_vector = _mm_loadu_si128(
+			               (const __m128i *) buffer );
+
+			previous_lower_sum_vector = _mm_add_epi32(
+			                             previous_lower_sum_vector,
+			                             lower_sum_vector );
+
+			lower_sum_vector = _mm_add_epi32(
+			                    lower_sum_vector,
+			                    _mm_sad_epu8( data_vector, zero_vector ) );
+
+			upper_sum_vector = _mm_add_epi32(
+			                    upper_sum_vector,
+			                    _mm_madd_epi16( _mm_unpacklo_epi8( data_vector, zero_vector ), upper_weights_vector ) );
+
+			upper_sum_vector = _mm_add_epi32(
+			                    upper_sum_vector,
+			                    _mm_madd_epi16( _mm_unpackhi_epi8( data_vector, zero_vector ), lower_weights_vector ) );
+
+			buffer += 16;
+
+			number_of_blocks--;
+		}
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_slli_epi32( previous_lower_sum_vector, 4 ) );
+
+		/* Add the 4 32-bit values of the sum vectors
+		 */
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_shuffle_epi32( lower_sum_vector, 0x4e ) );
+		lower_sum_vector = _mm_add_epi32(
+		                    lower_sum_vector,
+		                    _mm_shuffle_epi32( lower_sum_vector, 0xb1 ) );
+
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_shuffle_epi32( upper_sum_vector, 0x4e ) );
+		upper_sum_vector = _mm_add_epi32(
+		                    upper_sum_vector,
+		                    _mm_shuffle_epi32( upper_sum_vector, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_sum_vector );
+		upper_word += (uint32_t) _mm_cvtsi128_si32( upper_sum_vector );
+
+		lower_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+		upper_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+	}
+	return( libewf_simd_calculate_adler32_generic(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+
+/* Calculates the Adler-32 of a buffer using AVX2
+ * Every block of 32 bytes adds 32 times the lower word to the upper word,
+ * this is accumulated separately and multiplied once per maximum block size
+ * Returns the Adler-32
+ */
+LIBEWF_SIMD_TARGET_AVX2
+uint32_t libewf_simd_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	__m128i sum_vector;
+	__m256i data_vector;
+	__m256i lower_sum_vector;
+	__m256i previous_lower_sum_vector;
+	__m256i upper_sum_vector;
+
+	__m256i weights_vector  = _mm256_setr_epi8(
+	                           32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+
+	__m256i ones_vector     = _mm256_set1_epi16(
+	                           1 );
+
+	__m256i zero_vector     = _mm256_setzero_si256();
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = initial_value & 0x0000ffffUL;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0x0000ffffUL;
+
+	while( size >= 32 )
+	{
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > ( LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 32 ) )
+		{
+			number_of_blocks = LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 32;
+		}
+		size       -= number_of_blocks * 32;
+		upper_word += lower_word * (uint32_t) ( number_of_blocks * 32 );
+
+		lower_sum_vector          = _mm256_setzero_si256();
+		previous_lower_sum_vector = _mm256_setzero_si256();
+		upper_sum_vector          = _mm256_setzero_si256();
+
+		while( number_of_blocks > 0 )
+		{
+			data_vector = _mm256_loadu_si256(
+			               (const __m256i *) buffer );
+
+			previous_lower_sum_vector = _mm256_add_epi32(
+			                             previous_lower_sum_vector,
+			                             lower_sum_vector );
+
+			lower_sum_vector = _mm256_add_epi32(
+			                    lower_sum_vector,
+			                    _mm256_sad_epu8( data_vector, zero_vector ) );
+
+			/* The weighted byte pairs fit in 16-bit: 255 * 32 + 255 * 31 = 16065
+			 */
+			upper_sum_vector = _mm256_add_epi32(
+			                    upper_sum_vector,
+			                    _mm256_madd_epi16( _mm256_maddubs_epi16( data_vector, weights_vector ), ones_vector ) );
+
+			buffer += 32;
+
+			number_of_blocks--;
+		}
+		upper_sum_vector = _mm256_add_epi32(
+		                    upper_sum_vector,
+		                    _mm256_slli_epi32( previous_lower_sum_vector, 5 ) );
+
+		/* Add the 8 32-bit values of the sum vectors
+		 */
+		sum_vector = _mm_add_epi32(
+		              _mm256_castsi256_si128( lower_sum_vector ),
+		              _mm256_extracti128_si256( lower_sum_vector, 1 ) );
+		sum_vector = _mm_add_epi32(
+		              sum_vector,
+		              _mm_shuffle_epi32( sum_vector, 0x4e ) );
+		sum_vector = _mm_add_epi32(
+		              sum_vector,
+		              _mm_shuffle_epi32( sum_vector, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( sum_vector );
+
+		sum_vector = _mm_add_epi32(
+		              _mm256_castsi256_si128( upper_sum_vector ),
+		              _mm256_extracti128_si256( upper_sum_vector, 1 ) );
+		sum_vector = _mm_add_epi32(
+		              sum_vector,
+		              _mm_shuffle_epi32( sum_vector, 0x4e ) );
+		sum_vector = _mm_add_epi32(
+		              sum_vector,
+		              _mm_shuffle_epi32( sum_vector, 0xb1 ) );
+
+		upper_word += (uint32_t) _mm_cvtsi128_si32( sum_vector );
+
+		lower_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+		upper_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+	}
+	return( libewf_simd_calculate_adler32_generic(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+
+/* Calculates the Adler-32 of a buffer using NEON
+ * Every block of 16 bytes adds 16 times the lower word to the upper word,
+ * this is accumulated separately and multiplied once per maximum block size
+ * Returns the Adler-32
+ */
+uint32_t libewf_simd_calculate_adler32_neon(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	static const uint8_t weights_data[ 16 ] = {
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint8x16_t data_vector;
+	uint16x8_t weighted_sum_vector;
+	uint32x4_t lower_sum_vector;
+	uint32x4_t previous_lower_sum_vector;
+	uint32x4_t upper_sum_vector;
+
+	uint8x8_t upper_weights_vector = vld1_u8(
+	                                  weights_data );
+
+	uint8x8_t lower_weights_vector = vld1_u8(
+	                                  &( weights_data[ 8 ] ) );
+
+	size_t number_of_blocks        = 0;
+	uint32_t lower_word            = initial_value & 0x0000ffffUL;
+	uint32_t upper_word            = ( initial_value >> 16 ) & 0x0000ffffUL;
+
+	while( size >= 16 )
+	{
+		number_of_blocks = size / 16;
+
+		if( number_of_blocks > ( LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 16 ) )
+		{
+			number_of_blocks = LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE / 16;
+		}
+		size       -= number_of_blocks * 16;
+		upper_word += lower_word * (uint32_t) ( number_of_blocks * 16 );
+
+		lower_sum_vector          = vdupq_n_u32( 0 );
+		previous_lower_sum_vector = vdupq_n_u32( 0 );
+		upper_sum_vector          = vdupq_n_u32( 0 );
+
+		while( number_of_blocks > 0 )
+		{
+			data_vector = vld1q_u8(
+			               buffer );
+
+			previous_lower_sum_vector = vaddq_u32(
+			                             previous_lower_sum_vector,
+			                             lower_sum_vector );
+
+			lower_sum_vector = vpadalq_u16(
+			                    lower_sum_vector,
+			                    vpaddlq_u8( data_vector ) );
+
+			weighted_sum_vector = vmull_u8(
+			                       vget_low_u8( data_vector ),
+			                       upper_weights_vector );
+
+			weighted_sum_vector = vmlal_u8(
+			                       weighted_sum_vector,
+			                       vget_high_u8( data_vector ),
+			                       lower_weights_vector );
+
+			upper_sum_vector = vpadalq_u16(
+			                    upper_sum_vector,
+			                    weighted_sum_vector );
+
+			buffer += 16;
+
+			number_of_blocks--;
+		}
+		upper_sum_vector = vaddq_u32(
+		                    upper_sum_vector,
+		                    vshlq_n_u32( previous_lower_sum_vector, 4 ) );
+
+		lower_word += vgetq_lane_u32( lower_sum_vector, 0 )
+		            + vgetq_lane_u32( lower_sum_vector, 1 )
+		            + vgetq_lane_u32( lower_sum_vector, 2 )
+		            + vgetq_lane_u32( lower_sum_vector, 3 );
+
+		upper_word += vgetq_lane_u32( upper_sum_vector, 0 )
+		            + vgetq_lane_u32( upper_sum_vector, 1 )
+		            + vgetq_lane_u32( upper_sum_vector, 2 )
+		            + vgetq_lane_u32( upper_sum_vector, 3 );
+
+		lower_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+		upper_word %= LIBEWF_SIMD_ADLER32_MODULUS;
+	}
+	return( libewf_simd_calculate_adler32_generic(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+#endif /* defined( LIBEWF_SIMD_HAVE_NEON ) */
+
+/* Calculates the little-endian Adler-32 of a buffer
+ * It uses the initial value to calculate a new Adler-32
+ * The instruction set should be supported, LIBEWF_SIMD_INSTRUCTION_SET_NONE processes one byte at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_simd_calculate_adler32(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     int instruction_set,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_simd_calculate_adler32";
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( instruction_set != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+	 && ( ( libewf_simd_get_supported_instruction_sets() & instruction_set ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported instruction set: 0x%02x.",
+		 function,
+		 instruction_set );
+
+		return( -1 );
+	}
+	switch( instruction_set )
+	{
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+		case LIBEWF_SIMD_INSTRUCTION_SET_AVX2:
+			*checksum_value = libewf_simd_calculate_adler32_avx2(
+			                   buffer,
+			                   size,
+			                   initial_value );
+			break;
+#endif
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+		case LIBEWF_SIMD_INSTRUCTION_SET_SSE2:
+			*checksum_value = libewf_simd_calculate_adler32_sse2(
+			                   buffer,
+			                   size,
+			                   initial_value );
+			break;
+#endif
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+		case LIBEWF_SIMD_INSTRUCTION_SET_NEON:
+			*checksum_value = libewf_simd_calculate_adler32_neon(
+			                   buffer,
+			                   size,
+			                   initial_value );
+			break;
+#endif
+		case LIBEWF_SIMD_INSTRUCTION_SET_NONE:
+			*checksum_value = libewf_simd_calculate_adler32_generic(
+			                   buffer,
+			                   size,
+			                   initial_value );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported instruction set: 0x%02x.",
+			 function,
+			 instruction_set );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
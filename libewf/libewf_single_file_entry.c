@@ -27,6 +27,7 @@
 #include "libewf_libcstring.h"
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
+#include "libewf_name_hash_table.h"
 #include "libewf_single_file_entry.h"
 
 /* Creates a single file entry
@@ -113,6 +114,7 @@ int libewf_single_file_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_single_file_entry_free";
+	int result            = 1;
 
 	if( single_file_entry == NULL )
 	{
@@ -142,12 +144,28 @@ int libewf_single_file_entry_free(
 			memory_free(
 			 ( *single_file_entry )->sha1_hash );
 		}
+		if( ( *single_file_entry )->sub_nodes_name_hash_table != NULL )
+		{
+			if( libewf_name_hash_table_free(
+			     &( ( *single_file_entry )->sub_nodes_name_hash_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub nodes name hash table.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *single_file_entry );
 
 		*single_file_entry = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the single file entry
@@ -221,9 +239,10 @@ int libewf_single_file_entry_clone(
 
 		return( -1 );
 	}
-	( *destination_single_file_entry )->name      = NULL;
-	( *destination_single_file_entry )->md5_hash  = NULL;
-	( *destination_single_file_entry )->sha1_hash = NULL;
+	( *destination_single_file_entry )->name                      = NULL;
+	( *destination_single_file_entry )->md5_hash                  = NULL;
+	( *destination_single_file_entry )->sha1_hash                 = NULL;
+	( *destination_single_file_entry )->sub_nodes_name_hash_table = NULL;
 
 	if( source_single_file_entry->name != NULL )
 	{
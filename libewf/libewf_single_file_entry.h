@@ -27,6 +27,7 @@
 
 #include "libewf_date_time.h"
 #include "libewf_libcerror.h"
+#include "libewf_name_hash_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -103,6 +104,19 @@ struct libewf_single_file_entry
 	/* The SHA1 digest hash size
 	 */
 	size_t sha1_hash_size;
+
+	/* The name hash table of the sub nodes
+	 * only set for nodes with many sub nodes
+	 */
+	libewf_name_hash_table_t *sub_nodes_name_hash_table;
+
+	/* The index of the entry record in the single files
+	 */
+	int record_index;
+
+	/* Value to indicate the sub file entries were read
+	 */
+	uint8_t sub_file_entries_read;
 };
 
 int libewf_single_file_entry_initialize(
@@ -22,12 +22,363 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_definitions.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libuna.h"
+#include "libewf_name_hash_table.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_file_tree.h"
 
+/* Indexes the sub nodes of a single file tree node by name
+ * Nodes with few sub nodes are not indexed and searched linearly
+ * Returns 1 if successful, 0 if the sub nodes were not indexed or -1 on error
+ */
+int libewf_single_file_tree_index_sub_nodes(
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libewf_name_hash_table_t *name_hash_table         = NULL;
+	libewf_single_file_entry_t *single_file_entry     = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "libewf_single_file_tree_index_sub_nodes";
+	uint32_t name_hash                                = 0;
+	int number_of_sub_nodes                           = 0;
+	int sub_node_index                                = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		goto on_error;
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( single_file_entry->sub_nodes_name_hash_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file entry - sub nodes name hash table value already set.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_nodes < LIBEWF_SINGLE_FILE_TREE_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES )
+	{
+		return( 0 );
+	}
+	if( libewf_name_hash_table_initialize(
+	     &name_hash_table,
+	     number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create name hash table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     node,
+	     0,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_value(
+		     sub_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		if( sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		/* Sub nodes without a name cannot be found by name
+		 */
+		if( sub_single_file_entry->name != NULL )
+		{
+			/* If a name cannot be decoded the sub nodes are searched linearly
+			 * hence the error is not returned
+			 */
+			if( libewf_name_hash_table_get_utf8_name_hash(
+			     sub_single_file_entry->name,
+			     sub_single_file_entry->name_size,
+			     &name_hash,
+			     NULL ) != 1 )
+			{
+				libewf_name_hash_table_free(
+				 &name_hash_table,
+				 NULL );
+
+				return( 0 );
+			}
+			if( libewf_name_hash_table_insert_node(
+			     name_hash_table,
+			     name_hash,
+			     sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert sub node: %d in name hash table.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+	}
+	single_file_entry->sub_nodes_name_hash_table = name_hash_table;
+
+	return( 1 );
+
+on_error:
+	if( name_hash_table != NULL )
+	{
+		libewf_name_hash_table_free(
+		 &name_hash_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the single file entry sub node for the specific UTF-8 formatted name using the name hash table
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
+ */
+int libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+     libewf_name_hash_table_t *name_hash_table,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_tree_get_indexed_sub_node_by_utf8_name";
+	uint32_t name_hash    = 0;
+	uint32_t probe_index  = 0;
+	int result            = 0;
+
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_name_hash_table_get_utf8_name_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libewf_name_hash_table_get_node_by_name_hash(
+		          name_hash_table,
+		          name_hash,
+		          &probe_index,
+		          sub_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node from name hash table.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libcdata_tree_node_get_value(
+		     *sub_node,
+		     (intptr_t **) sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node.",
+			 function );
+
+			goto on_error;
+		}
+		if( *sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry.",
+			 function );
+
+			goto on_error;
+		}
+		/* Only the sub nodes with the same name hash are compared
+		 */
+		result = libuna_utf8_string_compare_with_utf8_stream(
+		          utf8_string,
+		          utf8_string_length,
+		          ( *sub_single_file_entry )->name,
+		          (size_t) ( *sub_single_file_entry )->name_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare UTF-8 string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( result == 0 );
+
+	if( result == 0 )
+	{
+		*sub_node              = NULL;
+		*sub_single_file_entry = NULL;
+
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( -1 );
+}
+
 /* Retrieves the single file entry sub node for the specific UTF-8 formatted name
  * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
  */
@@ -39,10 +390,11 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf8_name";
-	int number_of_sub_nodes = 0;
-	int result              = 0;
-	int sub_node_index      = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_file_tree_get_sub_node_by_utf8_name";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+	int sub_node_index                            = 0;
 
 	if( node == NULL )
 	{
@@ -77,6 +429,44 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
 
 		return( -1 );
 	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( single_file_entry != NULL )
+	 && ( single_file_entry->sub_nodes_name_hash_table != NULL ) )
+	{
+		result = libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+		          single_file_entry->sub_nodes_name_hash_table,
+		          utf8_string,
+		          utf8_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve indexed sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( result );
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
@@ -193,6 +583,147 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the single file entry sub node for the specific UTF-16 formatted name using the name hash table
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
+ */
+int libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+     libewf_name_hash_table_t *name_hash_table,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_tree_get_indexed_sub_node_by_utf16_name";
+	uint32_t name_hash    = 0;
+	uint32_t probe_index  = 0;
+	int result            = 0;
+
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_name_hash_table_get_utf16_name_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libewf_name_hash_table_get_node_by_name_hash(
+		          name_hash_table,
+		          name_hash,
+		          &probe_index,
+		          sub_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node from name hash table.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libcdata_tree_node_get_value(
+		     *sub_node,
+		     (intptr_t **) sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node.",
+			 function );
+
+			goto on_error;
+		}
+		if( *sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry.",
+			 function );
+
+			goto on_error;
+		}
+		/* Only the sub nodes with the same name hash are compared
+		 */
+		result = libuna_utf16_string_compare_with_utf8_stream(
+		          utf16_string,
+		          utf16_string_length,
+		          ( *sub_single_file_entry )->name,
+		          (size_t) ( *sub_single_file_entry )->name_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare UTF-16 string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( result == 0 );
+
+	if( result == 0 )
+	{
+		*sub_node              = NULL;
+		*sub_single_file_entry = NULL;
+
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( -1 );
+}
+
 /* Retrieves the single file entry sub node for the specific UTF-16 formatted name
  * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
  */
@@ -204,10 +735,11 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf16_name";
-	int number_of_sub_nodes = 0;
-	int result              = 0;
-	int sub_node_index      = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_file_tree_get_sub_node_by_utf16_name";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+	int sub_node_index                            = 0;
 
 	if( node == NULL )
 	{
@@ -242,6 +774,44 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
 
 		return( -1 );
 	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( single_file_entry != NULL )
+	 && ( single_file_entry->sub_nodes_name_hash_table != NULL ) )
+	{
+		result = libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+		          single_file_entry->sub_nodes_name_hash_table,
+		          utf16_string,
+		          utf16_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve indexed sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( result );
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
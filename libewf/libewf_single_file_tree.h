@@ -27,12 +27,25 @@
 
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_name_hash_table.h"
 #include "libewf_single_file_entry.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+int libewf_single_file_tree_index_sub_nodes(
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+     libewf_name_hash_table_t *name_hash_table,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
 int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libcdata_tree_node_t *single_file_tree_node,
      const uint8_t *utf8_string,
@@ -41,6 +54,14 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error );
 
+int libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+     libewf_name_hash_table_t *name_hash_table,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
 int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libcdata_tree_node_t *single_file_tree_node,
      const uint16_t *utf16_string,
@@ -28,9 +28,11 @@
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libcstring.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
 
 /* Creates single files
@@ -91,8 +93,28 @@ int libewf_single_files_initialize(
 		 "%s: unable to clear single files.",
 		 function );
 
+		memory_free(
+		 *single_files );
+
+		*single_files = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *single_files )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
 		goto on_error;
 	}
+#endif
 	return( 1 );
 
 on_error:
@@ -151,6 +173,47 @@ int libewf_single_files_free(
 				result = -1;
 			}
 		}
+		if( ( *single_files )->types != NULL )
+		{
+			if( libfvalue_split_utf8_string_free(
+			     &( ( *single_files )->types ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free split types.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *single_files )->entry_records != NULL )
+		{
+			memory_free(
+			 ( *single_files )->entry_records );
+		}
+		if( ( *single_files )->line_string != NULL )
+		{
+			memory_free(
+			 ( *single_files )->line_string );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *single_files )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *single_files );
 
@@ -159,18 +222,23 @@ int libewf_single_files_free(
 	return( result );
 }
 
-/* Parse an EWF ltree for the values
+/* Reads a line from the ltree data and converts it into an UTF-8 string
+ * The line string is stored in the single files and remains valid until the next line is read
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse(
+int libewf_single_files_read_line(
      libewf_single_files_t *single_files,
-     size64_t *media_size,
-     uint8_t *format,
+     size_t *ltree_data_offset,
+     uint8_t **line_string,
+     size_t *line_string_size,
      libcerror_error_t **error )
 {
-	uint8_t *file_entries_string    = NULL;
-	static char *function           = "libewf_single_files_parse";
-	size_t file_entries_string_size = 0;
+	uint8_t *reallocation        = NULL;
+	static char *function        = "libewf_single_files_read_line";
+	size_t line_data_size        = 0;
+	size_t line_end_offset       = 0;
+	size_t next_line_offset      = 0;
+	size_t safe_line_string_size = 0;
 
 	if( single_files == NULL )
 	{
@@ -194,102 +262,151 @@ int libewf_single_files_parse(
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_size_from_utf16_stream(
-	     single_files->ltree_data,
-	     single_files->ltree_data_size,
-	     LIBUNA_ENDIAN_LITTLE,
-	     &file_entries_string_size,
-	     error ) != 1 )
+	if( ltree_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine file entries string size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree data offset.",
 		 function );
 
 		return( -1 );
 	}
-	file_entries_string = (uint8_t *) memory_allocate(
-	                                   sizeof( uint8_t ) * (size_t) file_entries_string_size );
+	if( *ltree_data_offset > single_files->ltree_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree data offset value out of bounds.",
+		 function );
 
-	if( file_entries_string == NULL )
+		return( -1 );
+	}
+	if( line_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create file entries string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libuna_utf8_string_copy_from_utf16_stream(
-	     file_entries_string,
-	     file_entries_string_size,
-	     single_files->ltree_data,
-	     single_files->ltree_data_size,
-	     LIBUNA_ENDIAN_LITTLE,
-	     error ) != 1 )
+	if( line_string_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to set file entries string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_single_files_parse_file_entries(
+	if( libewf_single_files_get_line_end_offset(
 	     single_files,
-	     media_size,
-	     file_entries_string,
-	     file_entries_string_size,
-	     format,
+	     *ltree_data_offset,
+	     &line_end_offset,
+	     &next_line_offset,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine end of line.",
+		 function );
+
+		return( -1 );
+	}
+	line_data_size = line_end_offset - *ltree_data_offset;
+
+	if( line_data_size == 0 )
+	{
+		safe_line_string_size = 1;
+	}
+	else if( libuna_utf8_string_size_from_utf16_stream(
+	          &( single_files->ltree_data[ *ltree_data_offset ] ),
+	          line_data_size,
+	          LIBUNA_ENDIAN_LITTLE,
+	          &safe_line_string_size,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entries string.",
+		 "%s: unable to determine line string size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	memory_free(
-	 file_entries_string );
+	if( safe_line_string_size > single_files->line_string_allocated_size )
+	{
+		reallocation = (uint8_t *) memory_reallocate(
+		                            single_files->line_string,
+		                            sizeof( uint8_t ) * safe_line_string_size );
 
-	return( 1 );
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize line string.",
+			 function );
 
-on_error:
-	if( file_entries_string != NULL )
+			return( -1 );
+		}
+		single_files->line_string                = reallocation;
+		single_files->line_string_allocated_size = safe_line_string_size;
+	}
+	if( line_data_size == 0 )
 	{
-		memory_free(
-		 file_entries_string );
+		single_files->line_string[ 0 ] = 0;
 	}
-	return( -1 );
+	else if( libuna_utf8_string_copy_from_utf16_stream(
+	          single_files->line_string,
+	          safe_line_string_size,
+	          &( single_files->ltree_data[ *ltree_data_offset ] ),
+	          line_data_size,
+	          LIBUNA_ENDIAN_LITTLE,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set line string.",
+		 function );
+
+		return( -1 );
+	}
+	*line_string       = single_files->line_string;
+	*line_string_size  = safe_line_string_size;
+	*ltree_data_offset = next_line_offset;
+
+	return( 1 );
 }
 
-/* Parse a single file entries string for the values
+/* Determines the end of the line that starts at a specific offset in the ltree data
+ * The UTF-16 little-endian formatted ltree data is scanned for a newline or end-of-string character,
+ * the line end offset excludes the newline character and the next line offset is the offset
+ * of the line that follows or the ltree data size if there are no more lines
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse_file_entries(
+int libewf_single_files_get_line_end_offset(
      libewf_single_files_t *single_files,
-     size64_t *media_size,
-     const uint8_t *entries_string,
-     size_t entries_string_size,
-     uint8_t *format,
+     size_t ltree_data_offset,
+     size_t *line_end_offset,
+     size_t *next_line_offset,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *lines = NULL;
-	libfvalue_split_utf8_string_t *types = NULL;
-	uint8_t *line_string                 = NULL;
-	static char *function                = "libewf_single_files_parse_file_entries";
-	size_t line_string_size              = 0;
-	int line_index                       = 0;
-	int number_of_lines                  = 0;
+	static char *function = "libewf_single_files_get_line_end_offset";
+	size_t data_offset    = 0;
 
 	if( single_files == NULL )
 	{
@@ -302,362 +419,976 @@ int libewf_single_files_parse_file_entries(
 
 		return( -1 );
 	}
-	if( entries_string == NULL )
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_data_offset > single_files->ltree_data_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid entries string.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree data offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     entries_string,
-	     entries_string_size - 1,
-	     (uint8_t) '\n',
-	     &lines,
-	     error ) != 1 )
+	if( line_end_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into lines.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line end offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
+	if( next_line_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next line offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( number_of_lines > 0 )
+	for( data_offset = ltree_data_offset;
+	     ( data_offset + 1 ) < single_files->ltree_data_size;
+	     data_offset += 2 )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     0,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
+		if( single_files->ltree_data[ data_offset + 1 ] != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 0.",
-			 function );
-
-			goto on_error;
+			continue;
 		}
-		if( ( line_string == NULL )
-		 || ( line_string_size < 2 )
-		 || ( line_string[ 0 ] == 0 ) )
+		if( single_files->ltree_data[ data_offset ] == (uint8_t) '\n' )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 0.",
-			 function );
+			*line_end_offset  = data_offset;
+			*next_line_offset = data_offset + 2;
 
-			goto on_error;
+			return( 1 );
 		}
-		/* Remove trailing carriage return
+		/* The ltree data can be terminated by an end-of-string character
 		 */
-		else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
+		if( single_files->ltree_data[ data_offset ] == 0 )
 		{
-			line_string[ line_string_size - 2 ] = 0;
-
-			line_string_size -= 1;
+			break;
 		}
-		if( line_string_size != 2 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
+	}
+	*line_end_offset  = data_offset;
+	*next_line_offset = single_files->ltree_data_size;
 
-			goto on_error;
-		}
-		if( ( line_string[ 0 ] < (uint8_t) '0' )
-		 || ( line_string[ 0 ] > (uint8_t) '9' ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
+	return( 1 );
+}
 
-			goto on_error;
-		}
-		/* Find the line containing: "rec"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+/* Parse an EWF ltree for the values
+ * The ltree data is read line by line, only the root single file entry is parsed
+ * the other single file entries are parsed when their parent is accessed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_files_parse";
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_files_parse_file_entries(
+	     single_files,
+	     media_size,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Parse the single file entries in the ltree data for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_file_entries(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	uint8_t *line_string     = NULL;
+	static char *function    = "libewf_single_files_parse_file_entries";
+	size_t line_string_size  = 0;
+	size_t ltree_data_offset = 0;
+	int line_found           = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->types != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - types value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->root_file_entry_node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - root file entry node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_single_files_read_line(
+	     single_files,
+	     &ltree_data_offset,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( line_string == NULL )
+	 || ( line_string_size < 2 )
+	 || ( line_string[ 0 ] == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing line string: 0.",
+		 function );
+
+		goto on_error;
+	}
+	/* Remove trailing carriage return
+	 */
+	else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
+	{
+		line_string[ line_string_size - 2 ] = 0;
+
+		line_string_size -= 1;
+	}
+	if( line_string_size != 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported single file entries string.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( line_string[ 0 ] < (uint8_t) '0' )
+	 || ( line_string[ 0 ] > (uint8_t) '9' ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported single file entries string.",
+		 function );
+
+		goto on_error;
+	}
+	/* Find the line containing: "rec"
+	 */
+	ltree_data_offset = 0;
+
+	while( ltree_data_offset < single_files->ltree_data_size )
+	{
+		if( libewf_single_files_read_line(
+		     single_files,
+		     &ltree_data_offset,
+		     &line_string,
+		     &line_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line string.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( line_string_size == 4 )
+		 && ( line_string[ 0 ] == (uint8_t) 'r' )
+		 && ( line_string[ 1 ] == (uint8_t) 'e' )
+		 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
+		{
+			line_found = 1;
+
+			break;
+		}
+	}
+	if( line_found == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing record values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_record_values(
+	     single_files,
+	     media_size,
+	     &ltree_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse record values.",
+		 function );
+
+		goto on_error;
+	}
+	/* Find the line containing: "entry"
+	 */
+	ltree_data_offset = 0;
+	line_found        = 0;
+
+	while( ltree_data_offset < single_files->ltree_data_size )
+	{
+		if( libewf_single_files_read_line(
+		     single_files,
+		     &ltree_data_offset,
+		     &line_string,
+		     &line_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read line string.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( line_string_size == 6 )
+		 && ( line_string[ 0 ] == (uint8_t) 'e' )
+		 && ( line_string[ 1 ] == (uint8_t) 'n' )
+		 && ( line_string[ 2 ] == (uint8_t) 't' )
+		 && ( line_string[ 3 ] == (uint8_t) 'r' )
+		 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
+		{
+			line_found = 1;
+
+			break;
+		}
+	}
+	if( line_found == 0 )
+	{
+		return( 1 );
+	}
+	/* Skip the line that follows the "entry" line
+	 */
+	if( libewf_single_files_read_line(
+	     single_files,
+	     &ltree_data_offset,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string.",
+		 function );
+
+		goto on_error;
+	}
+	if( ltree_data_offset >= single_files->ltree_data_size )
+	{
+		return( 1 );
+	}
+	if( libewf_single_files_read_line(
+	     single_files,
+	     &ltree_data_offset,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read types line string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &( single_files->types ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into types.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_get_format_from_types(
+	     single_files->types,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine format from types.",
+		 function );
+
+		goto on_error;
+	}
+	/* Determine the location of all single file entries without parsing their values
+	 */
+	if( libewf_single_files_read_entry_records(
+	     single_files,
+	     &ltree_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read entry records.",
+		 function );
+
+		goto on_error;
+	}
+	/* The single files entries should be followed by an empty line
+	 */
+	if( libewf_single_files_read_line(
+	     single_files,
+	     &ltree_data_offset,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( line_string_size != 1 )
+	 || ( line_string[ 0 ] != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported empty line string - not empty.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_initialize(
+	     &( single_files->root_file_entry_node ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create root single file entry node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_file_entry(
+	     single_files,
+	     single_files->root_file_entry_node,
+	     0,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( single_files->root_file_entry_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &( single_files->root_file_entry_node ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_files->entry_records != NULL )
+	{
+		memory_free(
+		 single_files->entry_records );
+
+		single_files->entry_records                     = NULL;
+		single_files->number_of_entry_records           = 0;
+		single_files->number_of_allocated_entry_records = 0;
+	}
+	if( single_files->types != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &( single_files->types ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines the format from the single file entry types
+ * The position of the data offset type differs per format version
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_get_format_from_types(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	uint8_t *type_string    = NULL;
+	static char *function   = "libewf_single_files_get_format_from_types";
+	size_t type_string_size = 0;
+	int number_of_types     = 0;
+	int type_index          = 0;
+
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     types,
+	     &number_of_types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of types",
+		 function );
+
+		return( -1 );
+	}
+	for( type_index = 0;
+	     type_index < number_of_types;
+	     type_index++ )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     types,
+		     type_index,
+		     &type_string,
+		     &type_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type string: %d.",
+			 function,
+			 type_index );
+
+			return( -1 );
+		}
+		if( ( type_string == NULL )
+		 || ( type_string_size < 3 ) )
+		{
+			continue;
+		}
+		if( ( type_string[ 0 ] != (uint8_t) 'b' )
+		 || ( type_string[ 1 ] != (uint8_t) 'e' ) )
+		{
+			continue;
+		}
+		if( ( type_string_size == 3 )
+		 || ( ( type_string_size == 4 )
+		  &&  ( type_string[ 2 ] == (uint8_t) '\r' ) ) )
+		{
+			if( type_index == 19 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
+			}
+			else if( ( type_index == 20 )
+			      || ( type_index == 21 ) )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
+			}
+			else if( type_index == 2 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE7;
+			}
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the entry records of a single file entry and its sub entries
+ * An entry record contains the location of the values of the single file entry
+ * in the ltree data and the number of (sub) entries, the values are not parsed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_entry_records(
+     libewf_single_files_t *single_files,
+     size_t *ltree_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_single_files_entry_record_t *reallocation = NULL;
+	static char *function                            = "libewf_single_files_read_entry_records";
+	size_t line_end_offset                           = 0;
+	uint64_t number_of_sub_entries                   = 0;
+	int number_of_allocated_entry_records            = 0;
+	int record_index                                 = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->number_of_entry_records == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid single files - number of entry records value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
+	     single_files,
+	     ltree_data_offset,
+	     &number_of_sub_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entry number of sub entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every sub entry consists of at least 2 lines of 1 character each
+	 */
+	if( number_of_sub_entries > (uint64_t) ( ( single_files->ltree_data_size - *ltree_data_offset ) / 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of sub entries exceed the available ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->number_of_entry_records >= single_files->number_of_allocated_entry_records )
+	{
+		if( single_files->number_of_allocated_entry_records > ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_entry_records = INT_MAX;
+		}
+		else
+		{
+			number_of_allocated_entry_records = 2 * single_files->number_of_allocated_entry_records;
+		}
+		if( number_of_allocated_entry_records < LIBEWF_SINGLE_FILES_ENTRY_RECORDS_ALLOCATION_INCREMENT )
+		{
+			number_of_allocated_entry_records = LIBEWF_SINGLE_FILES_ENTRY_RECORDS_ALLOCATION_INCREMENT;
+		}
+		if( (size_t) number_of_allocated_entry_records > ( (size_t) SSIZE_MAX / sizeof( libewf_single_files_entry_record_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entry records value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (libewf_single_files_entry_record_t *) memory_reallocate(
+		                                                       single_files->entry_records,
+		                                                       sizeof( libewf_single_files_entry_record_t ) * number_of_allocated_entry_records );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entry records.",
+			 function );
+
+			return( -1 );
+		}
+		single_files->entry_records                     = reallocation;
+		single_files->number_of_allocated_entry_records = number_of_allocated_entry_records;
+	}
+	record_index = single_files->number_of_entry_records;
+
+	single_files->entry_records[ record_index ].values_offset         = *ltree_data_offset;
+	single_files->entry_records[ record_index ].number_of_sub_entries = (uint32_t) number_of_sub_entries;
+	single_files->entry_records[ record_index ].number_of_descendants = 0;
+
+	single_files->number_of_entry_records += 1;
+
+	/* Skip the values line
+	 */
+	if( libewf_single_files_get_line_end_offset(
+	     single_files,
+	     *ltree_data_offset,
+	     &line_end_offset,
+	     ltree_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine end of values line.",
+		 function );
+
+		return( -1 );
+	}
+	while( number_of_sub_entries > 0 )
+	{
+		if( libewf_single_files_read_entry_records(
+		     single_files,
+		     ltree_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub entry records.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_sub_entries--;
+	}
+	/* The entry records can be reallocated by the sub entries hence the index is used
+	 */
+	single_files->entry_records[ record_index ].number_of_descendants = (uint32_t) ( single_files->number_of_entry_records - record_index - 1 );
+
+	return( 1 );
+}
+
+/* Reads the sub file entries of a single file entry tree node
+ * The sub single file entries are parsed and added to the tree the first time this function is called
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *file_entry_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_file_entry_node     = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_files_read_sub_file_entries";
+	uint32_t sub_entry_index                      = 0;
+	uint8_t format                                = 0;
+	int result                                    = 1;
+	int sub_record_index                          = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
 
-				goto on_error;
-			}
-			if( line_string_size == 4 )
-			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from file entry node.",
+		 function );
 
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'r' )
-				 && ( line_string[ 1 ] == (uint8_t) 'e' )
-				 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
-				{
-					line_index += 1;
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
 
-					break;
-				}
-			}
-		}
-		if( libewf_single_files_parse_record_values(
-		     media_size,
-		     lines,
-		     &line_index,
-		     error ) != 1 )
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     single_files->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( single_file_entry->sub_file_entries_read == 0 )
+	{
+		if( ( single_file_entry->record_index < 0 )
+		 || ( single_file_entry->record_index >= single_files->number_of_entry_records ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-			 LIBCERROR_CONVERSION_ERROR_GENERIC,
-			 "%s: unable to parse record values.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid single file entry - record index value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
-		/* Find the line containing: "entry"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			if( line_string_size == 6 )
-			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'e' )
-				 && ( line_string[ 1 ] == (uint8_t) 'n' )
-				 && ( line_string[ 2 ] == (uint8_t) 't' )
-				 && ( line_string[ 3 ] == (uint8_t) 'r' )
-				 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
-				{
-					line_index += 2;
+		sub_record_index = single_file_entry->record_index + 1;
 
-					break;
-				}
-			}
-		}
-		if( line_index < number_of_lines )
+		for( sub_entry_index = 0;
+		     sub_entry_index < single_files->entry_records[ single_file_entry->record_index ].number_of_sub_entries;
+		     sub_entry_index++ )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			line_index += 1;
-
-			if( libfvalue_utf8_string_split(
-			     line_string,
-			     line_string_size,
-			     (uint8_t) '\t',
-			     &types,
-			     error ) != 1 )
+			if( sub_record_index >= single_files->number_of_entry_records )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to split entries string into types.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid sub record index value out of bounds.",
 				 function );
 
 				goto on_error;
 			}
 			if( libcdata_tree_node_initialize(
-			     &( single_files->root_file_entry_node ),
+			     &sub_file_entry_node,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create root single file entry node.",
+				 "%s: unable to create sub single file entry node.",
 				 function );
 
 				goto on_error;
 			}
 			if( libewf_single_files_parse_file_entry(
-			     single_files->root_file_entry_node,
-			     lines,
-			     &line_index,
-			     types,
-			     format,
+			     single_files,
+			     sub_file_entry_node,
+			     sub_record_index,
+			     &format,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 				 LIBCERROR_CONVERSION_ERROR_GENERIC,
-				 "%s: unable to parse file entry.",
-				 function );
+				 "%s: unable to parse sub file entry: %" PRIu32 ".",
+				 function,
+				 sub_entry_index );
 
 				goto on_error;
 			}
-			/* The single files entries should be followed by an empty line
-			 */
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
+			if( libcdata_tree_node_append_node(
+			     file_entry_node,
+			     sub_file_entry_node,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append sub single file entry node.",
+				 function );
 
 				goto on_error;
 			}
-			if( ( line_string_size != 1 )
-			 || ( line_string[ 0 ] != 0 ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported empty line string: %d - not empty.",
-				 function,
-				 line_index );
+			sub_file_entry_node = NULL;
 
-				goto on_error;
-			}
+			sub_record_index += (int) single_files->entry_records[ sub_record_index ].number_of_descendants + 1;
 		}
-		if( libfvalue_split_utf8_string_free(
-		     &types,
-		     error ) != 1 )
+		if( libewf_single_file_tree_index_sub_nodes(
+		     file_entry_node,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index sub nodes.",
 			 function );
 
 			goto on_error;
 		}
+		single_file_entry->sub_file_entries_read = 1;
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     single_files->mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 
 on_error:
-	if( types != NULL )
+	if( sub_file_entry_node != NULL )
 	{
-		libfvalue_split_utf8_string_free(
-		 &types,
-		 NULL );
-	}
-	if( lines != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &lines,
+		libcdata_tree_node_free(
+		 &sub_file_entry_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
 		 NULL );
 	}
+	/* Remove the sub nodes that were added so that a next call starts over
+	 */
+	libcdata_tree_node_empty(
+	 file_entry_node,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	 NULL );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 single_files->mutex,
+	 NULL );
+#endif
 	return( -1 );
 }
 
@@ -665,9 +1396,9 @@ on_error:
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_record_values(
+     libewf_single_files_t *single_files,
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     size_t *ltree_data_offset,
      libcerror_error_t **error )
 {
 	libfvalue_split_utf8_string_t *types  = NULL;
@@ -684,6 +1415,17 @@ int libewf_single_files_parse_record_values(
 	int number_of_values                  = 0;
 	int value_index                       = 0;
 
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
 	if( media_size == NULL )
 	{
 		libcerror_error_set(
@@ -695,36 +1437,33 @@ int libewf_single_files_parse_record_values(
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( ltree_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid ltree data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_single_files_read_line(
+	     single_files,
+	     ltree_data_offset,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
-
 	if( libfvalue_utf8_string_split(
 	     line_string,
 	     line_string_size,
@@ -755,25 +1494,22 @@ int libewf_single_files_parse_record_values(
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_single_files_read_line(
+	     single_files,
+	     ltree_data_offset,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
-
 	if( libfvalue_utf8_string_split(
 	     line_string,
 	     line_string_size,
@@ -989,53 +1725,63 @@ on_error:
 }
 
 /* Parse a single file entry string for the values
+ * The sub file entries are not parsed, use libewf_single_files_read_sub_file_entries for this
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry(
-     libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
-     libfvalue_split_utf8_string_t *types,
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *file_entry_node,
+     int record_index,
      uint8_t *format,
      libcerror_error_t **error )
 {
 	libewf_single_file_entry_t *single_file_entry = NULL;
 	libfvalue_split_utf8_string_t *values         = NULL;
-	libcdata_tree_node_t *file_entry_node         = NULL;
 	uint8_t *line_string                          = NULL;
 	uint8_t *type_string                          = NULL;
 	uint8_t *value_string                         = NULL;
 	static char *function                         = "libewf_single_files_parse_file_entry";
 	size_t line_string_size                       = 0;
+	size_t ltree_data_offset                      = 0;
 	size_t type_string_size                       = 0;
 	size_t value_string_size                      = 0;
 	size_t value_string_index                     = 0;
-	uint64_t number_of_sub_entries                = 0;
 	uint64_t value_64bit                          = 0;
-	int number_of_lines                           = 0;
 	int number_of_types                           = 0;
 	int number_of_values                          = 0;
 	int value_index                               = 0;
 	int zero_values_only                          = 0;
 
-	if( parent_file_entry_node == NULL )
+	if( single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid parent file entry node.",
+		 "%s: invalid single files.",
 		 function );
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( file_entry_node == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid file entry node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record_index < 0 )
+	 || ( record_index >= single_files->number_of_entry_records ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record index value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -1052,7 +1798,7 @@ int libewf_single_files_parse_file_entry(
 		return( -1 );
 	}
 	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     types,
+	     single_files->types,
 	     &number_of_types,
 	     error ) != 1 )
 	{
@@ -1065,39 +1811,25 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
-	     lines,
-	     line_index,
-	     &number_of_sub_entries,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entry number of sub entries.",
-		 function );
+	ltree_data_offset = single_files->entry_records[ record_index ].values_offset;
 
-		goto on_error;
-	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_single_files_read_line(
+	     single_files,
+	     &ltree_data_offset,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read values line string of record: %d.",
 		 function,
-		 *line_index );
+		 record_index );
 
 		goto on_error;
 	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
@@ -1158,7 +1890,7 @@ int libewf_single_files_parse_file_entry(
 	     value_index++ )
 	{
 		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     types,
+		     single_files->types,
 		     value_index,
 		     &type_string,
 		     &type_string_size,
@@ -1712,8 +2444,10 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
+	single_file_entry->record_index = record_index;
+
 	if( libcdata_tree_node_set_value(
-	     parent_file_entry_node,
+	     file_entry_node,
 	     (intptr_t *) single_file_entry,
 	     error ) != 1 )
 	{
@@ -1726,93 +2460,9 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	single_file_entry = NULL;
-
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
-		 function );
-
-		goto on_error;
-	}
-	if( ( *line_index + number_of_sub_entries ) > (uint64_t) number_of_lines )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of sub entries exceed the number of available lines.",
-		 function );
-
-		goto on_error;
-	}
-	while( number_of_sub_entries > 0 )
-	{
-		if( libcdata_tree_node_initialize(
-		     &file_entry_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create single file entry node.",
-			 function );
-
-			goto on_error;
-		}
-		if( libewf_single_files_parse_file_entry(
-		     file_entry_node,
-		     lines,
-		     line_index,
-		     types,
-		     format,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-			 LIBCERROR_CONVERSION_ERROR_GENERIC,
-			 "%s: unable to parse file entry.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_tree_node_append_node(
-		     parent_file_entry_node,
-		     file_entry_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append single file entry node to parent.",
-			 function );
-
-			goto on_error;
-		}
-		file_entry_node = NULL;
-
-		number_of_sub_entries--;
-	}
 	return( 1 );
 
 on_error:
-	if( file_entry_node != NULL )
-	{
-		libcdata_tree_node_free(
-		 &file_entry_node,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
-		 NULL );
-	}
 	if( single_file_entry != NULL )
 	{
 		libewf_single_file_entry_free(
@@ -1832,8 +2482,8 @@ on_error:
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_single_files_t *single_files,
+     size_t *ltree_data_offset,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error )
 {
@@ -1845,35 +2495,44 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 	size_t value_string_size              = 0;
 	int number_of_values                  = 0;
 
-	if( line_index == NULL )
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid ltree data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_single_files_read_line(
+	     single_files,
+	     ltree_data_offset,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read line string.",
+		 function );
 
 		goto on_error;
 	}
-	*line_index += 1;
 
 	if( libfvalue_utf8_string_split(
 	     line_string,
@@ -28,6 +28,7 @@
 #include "libewf_extern.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfvalue.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_types.h"
@@ -36,6 +37,24 @@
 extern "C" {
 #endif
 
+typedef struct libewf_single_files_entry_record libewf_single_files_entry_record_t;
+
+struct libewf_single_files_entry_record
+{
+	/* The offset of the values line in the ltree data
+	 */
+	size_t values_offset;
+
+	/* The number of sub entries
+	 */
+	uint32_t number_of_sub_entries;
+
+	/* The number of descendant entries
+	 * the next sibling entry record directly follows the descendant entry records
+	 */
+	uint32_t number_of_descendants;
+};
+
 typedef struct libewf_single_files libewf_single_files_t;
 
 struct libewf_single_files
@@ -56,9 +75,40 @@ struct libewf_single_files
 	 */
 	size_t ltree_data_size;
 
+	/* The line string
+	 * this value is reused when reading lines from the ltree data
+	 */
+	uint8_t *line_string;
+
+	/* The line string allocated size
+	 */
+	size_t line_string_allocated_size;
+
+	/* The single file entry types
+	 */
+	libfvalue_split_utf8_string_t *types;
+
+	/* The entry records
+	 */
+	libewf_single_files_entry_record_t *entry_records;
+
+	/* The number of entry records
+	 */
+	int number_of_entry_records;
+
+	/* The number of allocated entry records
+	 */
+	int number_of_allocated_entry_records;
+
 	/* The single file entry tree
 	 */
 	libcdata_tree_node_t *root_file_entry_node;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
 };
 
 int libewf_single_files_initialize(
@@ -69,6 +119,20 @@ int libewf_single_files_free(
      libewf_single_files_t **single_files,
      libcerror_error_t **error );
 
+int libewf_single_files_read_line(
+     libewf_single_files_t *single_files,
+     size_t *ltree_data_offset,
+     uint8_t **line_string,
+     size_t *line_string_size,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_line_end_offset(
+     libewf_single_files_t *single_files,
+     size_t ltree_data_offset,
+     size_t *line_end_offset,
+     size_t *next_line_offset,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse(
      libewf_single_files_t *single_files,
      size64_t *media_size,
@@ -78,28 +142,40 @@ int libewf_single_files_parse(
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
      size64_t *media_size,
-     const uint8_t *file_entries_string,
-     size_t file_entries_string_size,
      uint8_t *format,
      libcerror_error_t **error );
 
+int libewf_single_files_get_format_from_types(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_entry_records(
+     libewf_single_files_t *single_files,
+     size_t *ltree_data_offset,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *file_entry_node,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse_record_values(
+     libewf_single_files_t *single_files,
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
+     size_t *ltree_data_offset,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry(
-     libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
-     libfvalue_split_utf8_string_t *types,
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *file_entry_node,
+     int record_index,
      uint8_t *format,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_single_files_t *single_files,
+     size_t *ltree_data_offset,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error );
 
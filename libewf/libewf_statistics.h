@@ -0,0 +1,83 @@
+/*
+ * Handle statistics functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+struct libewf_statistics
+{
+	/* The statistic values
+	 */
+	uint64_t values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_reset(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_add(
+     libewf_statistics_t *statistics,
+     int statistic,
+     uint64_t value,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_values(
+     libewf_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+uint64_t libewf_statistics_get_time(
+          void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_STATISTICS_H ) */
+
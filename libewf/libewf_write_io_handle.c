@@ -38,6 +38,8 @@
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_direct_io_handle.h"
+#include "libewf_file_handle_pool.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
@@ -45,6 +47,8 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_libcstring.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
@@ -53,6 +57,7 @@
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
 
@@ -148,11 +153,31 @@ int libewf_write_io_handle_initialize(
 	( *write_io_handle )->maximum_chunks_per_section  = LIBEWF_MAXIMUM_TABLE_ENTRIES_ENCASE6;
 	( *write_io_handle )->maximum_number_of_segments  = (uint32_t) 14971;
 
+	if( libewf_write_io_handle_set_number_of_compression_threads(
+	     *write_io_handle,
+	     LIBEWF_DEFAULT_NUMBER_OF_COMPRESSION_THREADS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of compression threads.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *write_io_handle != NULL )
 	{
+		if( ( *write_io_handle )->chunk_group != NULL )
+		{
+			libewf_chunk_group_free(
+			 &( ( *write_io_handle )->chunk_group ),
+			 NULL );
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -168,8 +193,9 @@ int libewf_write_io_handle_free(
      libewf_write_io_handle_t **write_io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_write_io_handle_free";
-	int result            = 1;
+	static char *function   = "libewf_write_io_handle_free";
+	int pending_chunk_index = 0;
+	int result              = 1;
 
 	if( write_io_handle == NULL )
 	{
@@ -209,6 +235,82 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libewf_write_io_handle_free_thread_pool(
+		     *write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *write_io_handle )->thread_pool_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *write_io_handle )->thread_pool_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread pool condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *write_io_handle )->thread_pool_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *write_io_handle )->thread_pool_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread pool mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *write_io_handle )->pending_chunks_data != NULL )
+		{
+			for( pending_chunk_index = 0;
+			     pending_chunk_index < ( *write_io_handle )->number_of_pending_chunks;
+			     pending_chunk_index++ )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *write_io_handle )->pending_chunks_data[ pending_chunk_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free pending chunk data: %d.",
+					 function,
+					 pending_chunk_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *write_io_handle )->pending_chunks_data );
+		}
+		if( ( *write_io_handle )->pending_input_data_sizes != NULL )
+		{
+			memory_free(
+			 ( *write_io_handle )->pending_input_data_sizes );
+		}
 		if( libewf_chunk_group_free(
 		     &( ( *write_io_handle )->chunk_group ),
 		     error ) != 1 )
@@ -307,6 +409,20 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
 
+	( *destination_write_io_handle )->io_handle                        = NULL;
+	( *destination_write_io_handle )->pending_chunks_data              = NULL;
+	( *destination_write_io_handle )->pending_input_data_sizes         = NULL;
+	( *destination_write_io_handle )->pending_chunk_index              = 0;
+	( *destination_write_io_handle )->number_of_pending_chunks         = 0;
+	( *destination_write_io_handle )->maximum_number_of_pending_chunks = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_write_io_handle )->thread_pool              = NULL;
+	( *destination_write_io_handle )->thread_pool_mutex        = NULL;
+	( *destination_write_io_handle )->thread_pool_condition    = NULL;
+	( *destination_write_io_handle )->number_of_packing_chunks = 0;
+#endif
+
 	if( source_write_io_handle->case_data != NULL )
 	{
 		( *destination_write_io_handle )->case_data = (uint8_t *) memory_allocate(
@@ -451,11 +567,30 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+	if( libewf_write_io_handle_set_number_of_compression_threads(
+	     *destination_write_io_handle,
+	     source_write_io_handle->number_of_compression_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set destination number of compression threads.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_write_io_handle != NULL )
 	{
+		if( ( *destination_write_io_handle )->pending_chunks_data != NULL )
+		{
+			memory_free(
+			 ( *destination_write_io_handle )->pending_chunks_data );
+		}
 		if( ( *destination_write_io_handle )->table_section_data != NULL )
 		{
 			memory_free(
@@ -2304,6 +2439,7 @@ int libewf_write_io_handle_create_segment_file(
 	static char *function                   = "libewf_write_io_handle_create_segment_file";
 	size_t filename_size                    = 0;
 	int bfio_access_flags                   = 0;
+	int result                              = 0;
 
 	if( segment_table == NULL )
 	{
@@ -2402,47 +2538,90 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
-		 function );
+#if defined( HAVE_LIBEWF_DIRECT_IO_SUPPORT ) && !defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		result = libewf_direct_io_file_initialize(
+		          &file_io_handle,
+		          filename,
+		          libcstring_narrow_string_length(
+		           filename ),
+		          error );
 
-		goto on_error;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct IO file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 	}
+#endif
+	if( result == 0 )
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
-		 function );
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	memory_free(
 	 filename );
 
 	filename = NULL;
 
+	if( io_handle->file_handle_pool != NULL )
+	{
+		if( libewf_file_handle_pool_append_file(
+		     io_handle->file_handle_pool,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file IO handle to file handle pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
 
 	if( libbfio_pool_append_handle(
@@ -2479,6 +2658,25 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	if( ( io_handle->statistics != NULL )
+	 && ( io_handle->file_handle_pool == NULL ) )
+	{
+		if( libewf_statistics_add(
+		     io_handle->statistics,
+		     LIBEWF_STATISTIC_SEGMENT_FILE_OPENS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_segment_file_initialize(
 	     segment_file,
 	     io_handle,
@@ -3477,6 +3675,769 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	return( total_write_count );
 }
 
+/* Sets the number of threads used to pack (compress) the chunks
+ * A value of 0 or 1 packs the chunks in the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_set_number_of_compression_threads(
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function                = "libewf_write_io_handle_set_number_of_compression_threads";
+	int maximum_number_of_pending_chunks = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->number_of_pending_chunks != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle - pending chunks set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( number_of_threads != write_io_handle->number_of_compression_threads )
+	{
+		if( libewf_write_io_handle_free_thread_pool(
+		     write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( number_of_threads > 1 )
+	{
+		maximum_number_of_pending_chunks = number_of_threads * LIBEWF_COMPRESSION_CHUNKS_PER_THREAD;
+	}
+#endif
+	if( maximum_number_of_pending_chunks != write_io_handle->maximum_number_of_pending_chunks )
+	{
+		if( write_io_handle->pending_input_data_sizes != NULL )
+		{
+			memory_free(
+			 write_io_handle->pending_input_data_sizes );
+
+			write_io_handle->pending_input_data_sizes = NULL;
+		}
+		if( write_io_handle->pending_chunks_data != NULL )
+		{
+			memory_free(
+			 write_io_handle->pending_chunks_data );
+
+			write_io_handle->pending_chunks_data = NULL;
+		}
+		write_io_handle->maximum_number_of_pending_chunks = 0;
+
+		if( maximum_number_of_pending_chunks > 0 )
+		{
+			write_io_handle->pending_chunks_data = (libewf_chunk_data_t **) memory_allocate(
+			                                                                sizeof( libewf_chunk_data_t * ) * maximum_number_of_pending_chunks );
+
+			if( write_io_handle->pending_chunks_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create pending chunks data.",
+				 function );
+
+				goto on_error;
+			}
+			write_io_handle->pending_input_data_sizes = (size_t *) memory_allocate(
+			                                                        sizeof( size_t ) * maximum_number_of_pending_chunks );
+
+			if( write_io_handle->pending_input_data_sizes == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create pending input data sizes.",
+				 function );
+
+				goto on_error;
+			}
+			write_io_handle->maximum_number_of_pending_chunks = maximum_number_of_pending_chunks;
+		}
+	}
+	write_io_handle->number_of_compression_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( write_io_handle->pending_chunks_data != NULL )
+	{
+		memory_free(
+		 write_io_handle->pending_chunks_data );
+
+		write_io_handle->pending_chunks_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Appends a chunk to the chunks pending to be packed and written
+ * The write IO handle takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_append_pending_chunk(
+     libewf_write_io_handle_t *write_io_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_append_pending_chunk";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->pending_chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write IO handle - missing pending chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->pending_input_data_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write IO handle - missing pending input data sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->number_of_pending_chunks >= write_io_handle->maximum_number_of_pending_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write IO handle - number of pending chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->number_of_pending_chunks == 0 )
+	{
+		write_io_handle->pending_chunk_index = chunk_index;
+	}
+	else if( chunk_index != ( write_io_handle->pending_chunk_index + write_io_handle->number_of_pending_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	write_io_handle->pending_chunks_data[ write_io_handle->number_of_pending_chunks ]      = chunk_data;
+	write_io_handle->pending_input_data_sizes[ write_io_handle->number_of_pending_chunks ] = input_data_size;
+
+	write_io_handle->number_of_pending_chunks += 1;
+
+	return( 1 );
+}
+
+/* Packs pending chunk data
+ * Errors are not propagated, the chunk data is packed again before it is written
+ * Returns 1 if successful or 0 if not
+ */
+int libewf_write_io_handle_pack_pending_chunk_data(
+     libewf_chunk_data_t *chunk_data,
+     libewf_write_io_handle_t *write_io_handle )
+{
+	libcerror_error_t *error = NULL;
+
+	if( write_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_pack(
+	     chunk_data,
+	     write_io_handle->io_handle,
+	     write_io_handle->compressed_zero_byte_empty_block,
+	     write_io_handle->compressed_zero_byte_empty_block_size,
+	     write_io_handle->pack_flags,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Packs pending chunk data
+ * Callback function for the compression thread pool
+ * The number of packing chunks is decremented after the chunk data was packed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_pack_pending_chunk_data_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_write_io_handle_t *write_io_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_io_handle_pack_pending_chunk_data_callback";
+
+	if( write_io_handle == NULL )
+	{
+		return( -1 );
+	}
+	libewf_write_io_handle_pack_pending_chunk_data(
+	 chunk_data,
+	 write_io_handle );
+
+	if( libcthreads_mutex_grab(
+	     write_io_handle->thread_pool_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab thread pool mutex.",
+		 function );
+
+		goto on_error;
+	}
+	write_io_handle->number_of_packing_chunks -= 1;
+
+	if( libcthreads_condition_broadcast(
+	     write_io_handle->thread_pool_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast thread pool condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 write_io_handle->thread_pool_mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     write_io_handle->thread_pool_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release thread pool mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Packs the pending chunks using the compression thread pool
+ * The thread pool is created on first use and reused for subsequent pending chunks
+ * This function waits until all the pending chunks have been packed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_pack_pending_chunks(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_write_io_handle_pack_pending_chunks";
+	int number_of_pushed_chunks = 0;
+	int pending_chunk_index     = 0;
+	int result                  = 1;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->thread_pool_mutex == NULL )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( write_io_handle->thread_pool_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( write_io_handle->thread_pool_condition == NULL )
+	{
+		if( libcthreads_condition_initialize(
+		     &( write_io_handle->thread_pool_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool condition.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( write_io_handle->thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( write_io_handle->thread_pool ),
+		     NULL,
+		     write_io_handle->number_of_compression_threads,
+		     write_io_handle->maximum_number_of_pending_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_write_io_handle_pack_pending_chunk_data_callback,
+		     (void *) write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     write_io_handle->thread_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab thread pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+	write_io_handle->number_of_packing_chunks = write_io_handle->number_of_pending_chunks;
+
+	if( libcthreads_mutex_release(
+	     write_io_handle->thread_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release thread pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( pending_chunk_index = 0;
+	     pending_chunk_index < write_io_handle->number_of_pending_chunks;
+	     pending_chunk_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     write_io_handle->thread_pool,
+		     (intptr_t *) write_io_handle->pending_chunks_data[ pending_chunk_index ],
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push pending chunk data: %d onto queue.",
+			 function,
+			 pending_chunk_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_pushed_chunks++;
+	}
+	/* Wait for the chunks that were pushed onto the queue, the chunk data
+	 * must not be written or freed while a worker thread is still packing it
+	 */
+	if( libcthreads_mutex_grab(
+	     write_io_handle->thread_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab thread pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+	write_io_handle->number_of_packing_chunks -= write_io_handle->number_of_pending_chunks - number_of_pushed_chunks;
+
+	while( write_io_handle->number_of_packing_chunks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     write_io_handle->thread_pool_condition,
+		     write_io_handle->thread_pool_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for thread pool condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 write_io_handle->thread_pool_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     write_io_handle->thread_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release thread pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Frees the compression thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_free_thread_pool(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_free_thread_pool";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( write_io_handle->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Packs the pending chunks, using multiple threads if available, and writes them in order
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_write_pending_chunks(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfvalue_table_t *header_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_write_io_handle_write_pending_chunks";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	uint64_t chunk_index      = 0;
+	int pending_chunk_index   = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->number_of_pending_chunks == 0 )
+	{
+		return( 0 );
+	}
+	if( ( write_io_handle->pending_chunks_data == NULL )
+	 || ( write_io_handle->pending_input_data_sizes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write IO handle - missing pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+	write_io_handle->io_handle = io_handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( write_io_handle->number_of_compression_threads > 1 )
+	 && ( write_io_handle->number_of_pending_chunks > 1 ) )
+	{
+		if( libewf_write_io_handle_pack_pending_chunks(
+		     write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack pending chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	for( pending_chunk_index = 0;
+	     pending_chunk_index < write_io_handle->number_of_pending_chunks;
+	     pending_chunk_index++ )
+	{
+		chunk_index = write_io_handle->pending_chunk_index + pending_chunk_index;
+
+		/* Chunks that were packed by the thread pool are not packed again
+		 */
+		if( libewf_chunk_data_pack(
+		     write_io_handle->pending_chunks_data[ pending_chunk_index ],
+		     io_handle,
+		     write_io_handle->compressed_zero_byte_empty_block,
+		     write_io_handle->compressed_zero_byte_empty_block_size,
+		     write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               write_io_handle,
+		               io_handle,
+		               file_io_pool,
+		               media_values,
+		               segment_table,
+		               header_values,
+		               hash_values,
+		               hash_sections,
+		               sessions,
+		               tracks,
+		               acquiry_errors,
+		               chunk_index,
+		               write_io_handle->pending_chunks_data[ pending_chunk_index ],
+		               write_io_handle->pending_input_data_sizes[ pending_chunk_index ],
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( write_io_handle->pending_chunks_data[ pending_chunk_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* Writing the chunk can finalize the write, e.g. when the media size was reached,
+		 * the remaining pending chunks are not written
+		 */
+		if( write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+	}
+	for( pending_chunk_index = pending_chunk_index + 1;
+	     pending_chunk_index < write_io_handle->number_of_pending_chunks;
+	     pending_chunk_index++ )
+	{
+		if( libewf_chunk_data_free(
+		     &( write_io_handle->pending_chunks_data[ pending_chunk_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pending chunk data: %d.",
+			 function,
+			 pending_chunk_index );
+
+			goto on_error;
+		}
+	}
+	write_io_handle->number_of_pending_chunks = 0;
+	write_io_handle->io_handle                = NULL;
+
+	return( total_write_count );
+
+on_error:
+	for( pending_chunk_index = 0;
+	     pending_chunk_index < write_io_handle->number_of_pending_chunks;
+	     pending_chunk_index++ )
+	{
+		if( write_io_handle->pending_chunks_data[ pending_chunk_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( write_io_handle->pending_chunks_data[ pending_chunk_index ] ),
+			 NULL );
+		}
+	}
+	write_io_handle->number_of_pending_chunks = 0;
+	write_io_handle->io_handle                = NULL;
+
+	return( -1 );
+}
+
 /* Corrects sections after streamed write
  * Returns 1 if successful or -1 on error
  */
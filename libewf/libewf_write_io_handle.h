@@ -40,6 +40,7 @@
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcdata.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
@@ -207,6 +208,52 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The number of threads used to pack (compress) the chunks
+	 */
+	int number_of_compression_threads;
+
+	/* The IO handle used to pack the pending chunks
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The chunks data pending to be packed and written
+	 */
+	libewf_chunk_data_t **pending_chunks_data;
+
+	/* The input data sizes of the pending chunks
+	 */
+	size_t *pending_input_data_sizes;
+
+	/* The chunk index of the first pending chunk
+	 */
+	uint64_t pending_chunk_index;
+
+	/* The number of pending chunks
+	 */
+	int number_of_pending_chunks;
+
+	/* The maximum number of pending chunks
+	 */
+	int maximum_number_of_pending_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The compression thread pool, created the first time chunks are packed in parallel
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the number of chunks being packed
+	 */
+	libcthreads_mutex_t *thread_pool_mutex;
+
+	/* The condition that is signalled when a chunk has been packed
+	 */
+	libcthreads_condition_t *thread_pool_condition;
+
+	/* The number of chunks that are queued or being packed by the thread pool
+	 */
+	int number_of_packing_chunks;
+#endif
 };
 
 int libewf_write_io_handle_initialize(
@@ -316,6 +363,44 @@ ssize_t libewf_write_io_handle_write_new_chunk(
          size_t input_data_size,
          libcerror_error_t **error );
 
+int libewf_write_io_handle_set_number_of_compression_threads(
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_append_pending_chunk(
+     libewf_write_io_handle_t *write_io_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_write_io_handle_free_thread_pool(
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error );
+
+#endif
+
+int libewf_write_io_handle_pack_pending_chunk_data(
+     libewf_chunk_data_t *chunk_data,
+     libewf_write_io_handle_t *write_io_handle );
+
+ssize_t libewf_write_io_handle_write_pending_chunks(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_media_values_t *media_values,
+         libewf_segment_table_t *segment_table,
+         libfvalue_table_t *header_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         libcerror_error_t **error );
+
 int libewf_write_io_handle_finalize_write_sections_corrections(
      libewf_write_io_handle_t *write_io_handle,
      libbfio_pool_t *file_io_pool,
@@ -0,0 +1,161 @@
+/*
+ * SIMD (Single Instruction Multiple Data) functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SIMD_H )
+#define _LIBEWF_SIMD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Determine the SIMD instruction sets that can be build
+ * The x86 instruction sets require GCC or clang function target attributes or Visual Studio
+ */
+#if !defined( LIBEWF_DISABLE_SIMD )
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define LIBEWF_SIMD_HAVE_X86_ATTRIBUTES
+#define LIBEWF_SIMD_HAVE_SSE2
+#define LIBEWF_SIMD_HAVE_AVX2
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1700 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define LIBEWF_SIMD_HAVE_SSE2
+#define LIBEWF_SIMD_HAVE_AVX2
+
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ ) || defined( __aarch64__ ) || defined( _M_ARM64 )
+#define LIBEWF_SIMD_HAVE_NEON
+
+#endif
+
+#endif /* !defined( LIBEWF_DISABLE_SIMD ) */
+
+/* The Adler-32 modulus and the maximum number of bytes that can be processed
+ * before the modulus needs to be applied to prevent 32-bit overflow
+ */
+#define LIBEWF_SIMD_ADLER32_MODULUS			65521
+#define LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE		5552
+
+/* The SIMD instruction sets
+ */
+enum LIBEWF_SIMD_INSTRUCTION_SETS
+{
+	LIBEWF_SIMD_INSTRUCTION_SET_NONE		= 0x00,
+	LIBEWF_SIMD_INSTRUCTION_SET_SSE2		= 0x01,
+	LIBEWF_SIMD_INSTRUCTION_SET_AVX2		= 0x02,
+	LIBEWF_SIMD_INSTRUCTION_SET_NEON		= 0x04
+};
+
+int libewf_simd_get_supported_instruction_sets(
+     void );
+
+int libewf_simd_get_best_instruction_set(
+     void );
+
+int libewf_simd_check_for_64_bit_pattern_fill_generic(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data );
+
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+
+int libewf_simd_check_for_64_bit_pattern_fill_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+
+int libewf_simd_check_for_64_bit_pattern_fill_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+
+int libewf_simd_check_for_64_bit_pattern_fill_neon(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern_data );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_NEON ) */
+
+int libewf_simd_check_for_64_bit_pattern_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern,
+     int instruction_set,
+     libcerror_error_t **error );
+
+uint32_t libewf_simd_calculate_adler32_generic(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#if defined( LIBEWF_SIMD_HAVE_SSE2 )
+
+uint32_t libewf_simd_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_AVX2 )
+
+uint32_t libewf_simd_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_SIMD_HAVE_NEON )
+
+uint32_t libewf_simd_calculate_adler32_neon(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#endif /* defined( LIBEWF_SIMD_HAVE_NEON ) */
+
+int libewf_simd_calculate_adler32(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     int instruction_set,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SIMD_H ) */
+
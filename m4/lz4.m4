@@ -0,0 +1,136 @@
+dnl Functions for lz4
+dnl
+dnl Version: 20160601
+
+dnl Function to detect if lz4 is available
+AC_DEFUN([AX_LZ4_CHECK_LIB],
+ [dnl Check if parameters were provided
+ AS_IF(
+  [test "x$ac_cv_with_lz4" != x && test "x$ac_cv_with_lz4" != xno && test "x$ac_cv_with_lz4" != xyes],
+  [AS_IF(
+   [test -d "$ac_cv_with_lz4"],
+   [CFLAGS="$CFLAGS -I${ac_cv_with_lz4}/include"
+   LDFLAGS="$LDFLAGS -L${ac_cv_with_lz4}/lib"],
+   [AC_MSG_WARN([no such directory: $ac_cv_with_lz4])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_with_lz4" = xno],
+  [ac_cv_lz4=no],
+  [dnl Check for a pkg-config file
+  AS_IF(
+   [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
+   [PKG_CHECK_MODULES(
+    [lz4],
+    [liblz4 >= 1.8.0],
+    [ac_cv_lz4=lz4],
+    [ac_cv_lz4=no])
+   ])
+
+  AS_IF(
+   [test "x$ac_cv_lz4" = xlz4],
+   [ac_cv_lz4_CPPFLAGS="$pkg_cv_lz4_CFLAGS"
+   ac_cv_lz4_LIBADD="$pkg_cv_lz4_LIBS"],
+   [dnl Check for headers
+   AC_CHECK_HEADERS([lz4frame.h lz4hc.h])
+
+   AS_IF(
+    [test "x$ac_cv_header_lz4frame_h" = xno || test "x$ac_cv_header_lz4hc_h" = xno],
+    [ac_cv_lz4=no],
+    [dnl Check for the individual functions
+    ac_cv_lz4=lz4
+    AC_CHECK_LIB(
+     lz4,
+     LZ4_versionNumber,
+     [ac_lz4_dummy=yes],
+     [ac_cv_lz4=no])
+
+    AC_CHECK_LIB(
+     lz4,
+     LZ4F_compressFrame,
+     [ac_lz4_dummy=yes],
+     [ac_cv_lz4=no])
+
+    AC_CHECK_LIB(
+     lz4,
+     LZ4F_decompress,
+     [ac_lz4_dummy=yes],
+     [ac_cv_lz4=no])
+
+    ac_cv_lz4_LIBADD="-llz4";
+    ])
+   ])
+
+  AS_IF(
+   [test "x$ac_cv_with_lz4" != xauto-detect && test "x$ac_cv_lz4" = xno],
+   [AC_MSG_FAILURE(
+    [lz4 support was requested but liblz4 1.8.0 or later was not found],
+    [1])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_lz4" = xlz4],
+  [AC_DEFINE(
+   [HAVE_LIBLZ4],
+   [1],
+   [Define to 1 if you have the 'lz4' library (-llz4).])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_lz4" != xno],
+  [AC_SUBST(
+   [HAVE_LIBLZ4],
+   [1]) ],
+  [AC_SUBST(
+   [HAVE_LIBLZ4],
+   [0])
+  ])
+ ])
+
+dnl Function to detect how to enable lz4
+dnl lz4 compressed EWF2 images are a libewf specific extension
+dnl so support is only enabled on request
+AC_DEFUN([AX_LZ4_CHECK_ENABLE],
+ [AX_COMMON_ARG_WITH(
+  [lz4],
+  [lz4],
+  [search for lz4 in includedir and libdir or in the specified DIR, or no if not to use lz4],
+  [no],
+  [DIR])
+
+ dnl Check for a shared library version
+ AX_LZ4_CHECK_LIB
+
+ AS_IF(
+  [test "x$ac_cv_lz4_CPPFLAGS" != "x"],
+  [AC_SUBST(
+   [LZ4_CPPFLAGS],
+   [$ac_cv_lz4_CPPFLAGS])
+  ])
+ AS_IF(
+  [test "x$ac_cv_lz4_LIBADD" != "x"],
+  [AC_SUBST(
+   [LZ4_LIBADD],
+   [$ac_cv_lz4_LIBADD])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_lz4" = xlz4],
+  [AC_SUBST(
+   [ax_lz4_pc_libs_private],
+   [-llz4])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_lz4" = xlz4],
+  [AC_SUBST(
+   [ax_lz4_spec_requires],
+   [lz4-libs])
+  AC_SUBST(
+   [ax_lz4_spec_build_requires],
+   [lz4-devel])
+  ])
+ ])
+
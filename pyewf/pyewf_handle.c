@@ -50,6 +50,25 @@ int libewf_handle_open_file_io_pool(
      libewf_error_t **error );
 #endif
 
+/* The statistic names, in order of the LIBEWF_STATISTIC_ definitions
+ */
+static const char *pyewf_handle_statistic_names[ LIBEWF_NUMBER_OF_STATISTICS ] = {
+	"bytes_read",
+	"bytes_written",
+	"chunks_read",
+	"chunks_written",
+	"chunks_cache_hits",
+	"chunks_cache_misses",
+	"chunk_groups_cache_hits",
+	"chunk_groups_cache_misses",
+	"segment_files_cache_hits",
+	"segment_files_cache_misses",
+	"decompression_time",
+	"compression_time",
+	"checksum_failures",
+	"segment_file_opens",
+	"segment_file_closes" };
+
 PyMethodDef pyewf_handle_object_methods[] = {
 
 	{ "signal_abort",
@@ -125,6 +144,14 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves the current offset within the media data." },
 
+	{ "get_statistics",
+	  (PyCFunction) pyewf_handle_get_statistics,
+	  METH_NOARGS,
+	  "get_statistics() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the statistics of the handle, such as the number of bytes read,\n"
+	  "the cache hits and misses and the (de)compression time in nanoseconds." },
+
 	/* Some Pythonesque aliases */
 
 	{ "read",
@@ -1823,6 +1850,116 @@ PyObject *pyewf_handle_get_offset(
 	return( integer_object );
 }
 
+/* Retrieves the statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	uint64_t values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error    = NULL;
+	PyObject *dictionary_object = NULL;
+	PyObject *integer_object    = NULL;
+	static char *function       = "pyewf_handle_get_statistics";
+	int result                  = 0;
+	int statistic_index         = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_statistics(
+	          pyewf_handle->handle,
+	          values,
+	          LIBEWF_NUMBER_OF_STATISTICS,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dictionary.",
+		 function );
+
+		goto on_error;
+	}
+	for( statistic_index = 0;
+	     statistic_index < LIBEWF_NUMBER_OF_STATISTICS;
+	     statistic_index++ )
+	{
+		integer_object = pyewf_integer_unsigned_new_from_64bit(
+		                  values[ statistic_index ] );
+
+		if( integer_object == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create statistic: %s value.",
+			 function,
+			 pyewf_handle_statistic_names[ statistic_index ] );
+
+			goto on_error;
+		}
+		/* PyDict_SetItemString does not steal the reference of the value
+		 */
+		result = PyDict_SetItemString(
+		          dictionary_object,
+		          pyewf_handle_statistic_names[ statistic_index ],
+		          integer_object );
+
+		Py_DecRef(
+		 integer_object );
+
+		if( result != 0 )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to set statistic: %s in dictionary.",
+			 function,
+			 pyewf_handle_statistic_names[ statistic_index ] );
+
+			goto on_error;
+		}
+	}
+	return( dictionary_object );
+
+on_error:
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
 /* Retrieves the root file entry
  * Returns a Python object if successful or NULL on error
  */
@@ -121,6 +121,10 @@ PyObject *pyewf_handle_get_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
 
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
 PyObject *pyewf_handle_get_root_file_entry(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
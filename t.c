@@ -0,0 +1,31 @@
+#include "common.h"
+#include "libewf_simd.h"
+#include <stdio.h>
+#include <zlib.h>
+int main(){
+ size_t n=3*1024*1024; uint8_t*b=malloc(n+64); int fails=0;
+ for(size_t i=0;i<n+64;i++) b[i]=0xff;
+ for(int mode=0;mode<3;mode++){
+  if(mode==1) for(size_t i=0;i<n+64;i++) b[i]=rand();
+  if(mode==2) for(size_t i=0;i<n+64;i++) b[i]=(i%7)?0xff:0;
+  size_t sizes[]={0,1,15,16,17,31,32,33,63,64,100,5551,5552,5553,5552*2+7,65536,1<<20,n};
+  for(int s=0;s<18;s++) for(int off=0;off<5;off++){
+   uint32_t ref=adler32(1,b+off,sizes[s]);
+   uint32_t inits[]={1, 0xfff0fff0u};
+   for(int k=0;k<2;k++){ uint32_t iv=inits[k]; uint32_t r=adler32(iv,b+off,sizes[s]);
+   if(libewf_simd_calculate_adler32_generic(b+off,sizes[s],iv)!=r){printf("gen fail %zu\n",sizes[s]);fails++;}
+   if(libewf_simd_calculate_adler32_sse2(b+off,sizes[s],iv)!=r){printf("sse fail %zu %d\n",sizes[s],mode);fails++;}
+   if(libewf_simd_calculate_adler32_avx2(b+off,sizes[s],iv)!=r){printf("avx fail %zu %d iv %x\n",sizes[s],mode,iv);fails++;}
+   }
+  }
+ }
+ /* pattern */
+ uint8_t *p=malloc(4096+64);
+ for(int off=0;off<16;off++) for(size_t sz=0;sz<2048;sz+=13){
+  uint64_t pat=0x0102030405060708ULL; for(size_t i=0;i<sz;i++) p[off+i]=(uint8_t)(pat>>(8*(i%8)));
+  int a=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,0,NULL),c=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,1,NULL),d=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,2,NULL);
+  if(a!=1||c!=1||d!=1){printf("pat fail %d %zu %d %d %d\n",off,sz,a,c,d);fails++;}
+  if(sz>0){p[off+sz-1]^=1; a=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,0,NULL),c=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,1,NULL),d=libewf_simd_check_for_64_bit_pattern_fill(p+off,sz,pat,2,NULL); if(a|c|d){printf("neg fail\n");fails++;}}
+ }
+ printf("fails=%d best=%d\n",fails,libewf_simd_get_best_instruction_set());
+}
@@ -0,0 +1,466 @@
+/*
+ * Chunk data pool test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data_pool.h"
+
+#define EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE	1024
+
+/* Checks the pool statistics
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_data_pool_check_statistics(
+     libewf_chunk_data_pool_t *pool,
+     uint64_t expected_number_of_allocations,
+     uint64_t expected_number_of_reuses,
+     size64_t expected_pooled_size,
+     libcerror_error_t **error )
+{
+	static char *function          = "ewf_test_chunk_data_pool_check_statistics";
+	uint64_t number_of_allocations = 0;
+	uint64_t number_of_reuses      = 0;
+	size64_t pooled_size           = 0;
+
+	if( libewf_chunk_data_pool_get_statistics(
+	     pool,
+	     &number_of_allocations,
+	     &number_of_reuses,
+	     &pooled_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_allocations != expected_number_of_allocations )
+	 || ( number_of_reuses != expected_number_of_reuses )
+	 || ( pooled_size != expected_pooled_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected allocations: %" PRIu64 ", reuses: %" PRIu64 " and pooled size: %" PRIu64 ".\n",
+		 number_of_allocations,
+		 number_of_reuses,
+		 pooled_size );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Prints the result of a test
+ */
+void ewf_test_chunk_data_pool_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Tests reusing released memory blocks
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_data_pool_reuse(
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_pool_t *pool = NULL;
+	uint8_t *block                 = NULL;
+	uint8_t *large_block           = NULL;
+	uint8_t *released_block        = NULL;
+	int result                     = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing reuse\t" );
+
+	result = libewf_chunk_data_pool_initialize(
+	          &pool,
+	          4 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          &block,
+		          error );
+	}
+	if( result == 1 )
+	{
+		released_block = block;
+
+		result = libewf_chunk_data_pool_release(
+		          pool,
+		          &block,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( block != NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Released block was not cleared.\n" );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          1,
+		          0,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	/* A block of a different size is not reused
+	 */
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          2 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          &large_block,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          2,
+		          0,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	/* A block of the same size is reused
+	 */
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          &block,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( block != released_block ) )
+	{
+		fprintf(
+		 stderr,
+		 "Released block was not reused.\n" );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          2,
+		          1,
+		          0,
+		          error );
+	}
+	/* Allocating a block of size 0 fails
+	 */
+	if( result == 1 )
+	{
+		released_block = NULL;
+
+		if( libewf_chunk_data_pool_allocate(
+		     pool,
+		     0,
+		     &released_block,
+		     error ) != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Block of size 0 was allocated.\n" );
+
+			result = 0;
+		}
+		else
+		{
+			libcerror_error_free(
+			 error );
+		}
+	}
+	if( libewf_chunk_data_pool_release(
+	     pool,
+	     &large_block,
+	     2 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	if( libewf_chunk_data_pool_release(
+	     pool,
+	     &block,
+	     EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          2,
+		          1,
+		          3 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	if( pool != NULL )
+	{
+		if( libewf_chunk_data_pool_free(
+		     &pool,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_chunk_data_pool_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests the maximum size of the pool
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_data_pool_maximum_size(
+     libcerror_error_t **error )
+{
+	uint8_t *blocks[ 4 ]           = { NULL, NULL, NULL, NULL };
+	uint8_t *block                 = NULL;
+	libewf_chunk_data_pool_t *pool = NULL;
+	int block_index                = 0;
+	int result                     = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing maximum size\t" );
+
+	result = libewf_chunk_data_pool_initialize(
+	          &pool,
+	          3 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+	          error );
+
+	for( block_index = 0;
+	     ( result == 1 ) && ( block_index < 4 );
+	     block_index++ )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          &( blocks[ block_index ] ),
+		          error );
+	}
+	/* The fourth released block exceeds the maximum size and is freed
+	 */
+	for( block_index = 0;
+	     ( result == 1 ) && ( block_index < 4 );
+	     block_index++ )
+	{
+		result = libewf_chunk_data_pool_release(
+		          pool,
+		          &( blocks[ block_index ] ),
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          4,
+		          0,
+		          3 * EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	/* Reducing the maximum size frees blocks
+	 */
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_set_maximum_size(
+		          pool,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          4,
+		          0,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	/* The remaining block is reused
+	 */
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_allocate(
+		          pool,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          &block,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          4,
+		          1,
+		          0,
+		          error );
+	}
+	/* A maximum size of 0 disables the pool
+	 */
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_set_maximum_size(
+		          pool,
+		          0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pool_release(
+		          pool,
+		          &block,
+		          EWF_TEST_CHUNK_DATA_POOL_BLOCK_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_chunk_data_pool_check_statistics(
+		          pool,
+		          4,
+		          1,
+		          0,
+		          error );
+	}
+	for( block_index = 0;
+	     block_index < 4;
+	     block_index++ )
+	{
+		if( blocks[ block_index ] != NULL )
+		{
+			memory_free(
+			 blocks[ block_index ] );
+		}
+	}
+	if( block != NULL )
+	{
+		memory_free(
+		 block );
+	}
+	if( pool != NULL )
+	{
+		if( libewf_chunk_data_pool_free(
+		     &pool,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_chunk_data_pool_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( ewf_test_chunk_data_pool_reuse(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test reuse.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_chunk_data_pool_maximum_size(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test maximum size.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
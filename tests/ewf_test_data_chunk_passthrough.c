@@ -0,0 +1,1290 @@
+/*
+ * Data chunk pass-through testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE	32768
+
+/* The media consists of 9 chunks and a partial last chunk
+ */
+#define EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE	( ( 9 * EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ) + 1024 )
+
+/* The chunk that is corrupted in the input segment file
+ */
+#define EWF_TEST_DATA_CHUNK_PASSTHROUGH_CORRUPTED_CHUNK	3
+
+/* Retrieves the expected value of the (media) data at a specific offset
+ * The chunks alternate between compressible, empty (zero) and incompressible data
+ */
+uint8_t ewf_test_data_chunk_passthrough_get_data_value(
+         off64_t offset )
+{
+	uint32_t value = 0;
+
+	switch( ( offset / EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ) % 3 )
+	{
+		case 0:
+			return( (uint8_t) ( ( offset / 512 ) + ( offset % 509 ) ) );
+
+		case 1:
+			return( 0 );
+
+		default:
+			break;
+	}
+	value  = (uint32_t) offset;
+	value ^= value >> 16;
+	value *= 0x7feb352dUL;
+	value ^= value >> 15;
+	value *= 0x846ca68bUL;
+	value ^= value >> 16;
+
+	return( (uint8_t) value );
+}
+
+/* Removes the segment files
+ */
+void ewf_test_data_chunk_passthrough_remove_segment_files(
+      void )
+{
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_data_chunk_passthrough_input" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_data_chunk_passthrough_corrupted" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_data_chunk_passthrough_output" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_data_chunk_passthrough_recompressed" );
+}
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_open_handle(
+     libewf_handle_t **handle,
+     const libcstring_system_character_t *filename,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_data_chunk_passthrough_open_handle";
+
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     access_flags,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     (char * const *) &filename,
+	     1,
+	     access_flags,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_close_handle(
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_data_chunk_passthrough_close_handle";
+
+	if( libewf_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		libewf_handle_free(
+		 handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libewf_handle_free(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the output values of a handle opened for writing
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_set_output_values(
+     libewf_handle_t *handle,
+     uint8_t format,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_data_chunk_passthrough_set_output_values";
+
+	/* Format needs to be set before compression values
+	 */
+	if( libewf_handle_set_format(
+	     handle,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Corrupts the stored data of a chunk in a segment file without compression
+ * Returns 1 if successful, 0 if the chunk data was not found or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_corrupt_chunk(
+     const char *filename,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_data[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+
+	FILE *file_stream     = NULL;
+	uint8_t *file_data    = NULL;
+	static char *function = "ewf_test_data_chunk_passthrough_corrupt_chunk";
+	size_t file_data_size = 0;
+	size_t file_offset    = 0;
+	size_t read_count     = 0;
+	int result            = 0;
+
+	file_stream = file_stream_open(
+	               filename,
+	               "r+b" );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file stream.",
+		 function );
+
+		goto on_error;
+	}
+	/* The segment file is small enough to be read as a whole
+	 */
+	file_data_size = 2 * EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE;
+
+	file_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * file_data_size );
+
+	if( file_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = file_stream_read(
+	              file_stream,
+	              file_data,
+	              file_data_size );
+
+	ewf_test_image_fill_buffer(
+	 chunk_data,
+	 EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE,
+	 (off64_t) ( chunk_index * EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ),
+	 &ewf_test_data_chunk_passthrough_get_data_value );
+
+	for( file_offset = 0;
+	     ( file_offset + EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ) <= read_count;
+	     file_offset++ )
+	{
+		if( ( file_data[ file_offset ] == chunk_data[ 0 ] )
+		 && ( memory_compare(
+		       &( file_data[ file_offset ] ),
+		       chunk_data,
+		       EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ) == 0 ) )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	if( result != 0 )
+	{
+		/* Flip the bits of a single byte in the middle of the chunk data
+		 */
+		file_offset += EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE / 2;
+
+		file_data[ file_offset ] ^= 0xff;
+
+		if( file_stream_seek_offset(
+		     file_stream,
+		     (off64_t) file_offset,
+		     SEEK_SET ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIzd ".",
+			 function,
+			 file_offset );
+
+			goto on_error;
+		}
+		if( file_stream_write(
+		     file_stream,
+		     &( file_data[ file_offset ] ),
+		     1 ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write corrupted data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 file_data );
+
+	file_data = NULL;
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file stream.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_data != NULL )
+	{
+		memory_free(
+		 file_data );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Copies the media data of an input image to an output image
+ * If use_data_chunks is set the data chunks read from the input are written to the output as-is,
+ * every other data chunk is unpacked before writing as ewfexport does for hashing
+ * otherwise the media data is read into a buffer and compressed again when written
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_copy(
+     const libcstring_system_character_t *input_filename,
+     const libcstring_system_character_t *output_basename,
+     int8_t compression_level,
+     uint8_t use_data_chunks,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+
+	libewf_data_chunk_t *data_chunk = NULL;
+	libewf_handle_t *input_handle   = NULL;
+	libewf_handle_t *output_handle  = NULL;
+	static char *function           = "ewf_test_data_chunk_passthrough_copy";
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	ssize_t write_count             = 0;
+	off64_t read_offset             = 0;
+	uint64_t chunk_index            = 0;
+
+	if( ewf_test_data_chunk_passthrough_open_handle(
+	     &input_handle,
+	     input_filename,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_open_handle(
+	     &output_handle,
+	     output_basename,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_set_output_values(
+	     output_handle,
+	     LIBEWF_FORMAT_ENCASE6,
+	     compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set output values.",
+		 function );
+
+		goto on_error;
+	}
+	if( use_data_chunks != 0 )
+	{
+		if( libewf_handle_get_data_chunk(
+		     input_handle,
+		     &data_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( read_offset < (off64_t) EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE )
+	{
+		read_size = EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE;
+
+		if( (size64_t) read_size > ( (size64_t) EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE - read_offset ) )
+		{
+			read_size = (size_t) ( EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE - read_offset );
+		}
+		if( use_data_chunks != 0 )
+		{
+			read_count = libewf_handle_read_data_chunk(
+			              input_handle,
+			              data_chunk,
+			              error );
+
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( ( chunk_index % 2 ) == 0 )
+			{
+				read_count = libewf_data_chunk_read_buffer(
+				              data_chunk,
+				              buffer,
+				              read_size,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from data chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			write_count = libewf_handle_write_data_chunk(
+			               output_handle,
+			               data_chunk,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			read_count = libewf_handle_read_buffer(
+			              input_handle,
+			              buffer,
+			              read_size,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 ".",
+				 function,
+				 read_offset );
+
+				goto on_error;
+			}
+			write_count = libewf_handle_write_buffer(
+			               output_handle,
+			               buffer,
+			               read_size,
+			               error );
+
+			if( write_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer at offset: %" PRIi64 ".",
+				 function,
+				 read_offset );
+
+				goto on_error;
+			}
+		}
+		read_offset += (off64_t) read_size;
+
+		chunk_index++;
+	}
+	if( data_chunk != NULL )
+	{
+		if( libewf_data_chunk_free(
+		     &data_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_data_chunk_passthrough_close_handle(
+	     &output_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_close_handle(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( output_handle != NULL )
+	{
+		libewf_handle_close(
+		 output_handle,
+		 NULL );
+		libewf_handle_free(
+		 &output_handle,
+		 NULL );
+	}
+	if( input_handle != NULL )
+	{
+		libewf_handle_close(
+		 input_handle,
+		 NULL );
+		libewf_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of checksum errors found when reading all media data of an image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_get_number_of_checksum_errors(
+     const libcstring_system_character_t *filename,
+     uint32_t *number_of_checksum_errors,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_data_chunk_passthrough_get_number_of_checksum_errors";
+	ssize_t read_count      = 0;
+
+	if( ewf_test_data_chunk_passthrough_open_handle(
+	     &handle,
+	     filename,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( read_count > 0 );
+
+	if( libewf_handle_get_number_of_checksum_errors(
+	     handle,
+	     number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_close_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Compares the chunks of the pass-through output with those of the recompressed output
+ * The stored (packed) chunk sizes and the media data must be equal
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_data_chunk_passthrough_compare(
+     uint8_t compare_expected_data,
+     libcerror_error_t **error )
+{
+	uint8_t expected_buffer[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+	uint8_t output_buffer[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+	uint8_t recompressed_buffer[ EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE ];
+
+	libewf_data_chunk_t *output_data_chunk       = NULL;
+	libewf_data_chunk_t *recompressed_data_chunk = NULL;
+	libewf_handle_t *output_handle               = NULL;
+	libewf_handle_t *recompressed_handle         = NULL;
+	static char *function                        = "ewf_test_data_chunk_passthrough_compare";
+	size_t read_size                             = 0;
+	ssize_t output_read_count                    = 0;
+	ssize_t recompressed_read_count              = 0;
+	off64_t read_offset                          = 0;
+	int result                                   = 1;
+
+	if( ewf_test_data_chunk_passthrough_open_handle(
+	     &output_handle,
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_output.E01" ),
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_open_handle(
+	     &recompressed_handle,
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_recompressed.E01" ),
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open recompressed handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     output_handle,
+	     &output_data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve output data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     recompressed_handle,
+	     &recompressed_data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recompressed data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( result == 1 )
+	    && ( read_offset < (off64_t) EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE ) )
+	{
+		read_size = EWF_TEST_DATA_CHUNK_PASSTHROUGH_CHUNK_SIZE;
+
+		if( (size64_t) read_size > ( (size64_t) EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE - read_offset ) )
+		{
+			read_size = (size_t) ( EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE - read_offset );
+		}
+		/* Reading a data chunk returns the size of the stored (packed) chunk data
+		 */
+		output_read_count = libewf_handle_read_data_chunk(
+		                     output_handle,
+		                     output_data_chunk,
+		                     error );
+
+		if( output_read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read output data chunk at offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
+
+			goto on_error;
+		}
+		recompressed_read_count = libewf_handle_read_data_chunk(
+		                           recompressed_handle,
+		                           recompressed_data_chunk,
+		                           error );
+
+		if( recompressed_read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read recompressed data chunk at offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
+
+			goto on_error;
+		}
+		if( output_read_count != recompressed_read_count )
+		{
+			result = 0;
+		}
+		if( result == 1 )
+		{
+			output_read_count = libewf_data_chunk_read_buffer(
+			                     output_data_chunk,
+			                     output_buffer,
+			                     read_size,
+			                     error );
+
+			recompressed_read_count = libewf_data_chunk_read_buffer(
+			                           recompressed_data_chunk,
+			                           recompressed_buffer,
+			                           read_size,
+			                           error );
+
+			if( ( output_read_count != (ssize_t) read_size )
+			 || ( recompressed_read_count != (ssize_t) read_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from data chunks at offset: %" PRIi64 ".",
+				 function,
+				 read_offset );
+
+				goto on_error;
+			}
+			if( memory_compare(
+			     output_buffer,
+			     recompressed_buffer,
+			     read_size ) != 0 )
+			{
+				result = 0;
+			}
+		}
+		if( ( result == 1 )
+		 && ( compare_expected_data != 0 ) )
+		{
+			ewf_test_image_fill_buffer(
+			 expected_buffer,
+			 read_size,
+			 read_offset,
+			 &ewf_test_data_chunk_passthrough_get_data_value );
+
+			if( memory_compare(
+			     output_buffer,
+			     expected_buffer,
+			     read_size ) != 0 )
+			{
+				result = 0;
+			}
+		}
+		read_offset += (off64_t) read_size;
+	}
+	if( libewf_data_chunk_free(
+	     &recompressed_data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free recompressed data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_data_chunk_free(
+	     &output_data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free output data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_close_handle(
+	     &recompressed_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close recompressed handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_close_handle(
+	     &output_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( recompressed_data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &recompressed_data_chunk,
+		 NULL );
+	}
+	if( output_data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &output_data_chunk,
+		 NULL );
+	}
+	if( recompressed_handle != NULL )
+	{
+		libewf_handle_close(
+		 recompressed_handle,
+		 NULL );
+		libewf_handle_free(
+		 &recompressed_handle,
+		 NULL );
+	}
+	if( output_handle != NULL )
+	{
+		libewf_handle_close(
+		 output_handle,
+		 NULL );
+		libewf_handle_free(
+		 &output_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests passing the data chunks of an input image through to an output image
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_data_chunk_passthrough(
+     const char *description,
+     const libcstring_system_character_t *input_filename,
+     int8_t compression_level,
+     uint8_t compare_expected_data,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_data_chunk_passthrough";
+	uint32_t number_of_checksum_errors = 0;
+	int result                         = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing pass-through of %s\t",
+	 description );
+
+	if( ewf_test_data_chunk_passthrough_copy(
+	     input_filename,
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_output" ),
+	     compression_level,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pass through data chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_copy(
+	     input_filename,
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_recompressed" ),
+	     compression_level,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to recompress media data.",
+		 function );
+
+		goto on_error;
+	}
+	result = ewf_test_data_chunk_passthrough_compare(
+	          compare_expected_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare output.",
+		 function );
+
+		goto on_error;
+	}
+	/* Chunks that were corrupted in the input are packed again
+	 * and have a valid checksum in the output
+	 */
+	if( result == 1 )
+	{
+		if( ewf_test_data_chunk_passthrough_get_number_of_checksum_errors(
+		     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_output.E01" ),
+		     &number_of_checksum_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of checksum errors.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_checksum_errors != 0 )
+		{
+			result = 0;
+		}
+	}
+	remove(
+	 "ewf_test_data_chunk_passthrough_output.E01" );
+	remove(
+	 "ewf_test_data_chunk_passthrough_recompressed.E01" );
+
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+
+on_error:
+	remove(
+	 "ewf_test_data_chunk_passthrough_output.E01" );
+	remove(
+	 "ewf_test_data_chunk_passthrough_recompressed.E01" );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error           = NULL;
+	uint32_t number_of_checksum_errors = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	/* EWF version 1 chunks with the same compression method are written as-is
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_input" ),
+	     LIBEWF_FORMAT_ENCASE6,
+	     EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_FAST,
+	     0,
+	     &ewf_test_data_chunk_passthrough_get_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write input segment files.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough(
+	     "EWF chunks",
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_input.E01" ),
+	     LIBEWF_COMPRESSION_FAST,
+	     1,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* EWF version 2 chunks are another format and are packed again
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_input" ),
+	     LIBEWF_FORMAT_V2_ENCASE7,
+	     EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_FAST,
+	     0,
+	     &ewf_test_data_chunk_passthrough_get_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write input segment files.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough(
+	     "EWF version 2 chunks",
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_input.Ex01" ),
+	     LIBEWF_COMPRESSION_FAST,
+	     1,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* A corrupted chunk is packed again instead of copying its stored checksum
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_corrupted" ),
+	     LIBEWF_FORMAT_ENCASE6,
+	     EWF_TEST_DATA_CHUNK_PASSTHROUGH_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     &ewf_test_data_chunk_passthrough_get_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write input segment files.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_corrupt_chunk(
+	     "ewf_test_data_chunk_passthrough_corrupted.E01",
+	     EWF_TEST_DATA_CHUNK_PASSTHROUGH_CORRUPTED_CHUNK,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to corrupt chunk in input segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough_get_number_of_checksum_errors(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_corrupted.E01" ),
+	     &number_of_checksum_errors,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of checksum errors.\n" );
+
+		goto on_error;
+	}
+	if( number_of_checksum_errors != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of checksum errors in input segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_data_chunk_passthrough(
+	     "corrupted EWF chunk",
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_data_chunk_passthrough_corrupted.E01" ),
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_test_data_chunk_passthrough_remove_segment_files();
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	ewf_test_data_chunk_passthrough_remove_segment_files();
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,781 @@
+/*
+ * Adler-32 and deflate decompression test and benchmark program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <time.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_deflate.h"
+#include "../libewf/libewf_simd.h"
+
+#define EWF_TEST_DEFLATE_DATA_SIZE		( 1024 * 1024 )
+#define EWF_TEST_DEFLATE_CHUNK_SIZE		( 32 * 1024 )
+#define EWF_TEST_DEFLATE_BENCHMARK_DATA_SIZE	( 256 * 1024 * 1024 )
+
+/* The instruction sets to test
+ */
+static int ewf_test_deflate_instruction_sets[ 4 ] = {
+	LIBEWF_SIMD_INSTRUCTION_SET_NONE,
+	LIBEWF_SIMD_INSTRUCTION_SET_SSE2,
+	LIBEWF_SIMD_INSTRUCTION_SET_AVX2,
+	LIBEWF_SIMD_INSTRUCTION_SET_NEON };
+
+static const char *ewf_test_deflate_instruction_set_names[ 4 ] = {
+	"generic",
+	"SSE2",
+	"AVX2",
+	"NEON" };
+
+/* Fills the buffer with compressible text-like test data
+ */
+void ewf_test_deflate_fill_buffer(
+      uint8_t *buffer,
+      size_t size )
+{
+	static const char *words[ 8 ] = {
+		"evidence ", "segment ", "chunk ", "sector ", "\r\n", "table ", "0x0000 ", "header " };
+
+	const char *word     = NULL;
+	size_t buffer_offset = 0;
+	uint32_t seed        = 0x12345678UL;
+
+	while( buffer_offset < size )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		/* Mix in random bytes to prevent long matches only
+		 */
+		if( ( ( seed >> 16 ) & 0x07 ) == 0 )
+		{
+			buffer[ buffer_offset++ ] = (uint8_t) ( seed >> 24 );
+
+			continue;
+		}
+		for( word = words[ ( seed >> 20 ) & 0x07 ];
+		     ( *word != 0 ) && ( buffer_offset < size );
+		     word++ )
+		{
+			buffer[ buffer_offset++ ] = (uint8_t) *word;
+		}
+	}
+}
+
+/* Calculates the Adler-32 of a buffer one byte at a time as reference
+ * Returns the Adler-32
+ */
+uint32_t ewf_test_deflate_calculate_adler32(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	uint32_t lower_word = initial_value & 0x0000ffffUL;
+	uint32_t upper_word = ( initial_value >> 16 ) & 0x0000ffffUL;
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		lower_word = ( lower_word + buffer[ buffer_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Tests the Adler-32 calculation of all supported instruction sets on specific data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_deflate_adler32_data(
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value )
+{
+	libcerror_error_t *error  = NULL;
+	uint32_t checksum         = 0;
+	uint32_t expected_checksum = 0;
+	int instruction_set_index = 0;
+	int instruction_sets      = 0;
+
+	expected_checksum = ewf_test_deflate_calculate_adler32(
+	                     buffer,
+	                     size,
+	                     initial_value );
+
+	instruction_sets = libewf_simd_get_supported_instruction_sets();
+
+	for( instruction_set_index = 0;
+	     instruction_set_index < 4;
+	     instruction_set_index++ )
+	{
+		if( ( ewf_test_deflate_instruction_sets[ instruction_set_index ] != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+		 && ( ( instruction_sets & ewf_test_deflate_instruction_sets[ instruction_set_index ] ) == 0 ) )
+		{
+			continue;
+		}
+		if( libewf_simd_calculate_adler32(
+		     &checksum,
+		     buffer,
+		     size,
+		     initial_value,
+		     ewf_test_deflate_instruction_sets[ instruction_set_index ],
+		     &error ) != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+		if( checksum != expected_checksum )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected %s Adler-32: 0x%08" PRIx32 " (expected: 0x%08" PRIx32 ") for size: %" PRIzd ".\n",
+			 ewf_test_deflate_instruction_set_names[ instruction_set_index ],
+			 checksum,
+			 expected_checksum,
+			 size );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the Adler-32 calculation
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_deflate_adler32(
+     uint8_t *buffer )
+{
+	size_t size         = 0;
+	size_t start_offset = 0;
+	int result          = 0;
+
+	ewf_test_deflate_fill_buffer(
+	 buffer,
+	 EWF_TEST_DEFLATE_DATA_SIZE );
+
+	/* Test the different sizes and alignments of the data
+	 */
+	for( size = 0;
+	     size <= 1024;
+	     size += ( size < 80 ) ? 1 : 97 )
+	{
+		for( start_offset = 0;
+		     start_offset < 32;
+		     start_offset += 3 )
+		{
+			result = ewf_test_deflate_adler32_data(
+			          &( buffer[ start_offset ] ),
+			          size,
+			          1 );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+		}
+	}
+	/* Test the sizes around the block size where the modulus is applied
+	 */
+	for( size = LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE - 33;
+	     size <= LIBEWF_SIMD_ADLER32_MAXIMUM_BLOCK_SIZE + 33;
+	     size++ )
+	{
+		result = ewf_test_deflate_adler32_data(
+		          &( buffer[ 1 ] ),
+		          size,
+		          0xfff0fff0UL );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	result = ewf_test_deflate_adler32_data(
+	          buffer,
+	          EWF_TEST_DEFLATE_DATA_SIZE - 1,
+	          1 );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	/* Bytes of 0xff are the worst case for overflow of the sums
+	 */
+	if( memory_set(
+	     buffer,
+	     0xff,
+	     EWF_TEST_DEFLATE_DATA_SIZE ) == NULL )
+	{
+		return( -1 );
+	}
+	result = ewf_test_deflate_adler32_data(
+	          buffer,
+	          EWF_TEST_DEFLATE_DATA_SIZE,
+	          0xfff0fff0UL );
+
+	return( result );
+}
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+/* Compresses data using zlib with a specific level and strategy
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_deflate_compress(
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int level,
+     int strategy )
+{
+	z_stream stream;
+
+	int result = 0;
+
+	if( memory_set(
+	     &stream,
+	     0,
+	     sizeof( z_stream ) ) == NULL )
+	{
+		return( -1 );
+	}
+	if( deflateInit2(
+	     &stream,
+	     level,
+	     Z_DEFLATED,
+	     15,
+	     8,
+	     strategy ) != Z_OK )
+	{
+		return( -1 );
+	}
+	stream.next_in   = (Bytef *) uncompressed_data;
+	stream.avail_in  = (uInt) uncompressed_data_size;
+	stream.next_out  = (Bytef *) compressed_data;
+	stream.avail_out = (uInt) *compressed_data_size;
+
+	result = deflate(
+	          &stream,
+	          Z_FINISH );
+
+	*compressed_data_size = (size_t) stream.total_out;
+
+	deflateEnd(
+	 &stream );
+
+	if( result != Z_STREAM_END )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the deflate decompression of data compressed by zlib
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_deflate_decompress(
+     uint8_t *buffer )
+{
+	int levels[ 5 ]            = { 0, 1, 6, 9, 6 };
+	int strategies[ 5 ]        = { Z_DEFAULT_STRATEGY, Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY, Z_RLE };
+
+	libcerror_error_t *error   = NULL;
+	uint8_t *compressed_data   = NULL;
+	uint8_t *uncompressed_data = NULL;
+	size_t compressed_data_size   = 0;
+	size_t data_size              = 0;
+	size_t uncompressed_data_size = 0;
+	int index                     = 0;
+	int result                    = 1;
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               2 * EWF_TEST_DEFLATE_DATA_SIZE );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_DEFLATE_DATA_SIZE );
+
+	if( ( compressed_data == NULL )
+	 || ( uncompressed_data == NULL ) )
+	{
+		result = -1;
+
+		goto on_exit;
+	}
+	ewf_test_deflate_fill_buffer(
+	 buffer,
+	 EWF_TEST_DEFLATE_DATA_SIZE );
+
+	for( data_size = 1;
+	     data_size <= EWF_TEST_DEFLATE_DATA_SIZE;
+	     data_size *= 4 )
+	{
+		for( index = 0;
+		     index < 5;
+		     index++ )
+		{
+			compressed_data_size = 2 * EWF_TEST_DEFLATE_DATA_SIZE;
+
+			if( ewf_test_deflate_compress(
+			     buffer,
+			     data_size,
+			     compressed_data,
+			     &compressed_data_size,
+			     levels[ index ],
+			     strategies[ index ] ) != 1 )
+			{
+				result = -1;
+
+				goto on_exit;
+			}
+			uncompressed_data_size = EWF_TEST_DEFLATE_DATA_SIZE;
+
+			if( libewf_deflate_decompress(
+			     compressed_data,
+			     compressed_data_size,
+			     uncompressed_data,
+			     &uncompressed_data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_backtrace_fprint(
+				 error,
+				 stderr );
+
+				libcerror_error_free(
+				 &error );
+
+				fprintf(
+				 stderr,
+				 "Unable to decompress data of size: %" PRIzd " compressed with level: %d and strategy: %d.\n",
+				 data_size,
+				 levels[ index ],
+				 strategies[ index ] );
+
+				result = 0;
+
+				goto on_exit;
+			}
+			if( ( uncompressed_data_size != data_size )
+			 || ( memory_compare(
+			       uncompressed_data,
+			       buffer,
+			       data_size ) != 0 ) )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch in decompressed data of size: %" PRIzd " compressed with level: %d and strategy: %d.\n",
+				 data_size,
+				 levels[ index ],
+				 strategies[ index ] );
+
+				result = 0;
+
+				goto on_exit;
+			}
+		}
+	}
+	/* A corrupted checksum should be detected
+	 */
+	compressed_data[ compressed_data_size - 1 ] ^= 0x01;
+
+	uncompressed_data_size = EWF_TEST_DEFLATE_DATA_SIZE;
+
+	if( libewf_deflate_decompress(
+	     compressed_data,
+	     compressed_data_size,
+	     uncompressed_data,
+	     &uncompressed_data_size,
+	     &error ) != -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Corrupted checksum was not detected.\n" );
+
+		result = 0;
+	}
+	libcerror_error_free(
+	 &error );
+
+on_exit:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+/* Prints the throughput of a benchmark
+ */
+void ewf_test_deflate_print_throughput(
+      const char *name,
+      const char *implementation,
+      clock_t start_time,
+      clock_t end_time,
+      double *reference_time )
+{
+	double elapsed_time = (double) ( end_time - start_time ) / CLOCKS_PER_SEC;
+
+	if( elapsed_time <= 0.0 )
+	{
+		elapsed_time = 1.0 / CLOCKS_PER_SEC;
+	}
+	if( *reference_time <= 0.0 )
+	{
+		*reference_time = elapsed_time;
+	}
+	fprintf(
+	 stdout,
+	 "%s\t%s\t\t%.1f\t\t%.2fx\n",
+	 name,
+	 implementation,
+	 (double) EWF_TEST_DEFLATE_BENCHMARK_DATA_SIZE / ( 1024 * 1024 ) / elapsed_time,
+	 *reference_time / elapsed_time );
+}
+
+/* Benchmarks the Adler-32 calculation and deflate decompression against zlib
+ * using chunks of 32 KiB
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_deflate_benchmark(
+     uint8_t *buffer )
+{
+	libcerror_error_t *error  = NULL;
+	clock_t end_time          = 0;
+	clock_t start_time        = 0;
+	double reference_time     = 0.0;
+	uint32_t checksum         = 0;
+	int instruction_set_index = 0;
+	int instruction_sets      = 0;
+	int iteration             = 0;
+	int number_of_iterations  = EWF_TEST_DEFLATE_BENCHMARK_DATA_SIZE / EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	uint8_t *compressed_data      = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	uLongf zlib_data_size         = 0;
+	size_t compressed_data_size   = 0;
+	size_t uncompressed_data_size = 0;
+#endif
+
+	ewf_test_deflate_fill_buffer(
+	 buffer,
+	 EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+	fprintf(
+	 stdout,
+	 "Function\tImplementation\tMiB/s\t\tSpeed-up\n" );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		checksum = (uint32_t) adler32(
+		                       checksum,
+		                       (const Bytef *) buffer,
+		                       (uInt) EWF_TEST_DEFLATE_CHUNK_SIZE );
+	}
+	end_time = clock();
+
+	ewf_test_deflate_print_throughput(
+	 "adler32",
+	 "zlib",
+	 start_time,
+	 end_time,
+	 &reference_time );
+#endif
+	instruction_sets = libewf_simd_get_supported_instruction_sets();
+
+	for( instruction_set_index = 0;
+	     instruction_set_index < 4;
+	     instruction_set_index++ )
+	{
+		if( ( ewf_test_deflate_instruction_sets[ instruction_set_index ] != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+		 && ( ( instruction_sets & ewf_test_deflate_instruction_sets[ instruction_set_index ] ) == 0 ) )
+		{
+			continue;
+		}
+		start_time = clock();
+
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			if( libewf_simd_calculate_adler32(
+			     &checksum,
+			     buffer,
+			     EWF_TEST_DEFLATE_CHUNK_SIZE,
+			     checksum,
+			     ewf_test_deflate_instruction_sets[ instruction_set_index ],
+			     &error ) != 1 )
+			{
+				libcerror_error_backtrace_fprint(
+				 error,
+				 stderr );
+
+				libcerror_error_free(
+				 &error );
+
+				return( -1 );
+			}
+		}
+		end_time = clock();
+
+		ewf_test_deflate_print_throughput(
+		 "adler32",
+		 ewf_test_deflate_instruction_set_names[ instruction_set_index ],
+		 start_time,
+		 end_time,
+		 &reference_time );
+	}
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	compressed_data = (uint8_t *) memory_allocate(
+	                               2 * EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_DEFLATE_CHUNK_SIZE );
+
+	if( ( compressed_data == NULL )
+	 || ( uncompressed_data == NULL ) )
+	{
+		goto on_error;
+	}
+	compressed_data_size = 2 * EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+	if( ewf_test_deflate_compress(
+	     buffer,
+	     EWF_TEST_DEFLATE_CHUNK_SIZE,
+	     compressed_data,
+	     &compressed_data_size,
+	     Z_DEFAULT_COMPRESSION,
+	     Z_DEFAULT_STRATEGY ) != 1 )
+	{
+		goto on_error;
+	}
+	reference_time = 0.0;
+
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		zlib_data_size = (uLongf) EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+		if( uncompress(
+		     (Bytef *) uncompressed_data,
+		     &zlib_data_size,
+		     (const Bytef *) compressed_data,
+		     (uLong) compressed_data_size ) != Z_OK )
+		{
+			goto on_error;
+		}
+	}
+	end_time = clock();
+
+	ewf_test_deflate_print_throughput(
+	 "inflate",
+	 "zlib",
+	 start_time,
+	 end_time,
+	 &reference_time );
+
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		uncompressed_data_size = EWF_TEST_DEFLATE_CHUNK_SIZE;
+
+		if( libewf_deflate_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+	}
+	end_time = clock();
+
+	ewf_test_deflate_print_throughput(
+	 "inflate",
+	 "libewf",
+	 start_time,
+	 end_time,
+	 &reference_time );
+
+	memory_free(
+	 uncompressed_data );
+	memory_free(
+	 compressed_data );
+#endif
+	return( 1 );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+on_error:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( -1 );
+#endif
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint8_t *buffer                    = NULL;
+	libcstring_system_integer_t option = 0;
+	int run_benchmark                  = 0;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "b" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (libcstring_system_integer_t) 'b':
+				run_benchmark = 1;
+
+				break;
+		}
+	}
+	/* Add room to test the different alignments of the data
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_DEFLATE_DATA_SIZE + 32 );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_deflate_adler32(
+	     buffer ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test Adler-32.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( ewf_test_deflate_decompress(
+	     buffer ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test deflate decompression.\n" );
+
+		goto on_error;
+	}
+#endif
+	if( run_benchmark != 0 )
+	{
+		if( ewf_test_deflate_benchmark(
+		     buffer ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark Adler-32 and deflate decompression.\n" );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+}
+
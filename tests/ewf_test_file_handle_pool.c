@@ -0,0 +1,981 @@
+/*
+ * File handle pool test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_RESOURCE_H )
+#include <sys/resource.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_file_handle_pool.h"
+
+#define EWF_TEST_FILE_HANDLE_POOL_DATA_SIZE		4096
+#define EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES	20
+
+/* The soft limit of the number of open file descriptors used to test the descriptor budget
+ */
+#define EWF_TEST_FILE_HANDLE_POOL_DESCRIPTOR_LIMIT	64
+
+/* The data of the files
+ */
+static uint8_t ewf_test_file_handle_pool_data[ EWF_TEST_FILE_HANDLE_POOL_DATA_SIZE ];
+
+/* Appends memory range files to the pool and opens them
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_file_handle_pool_append_files(
+     libewf_file_handle_pool_t *pool,
+     libbfio_handle_t **file_io_handles,
+     int number_of_files,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_file_handle_pool_append_files";
+	int file_index                   = 0;
+
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		if( libbfio_memory_range_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+		if( libbfio_memory_range_set(
+		     file_io_handle,
+		     ewf_test_file_handle_pool_data,
+		     EWF_TEST_FILE_HANDLE_POOL_DATA_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set memory range of file IO handle: %d.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+		if( libewf_file_handle_pool_append_file(
+		     pool,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file: %d to pool.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+		file_io_handles[ file_index ] = file_io_handle;
+		file_io_handle                = NULL;
+
+		if( libbfio_handle_open(
+		     file_io_handles[ file_index ],
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file: %d.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees the files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_file_handle_pool_free_files(
+     libbfio_handle_t **file_io_handles,
+     int number_of_files,
+     libcerror_error_t **error )
+{
+	int file_index = 0;
+	int result     = 1;
+
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		if( file_io_handles[ file_index ] == NULL )
+		{
+			continue;
+		}
+		if( libbfio_handle_is_open(
+		     file_io_handles[ file_index ],
+		     NULL ) == 1 )
+		{
+			if( libbfio_handle_close(
+			     file_io_handles[ file_index ],
+			     ( result == 1 ) ? error : NULL ) != 0 )
+			{
+				result = -1;
+			}
+		}
+		if( libbfio_handle_free(
+		     &( file_io_handles[ file_index ] ),
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads a file byte by byte
+ * Every read is an access of the file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_file_handle_pool_read_file(
+     libbfio_handle_t *file_io_handle,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+	uint8_t value         = 0;
+	static char *function = "ewf_test_file_handle_pool_read_file";
+	int read_index        = 0;
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		if( libbfio_handle_read_buffer(
+		     file_io_handle,
+		     &value,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks which files have an open underlying file IO handle
+ * The files in the open bit mask are expected to be open, all others are expected to be closed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_handle_pool_check_open_files(
+     libewf_file_handle_pool_t *pool,
+     uint32_t open_files )
+{
+	int file_index = 0;
+	int is_open    = 0;
+
+	for( file_index = 0;
+	     file_index < pool->number_of_files;
+	     file_index++ )
+	{
+		is_open = (int) ( pool->files[ file_index ]->open_index != -1 );
+
+		if( is_open != (int) ( ( open_files >> file_index ) & 1 ) )
+		{
+			fprintf(
+			 stderr,
+			 "File: %d is %sopen.\n",
+			 file_index,
+			 ( is_open == 0 ) ? "not " : "" );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks the open handles statistics of the pool
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_file_handle_pool_check_statistics(
+     libewf_file_handle_pool_t *pool,
+     int expected_number_of_open_handles,
+     int expected_maximum_number_of_open_handles,
+     uint64_t expected_number_of_opens,
+     uint64_t expected_number_of_closes,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_file_handle_pool_check_statistics";
+	uint64_t number_of_closes          = 0;
+	uint64_t number_of_opens           = 0;
+	int maximum_number_of_open_handles = 0;
+	int number_of_open_handles         = 0;
+
+	if( libewf_file_handle_pool_get_statistics(
+	     pool,
+	     &number_of_open_handles,
+	     &maximum_number_of_open_handles,
+	     &number_of_opens,
+	     &number_of_closes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_open_handles != expected_number_of_open_handles )
+	 || ( maximum_number_of_open_handles != expected_maximum_number_of_open_handles )
+	 || ( number_of_opens != expected_number_of_opens )
+	 || ( number_of_closes != expected_number_of_closes ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected open handles: %d, maximum: %d, opens: %" PRIu64 " and closes: %" PRIu64 ".\n",
+		 number_of_open_handles,
+		 maximum_number_of_open_handles,
+		 number_of_opens,
+		 number_of_closes );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Prints the result of a test
+ */
+void ewf_test_file_handle_pool_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Tests the least frequently used eviction
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_file_handle_pool_eviction(
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handles[ 3 ] = { NULL, NULL, NULL };
+
+	libewf_file_handle_pool_t *pool = NULL;
+	uint8_t value                   = 0;
+	int result                      = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing least frequently used eviction\t" );
+
+	result = libewf_file_handle_pool_initialize(
+	          &pool,
+	          2,
+	          NULL,
+	          error );
+
+	/* All files are accessed once, which makes file 0 the least recently used
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_append_files(
+		          pool,
+		          file_io_handles,
+		          3,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_open_files(
+		          pool,
+		          0x06 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_statistics(
+		          pool,
+		          2,
+		          2,
+		          3,
+		          1,
+		          error );
+	}
+	/* File 1 is accessed 3 times and file 2 twice
+	 * so reopening file 0 closes file 2
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 1 ],
+		          2,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 2 ],
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 0 ],
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_open_files(
+		          pool,
+		          0x03 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_statistics(
+		          pool,
+		          2,
+		          2,
+		          4,
+		          2,
+		          error );
+	}
+	/* A reopened file continues at the offset it was closed at
+	 * and closes file 0 which is now the least frequently used
+	 */
+	if( result == 1 )
+	{
+		if( libbfio_handle_read_buffer(
+		     file_io_handles[ 2 ],
+		     &value,
+		     1,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+		else if( value != ewf_test_file_handle_pool_data[ 1 ] )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected value read from reopened file.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_open_files(
+		          pool,
+		          0x06 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_statistics(
+		          pool,
+		          2,
+		          2,
+		          5,
+		          3,
+		          error );
+	}
+	if( ewf_test_file_handle_pool_free_files(
+	     file_io_handles,
+	     3,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( pool != NULL )
+	{
+		if( libewf_file_handle_pool_free(
+		     &pool,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_file_handle_pool_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests the aging of the access frequencies at the end of an access window
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_file_handle_pool_window_aging(
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handles[ 3 ] = { NULL, NULL, NULL };
+
+	libewf_file_handle_pool_t *pool = NULL;
+	uint64_t window_number          = 0;
+	int window_index                = 0;
+	int result                      = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing window aging\t" );
+
+	result = libewf_file_handle_pool_initialize(
+	          &pool,
+	          0,
+	          NULL,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_append_files(
+		          pool,
+		          file_io_handles,
+		          3,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( pool->working_set_size != 3 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected working set size: %d.\n",
+		 pool->working_set_size );
+
+		result = 0;
+	}
+	/* File 0 is accessed 8 times and file 1 3 times
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 0 ],
+		          7,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 1 ],
+		          2,
+		          error );
+	}
+	/* Every window halves the access frequencies
+	 */
+	for( window_index = 0;
+	     ( result == 1 ) && ( window_index < 3 );
+	     window_index++ )
+	{
+		result = libewf_file_handle_pool_end_window(
+		          pool,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ( pool->files[ 0 ]->frequency != 1 )
+	  ||  ( pool->files[ 1 ]->frequency != 0 )
+	  ||  ( pool->files[ 2 ]->frequency != 0 )
+	  ||  ( pool->working_set_size != 0 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected frequencies: %" PRIu32 ", %" PRIu32 " and %" PRIu32 ".\n",
+		 pool->files[ 0 ]->frequency,
+		 pool->files[ 1 ]->frequency,
+		 pool->files[ 2 ]->frequency );
+
+		result = 0;
+	}
+	/* After aging the recent accesses of file 1 outweigh the earlier accesses of file 0
+	 * so reopening file 2 with a maximum of 2 open handles closes file 0
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 1 ],
+		          2,
+		          error );
+	}
+	if( result == 1 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handles[ 2 ],
+		     error ) != 0 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_file_handle_pool_set_maximum_number_of_open_handles(
+		          pool,
+		          2,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libbfio_handle_open(
+		          file_io_handles[ 2 ],
+		          LIBBFIO_OPEN_READ,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_open_files(
+		          pool,
+		          0x06 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_statistics(
+		          pool,
+		          2,
+		          2,
+		          4,
+		          2,
+		          error );
+	}
+	/* A window ends automatically after a window size number of accesses
+	 */
+	if( result == 1 )
+	{
+		window_number = pool->window_number;
+
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ 1 ],
+		          LIBEWF_FILE_HANDLE_POOL_WINDOW_SIZE,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( pool->window_number != ( window_number + 1 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected window number: %" PRIu64 ".\n",
+		 pool->window_number );
+
+		result = 0;
+	}
+	if( ewf_test_file_handle_pool_free_files(
+	     file_io_handles,
+	     3,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( pool != NULL )
+	{
+		if( libewf_file_handle_pool_free(
+		     &pool,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_file_handle_pool_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Checks the maximum number of open handles after ending the access window
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_file_handle_pool_check_end_window(
+     libewf_file_handle_pool_t *pool,
+     int expected_maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_file_handle_pool_check_end_window";
+
+	if( libewf_file_handle_pool_end_window(
+	     pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end window.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool->maximum_number_of_open_handles != expected_maximum_number_of_open_handles )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected maximum number of open handles: %d, expected: %d.\n",
+		 pool->maximum_number_of_open_handles,
+		 expected_maximum_number_of_open_handles );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the automatic maximum number of open handles
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_file_handle_pool_automatic(
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handles[ EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES ];
+
+#if defined( HAVE_GETRLIMIT )
+	struct rlimit limit_data;
+	struct rlimit original_limit_data;
+
+	uint8_t restore_limit = 0;
+#endif
+
+	libewf_file_handle_pool_t *pool = NULL;
+	int descriptor_budget           = 0;
+	int expected_descriptor_budget  = LIBEWF_FILE_HANDLE_POOL_DEFAULT_DESCRIPTOR_BUDGET;
+	int file_index                  = 0;
+	int result                      = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing automatic maximum number of open handles\t" );
+
+	for( file_index = 0;
+	     file_index < EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES;
+	     file_index++ )
+	{
+		file_io_handles[ file_index ] = NULL;
+	}
+#if defined( HAVE_GETRLIMIT )
+	/* The descriptor budget is half of the soft limit of the number of open file descriptors
+	 */
+	if( getrlimit(
+	     RLIMIT_NOFILE,
+	     &original_limit_data ) != 0 )
+	{
+		result = -1;
+	}
+	else if( ( original_limit_data.rlim_max != RLIM_INFINITY )
+	      && ( original_limit_data.rlim_max < (rlim_t) EWF_TEST_FILE_HANDLE_POOL_DESCRIPTOR_LIMIT ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported limit of the number of open file descriptors.\n" );
+
+		result = -1;
+	}
+	else
+	{
+		limit_data.rlim_cur = (rlim_t) EWF_TEST_FILE_HANDLE_POOL_DESCRIPTOR_LIMIT;
+		limit_data.rlim_max = original_limit_data.rlim_max;
+
+		if( setrlimit(
+		     RLIMIT_NOFILE,
+		     &limit_data ) != 0 )
+		{
+			result = -1;
+		}
+		else
+		{
+			restore_limit = 1;
+
+			expected_descriptor_budget = EWF_TEST_FILE_HANDLE_POOL_DESCRIPTOR_LIMIT / 2;
+		}
+	}
+#endif
+	if( result == 1 )
+	{
+		result = libewf_file_handle_pool_get_descriptor_budget(
+		          &descriptor_budget,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( descriptor_budget != expected_descriptor_budget ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected descriptor budget: %d.\n",
+		 descriptor_budget );
+
+		result = 0;
+	}
+	/* Until a working set has been observed the whole budget is available
+	 */
+	if( result == 1 )
+	{
+		result = libewf_file_handle_pool_initialize(
+		          &pool,
+		          LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC,
+		          NULL,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ( pool->automatic == 0 )
+	  ||  ( pool->maximum_number_of_open_handles != expected_descriptor_budget ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected maximum number of open handles: %d.\n",
+		 pool->maximum_number_of_open_handles );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_append_files(
+		          pool,
+		          file_io_handles,
+		          EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES,
+		          error );
+	}
+	/* A working set of more than half the budget is limited to the budget
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_end_window(
+		          pool,
+		          ( EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES > ( expected_descriptor_budget / 2 ) ) ? expected_descriptor_budget : 2 * EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES,
+		          error );
+	}
+	/* Otherwise the maximum is twice the working set
+	 */
+	for( file_index = 0;
+	     ( result == 1 ) && ( file_index < 12 );
+	     file_index++ )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ file_index ],
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_end_window(
+		          pool,
+		          24,
+		          error );
+	}
+	/* But not less than the minimum number of open handles
+	 */
+	for( file_index = 0;
+	     ( result == 1 ) && ( file_index < 3 );
+	     file_index++ )
+	{
+		result = ewf_test_file_handle_pool_read_file(
+		          file_io_handles[ file_index ],
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_end_window(
+		          pool,
+		          LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES,
+		          error );
+	}
+	/* Reopening a file closes files until the new maximum is reached
+	 */
+	if( result == 1 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handles[ EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES - 1 ],
+		     error ) != 0 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = libbfio_handle_open(
+		          file_io_handles[ EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES - 1 ],
+		          LIBBFIO_OPEN_READ,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_statistics(
+		          pool,
+		          LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES,
+		          LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES,
+		          EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES + 1,
+		          EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES + 1 - LIBEWF_FILE_HANDLE_POOL_MINIMUM_NUMBER_OF_OPEN_HANDLES,
+		          error );
+	}
+	/* An explicit maximum is not changed by the end of a window
+	 */
+	if( result == 1 )
+	{
+		result = libewf_file_handle_pool_set_maximum_number_of_open_handles(
+		          pool,
+		          5,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_file_handle_pool_check_end_window(
+		          pool,
+		          5,
+		          error );
+	}
+	if( ewf_test_file_handle_pool_free_files(
+	     file_io_handles,
+	     EWF_TEST_FILE_HANDLE_POOL_NUMBER_OF_FILES,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( pool != NULL )
+	{
+		if( libewf_file_handle_pool_free(
+		     &pool,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+#if defined( HAVE_GETRLIMIT )
+	if( restore_limit != 0 )
+	{
+		if( setrlimit(
+		     RLIMIT_NOFILE,
+		     &original_limit_data ) != 0 )
+		{
+			result = -1;
+		}
+	}
+#endif
+	ewf_test_file_handle_pool_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_FILE_HANDLE_POOL_DATA_SIZE;
+	     data_offset++ )
+	{
+		ewf_test_file_handle_pool_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	if( ewf_test_file_handle_pool_eviction(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test least frequently used eviction.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_file_handle_pool_window_aging(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test window aging.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_file_handle_pool_automatic(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test automatic maximum number of open handles.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,672 @@
+/*
+ * Expert Witness Compression Format (EWF) library handle get fill range testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_handle_get_fill_range generate verbose output
+#define EWF_TEST_HANDLE_GET_FILL_RANGE_VERBOSE
+ */
+
+#define EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE		32768
+#define EWF_TEST_HANDLE_GET_FILL_RANGE_LAST_CHUNK_SIZE		16384
+
+/* The media consists of 6 chunks and a partial last chunk
+ */
+#define EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE		( ( 6 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE ) + EWF_TEST_HANDLE_GET_FILL_RANGE_LAST_CHUNK_SIZE )
+
+/* Retrieves the expected value of the (media) data at a specific offset
+ * Chunks 0, 1 and 5 are filled with 0x00, chunks 2 and 3 with 0xab,
+ * chunk 4 is not filled and the partial last chunk is filled with 0x5a
+ */
+uint8_t ewf_test_handle_get_fill_range_get_data_value(
+         off64_t offset )
+{
+	switch( offset / EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE )
+	{
+		case 0:
+		case 1:
+		case 5:
+			return( 0x00 );
+
+		case 2:
+		case 3:
+			return( 0xab );
+
+		case 4:
+			return( ewf_test_image_get_data_value(
+			         offset ) );
+
+		default:
+			break;
+	}
+	return( 0x5a );
+}
+
+/* Retrieves the expected value of the (media) data at a specific offset
+ * All the chunks are filled with 0x00
+ */
+uint8_t ewf_test_handle_get_fill_range_get_zero_data_value(
+         off64_t offset EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( offset )
+
+	return( 0x00 );
+}
+
+/* Opens a handle for reading
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_get_fill_range_open_handle(
+     libcstring_system_character_t *filename,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t *filenames[ 1 ] = {
+		NULL };
+
+	static char *function = "ewf_test_handle_get_fill_range_open_handle";
+	uint32_t chunk_size   = 0;
+
+	filenames[ 0 ] = filename;
+
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     *handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	/* The expected fill ranges depend on the default chunk size
+	 */
+	if( chunk_size != EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk size: %" PRIu32 ".",
+		 function,
+		 chunk_size );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_close(
+		 *handle,
+		 NULL );
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_get_fill_range_close_handle(
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_handle_get_fill_range_close_handle";
+	int result            = 1;
+
+	if( libewf_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests retrieving a specific fill range
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_handle_get_fill_range_check(
+     libewf_handle_t *handle,
+     const char *description,
+     off64_t offset,
+     size64_t size,
+     int expected_result,
+     size64_t expected_range_size,
+     uint8_t expected_fill_value,
+     libcerror_error_t **error )
+{
+	size64_t range_size = 0;
+	uint8_t fill_value  = 0;
+	int result          = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing get fill range of %s\t",
+	 description );
+
+	result = libewf_handle_get_fill_range(
+	          handle,
+	          offset,
+	          size,
+	          &range_size,
+	          &fill_value,
+	          error );
+
+	if( result != -1 )
+	{
+		if( ( result != expected_result )
+		 || ( range_size != expected_range_size )
+		 || ( ( result == 1 )
+		  && ( fill_value != expected_fill_value ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected result: %d, range size: %" PRIu64 " and fill value: 0x%02" PRIx8 " at offset: %" PRIi64 ".\n",
+			 result,
+			 range_size,
+			 fill_value,
+			 offset );
+
+			result = 0;
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests retrieving fill ranges of an image that contains fill chunks
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_handle_get_fill_range_fill_chunks(
+     libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	int result              = 0;
+
+	result = ewf_test_handle_get_fill_range_open_handle(
+	          filename,
+	          &handle,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "zero fill chunks",
+		          0,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          1,
+		          2 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		          0x00,
+		          error );
+	}
+	/* The range stops at the first chunk that is not filled
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "non-zero fill chunks up to a non-fill chunk",
+		          ( 2 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE ) + 512,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          1,
+		          ( 2 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE ) - 512,
+		          0xab,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "non-fill chunk",
+		          ( 4 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE ) + 100,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          0,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE - 100,
+		          0x00,
+		          error );
+	}
+	/* The range stops at the first chunk with a different fill value
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "fill chunks with different fill values",
+		          5 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          1,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		          0x00,
+		          error );
+	}
+	/* The range is truncated to the media size
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "partial last chunk",
+		          6 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		          2 * EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		          1,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_LAST_CHUNK_SIZE,
+		          0x5a,
+		          error );
+	}
+	/* The range is truncated to the requested size
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "size smaller than a chunk",
+		          512,
+		          1024,
+		          1,
+		          1024,
+		          0x00,
+		          error );
+	}
+	if( handle != NULL )
+	{
+		if( ewf_test_handle_get_fill_range_close_handle(
+		     &handle,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Tests retrieving fill ranges of an image with uncompressed chunks
+ * Uncompressed chunks are not detected as filled even if they contain the same byte value
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_handle_get_fill_range_uncompressed_chunks(
+     libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	int result              = 0;
+
+	result = ewf_test_handle_get_fill_range_open_handle(
+	          filename,
+	          &handle,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_handle_get_fill_range_check(
+		          handle,
+		          "uncompressed zero chunks",
+		          0,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          0,
+		          EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		          0x00,
+		          error );
+	}
+	if( handle != NULL )
+	{
+		if( ewf_test_handle_get_fill_range_close_handle(
+		     &handle,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Tests retrieving a fill range with invalid arguments
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_handle_get_fill_range_arguments(
+     libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *argument_error = NULL;
+	libewf_handle_t *handle           = NULL;
+	size64_t range_size               = 0;
+	uint8_t fill_value                = 0;
+	int result                        = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing get fill range with invalid arguments\t" );
+
+	result = ewf_test_handle_get_fill_range_open_handle(
+	          filename,
+	          &handle,
+	          error );
+
+	if( result == 1 )
+	{
+		if( libewf_handle_get_fill_range(
+		     NULL,
+		     0,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		     &range_size,
+		     &fill_value,
+		     &argument_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &argument_error );
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_fill_range(
+		     handle,
+		     -1,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		     &range_size,
+		     &fill_value,
+		     &argument_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &argument_error );
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_fill_range(
+		     handle,
+		     0,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		     NULL,
+		     &fill_value,
+		     &argument_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &argument_error );
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_fill_range(
+		     handle,
+		     0,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		     &range_size,
+		     NULL,
+		     &argument_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &argument_error );
+	}
+	/* An offset at or beyond the media size results in an empty range
+	 */
+	if( result == 1 )
+	{
+		range_size = 1;
+
+		if( libewf_handle_get_fill_range(
+		     handle,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+		     EWF_TEST_HANDLE_GET_FILL_RANGE_CHUNK_SIZE,
+		     &range_size,
+		     &fill_value,
+		     error ) != 0 )
+		{
+			result = 0;
+		}
+		else if( range_size != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( handle != NULL )
+	{
+		if( ewf_test_handle_get_fill_range_close_handle(
+		     &handle,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_HANDLE_GET_FILL_RANGE_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	/* The fill chunks are stored using pattern fill
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_pattern_fill" ),
+	     LIBEWF_FORMAT_V2_ENCASE7,
+	     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION,
+	     &ewf_test_handle_get_fill_range_get_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write pattern fill segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_get_fill_range_fill_chunks(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_pattern_fill.Ex01" ),
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* The zero fill chunks are stored using empty block compression
+	 * and the non-zero fill chunks compress to a fraction of the chunk size
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_compressed" ),
+	     LIBEWF_FORMAT_ENCASE6,
+	     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_FAST,
+	     LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	     &ewf_test_handle_get_fill_range_get_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write compressed segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_get_fill_range_fill_chunks(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_compressed.E01" ),
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_handle_get_fill_range_arguments(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_compressed.E01" ),
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_uncompressed" ),
+	     LIBEWF_FORMAT_ENCASE6,
+	     EWF_TEST_HANDLE_GET_FILL_RANGE_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     &ewf_test_handle_get_fill_range_get_zero_data_value,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write uncompressed segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_get_fill_range_uncompressed_chunks(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_handle_get_fill_range_uncompressed.E01" ),
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_pattern_fill" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_compressed" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_uncompressed" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_pattern_fill" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_compressed" );
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_handle_get_fill_range_uncompressed" );
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,357 @@
+/*
+ * Test image functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+
+#define EWF_TEST_IMAGE_BUFFER_SIZE	4096
+
+/* Retrieves the default value of the (media) data at a specific offset
+ */
+uint8_t ewf_test_image_get_data_value(
+         off64_t offset )
+{
+	return( (uint8_t) ( ( offset / 512 ) + ( offset % 509 ) ) );
+}
+
+/* Fills a buffer with the (media) data at a specific offset
+ * If get_data_value is NULL the default (media) data is used
+ */
+void ewf_test_image_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      off64_t offset,
+      uint8_t (*get_data_value)(
+                 off64_t offset ) )
+{
+	size_t buffer_offset = 0;
+
+	if( get_data_value == NULL )
+	{
+		get_data_value = &ewf_test_image_get_data_value;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = get_data_value(
+		                           offset + (off64_t) buffer_offset );
+	}
+}
+
+/* Writes a set of segment files that contains the (media) data
+ * A format of LIBEWF_FORMAT_UNKNOWN or a maximum segment size of 0 retains the library default
+ * If get_data_value is NULL the default (media) data is used
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_write(
+     libcstring_system_character_t *basename,
+     uint8_t format,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t (*get_data_value)(
+                off64_t offset ),
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_IMAGE_BUFFER_SIZE ];
+
+	libcstring_system_character_t *basenames[ 1 ] = {
+		NULL };
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_image_write";
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+	off64_t write_offset    = 0;
+
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	basenames[ 0 ] = basename;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     basenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     basenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( format != LIBEWF_FORMAT_UNKNOWN )
+	{
+		if( libewf_handle_set_format(
+		     handle,
+		     format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set format.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_segment_size != 0 )
+	{
+		if( libewf_handle_set_maximum_segment_size(
+		     handle,
+		     maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	while( write_offset < (off64_t) media_size )
+	{
+		write_size = EWF_TEST_IMAGE_BUFFER_SIZE;
+
+		if( (size64_t) write_size > ( media_size - (size64_t) write_offset ) )
+		{
+			write_size = (size_t) ( media_size - (size64_t) write_offset );
+		}
+		ewf_test_image_fill_buffer(
+		 buffer,
+		 write_size,
+		 write_offset,
+		 get_data_value );
+
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIi64 ".",
+			 function,
+			 write_offset );
+
+			goto on_error;
+		}
+		write_offset += (off64_t) write_count;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Removes the segment files of both the EWF1 (.E01) and EWF2 (.Ex01) formats
+ */
+void ewf_test_image_remove_segment_files(
+      const char *basename )
+{
+	char filename[ 256 ];
+
+	int result         = 0;
+	int segment_number = 0;
+
+	if( basename == NULL )
+	{
+		return;
+	}
+	for( segment_number = 1;
+	     segment_number < 100;
+	     segment_number++ )
+	{
+		result = 0;
+
+		if( libcstring_narrow_string_snprintf(
+		     filename,
+		     256,
+		     "%s.E%02d",
+		     basename,
+		     segment_number ) >= 0 )
+		{
+			if( remove(
+			     filename ) == 0 )
+			{
+				result = 1;
+			}
+		}
+		if( libcstring_narrow_string_snprintf(
+		     filename,
+		     256,
+		     "%s.Ex%02d",
+		     basename,
+		     segment_number ) >= 0 )
+		{
+			if( remove(
+			     filename ) == 0 )
+			{
+				result = 1;
+			}
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+	}
+}
+
+/* Prints the result of a test
+ */
+void ewf_test_image_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
@@ -0,0 +1,67 @@
+/*
+ * Test image functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_TEST_IMAGE_H )
+#define _EWF_TEST_IMAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+uint8_t ewf_test_image_get_data_value(
+         off64_t offset );
+
+void ewf_test_image_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      off64_t offset,
+      uint8_t (*get_data_value)(
+                 off64_t offset ) );
+
+int ewf_test_image_write(
+     libcstring_system_character_t *basename,
+     uint8_t format,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     uint8_t (*get_data_value)(
+                off64_t offset ),
+     libcerror_error_t **error );
+
+void ewf_test_image_remove_segment_files(
+      const char *basename );
+
+void ewf_test_image_print_result(
+      int result );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_TEST_IMAGE_H ) */
+
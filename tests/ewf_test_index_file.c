@@ -0,0 +1,988 @@
+/*
+ * Expert Witness Compression Format (EWF) library index file testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+
+/* Define to make ewf_test_index_file generate verbose output
+#define EWF_TEST_INDEX_FILE_VERBOSE
+ */
+
+#define EWF_TEST_INDEX_FILE_BUFFER_SIZE		4096
+#define EWF_TEST_INDEX_FILE_FILENAME		"ewf_test_index_file.idx"
+
+/* The layout of the index file, refer to libewf/ewf_index_file.h
+ */
+#define EWF_TEST_INDEX_FILE_HEADER_SIZE		32
+#define EWF_TEST_INDEX_FILE_NUMBER_OF_SEGMENTS_OFFSET	12
+#define EWF_TEST_INDEX_FILE_DATA_SIZE_OFFSET	16
+#define EWF_TEST_INDEX_FILE_DATA_CHECKSUM_OFFSET	24
+#define EWF_TEST_INDEX_FILE_CHECKSUM_OFFSET	28
+
+#define EWF_TEST_INDEX_FILE_SEGMENT_FILE_SIZE_OFFSET	( EWF_TEST_INDEX_FILE_HEADER_SIZE + 12 )
+#define EWF_TEST_INDEX_FILE_MODIFICATION_TIME_OFFSET	( EWF_TEST_INDEX_FILE_HEADER_SIZE + 20 )
+#define EWF_TEST_INDEX_FILE_NUMBER_OF_SECTIONS_OFFSET	( EWF_TEST_INDEX_FILE_HEADER_SIZE + 56 )
+#define EWF_TEST_INDEX_FILE_NUMBER_OF_CHUNK_GROUPS_OFFSET	( EWF_TEST_INDEX_FILE_HEADER_SIZE + 84 )
+#define EWF_TEST_INDEX_FILE_SEGMENT_SIZE		92
+
+/* Calculates an Adler-32 checksum
+ */
+uint32_t ewf_test_index_file_calculate_adler32(
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+	uint32_t lower_word = 1;
+	uint32_t upper_word = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		lower_word = ( lower_word + data[ data_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Updates the data and header checksums of index file data
+ * so that only the modified values are validated
+ */
+void ewf_test_index_file_update_checksums(
+      uint8_t *data,
+      size_t data_size )
+{
+	uint32_t checksum = 0;
+
+	checksum = ewf_test_index_file_calculate_adler32(
+	            &( data[ EWF_TEST_INDEX_FILE_HEADER_SIZE ] ),
+	            data_size - EWF_TEST_INDEX_FILE_HEADER_SIZE );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ EWF_TEST_INDEX_FILE_DATA_CHECKSUM_OFFSET ] ),
+	 checksum );
+
+	checksum = ewf_test_index_file_calculate_adler32(
+	            data,
+	            EWF_TEST_INDEX_FILE_CHECKSUM_OFFSET );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ EWF_TEST_INDEX_FILE_CHECKSUM_OFFSET ] ),
+	 checksum );
+}
+
+/* Reads the data of the index file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_index_file_read_data(
+     uint8_t **data,
+     size_t *data_size )
+{
+	FILE *file_stream = NULL;
+	long file_size    = 0;
+
+	file_stream = fopen(
+	               EWF_TEST_INDEX_FILE_FILENAME,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( fseek(
+	     file_stream,
+	     0,
+	     SEEK_END ) != 0 )
+	{
+		goto on_error;
+	}
+	file_size = ftell(
+	             file_stream );
+
+	if( file_size <= EWF_TEST_INDEX_FILE_HEADER_SIZE )
+	{
+		goto on_error;
+	}
+	if( fseek(
+	     file_stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		goto on_error;
+	}
+	/* Leave room to append trailing data
+	 */
+	*data = (uint8_t *) memory_allocate(
+	                     (size_t) file_size + 8 );
+
+	if( *data == NULL )
+	{
+		goto on_error;
+	}
+	if( fread(
+	     *data,
+	     1,
+	     (size_t) file_size,
+	     file_stream ) != (size_t) file_size )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+
+		goto on_error;
+	}
+	*data_size = (size_t) file_size;
+
+	fclose(
+	 file_stream );
+
+	return( 1 );
+
+on_error:
+	fclose(
+	 file_stream );
+
+	return( -1 );
+}
+
+/* Writes (modified) data to the index file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_index_file_write_data(
+     const uint8_t *data,
+     size_t data_size )
+{
+	FILE *file_stream = NULL;
+	int result        = 1;
+
+	file_stream = fopen(
+	               EWF_TEST_INDEX_FILE_FILENAME,
+	               "wb" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( fwrite(
+	     data,
+	     1,
+	     data_size,
+	     file_stream ) != data_size )
+	{
+		result = -1;
+	}
+	if( fclose(
+	     file_stream ) != 0 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Opens a handle, reading the index file first if requested
+ * Returns 1 if successful, 0 if the index file was rejected or -1 on error
+ */
+int ewf_test_index_file_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     uint8_t read_index_file,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( read_index_file != 0 )
+	{
+		if( libewf_handle_read_index_file(
+		     *handle,
+		     EWF_TEST_INDEX_FILE_FILENAME,
+		     error ) != 1 )
+		{
+			libewf_handle_free(
+			 handle,
+			 NULL );
+
+			return( 0 );
+		}
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compares the media values and (media) data of a handle with the reference handle
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_index_file_compare_handles(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_INDEX_FILE_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_INDEX_FILE_BUFFER_SIZE ];
+
+	off64_t read_offset                   = 0;
+	size64_t media_size                   = 0;
+	size64_t reference_media_size         = 0;
+	uint64_t number_of_sectors            = 0;
+	uint64_t reference_number_of_sectors  = 0;
+	size32_t chunk_size                   = 0;
+	size32_t reference_chunk_size         = 0;
+	size_t read_size                      = 0;
+	ssize_t read_count                    = 0;
+
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     reference_handle,
+	     &reference_media_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_sectors(
+	     handle,
+	     &number_of_sectors,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_sectors(
+	     reference_handle,
+	     &reference_number_of_sectors,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     reference_handle,
+	     &reference_chunk_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( media_size != reference_media_size )
+	 || ( number_of_sectors != reference_number_of_sectors )
+	 || ( chunk_size != reference_chunk_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Mismatch in media values.\n" );
+
+		return( 0 );
+	}
+	while( (size64_t) read_offset < media_size )
+	{
+		read_size = EWF_TEST_INDEX_FILE_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( media_size - read_offset ) )
+		{
+			read_size = (size_t) ( media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			return( -1 );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              reference_handle,
+		              reference_buffer,
+		              read_size,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			return( -1 );
+		}
+		if( memory_compare(
+		     buffer,
+		     reference_buffer,
+		     read_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 "\n",
+			 read_offset );
+
+			return( 0 );
+		}
+		read_offset += (off64_t) read_size;
+	}
+	return( 1 );
+}
+
+/* Tests opening a handle using (modified) index file data
+ * If expect_rejected is set reading the index file must fail otherwise
+ * the handle must open and contain the same data as the reference handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_index_file_open_with_data(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     libewf_handle_t *reference_handle,
+     const char *description,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t expect_rejected )
+{
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	int result               = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing index file: %s\t",
+	 description );
+
+	if( ewf_test_index_file_write_data(
+	     data,
+	     data_size ) != 1 )
+	{
+		result = -1;
+	}
+	else
+	{
+		result = ewf_test_index_file_open_handle(
+		          filenames,
+		          number_of_filenames,
+		          1,
+		          &handle,
+		          &error );
+	}
+	if( expect_rejected != 0 )
+	{
+		if( result == 0 )
+		{
+			result = 1;
+		}
+		else if( result == 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Index file was not rejected.\n" );
+
+			result = 0;
+		}
+	}
+	else if( result == 1 )
+	{
+		result = ewf_test_index_file_compare_handles(
+		          handle,
+		          reference_handle,
+		          &error );
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Index file was rejected.\n" );
+	}
+	if( handle != NULL )
+	{
+		if( libewf_handle_close(
+		     handle,
+		     NULL ) != 0 )
+		{
+			result = -1;
+		}
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		if( ( expect_rejected == 0 )
+		 && ( result != 1 ) )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests writing an index file and opening with valid, corrupted and stale index files
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_index_file(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     libewf_handle_t *reference_handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	uint8_t *modified_data   = NULL;
+	size_t data_size         = 0;
+	uint64_t value_64bit     = 0;
+	int result               = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing writing index file\t" );
+
+	result = libewf_handle_write_index_file(
+	          reference_handle,
+	          EWF_TEST_INDEX_FILE_FILENAME,
+	          &error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_index_file_read_data(
+		          &data,
+		          &data_size );
+	}
+	if( result == 1 )
+	{
+		if( data_size < ( EWF_TEST_INDEX_FILE_HEADER_SIZE + EWF_TEST_INDEX_FILE_SEGMENT_SIZE ) )
+		{
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		modified_data = (uint8_t *) memory_allocate(
+		                             data_size + 8 );
+
+		if( modified_data == NULL )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* The unmodified index file
+	 */
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "round trip",
+	          data,
+	          data_size,
+	          0 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A corrupted header checksum
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	modified_data[ EWF_TEST_INDEX_FILE_NUMBER_OF_SEGMENTS_OFFSET ] ^= 0xff;
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "corrupted header checksum",
+	          modified_data,
+	          data_size,
+	          1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A corrupted data checksum
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	modified_data[ data_size - 1 ] ^= 0xff;
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "corrupted data checksum",
+	          modified_data,
+	          data_size,
+	          1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A number of sections value that is out of bounds with valid checksums
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_NUMBER_OF_SECTIONS_OFFSET ] ),
+	 0x7fffffffUL );
+
+	ewf_test_index_file_update_checksums(
+	 modified_data,
+	 data_size );
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "number of sections out of bounds",
+	          modified_data,
+	          data_size,
+	          1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A number of chunk groups value that is out of bounds with valid checksums
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_NUMBER_OF_CHUNK_GROUPS_OFFSET ] ),
+	 0x7fffffffUL );
+
+	ewf_test_index_file_update_checksums(
+	 modified_data,
+	 data_size );
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "number of chunk groups out of bounds",
+	          modified_data,
+	          data_size,
+	          1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* Trailing data that is included in the data size and checksums
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	memory_set(
+	 &( modified_data[ data_size ] ),
+	 0,
+	 8 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_DATA_SIZE_OFFSET ] ),
+	 (uint64_t) ( data_size + 8 - EWF_TEST_INDEX_FILE_HEADER_SIZE ) );
+
+	ewf_test_index_file_update_checksums(
+	 modified_data,
+	 data_size + 8 );
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "trailing data",
+	          modified_data,
+	          data_size + 8,
+	          1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A stale index file, the segment file size no longer matches
+	 * the index file is ignored and the handle is opened normally
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_SEGMENT_FILE_SIZE_OFFSET ] ),
+	 value_64bit );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_SEGMENT_FILE_SIZE_OFFSET ] ),
+	 value_64bit + 1 );
+
+	ewf_test_index_file_update_checksums(
+	 modified_data,
+	 data_size );
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "stale segment file size",
+	          modified_data,
+	          data_size,
+	          0 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* A stale index file, the segment file modification time no longer matches
+	 */
+	memory_copy(
+	 modified_data,
+	 data,
+	 data_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_MODIFICATION_TIME_OFFSET ] ),
+	 value_64bit );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( modified_data[ EWF_TEST_INDEX_FILE_MODIFICATION_TIME_OFFSET ] ),
+	 value_64bit - 1 );
+
+	ewf_test_index_file_update_checksums(
+	 modified_data,
+	 data_size );
+
+	result = ewf_test_index_file_open_with_data(
+	          filenames,
+	          number_of_filenames,
+	          reference_handle,
+	          "stale segment file modification time",
+	          modified_data,
+	          data_size,
+	          0 );
+
+on_error:
+	if( modified_data != NULL )
+	{
+		memory_free(
+		 modified_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	remove(
+	 EWF_TEST_INDEX_FILE_FILENAME );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t **filenames = NULL;
+	libcstring_system_character_t *source     = NULL;
+	libcerror_error_t *error                  = NULL;
+	libewf_handle_t *handle                   = NULL;
+	libcstring_system_integer_t option        = 0;
+	size_t string_length                      = 0;
+	int number_of_filenames                   = 0;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_INDEX_FILE_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	string_length = libcstring_wide_string_length(
+	                 source );
+
+	if( libewf_glob_wide(
+	     source,
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	string_length = libcstring_narrow_string_length(
+	                 source );
+
+	if( libewf_glob(
+	     source,
+	     string_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( number_of_filenames <= 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filenames.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_index_file_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     0,
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_index_file(
+	     filenames,
+	     number_of_filenames,
+	     handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test index file.\n" );
+
+		goto on_error;
+	}
+	/* Clean up
+	 */
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,634 @@
+/*
+ * Integrity hash testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/integrity_hash.h"
+
+#define EWF_TEST_INTEGRITY_HASH_BUFFER_SIZE	( 256 * 1024 )
+#define EWF_TEST_INTEGRITY_HASH_DATA_SIZE	( 4 * 1024 * 1024 )
+
+/* The sizes of the successive updates, these are used round-robin
+ */
+size_t ewf_test_integrity_hash_update_sizes[ 6 ] = {
+	1, 511, 32768, 65539, EWF_TEST_INTEGRITY_HASH_BUFFER_SIZE, 7 };
+
+/* Prints the result of a test
+ */
+void ewf_test_integrity_hash_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Calculates the digest hashes of data
+ * The data is provided in updates of varying sizes using a single buffer
+ * that is overwritten after every update
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_integrity_hash_calculate(
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     uint8_t use_threads,
+     const uint8_t *data,
+     size_t data_size,
+     libcstring_system_character_t *md5_hash_string,
+     libcstring_system_character_t *sha1_hash_string,
+     libcstring_system_character_t *sha256_hash_string,
+     int *number_of_workers,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_INTEGRITY_HASH_BUFFER_SIZE ];
+
+	integrity_hash_t *integrity_hash = NULL;
+	static char *function            = "ewf_test_integrity_hash_calculate";
+	size_t data_offset               = 0;
+	size_t update_size               = 0;
+	int update_index                 = 0;
+
+	if( integrity_hash_initialize(
+	     &integrity_hash,
+	     calculate_md5,
+	     calculate_sha1,
+	     calculate_sha256,
+	     use_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	*number_of_workers = integrity_hash->number_of_workers;
+#else
+	*number_of_workers = 0;
+#endif
+	while( data_offset < data_size )
+	{
+		update_size = ewf_test_integrity_hash_update_sizes[ update_index ];
+
+		if( update_size > ( data_size - data_offset ) )
+		{
+			update_size = data_size - data_offset;
+		}
+		memory_copy(
+		 buffer,
+		 &( data[ data_offset ] ),
+		 update_size );
+
+		if( integrity_hash_update(
+		     integrity_hash,
+		     buffer,
+		     update_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update integrity hash.",
+			 function );
+
+			goto on_error;
+		}
+		/* The buffer can be reused as soon as the update returns
+		 */
+		memory_set(
+		 buffer,
+		 0xff,
+		 update_size );
+
+		data_offset += update_size;
+
+		update_index = ( update_index + 1 ) % 6;
+	}
+	if( integrity_hash_finalize(
+	     integrity_hash,
+	     md5_hash_string,
+	     33,
+	     sha1_hash_string,
+	     41,
+	     sha256_hash_string,
+	     65,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( integrity_hash_free(
+	     &integrity_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( integrity_hash != NULL )
+	{
+		integrity_hash_free(
+		 &integrity_hash,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the digest hashes of a known test vector
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_integrity_hash_test_vector(
+     uint8_t use_threads,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t md5_hash_string[ 33 ];
+	libcstring_system_character_t sha1_hash_string[ 41 ];
+	libcstring_system_character_t sha256_hash_string[ 65 ];
+
+	static char *function = "ewf_test_integrity_hash_test_vector";
+	int number_of_workers = 0;
+	int result            = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing test vector %s threads\t",
+	 ( use_threads != 0 ) ? "with" : "without" );
+
+	if( ewf_test_integrity_hash_calculate(
+	     1,
+	     1,
+	     1,
+	     use_threads,
+	     (uint8_t *) "abc",
+	     3,
+	     md5_hash_string,
+	     sha1_hash_string,
+	     sha256_hash_string,
+	     &number_of_workers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate digest hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcstring_system_string_compare(
+	     md5_hash_string,
+	     _LIBCSTRING_SYSTEM_STRING( "900150983cd24fb0d6963f7d28e17f72" ),
+	     32 ) != 0 )
+	{
+		result = 0;
+	}
+	if( libcstring_system_string_compare(
+	     sha1_hash_string,
+	     _LIBCSTRING_SYSTEM_STRING( "a9993e364706816aba3e25717850c26c9cd0d89d" ),
+	     40 ) != 0 )
+	{
+		result = 0;
+	}
+	if( libcstring_system_string_compare(
+	     sha256_hash_string,
+	     _LIBCSTRING_SYSTEM_STRING( "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" ),
+	     64 ) != 0 )
+	{
+		result = 0;
+	}
+	ewf_test_integrity_hash_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests if the digest hashes calculated by the worker threads
+ * are equal to those calculated by a single thread
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_integrity_hash_compare(
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t md5_hash_string[ 2 ][ 33 ];
+	libcstring_system_character_t sha1_hash_string[ 2 ][ 41 ];
+	libcstring_system_character_t sha256_hash_string[ 2 ][ 65 ];
+
+	static char *function          = "ewf_test_integrity_hash_compare";
+	int expected_number_of_workers = 0;
+	int number_of_workers          = 0;
+	int result                     = 1;
+	int use_threads                = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing digest hashes:%s%s%s with and without threads\t",
+	 ( calculate_md5 != 0 ) ? " MD5" : "",
+	 ( calculate_sha1 != 0 ) ? " SHA1" : "",
+	 ( calculate_sha256 != 0 ) ? " SHA256" : "" );
+
+	if( memory_set(
+	     md5_hash_string,
+	     0,
+	     sizeof( md5_hash_string ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear MD5 hash strings.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     sha1_hash_string,
+	     0,
+	     sizeof( sha1_hash_string ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear SHA1 hash strings.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     sha256_hash_string,
+	     0,
+	     sizeof( sha256_hash_string ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear SHA256 hash strings.",
+		 function );
+
+		return( -1 );
+	}
+	for( use_threads = 0;
+	     use_threads < 2;
+	     use_threads++ )
+	{
+		if( ewf_test_integrity_hash_calculate(
+		     calculate_md5,
+		     calculate_sha1,
+		     calculate_sha256,
+		     (uint8_t) use_threads,
+		     data,
+		     data_size,
+		     md5_hash_string[ use_threads ],
+		     sha1_hash_string[ use_threads ],
+		     sha256_hash_string[ use_threads ],
+		     &number_of_workers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		/* Every additional digest hash is calculated by a worker thread
+		 */
+		expected_number_of_workers = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( use_threads != 0 )
+		{
+			expected_number_of_workers = (int) calculate_md5
+			                           + (int) calculate_sha1
+			                           + (int) calculate_sha256
+			                           - 1;
+		}
+#endif
+		if( number_of_workers != expected_number_of_workers )
+		{
+			result = 0;
+		}
+	}
+	if( memory_compare(
+	     md5_hash_string[ 0 ],
+	     md5_hash_string[ 1 ],
+	     sizeof( libcstring_system_character_t ) * 33 ) != 0 )
+	{
+		result = 0;
+	}
+	if( memory_compare(
+	     sha1_hash_string[ 0 ],
+	     sha1_hash_string[ 1 ],
+	     sizeof( libcstring_system_character_t ) * 41 ) != 0 )
+	{
+		result = 0;
+	}
+	if( memory_compare(
+	     sha256_hash_string[ 0 ],
+	     sha256_hash_string[ 1 ],
+	     sizeof( libcstring_system_character_t ) * 65 ) != 0 )
+	{
+		result = 0;
+	}
+	ewf_test_integrity_hash_print_result(
+	 result );
+
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests that update and free fail instead of waiting when a worker thread failed
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_integrity_hash_worker_failed(
+     libcerror_error_t **error )
+{
+	libcerror_error_t *update_error  = NULL;
+	integrity_hash_t *integrity_hash = NULL;
+	static char *function            = "ewf_test_integrity_hash_worker_failed";
+	int result                       = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing update with failed worker thread\t" );
+
+	if( integrity_hash_initialize(
+	     &integrity_hash,
+	     1,
+	     1,
+	     1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash->number_of_workers > 0 )
+	{
+		/* Mark the workers as failed the same way a worker thread that exits on error does
+		 */
+		if( libcthreads_mutex_grab(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		integrity_hash->worker_failed = 1;
+
+		if( libcthreads_mutex_release(
+		     integrity_hash->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( integrity_hash_update(
+		     integrity_hash,
+		     (uint8_t *) "abc",
+		     3,
+		     &update_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &update_error );
+
+		if( integrity_hash_free(
+		     &integrity_hash,
+		     &update_error ) != -1 )
+		{
+			result = 0;
+		}
+		libcerror_error_free(
+		 &update_error );
+	}
+	else if( integrity_hash_free(
+	          &integrity_hash,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_test_integrity_hash_print_result(
+	 result );
+
+	return( result );
+
+on_error:
+	if( integrity_hash != NULL )
+	{
+		integrity_hash_free(
+		 &integrity_hash,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	size_t data_offset       = 0;
+	uint32_t value           = 1;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * EWF_TEST_INTEGRITY_HASH_DATA_SIZE );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_INTEGRITY_HASH_DATA_SIZE;
+	     data_offset++ )
+	{
+		value ^= value << 13;
+		value ^= value >> 17;
+		value ^= value << 5;
+
+		data[ data_offset ] = (uint8_t) value;
+	}
+	if( ewf_test_integrity_hash_test_vector(
+	     0,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_integrity_hash_test_vector(
+	     1,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_integrity_hash_compare(
+	     1,
+	     1,
+	     1,
+	     data,
+	     EWF_TEST_INTEGRITY_HASH_DATA_SIZE,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_integrity_hash_compare(
+	     1,
+	     0,
+	     1,
+	     data,
+	     EWF_TEST_INTEGRITY_HASH_DATA_SIZE,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_integrity_hash_compare(
+	     0,
+	     1,
+	     0,
+	     data,
+	     EWF_TEST_INTEGRITY_HASH_DATA_SIZE,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewf_test_integrity_hash_worker_failed(
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#endif
+	memory_free(
+	 data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+}
+
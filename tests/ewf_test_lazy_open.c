@@ -0,0 +1,1006 @@
+/*
+ * Expert Witness Compression Format (EWF) library lazy open testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_lazy_open generate verbose output
+#define EWF_TEST_LAZY_OPEN_VERBOSE
+ */
+
+#define EWF_TEST_LAZY_OPEN_BUFFER_SIZE		4096
+#define EWF_TEST_LAZY_OPEN_MEDIA_SIZE		( 1024 * 1024 )
+#define EWF_TEST_LAZY_OPEN_MAXIMUM_SEGMENT_SIZE	( 256 * 1024 )
+#define EWF_TEST_LAZY_OPEN_NUMBER_OF_THREADS	4
+
+/* The maximum number of open handles is less than the number of segment files
+ */
+#define EWF_TEST_LAZY_OPEN_MAXIMUM_NUMBER_OF_OPEN_HANDLES	2
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_lazy_open_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     uint8_t lazy_open,
+     int maximum_number_of_open_handles,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_lazy_open(
+	     *handle,
+	     lazy_open,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_set_maximum_number_of_open_handles(
+	     *handle,
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libewf_handle_free(
+	 handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes and frees a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_lazy_open_close_handle(
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	int result = 1;
+
+	if( *handle == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests if the media values of a lazily opened handle equal those of the reference handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lazy_open_compare_media_values(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle )
+{
+	libcerror_error_t *error             = NULL;
+	size64_t media_size                  = 0;
+	size64_t reference_media_size        = 0;
+	uint64_t number_of_sectors           = 0;
+	uint64_t reference_number_of_sectors = 0;
+	uint32_t bytes_per_sector            = 0;
+	uint32_t reference_bytes_per_sector  = 0;
+	size32_t chunk_size                  = 0;
+	size32_t reference_chunk_size        = 0;
+	int result                           = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing lazy open media values\t" );
+
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_media_size(
+	          reference_handle,
+	          &reference_media_size,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_number_of_sectors(
+	          handle,
+	          &number_of_sectors,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_number_of_sectors(
+	          reference_handle,
+	          &reference_number_of_sectors,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_bytes_per_sector(
+	          handle,
+	          &bytes_per_sector,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_bytes_per_sector(
+	          reference_handle,
+	          &reference_bytes_per_sector,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_get_chunk_size(
+	          reference_handle,
+	          &reference_chunk_size,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( ( media_size != EWF_TEST_LAZY_OPEN_MEDIA_SIZE )
+	      || ( media_size != reference_media_size )
+	      || ( number_of_sectors != reference_number_of_sectors )
+	      || ( bytes_per_sector != reference_bytes_per_sector )
+	      || ( chunk_size != reference_chunk_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Mismatch in media values.\n" );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests reading (media) data at a specific offset from a lazily opened handle
+ * and compares it with the reference handle and the expected data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lazy_open_read_at_offset(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle,
+     const char *description,
+     off64_t read_offset )
+{
+	uint8_t buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	size_t read_size         = EWF_TEST_LAZY_OPEN_BUFFER_SIZE;
+	ssize_t read_count       = 0;
+	int iteration            = 0;
+	int result               = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing lazy open read in %s segment file at offset: %" PRIi64 "\t",
+	 description,
+	 read_offset );
+
+	if( (size64_t) ( read_offset + read_size ) > EWF_TEST_LAZY_OPEN_MEDIA_SIZE )
+	{
+		read_size = (size_t) ( EWF_TEST_LAZY_OPEN_MEDIA_SIZE - read_offset );
+	}
+	ewf_test_image_fill_buffer(
+	 expected_buffer,
+	 read_size,
+	 read_offset,
+	 NULL );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              reference_handle,
+	              reference_buffer,
+	              read_size,
+	              read_offset,
+	              &error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		result = -1;
+	}
+	/* The second read is from a segment file that is already mapped
+	 */
+	for( iteration = 0;
+	     ( result == 1 ) && ( iteration < 2 );
+	     iteration++ )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		else if( ( memory_compare(
+		            buffer,
+		            expected_buffer,
+		            read_size ) != 0 )
+		      || ( memory_compare(
+		            buffer,
+		            reference_buffer,
+		            read_size ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 "\n",
+			 read_offset );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests if all the (media) data of a lazily opened handle equals that of the reference handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lazy_open_compare_data(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle )
+{
+	uint8_t buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+	uint8_t reference_buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	off64_t read_offset      = 0;
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing lazy open read of all data\t" );
+
+	while( ( result == 1 )
+	    && ( read_offset < (off64_t) EWF_TEST_LAZY_OPEN_MEDIA_SIZE ) )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              EWF_TEST_LAZY_OPEN_BUFFER_SIZE,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) EWF_TEST_LAZY_OPEN_BUFFER_SIZE )
+		{
+			result = -1;
+		}
+		else if( libewf_handle_read_buffer_at_offset(
+		          reference_handle,
+		          reference_buffer,
+		          EWF_TEST_LAZY_OPEN_BUFFER_SIZE,
+		          read_offset,
+		          &error ) != read_count )
+		{
+			result = -1;
+		}
+		else if( memory_compare(
+		          buffer,
+		          reference_buffer,
+		          EWF_TEST_LAZY_OPEN_BUFFER_SIZE ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 "\n",
+			 read_offset );
+
+			result = 0;
+		}
+		read_offset += (off64_t) EWF_TEST_LAZY_OPEN_BUFFER_SIZE;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests the open handles statistics of a handle with fewer open handles than segment files
+ * after all the (media) data was read
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lazy_open_check_open_handles(
+     libewf_handle_t *handle,
+     int number_of_filenames )
+{
+	libcerror_error_t *error           = NULL;
+	uint64_t number_of_closes          = 0;
+	uint64_t number_of_opens           = 0;
+	int maximum_number_of_open_handles = 0;
+	int number_of_open_handles         = 0;
+	int result                         = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing maximum number of open handles\t" );
+
+	if( libewf_handle_get_open_handles_statistics(
+	     handle,
+	     &number_of_open_handles,
+	     &maximum_number_of_open_handles,
+	     &number_of_opens,
+	     &number_of_closes,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	/* The segment files closed to stay within the maximum are reopened when read from again
+	 */
+	else if( ( maximum_number_of_open_handles != EWF_TEST_LAZY_OPEN_MAXIMUM_NUMBER_OF_OPEN_HANDLES )
+	      || ( number_of_open_handles > EWF_TEST_LAZY_OPEN_MAXIMUM_NUMBER_OF_OPEN_HANDLES )
+	      || ( number_of_opens <= (uint64_t) number_of_filenames )
+	      || ( number_of_closes != ( number_of_opens - (uint64_t) number_of_open_handles ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected open handles: %d, maximum: %d, opens: %" PRIu64 " and closes: %" PRIu64 ".\n",
+		 number_of_open_handles,
+		 maximum_number_of_open_handles,
+		 number_of_opens,
+		 number_of_closes );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The thread pool callback function for concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_lazy_open_concurrent_callback_function(
+     off64_t *read_offset,
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_LAZY_OPEN_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewf_test_lazy_open_concurrent_callback_function";
+	ssize_t read_count       = 0;
+
+	if( read_offset == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              EWF_TEST_LAZY_OPEN_BUFFER_SIZE,
+	              *read_offset,
+	              &error );
+
+	if( read_count != (ssize_t) EWF_TEST_LAZY_OPEN_BUFFER_SIZE )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	ewf_test_image_fill_buffer(
+	 expected_buffer,
+	 EWF_TEST_LAZY_OPEN_BUFFER_SIZE,
+	 *read_offset,
+	 NULL );
+
+	if( memory_compare(
+	     buffer,
+	     expected_buffer,
+	     EWF_TEST_LAZY_OPEN_BUFFER_SIZE ) != 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in data read at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests concurrently reading from a lazily opened handle in multiple threads
+ * Every segment file is read from by multiple threads at the same time
+ * so that the segment files are mapped concurrently
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lazy_open_read_concurrent(
+     libewf_handle_t *handle )
+{
+	off64_t read_offsets[ 2 * ( EWF_TEST_LAZY_OPEN_MEDIA_SIZE / EWF_TEST_LAZY_OPEN_BUFFER_SIZE ) ];
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int iteration                          = 0;
+	int number_of_blocks                   = 0;
+	int number_of_iterations               = 0;
+	int result                             = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing lazy open concurrent read\t" );
+
+	number_of_blocks     = (int) ( EWF_TEST_LAZY_OPEN_MEDIA_SIZE / EWF_TEST_LAZY_OPEN_BUFFER_SIZE );
+	number_of_iterations = 2 * number_of_blocks;
+
+	/* Read every block twice in reverse order, the second reads start
+	 * in the last segment file while the first reads are still ongoing
+	 */
+	for( iteration = 0;
+	     iteration < number_of_blocks;
+	     iteration++ )
+	{
+		read_offsets[ 2 * iteration ] = (off64_t) ( number_of_blocks - iteration - 1 ) * EWF_TEST_LAZY_OPEN_BUFFER_SIZE;
+
+		read_offsets[ ( 2 * iteration ) + 1 ] = (off64_t) ( ( number_of_blocks / 2 ) + iteration ) % number_of_blocks * EWF_TEST_LAZY_OPEN_BUFFER_SIZE;
+	}
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     EWF_TEST_LAZY_OPEN_NUMBER_OF_THREADS,
+	     number_of_iterations,
+	     (int (*)(intptr_t *, void *)) &ewf_test_lazy_open_concurrent_callback_function,
+	     (void *) handle,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	for( iteration = 0;
+	     ( result == 1 ) && ( iteration < number_of_iterations );
+	     iteration++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) &( read_offsets[ iteration ] ),
+		     &error ) == -1 )
+		{
+			result = -1;
+		}
+	}
+	if( thread_pool != NULL )
+	{
+		/* The thread pool join fails if one of the callbacks failed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     ( result == 1 ) ? &error : NULL ) != 1 )
+		{
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcstring_system_character_t **filenames = NULL;
+	libcerror_error_t *error                  = NULL;
+	libewf_handle_t *handle                   = NULL;
+	libewf_handle_t *reference_handle         = NULL;
+	int number_of_filenames                   = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_LAZY_OPEN_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	/* The data is stored uncompressed so that the media data spans multiple segment files
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_lazy_open" ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     EWF_TEST_LAZY_OPEN_MEDIA_SIZE,
+	     EWF_TEST_LAZY_OPEN_MAXIMUM_SEGMENT_SIZE,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     NULL,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write segment files.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     L"ewf_test_lazy_open.E01",
+	     22,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     "ewf_test_lazy_open.E01",
+	     22,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	/* Lazy open only defers reading the segment files between the first and the last
+	 */
+	if( number_of_filenames < 3 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of segment files: %d.\n",
+		 number_of_filenames );
+
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     0,
+	     LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC,
+	     &reference_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open reference handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     1,
+	     LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC,
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_compare_media_values(
+	     handle,
+	     reference_handle ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Read from the middle segment file before any of the preceding segment files are mapped
+	 */
+	if( ewf_test_lazy_open_read_at_offset(
+	     handle,
+	     reference_handle,
+	     "middle",
+	     (off64_t) ( EWF_TEST_LAZY_OPEN_MEDIA_SIZE / 2 ) ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_read_at_offset(
+	     handle,
+	     reference_handle,
+	     "last",
+	     (off64_t) ( EWF_TEST_LAZY_OPEN_MEDIA_SIZE - EWF_TEST_LAZY_OPEN_BUFFER_SIZE ) ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_compare_data(
+	     handle,
+	     reference_handle ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_close_handle(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	/* Read all the data with fewer open handles than segment files
+	 * the first segment file is reopened since opening the handle reads every segment file
+	 */
+	if( ewf_test_lazy_open_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     0,
+	     EWF_TEST_LAZY_OPEN_MAXIMUM_NUMBER_OF_OPEN_HANDLES,
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_compare_data(
+	     handle,
+	     reference_handle ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_check_open_handles(
+	     handle,
+	     number_of_filenames ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_close_handle(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewf_test_lazy_open_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     1,
+	     LIBEWF_MAXIMUM_NUMBER_OF_OPEN_HANDLES_AUTOMATIC,
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_read_concurrent(
+	     handle ) != 1 )
+	{
+		goto on_error;
+	}
+	/* All segment files are mapped by now, mapping them again must not change the data
+	 */
+	if( ewf_test_lazy_open_compare_data(
+	     handle,
+	     reference_handle ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_lazy_open_close_handle(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Clean up
+	 */
+	if( ewf_test_lazy_open_close_handle(
+	     &reference_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close reference handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_lazy_open" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( reference_handle != NULL )
+	{
+		libewf_handle_close(
+		 reference_handle,
+		 NULL );
+		libewf_handle_free(
+		 &reference_handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_lazy_open" );
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,872 @@
+/*
+ * Least recently used cache test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_lru_cache.h"
+
+/* The size of the test values
+ */
+#define EWF_TEST_LRU_CACHE_VALUE_SIZE	100
+
+/* The number of values freed by the cache
+ */
+static int ewf_test_lru_cache_number_of_freed_values = 0;
+
+/* Frees a test value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_lru_cache_free_value(
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_lru_cache_free_value";
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value != NULL )
+	{
+		memory_free(
+		 *value );
+
+		*value = NULL;
+
+		ewf_test_lru_cache_number_of_freed_values += 1;
+	}
+	return( 1 );
+}
+
+/* Sets a test value in the cache
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_lru_cache_set_value(
+     libewf_lru_cache_t *cache,
+     uint64_t identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_lru_cache_set_value";
+	intptr_t *test_value  = NULL;
+
+	test_value = (intptr_t *) memory_allocate(
+	                           sizeof( uint64_t ) );
+
+	if( test_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create value.",
+		 function );
+
+		return( -1 );
+	}
+	*( (uint64_t *) test_value ) = identifier;
+
+	if( value != NULL )
+	{
+		*value = test_value;
+	}
+	/* The cache takes over management of the value, also on error
+	 */
+	if( libewf_lru_cache_set_value(
+	     cache,
+	     identifier,
+	     test_value,
+	     EWF_TEST_LRU_CACHE_VALUE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value: %" PRIu64 ".",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Checks which identifiers are cached
+ * The identifiers in the cached bit mask are expected to be cached,
+ * all other identifiers up to 64 are expected not to be cached
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lru_cache_check_values(
+     libewf_lru_cache_t *cache,
+     uint64_t cached,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_lru_cache_check_values";
+	uint64_t identifier   = 0;
+	int result            = 0;
+
+	for( identifier = 0;
+	     identifier < 64;
+	     identifier++ )
+	{
+		result = libewf_lru_cache_has_value(
+		          cache,
+		          identifier,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if value: %" PRIu64 " is cached.",
+			 function,
+			 identifier );
+
+			return( -1 );
+		}
+		if( result != (int) ( ( cached >> identifier ) & 1 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Value: %" PRIu64 " is %scached.\n",
+			 identifier,
+			 ( result == 0 ) ? "not " : "" );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks the number of pins and the cache statistics
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lru_cache_check_statistics(
+     libewf_lru_cache_t *cache,
+     int expected_number_of_pins,
+     uint64_t expected_number_of_hits,
+     uint64_t expected_number_of_misses,
+     uint64_t expected_number_of_evictions,
+     libcerror_error_t **error )
+{
+	static char *function        = "ewf_test_lru_cache_check_statistics";
+	uint64_t number_of_evictions = 0;
+	uint64_t number_of_hits      = 0;
+	uint64_t number_of_misses    = 0;
+	int number_of_pins           = 0;
+
+	if( libewf_lru_cache_get_number_of_pins(
+	     cache,
+	     &number_of_pins,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pins.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_lru_cache_get_statistics(
+	     cache,
+	     &number_of_hits,
+	     &number_of_misses,
+	     &number_of_evictions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_pins != expected_number_of_pins )
+	 || ( number_of_hits != expected_number_of_hits )
+	 || ( number_of_misses != expected_number_of_misses )
+	 || ( number_of_evictions != expected_number_of_evictions ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected pins: %d, hits: %" PRIu64 ", misses: %" PRIu64 " and evictions: %" PRIu64 ".\n",
+		 number_of_pins,
+		 number_of_hits,
+		 number_of_misses,
+		 number_of_evictions );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the least recently used eviction
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lru_cache_eviction(
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_t *cache = NULL;
+	intptr_t *value           = NULL;
+	uint64_t identifier       = 0;
+	int result                = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing eviction\t" );
+
+	ewf_test_lru_cache_number_of_freed_values = 0;
+
+	result = libewf_lru_cache_initialize(
+	          &cache,
+	          3 * EWF_TEST_LRU_CACHE_VALUE_SIZE,
+	          &ewf_test_lru_cache_free_value,
+	          error );
+
+	for( identifier = 1;
+	     ( result == 1 ) && ( identifier <= 3 );
+	     identifier++ )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          identifier,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x0eULL,
+		          error );
+	}
+	/* Using value 1 makes value 2 the least recently used
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_get_value(
+		          cache,
+		          1,
+		          &value,
+		          error );
+
+		if( ( result == 1 )
+		 && ( *( (uint64_t *) value ) != 1 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected value: 1.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          4,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x1aULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_get_value(
+		          cache,
+		          2,
+		          &value,
+		          error );
+
+		if( result == 0 )
+		{
+			result = 1;
+		}
+		else if( result == 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Evicted value: 2 was retrieved.\n" );
+
+			result = 0;
+		}
+	}
+	/* Replacing a value frees the previous value
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          3,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_statistics(
+		          cache,
+		          0,
+		          1,
+		          1,
+		          1,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_lru_cache_number_of_freed_values != 2 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of freed values: %d.\n",
+		 ewf_test_lru_cache_number_of_freed_values );
+
+		result = 0;
+	}
+	/* Reducing the maximum size keeps the most recently used value
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_set_maximum_size(
+		          cache,
+		          0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x08ULL,
+		          error );
+	}
+	if( cache != NULL )
+	{
+		if( libewf_lru_cache_free(
+		     &cache,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_lru_cache_number_of_freed_values != 5 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of freed values: %d.\n",
+		 ewf_test_lru_cache_number_of_freed_values );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+}
+
+/* Tests that pinned values are not evicted
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lru_cache_pinned_eviction(
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_t *cache = NULL;
+	intptr_t *pinned_value    = NULL;
+	intptr_t *value           = NULL;
+	uint64_t identifier       = 0;
+	int result                = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing eviction while pinned\t" );
+
+	ewf_test_lru_cache_number_of_freed_values = 0;
+
+	result = libewf_lru_cache_initialize(
+	          &cache,
+	          3 * EWF_TEST_LRU_CACHE_VALUE_SIZE,
+	          &ewf_test_lru_cache_free_value,
+	          error );
+
+	for( identifier = 1;
+	     ( result == 1 ) && ( identifier <= 3 );
+	     identifier++ )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          identifier,
+		          NULL,
+		          error );
+	}
+	/* Pin value 1 twice
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_pin_value(
+		          cache,
+		          1,
+		          &pinned_value,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_pin_value(
+		          cache,
+		          1,
+		          &value,
+		          error );
+
+		if( ( result == 1 )
+		 && ( value != pinned_value ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected pinned value: 1.\n" );
+
+			result = 0;
+		}
+	}
+	/* Pinning a value that is not cached fails
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_pin_value(
+		          cache,
+		          63,
+		          &value,
+		          error );
+
+		if( result == 0 )
+		{
+			result = 1;
+		}
+		else if( result == 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Value: 63 was pinned.\n" );
+
+			result = 0;
+		}
+	}
+	/* Values 4 to 6 push value 1 to the least recently used end of the cache,
+	 * where it is skipped instead of evicted
+	 */
+	for( identifier = 4;
+	     ( result == 1 ) && ( identifier <= 6 );
+	     identifier++ )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          identifier,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x62ULL,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( *( (uint64_t *) pinned_value ) != 1 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected pinned value: 1.\n" );
+
+		result = 0;
+	}
+	/* Setting a pinned value keeps the pinned value and frees the new value
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          1,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_get_value(
+		          cache,
+		          1,
+		          &value,
+		          error );
+
+		if( ( result == 1 )
+		 && ( value != pinned_value ) )
+		{
+			fprintf(
+			 stderr,
+			 "Pinned value: 1 was replaced.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_statistics(
+		          cache,
+		          2,
+		          3,
+		          1,
+		          3,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_lru_cache_number_of_freed_values != 4 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of freed values: %d.\n",
+		 ewf_test_lru_cache_number_of_freed_values );
+
+		result = 0;
+	}
+	/* A value pinned twice remains pinned after it is unpinned once
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_unpin_value(
+		          cache,
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          7,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_set_maximum_size(
+		          cache,
+		          0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x82ULL,
+		          error );
+	}
+	/* Once unpinned the value is evicted
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_unpin_value(
+		          cache,
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0x80ULL,
+		          error );
+	}
+	/* Unpinning a value that is not pinned fails
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_unpin_value(
+		          cache,
+		          7,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_free(
+			 error );
+
+			result = 1;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Value: 7 was unpinned.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_statistics(
+		          cache,
+		          0,
+		          3,
+		          1,
+		          6,
+		          error );
+	}
+	if( cache != NULL )
+	{
+		if( libewf_lru_cache_free(
+		     &cache,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_lru_cache_number_of_freed_values != 8 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of freed values: %d.\n",
+		 ewf_test_lru_cache_number_of_freed_values );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+}
+
+/* Tests emptying a cache with pinned values
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_lru_cache_empty_pinned(
+     libcerror_error_t **error )
+{
+	libewf_lru_cache_t *cache = NULL;
+	intptr_t *value           = NULL;
+	int result                = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing empty while pinned\t" );
+
+	ewf_test_lru_cache_number_of_freed_values = 0;
+
+	result = libewf_lru_cache_initialize(
+	          &cache,
+	          3 * EWF_TEST_LRU_CACHE_VALUE_SIZE,
+	          &ewf_test_lru_cache_free_value,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_set_value(
+		          cache,
+		          1,
+		          NULL,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_pin_value(
+		          cache,
+		          1,
+		          &value,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_statistics(
+		          cache,
+		          1,
+		          1,
+		          0,
+		          0,
+		          error );
+	}
+	/* Emptying the cache frees pinned values and resets the number of pins
+	 */
+	if( result == 1 )
+	{
+		result = libewf_lru_cache_empty(
+		          cache,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_values(
+		          cache,
+		          0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_lru_cache_check_statistics(
+		          cache,
+		          0,
+		          1,
+		          0,
+		          0,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_lru_cache_number_of_freed_values != 1 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of freed values: %d.\n",
+		 ewf_test_lru_cache_number_of_freed_values );
+
+		result = 0;
+	}
+	if( cache != NULL )
+	{
+		if( libewf_lru_cache_free(
+		     &cache,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( ewf_test_lru_cache_eviction(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test eviction.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lru_cache_pinned_eviction(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test eviction while pinned.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_lru_cache_empty_pinned(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test empty while pinned.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,941 @@
+/*
+ * Memory mapped read test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_memory_map generate verbose output
+#define EWF_TEST_MEMORY_MAP_VERBOSE
+ */
+
+/* The library only supports memory mapped IO with the POSIX mmap functions
+ * and narrow character filenames, refer to libewf_memory_map.h
+ */
+#if !defined( WINAPI ) && !defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_FCNTL_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP )
+#define EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP
+#endif
+
+#define EWF_TEST_MEMORY_MAP_EXIT_IGNORE		77
+
+#define EWF_TEST_MEMORY_MAP_BUFFER_SIZE		4096
+#define EWF_TEST_MEMORY_MAP_FILENAME		"ewf_test_memory_map.E01"
+
+/* The media size is not a multiple of the chunk size to test a partial last chunk
+ */
+#define EWF_TEST_MEMORY_MAP_MEDIA_SIZE		260000
+
+/* The chunk that is corrupted
+ */
+#define EWF_TEST_MEMORY_MAP_CHUNK_INDEX		2
+
+#if defined( EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP )
+
+/* Determines the offset of the data of a chunk in the segment file
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int ewf_test_memory_map_get_chunk_file_offset(
+     size32_t chunk_size,
+     uint64_t chunk_index,
+     long *file_offset )
+{
+	uint8_t *chunk_data = NULL;
+	uint8_t *file_data  = NULL;
+	FILE *file_stream   = NULL;
+	long file_size      = 0;
+	long search_offset  = 0;
+	int result          = 0;
+
+	file_stream = fopen(
+	               EWF_TEST_MEMORY_MAP_FILENAME,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( fseek(
+	     file_stream,
+	     0,
+	     SEEK_END ) != 0 )
+	{
+		goto on_error;
+	}
+	file_size = ftell(
+	             file_stream );
+
+	if( file_size <= (long) chunk_size )
+	{
+		goto on_error;
+	}
+	if( fseek(
+	     file_stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		goto on_error;
+	}
+	file_data = (uint8_t *) memory_allocate(
+	                         (size_t) file_size );
+
+	if( file_data == NULL )
+	{
+		goto on_error;
+	}
+	if( fread(
+	     file_data,
+	     1,
+	     (size_t) file_size,
+	     file_stream ) != (size_t) file_size )
+	{
+		goto on_error;
+	}
+	chunk_data = (uint8_t *) memory_allocate(
+	                          (size_t) chunk_size );
+
+	if( chunk_data == NULL )
+	{
+		goto on_error;
+	}
+	ewf_test_image_fill_buffer(
+	 chunk_data,
+	 (size_t) chunk_size,
+	 (off64_t) ( chunk_index * chunk_size ),
+	 NULL );
+
+	for( search_offset = 0;
+	     search_offset <= ( file_size - (long) chunk_size );
+	     search_offset++ )
+	{
+		if( memory_compare(
+		     &( file_data[ search_offset ] ),
+		     chunk_data,
+		     (size_t) chunk_size ) == 0 )
+		{
+			*file_offset = search_offset;
+
+			result = 1;
+
+			break;
+		}
+	}
+	memory_free(
+	 chunk_data );
+	memory_free(
+	 file_data );
+
+	fclose(
+	 file_stream );
+
+	return( result );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		memory_free(
+		 chunk_data );
+	}
+	if( file_data != NULL )
+	{
+		memory_free(
+		 file_data );
+	}
+	fclose(
+	 file_stream );
+
+	return( -1 );
+}
+
+/* Inverts a byte in the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_memory_map_invert_byte(
+     long file_offset )
+{
+	FILE *file_stream = NULL;
+	int result        = 1;
+	int value         = 0;
+
+	file_stream = fopen(
+	               EWF_TEST_MEMORY_MAP_FILENAME,
+	               "r+b" );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( fseek(
+	     file_stream,
+	     file_offset,
+	     SEEK_SET ) != 0 )
+	{
+		result = -1;
+	}
+	else
+	{
+		value = fgetc(
+		         file_stream );
+
+		if( value == EOF )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( fseek(
+		     file_stream,
+		     file_offset,
+		     SEEK_SET ) != 0 )
+		{
+			result = -1;
+		}
+		else if( fputc(
+		          value ^ 0xff,
+		          file_stream ) == EOF )
+		{
+			result = -1;
+		}
+	}
+	if( fclose(
+	     file_stream ) != 0 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_memory_map_open_handle(
+     int access_flags,
+     uint8_t verify_checksums,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	char *filenames[ 1 ] = {
+		EWF_TEST_MEMORY_MAP_FILENAME };
+
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_read_verify_checksums(
+	     *handle,
+	     verify_checksums,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     1,
+	     access_flags,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libewf_handle_free(
+	 handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes and frees a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_memory_map_close_handle(
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	int result = 1;
+
+	if( *handle == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads (media) data at a specific offset using the sequential read path
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_memory_map_read_at(
+     libewf_handle_t *handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	ssize_t read_count = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     offset,
+	     SEEK_SET,
+	     error ) != offset )
+	{
+		return( -1 );
+	}
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Checks the number of checksum errors of a handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_memory_map_check_checksum_errors(
+     libewf_handle_t *handle,
+     uint32_t expected_number_of_errors,
+     libcerror_error_t **error )
+{
+	uint32_t number_of_errors = 0;
+
+	if( libewf_handle_get_number_of_checksum_errors(
+	     handle,
+	     &number_of_errors,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( number_of_errors != expected_number_of_errors )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of checksum errors: %" PRIu32 ".\n",
+		 number_of_errors );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests reading all the (media) data in parts of a specific size
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_memory_map_read_parts(
+     libewf_handle_t *handle,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	off64_t read_offset      = 0;
+	size_t size              = 0;
+	int result               = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing memory mapped reads of size: %" PRIzd "\t",
+	 read_size );
+
+	buffer = (uint8_t *) memory_allocate(
+	                      read_size );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               read_size );
+
+	if( ( buffer == NULL )
+	 || ( expected_buffer == NULL ) )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          error ) != 0 )
+	{
+		result = -1;
+	}
+	while( ( result == 1 )
+	    && ( read_offset < (off64_t) EWF_TEST_MEMORY_MAP_MEDIA_SIZE ) )
+	{
+		size = read_size;
+
+		if( size > (size_t) ( EWF_TEST_MEMORY_MAP_MEDIA_SIZE - read_offset ) )
+		{
+			size = (size_t) ( EWF_TEST_MEMORY_MAP_MEDIA_SIZE - read_offset );
+		}
+		/* Read the full size to test the read at the end of the media
+		 */
+		if( libewf_handle_read_buffer(
+		     handle,
+		     buffer,
+		     read_size,
+		     error ) != (ssize_t) size )
+		{
+			result = -1;
+
+			break;
+		}
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 size,
+		 read_offset,
+		 NULL );
+
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 ".\n",
+			 read_offset );
+
+			result = 0;
+		}
+		read_offset += (off64_t) size;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_check_checksum_errors(
+		          handle,
+		          0,
+		          error );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests that the checksum of a chunk is verified once when the chunk is read in parts
+ * The chunk is corrupted in between the reads, which is not detected
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_memory_map_verify_once(
+     size32_t chunk_size,
+     long chunk_file_offset,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle  = NULL;
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	off64_t chunk_offset     = 0;
+	size_t part_size         = 0;
+	int result               = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing memory mapped chunk checksum verified once\t" );
+
+	chunk_offset = (off64_t) EWF_TEST_MEMORY_MAP_CHUNK_INDEX * chunk_size;
+	part_size    = (size_t) chunk_size / 2;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      (size_t) chunk_size );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               (size_t) chunk_size );
+
+	if( ( buffer == NULL )
+	 || ( expected_buffer == NULL ) )
+	{
+		result = -1;
+	}
+	else
+	{
+		result = ewf_test_memory_map_open_handle(
+		          LIBEWF_OPEN_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP,
+		          1,
+		          &handle,
+		          error );
+	}
+	/* Reading the first part verifies the checksum of the chunk
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_read_at(
+		          handle,
+		          chunk_offset,
+		          buffer,
+		          part_size,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_invert_byte(
+		          chunk_file_offset + (long) part_size + 1 );
+	}
+	/* Reading the second part does not verify the checksum again
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_read_at(
+		          handle,
+		          chunk_offset + part_size,
+		          &( buffer[ part_size ] ),
+		          (size_t) chunk_size - part_size,
+		          error );
+	}
+	if( result == 1 )
+	{
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 (size_t) chunk_size,
+		 chunk_offset,
+		 NULL );
+
+		expected_buffer[ part_size + 1 ] ^= 0xff;
+
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     (size_t) chunk_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in chunk: %d data.\n",
+			 EWF_TEST_MEMORY_MAP_CHUNK_INDEX );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_check_checksum_errors(
+		          handle,
+		          0,
+		          error );
+	}
+	if( ewf_test_memory_map_close_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests reading a corrupted chunk
+ * With checksum verification the memory mapped read falls back to the regular
+ * read path and the result must match a handle without memory mapped IO,
+ * without checksum verification the corrupted data is read as stored
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_memory_map_corrupted_chunk(
+     size32_t chunk_size,
+     uint8_t verify_checksums,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle           = NULL;
+	libewf_handle_t *reference_handle = NULL;
+	uint8_t *buffer                   = NULL;
+	uint8_t *expected_buffer          = NULL;
+	off64_t chunk_offset              = 0;
+	int result                        = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing memory mapped read of corrupted chunk with verify checksums: %" PRIu8 "\t",
+	 verify_checksums );
+
+	chunk_offset = (off64_t) EWF_TEST_MEMORY_MAP_CHUNK_INDEX * chunk_size;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      (size_t) chunk_size );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               (size_t) chunk_size );
+
+	if( ( buffer == NULL )
+	 || ( expected_buffer == NULL ) )
+	{
+		result = -1;
+	}
+	else
+	{
+		result = ewf_test_memory_map_open_handle(
+		          LIBEWF_OPEN_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP,
+		          verify_checksums,
+		          &handle,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_open_handle(
+		          LIBEWF_OPEN_READ,
+		          verify_checksums,
+		          &reference_handle,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_read_at(
+		          handle,
+		          chunk_offset,
+		          buffer,
+		          (size_t) chunk_size,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_read_at(
+		          reference_handle,
+		          chunk_offset,
+		          expected_buffer,
+		          (size_t) chunk_size,
+		          error );
+	}
+	if( result == 1 )
+	{
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     (size_t) chunk_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in chunk: %d data.\n",
+			 EWF_TEST_MEMORY_MAP_CHUNK_INDEX );
+
+			result = 0;
+		}
+	}
+	/* Without checksum verification the data is read as stored
+	 */
+	if( ( result == 1 )
+	 && ( verify_checksums == 0 ) )
+	{
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 (size_t) chunk_size,
+		 chunk_offset,
+		 NULL );
+
+		expected_buffer[ ( chunk_size / 2 ) + 1 ] ^= 0xff;
+
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     (size_t) chunk_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Chunk: %d data was not read as stored.\n",
+			 EWF_TEST_MEMORY_MAP_CHUNK_INDEX );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_check_checksum_errors(
+		          handle,
+		          ( verify_checksums != 0 ) ? 1 : 0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_memory_map_check_checksum_errors(
+		          reference_handle,
+		          ( verify_checksums != 0 ) ? 1 : 0,
+		          error );
+	}
+	if( ewf_test_memory_map_close_handle(
+	     &reference_handle,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	if( ewf_test_memory_map_close_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+#endif /* defined( EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP )
+	size_t read_sizes[ 6 ] = {
+		1, 509, EWF_TEST_MEMORY_MAP_BUFFER_SIZE + 7, 0, 0, 0 };
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	long chunk_file_offset   = 0;
+	size32_t chunk_size      = 0;
+	int read_size_index      = 0;
+#endif
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if !defined( EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP )
+	return( EWF_TEST_MEMORY_MAP_EXIT_IGNORE );
+#else
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_MEMORY_MAP_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	/* Only uncompressed chunks are read from the memory map
+	 */
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_memory_map" ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     EWF_TEST_MEMORY_MAP_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     NULL,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write segment file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_memory_map_open_handle(
+	     LIBEWF_OPEN_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP,
+	     1,
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk size.\n" );
+
+		goto on_error;
+	}
+	if( ( chunk_size == 0 )
+	 || ( ( (size64_t) EWF_TEST_MEMORY_MAP_CHUNK_INDEX + 2 ) * chunk_size > EWF_TEST_MEMORY_MAP_MEDIA_SIZE ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported chunk size: %" PRIu32 ".\n",
+		 chunk_size );
+
+		goto on_error;
+	}
+	/* Read parts within a chunk, parts that span chunks and parts that span the partial last chunk
+	 */
+	read_sizes[ 3 ] = (size_t) chunk_size - 1;
+	read_sizes[ 4 ] = (size_t) chunk_size;
+	read_sizes[ 5 ] = ( 3 * (size_t) chunk_size ) + 13;
+
+	for( read_size_index = 0;
+	     read_size_index < 6;
+	     read_size_index++ )
+	{
+		if( ewf_test_memory_map_read_parts(
+		     handle,
+		     read_sizes[ read_size_index ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test memory mapped reads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_memory_map_close_handle(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_memory_map_get_chunk_file_offset(
+	     chunk_size,
+	     EWF_TEST_MEMORY_MAP_CHUNK_INDEX,
+	     &chunk_file_offset ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine chunk: %d file offset.\n",
+		 EWF_TEST_MEMORY_MAP_CHUNK_INDEX );
+
+		goto on_error;
+	}
+	/* The verify once test corrupts the chunk for the tests that follow
+	 */
+	if( ewf_test_memory_map_verify_once(
+	     chunk_size,
+	     chunk_file_offset,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test verify once.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_memory_map_corrupted_chunk(
+	     chunk_size,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test corrupted chunk with checksum verification.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_memory_map_corrupted_chunk(
+	     chunk_size,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test corrupted chunk without checksum verification.\n" );
+
+		goto on_error;
+	}
+	remove(
+	 EWF_TEST_MEMORY_MAP_FILENAME );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_memory_map_close_handle(
+		 &handle,
+		 NULL );
+	}
+	remove(
+	 EWF_TEST_MEMORY_MAP_FILENAME );
+
+	return( EXIT_FAILURE );
+
+#endif /* !defined( EWF_TEST_MEMORY_MAP_HAVE_MEMORY_MAP ) */
+}
+
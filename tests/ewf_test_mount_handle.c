@@ -0,0 +1,963 @@
+/*
+ * Mount handle test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/mount_handle.h"
+
+#define EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE		4096
+#define EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE		( 4 * 1024 * 1024 )
+#define EWF_TEST_MOUNT_HANDLE_NUMBER_OF_THREADS		4
+#define EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS		4
+
+/* Reads a buffer at a specific offset from the mount handle and compares it with the expected (media) data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_check_read(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     off64_t offset,
+     size_t expected_read_count,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ];
+
+	ssize_t read_count = 0;
+
+	read_count = mount_handle_read_buffer_at_offset(
+	              mount_handle,
+	              stream_identifier,
+	              buffer,
+	              EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		return( -1 );
+	}
+	if( read_count != (ssize_t) expected_read_count )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected read count: %" PRIzd " at offset: %" PRIi64 ".\n",
+		 read_count,
+		 offset );
+
+		return( 0 );
+	}
+	ewf_test_image_fill_buffer(
+	 expected_buffer,
+	 expected_read_count,
+	 offset,
+	 NULL );
+
+	if( memory_compare(
+	     buffer,
+	     expected_buffer,
+	     expected_read_count ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Mismatch in data read at offset: %" PRIi64 ".\n",
+		 offset );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests reading at specific offsets from the mount handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_read_at_offset(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ];
+
+	off64_t current_offset = 3 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE;
+	ssize_t read_count     = 0;
+	int result             = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing read at offset\t" );
+
+	if( mount_handle_seek_offset(
+	     mount_handle,
+	     current_offset,
+	     SEEK_SET,
+	     error ) != current_offset )
+	{
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          0,
+		          0,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          0,
+		          ( EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE / 2 ) + 1000,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	/* A read beyond the end of the media is truncated
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          0,
+		          EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE - 1000,
+		          1000,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          0,
+		          EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE,
+		          0,
+		          error );
+	}
+	/* The reads at specific offsets do not change the current offset
+	 */
+	if( result == 1 )
+	{
+		read_count = mount_handle_read_buffer(
+		              mount_handle,
+		              buffer,
+		              EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		              error );
+
+		if( read_count != (ssize_t) EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		 current_offset,
+		 NULL );
+
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data read at current offset.\n" );
+
+			result = 0;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Retrieves the index of a tracked stream
+ * Returns the index of the stream or -1 if the stream is not tracked
+ */
+int ewf_test_mount_handle_get_stream_index(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier )
+{
+	int stream_index = 0;
+
+	for( stream_index = 0;
+	     stream_index < MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( mount_handle->streams[ stream_index ].identifier == stream_identifier )
+		{
+			return( stream_index );
+		}
+	}
+	return( -1 );
+}
+
+/* Checks the sequential read state of a stream
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mount_handle_check_stream(
+     mount_handle_t *mount_handle,
+     uint64_t stream_identifier,
+     off64_t expected_next_offset,
+     int expected_number_of_sequential_reads,
+     off64_t expected_prefetch_offset )
+{
+	mount_stream_t *stream = NULL;
+	int stream_index       = 0;
+
+	stream_index = ewf_test_mount_handle_get_stream_index(
+	                mount_handle,
+	                stream_identifier );
+
+	if( stream_index == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Stream: %" PRIu64 " is not tracked.\n",
+		 stream_identifier );
+
+		return( 0 );
+	}
+	stream = &( mount_handle->streams[ stream_index ] );
+
+	if( ( stream->next_offset != expected_next_offset )
+	 || ( stream->number_of_sequential_reads != expected_number_of_sequential_reads )
+	 || ( stream->prefetch_offset != expected_prefetch_offset ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected stream: %" PRIu64 " next offset: %" PRIi64 ", sequential reads: %d and prefetch offset: %" PRIi64 ".\n",
+		 stream_identifier,
+		 stream->next_offset,
+		 stream->number_of_sequential_reads,
+		 stream->prefetch_offset );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the tracking of streams
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_streams(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	uint64_t stream_identifiers[ MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS + 1 ];
+
+	int stream_index = 0;
+	int result       = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing streams\t" );
+
+	/* Every open stream gets a unique identifier
+	 */
+	for( stream_index = 0;
+	     ( result == 1 ) && ( stream_index <= MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS );
+	     stream_index++ )
+	{
+		result = mount_handle_open_stream(
+		          mount_handle,
+		          &( stream_identifiers[ stream_index ] ),
+		          error );
+
+		if( ( result == 1 )
+		 && ( stream_index > 0 )
+		 && ( stream_identifiers[ stream_index ] == stream_identifiers[ stream_index - 1 ] ) )
+		{
+			fprintf(
+			 stderr,
+			 "Stream identifier: %" PRIu64 " is not unique.\n",
+			 stream_identifiers[ stream_index ] );
+
+			result = 0;
+		}
+	}
+	/* Reading from more streams than can be tracked reuses the least recently used stream
+	 */
+	for( stream_index = 0;
+	     ( result == 1 ) && ( stream_index <= MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS );
+	     stream_index++ )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifiers[ stream_index ],
+		          (off64_t) stream_index * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( ewf_test_mount_handle_get_stream_index(
+	       mount_handle,
+	       stream_identifiers[ 0 ] ) != -1 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Least recently used stream is still tracked.\n" );
+
+		result = 0;
+	}
+	for( stream_index = 1;
+	     ( result == 1 ) && ( stream_index <= MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS );
+	     stream_index++ )
+	{
+		if( ewf_test_mount_handle_get_stream_index(
+		     mount_handle,
+		     stream_identifiers[ stream_index ] ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Stream: %" PRIu64 " is not tracked.\n",
+			 stream_identifiers[ stream_index ] );
+
+			result = 0;
+		}
+	}
+	/* A closed stream is no longer tracked
+	 */
+	for( stream_index = 0;
+	     stream_index <= MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( mount_handle_close_stream(
+		     mount_handle,
+		     stream_identifiers[ stream_index ],
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	for( stream_index = 0;
+	     ( result == 1 ) && ( stream_index <= MOUNT_HANDLE_MAXIMUM_NUMBER_OF_STREAMS );
+	     stream_index++ )
+	{
+		if( ewf_test_mount_handle_get_stream_index(
+		     mount_handle,
+		     stream_identifiers[ stream_index ] ) != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Closed stream: %" PRIu64 " is still tracked.\n",
+			 stream_identifiers[ stream_index ] );
+
+			result = 0;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The read value of the concurrent reads
+ */
+typedef struct ewf_test_mount_handle_read ewf_test_mount_handle_read_t;
+
+struct ewf_test_mount_handle_read
+{
+	/* The stream identifier
+	 */
+	uint64_t stream_identifier;
+
+	/* The offset
+	 */
+	off64_t offset;
+};
+
+/* The thread pool callback function for concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mount_handle_concurrent_callback_function(
+     ewf_test_mount_handle_read_t *read,
+     mount_handle_t *mount_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewf_test_mount_handle_concurrent_callback_function";
+	int result               = 0;
+
+	if( read == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read.",
+		 function );
+
+		goto on_error;
+	}
+	result = ewf_test_mount_handle_check_read(
+	          mount_handle,
+	          read->stream_identifier,
+	          read->offset,
+	          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read stream: %" PRIu64 " at offset: %" PRIi64 ".",
+		 function,
+		 read->stream_identifier,
+		 read->offset );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests concurrently reading multiple streams, while the streams are prefetched
+ * Every stream sequentially reads a part of the media, the reads of the streams are interleaved
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_read_concurrent(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	ewf_test_mount_handle_read_t reads[ EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE / EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ];
+	uint64_t stream_identifiers[ EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS ];
+
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int number_of_blocks                   = 0;
+	int number_of_blocks_per_stream        = 0;
+	int read_index                         = 0;
+	int result                             = 1;
+	int stream_index                       = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing concurrent read of streams\t" );
+
+	number_of_blocks            = (int) ( EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE / EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE );
+	number_of_blocks_per_stream = number_of_blocks / EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS;
+
+	for( stream_index = 0;
+	     ( result == 1 ) && ( stream_index < EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS );
+	     stream_index++ )
+	{
+		result = mount_handle_open_stream(
+		          mount_handle,
+		          &( stream_identifiers[ stream_index ] ),
+		          error );
+	}
+	for( read_index = 0;
+	     read_index < number_of_blocks;
+	     read_index++ )
+	{
+		stream_index = read_index % EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS;
+
+		reads[ read_index ].stream_identifier = stream_identifiers[ stream_index ];
+		reads[ read_index ].offset            = (off64_t) ( ( stream_index * number_of_blocks_per_stream ) + ( read_index / EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS ) ) * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE;
+	}
+	if( result == 1 )
+	{
+		result = libcthreads_thread_pool_create(
+		          &thread_pool,
+		          NULL,
+		          EWF_TEST_MOUNT_HANDLE_NUMBER_OF_THREADS,
+		          number_of_blocks,
+		          (int (*)(intptr_t *, void *)) &ewf_test_mount_handle_concurrent_callback_function,
+		          (void *) mount_handle,
+		          error );
+	}
+	for( read_index = 0;
+	     ( result == 1 ) && ( read_index < number_of_blocks );
+	     read_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) &( reads[ read_index ] ),
+		     error ) == -1 )
+		{
+			result = -1;
+		}
+	}
+	if( thread_pool != NULL )
+	{
+		/* The thread pool join fails if one of the callbacks failed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = 0;
+		}
+	}
+	for( stream_index = 0;
+	     stream_index < EWF_TEST_MOUNT_HANDLE_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( mount_handle_close_stream(
+		     mount_handle,
+		     stream_identifiers[ stream_index ],
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests that a sequentially read stream is not prefetched when the prefetch queue is full
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_prefetch_queue_full(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	uint64_t stream_identifier = 0;
+	int result                 = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing prefetch of sequential stream with full queue\t" );
+
+	/* No prefetches are queued at this point
+	 */
+	mount_handle->number_of_prefetches = MOUNT_HANDLE_MAXIMUM_NUMBER_OF_PREFETCHES;
+
+	result = mount_handle_open_stream(
+	          mount_handle,
+	          &stream_identifier,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          0,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	/* The read succeeds without queueing the prefetch window
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_stream(
+		          mount_handle,
+		          stream_identifier,
+		          2 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          MOUNT_HANDLE_SEQUENTIAL_READS_THRESHOLD,
+		          2 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE );
+	}
+	if( ( result == 1 )
+	 && ( mount_handle->number_of_prefetches != MOUNT_HANDLE_MAXIMUM_NUMBER_OF_PREFETCHES ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of prefetches: %d.\n",
+		 mount_handle->number_of_prefetches );
+
+		result = 0;
+	}
+	mount_handle->number_of_prefetches = 0;
+
+	if( stream_identifier != 0 )
+	{
+		if( mount_handle_close_stream(
+		     mount_handle,
+		     stream_identifier,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Tests the prefetching of a sequentially read stream
+ * The prefetch thread pool is joined by the test
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_mount_handle_prefetch(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	uint64_t values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
+	off64_t prefetch_offset         = 0;
+	off64_t read_offset             = 0;
+	uint64_t number_of_cache_misses = 0;
+	uint64_t stream_identifier      = 0;
+	int result                      = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing prefetch of sequential stream\t" );
+
+	result = mount_handle_open_stream(
+	          mount_handle,
+	          &stream_identifier,
+	          error );
+
+	/* The first read at offset 0 is sequential to the start of the stream
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          0,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_stream(
+		          mount_handle,
+		          stream_identifier,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          1,
+		          0 );
+	}
+	/* Once the threshold is reached both blocks of the prefetch window are queued
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		prefetch_offset = ( 2 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE ) + (off64_t) ( 2 * ( mount_handle->prefetch_size / 2 ) );
+
+		result = ewf_test_mount_handle_check_stream(
+		          mount_handle,
+		          stream_identifier,
+		          2 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          MOUNT_HANDLE_SEQUENTIAL_READS_THRESHOLD,
+		          prefetch_offset );
+	}
+	/* The next block is not queued until half of the prefetch window has been read
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          2 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_stream(
+		          mount_handle,
+		          stream_identifier,
+		          3 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          MOUNT_HANDLE_SEQUENTIAL_READS_THRESHOLD + 1,
+		          prefetch_offset );
+	}
+	/* A read that is not sequential resets the stream
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_read(
+		          mount_handle,
+		          stream_identifier,
+		          EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE - EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_mount_handle_check_stream(
+		          mount_handle,
+		          stream_identifier,
+		          EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE,
+		          0,
+		          0 );
+	}
+	/* Joining the prefetch thread pool waits for the queued prefetches to complete
+	 */
+	if( result == 1 )
+	{
+		result = libcthreads_thread_pool_join(
+		          &( mount_handle->prefetch_thread_pool ),
+		          error );
+	}
+	/* Every prefetch is released once it has been read
+	 */
+	if( ( result == 1 )
+	 && ( mount_handle->number_of_prefetches != 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of prefetches: %d.\n",
+		 mount_handle->number_of_prefetches );
+
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_statistics(
+		          mount_handle->input_handle,
+		          values,
+		          LIBEWF_NUMBER_OF_STATISTICS,
+		          error );
+	}
+	/* The prefetched data is read from the chunks cache
+	 */
+	if( result == 1 )
+	{
+		number_of_cache_misses = values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ];
+
+		for( read_offset = 3 * EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE;
+		     ( result == 1 ) && ( read_offset < prefetch_offset );
+		     read_offset += EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE )
+		{
+			result = ewf_test_mount_handle_check_read(
+			          mount_handle,
+			          0,
+			          read_offset,
+			          EWF_TEST_MOUNT_HANDLE_BUFFER_SIZE,
+			          error );
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_statistics(
+		          mount_handle->input_handle,
+		          values,
+		          LIBEWF_NUMBER_OF_STATISTICS,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ] != number_of_cache_misses ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected chunks cache misses: %" PRIu64 " reading prefetched data.\n",
+		 values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ] - number_of_cache_misses );
+
+		result = 0;
+	}
+	if( stream_identifier != 0 )
+	{
+		if( mount_handle_close_stream(
+		     mount_handle,
+		     stream_identifier,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcstring_system_character_t *filenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_mount_handle.E01" ) };
+
+	libcerror_error_t *error     = NULL;
+	mount_handle_t *mount_handle = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_mount_handle" ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     EWF_TEST_MOUNT_HANDLE_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     NULL,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write segment files.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_initialize(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_open_input(
+	     mount_handle,
+	     filenames,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open mount handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_mount_handle_read_at_offset(
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewf_test_mount_handle_prefetch_queue_full(
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_mount_handle_streams(
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_mount_handle_read_concurrent(
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_mount_handle_prefetch(
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		goto on_error;
+	}
+#endif
+	if( mount_handle_close(
+	     mount_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_free(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free mount handle.\n" );
+
+		goto on_error;
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_mount_handle" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( mount_handle != NULL )
+	{
+		mount_handle_close(
+		 mount_handle,
+		 NULL );
+		mount_handle_free(
+		 &mount_handle,
+		 NULL );
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_mount_handle" );
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1086 @@
+/*
+ * NBD server test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/mount_handle.h"
+#include "../ewftools/nbd_server.h"
+
+#define EWF_TEST_NBD_SERVER_EXIT_IGNORE		77
+
+#define EWF_TEST_NBD_SERVER_BUFFER_SIZE		4096
+#define EWF_TEST_NBD_SERVER_MEDIA_SIZE		( 1024 * 1024 )
+
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+
+/* The expected reply of a request
+ */
+typedef struct ewf_test_nbd_server_reply ewf_test_nbd_server_reply_t;
+
+struct ewf_test_nbd_server_reply
+{
+	/* The handle (cookie) of the request
+	 */
+	uint64_t handle;
+
+	/* The command of the request
+	 */
+	uint16_t command;
+
+	/* The offset of the request
+	 */
+	uint64_t offset;
+
+	/* The length of the request
+	 */
+	uint32_t length;
+
+	/* The expected error value
+	 */
+	uint32_t error_value;
+
+	/* Value to indicate the reply was received
+	 */
+	uint8_t is_received;
+};
+
+/* Appends an option to the client data
+ */
+void ewf_test_nbd_server_append_option(
+      uint8_t *client_data,
+      size_t *client_data_size,
+      uint32_t option,
+      const uint8_t *option_data,
+      uint32_t option_data_size )
+{
+	byte_stream_copy_from_uint64_big_endian(
+	 &( client_data[ *client_data_size ] ),
+	 NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ *client_data_size + 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ *client_data_size + 12 ] ),
+	 option_data_size );
+
+	*client_data_size += 16;
+
+	if( option_data_size > 0 )
+	{
+		memory_copy(
+		 &( client_data[ *client_data_size ] ),
+		 option_data,
+		 (size_t) option_data_size );
+
+		*client_data_size += (size_t) option_data_size;
+	}
+}
+
+/* Appends a request to the client data
+ */
+void ewf_test_nbd_server_append_request(
+      uint8_t *client_data,
+      size_t *client_data_size,
+      ewf_test_nbd_server_reply_t *reply )
+{
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ *client_data_size ] ),
+	 NBD_MAGIC_REQUEST );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( client_data[ *client_data_size + 4 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( client_data[ *client_data_size + 6 ] ),
+	 reply->command );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( client_data[ *client_data_size + 8 ] ),
+	 reply->handle );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( client_data[ *client_data_size + 16 ] ),
+	 reply->offset );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ *client_data_size + 24 ] ),
+	 reply->length );
+
+	*client_data_size += NBD_REQUEST_SIZE;
+
+	/* The data of a write request follows the request header
+	 */
+	if( reply->command == NBD_COMMAND_WRITE )
+	{
+		memory_set(
+		 &( client_data[ *client_data_size ] ),
+		 0xff,
+		 (size_t) reply->length );
+
+		*client_data_size += (size_t) reply->length;
+	}
+}
+
+/* Receives data from the server
+ * Returns 1 if successful, 0 if not all data was received or -1 on error
+ */
+int ewf_test_nbd_server_receive(
+     int socket_descriptor,
+     uint8_t *data,
+     size_t data_size )
+{
+	size_t data_offset = 0;
+	ssize_t read_count = 0;
+
+	while( data_offset < data_size )
+	{
+		read_count = read(
+		              socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset );
+
+		if( read_count < 0 )
+		{
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Receives an option reply from the server and checks its header
+ * Returns 1 if the reply matches, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_receive_option_reply(
+     int socket_descriptor,
+     uint32_t expected_option,
+     uint32_t expected_reply_type,
+     uint8_t *reply_data,
+     uint32_t expected_reply_data_size )
+{
+	uint8_t reply_header[ 20 ];
+
+	uint64_t magic           = 0;
+	uint32_t option          = 0;
+	uint32_t reply_data_size = 0;
+	uint32_t reply_type      = 0;
+	int result               = 0;
+
+	result = ewf_test_nbd_server_receive(
+	          socket_descriptor,
+	          reply_header,
+	          20 );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 magic );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 reply_data_size );
+
+	if( ( magic != NBD_MAGIC_OPTION_REPLY )
+	 || ( option != expected_option )
+	 || ( reply_type != expected_reply_type )
+	 || ( reply_data_size != expected_reply_data_size ) )
+	{
+		return( 0 );
+	}
+	if( reply_data_size > 0 )
+	{
+		result = ewf_test_nbd_server_receive(
+		          socket_descriptor,
+		          reply_data,
+		          (size_t) reply_data_size );
+	}
+	return( result );
+}
+
+/* Receives the replies of the information options INFO and GO
+ * Returns 1 if the replies match, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_receive_information_replies(
+     int socket_descriptor,
+     uint32_t option )
+{
+	uint8_t reply_data[ 14 ];
+
+	uint64_t value_64bit = 0;
+	uint32_t value_32bit = 0;
+	uint16_t value_16bit = 0;
+	int result           = 0;
+
+	result = ewf_test_nbd_server_receive_option_reply(
+	          socket_descriptor,
+	          option,
+	          NBD_REPLY_INFO,
+	          reply_data,
+	          12 );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 0 ] ),
+	 value_16bit );
+
+	if( value_16bit != NBD_INFO_EXPORT )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 2 ] ),
+	 value_64bit );
+
+	if( value_64bit != (uint64_t) EWF_TEST_NBD_SERVER_MEDIA_SIZE )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 10 ] ),
+	 value_16bit );
+
+	if( ( value_16bit & NBD_FLAG_READ_ONLY ) == 0 )
+	{
+		return( 0 );
+	}
+	result = ewf_test_nbd_server_receive_option_reply(
+	          socket_descriptor,
+	          option,
+	          NBD_REPLY_INFO,
+	          reply_data,
+	          14 );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 0 ] ),
+	 value_16bit );
+
+	if( value_16bit != NBD_INFO_BLOCK_SIZE )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 10 ] ),
+	 value_32bit );
+
+	if( value_32bit != NBD_SERVER_MAXIMUM_REQUEST_SIZE )
+	{
+		return( 0 );
+	}
+	return( ewf_test_nbd_server_receive_option_reply(
+	         socket_descriptor,
+	         option,
+	         NBD_REPLY_ACK,
+	         NULL,
+	         0 ) );
+}
+
+/* Receives the server handshake
+ * Returns 1 if the handshake matches, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_receive_handshake(
+     int socket_descriptor )
+{
+	uint8_t handshake_data[ 18 ];
+
+	uint64_t magic = 0;
+	uint16_t flags = 0;
+	int result     = 0;
+
+	result = ewf_test_nbd_server_receive(
+	          socket_descriptor,
+	          handshake_data,
+	          18 );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 magic );
+
+	if( magic != NBD_MAGIC_INITIAL )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 magic );
+
+	if( magic != NBD_MAGIC_OPTION )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 flags );
+
+	if( flags != ( NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Receives the simple replies of the transmission phase
+ * The replies of read requests can be received out of order and are matched by handle
+ * Returns 1 if the replies match, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_receive_simple_replies(
+     int socket_descriptor,
+     ewf_test_nbd_server_reply_t *replies,
+     int number_of_replies )
+{
+	uint8_t expected_data[ EWF_TEST_NBD_SERVER_BUFFER_SIZE ];
+	uint8_t reply_data[ EWF_TEST_NBD_SERVER_BUFFER_SIZE ];
+	uint8_t reply_header[ NBD_SIMPLE_REPLY_SIZE ];
+
+	ewf_test_nbd_server_reply_t *reply = NULL;
+	uint64_t handle                    = 0;
+	uint32_t error_value               = 0;
+	uint32_t magic                     = 0;
+	int reply_index                    = 0;
+	int reply_iterator                 = 0;
+	int result                         = 0;
+
+	for( reply_iterator = 0;
+	     reply_iterator < number_of_replies;
+	     reply_iterator++ )
+	{
+		result = ewf_test_nbd_server_receive(
+		          socket_descriptor,
+		          reply_header,
+		          NBD_SIMPLE_REPLY_SIZE );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( reply_header[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( reply_header[ 4 ] ),
+		 error_value );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( reply_header[ 8 ] ),
+		 handle );
+
+		if( magic != NBD_MAGIC_SIMPLE_REPLY )
+		{
+			return( 0 );
+		}
+		reply = NULL;
+
+		for( reply_index = 0;
+		     reply_index < number_of_replies;
+		     reply_index++ )
+		{
+			if( replies[ reply_index ].handle == handle )
+			{
+				reply = &( replies[ reply_index ] );
+
+				break;
+			}
+		}
+		if( ( reply == NULL )
+		 || ( reply->is_received != 0 )
+		 || ( reply->error_value != error_value ) )
+		{
+			return( 0 );
+		}
+		reply->is_received = 1;
+
+		if( ( reply->command == NBD_COMMAND_READ )
+		 && ( error_value == 0 ) )
+		{
+			result = ewf_test_nbd_server_receive(
+			          socket_descriptor,
+			          reply_data,
+			          (size_t) reply->length );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+			ewf_test_image_fill_buffer(
+			 expected_data,
+			 (size_t) reply->length,
+			 (off64_t) reply->offset,
+			 NULL );
+
+			if( memory_compare(
+			     reply_data,
+			     expected_data,
+			     (size_t) reply->length ) != 0 )
+			{
+				return( 0 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the option negotiation and the transmission of requests
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_transmission(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	ewf_test_nbd_server_reply_t replies[ 9 ] = {
+		/* Read at the start of the media
+		 */
+		{ 1, NBD_COMMAND_READ, 0, 4096, 0, 0 },
+		/* Read the end of the media
+		 */
+		{ 2, NBD_COMMAND_READ, EWF_TEST_NBD_SERVER_MEDIA_SIZE - 1000, 1000, 0, 0 },
+		/* Read across a chunk boundary
+		 */
+		{ 3, NBD_COMMAND_READ, 32768 - 1000, 3000, 0, 0 },
+		/* Write is not permitted and its data is discarded
+		 */
+		{ 4, NBD_COMMAND_WRITE, 0, 512, NBD_ERROR_PERMISSION, 0 },
+		/* Read beyond the end of the media
+		 */
+		{ 5, NBD_COMMAND_READ, EWF_TEST_NBD_SERVER_MEDIA_SIZE - 100, 200, NBD_ERROR_INVALID, 0 },
+		/* Read at an offset beyond the end of the media
+		 */
+		{ 6, NBD_COMMAND_READ, EWF_TEST_NBD_SERVER_MEDIA_SIZE + 4096, 512, NBD_ERROR_INVALID, 0 },
+		/* Read that exceeds the maximum request size
+		 */
+		{ 7, NBD_COMMAND_READ, 0, NBD_SERVER_MAXIMUM_REQUEST_SIZE + 512, NBD_ERROR_INVALID, 0 },
+		/* Read that directly follows the invalid requests
+		 */
+		{ 8, NBD_COMMAND_READ, 65536 + 17, 2048, 0, 0 },
+		{ 9, NBD_COMMAND_FLUSH, 0, 0, 0, 0 } };
+
+	uint8_t client_data[ 2048 ];
+	uint8_t option_data[ 6 ];
+	uint8_t reply_data[ 4 ];
+
+	ewf_test_nbd_server_reply_t disconnect_request = { 10, NBD_COMMAND_DISCONNECT, 0, 0, 0, 0 };
+	nbd_connection_t *nbd_connection               = NULL;
+	static char *function                          = "ewf_test_nbd_server_transmission";
+	size_t client_data_size                        = 0;
+	ssize_t write_count                            = 0;
+	int reply_index                                = 0;
+	int result                                     = 0;
+	int socket_descriptors[ 2 ]                    = { -1, -1 };
+
+	fprintf(
+	 stdout,
+	 "Testing transmission\t" );
+
+	if( socketpair(
+	     AF_UNIX,
+	     SOCK_STREAM,
+	     0,
+	     socket_descriptors ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create socket pair.",
+		 function );
+
+		goto on_error;
+	}
+	/* The connection takes over the server side of the socket pair
+	 */
+	if( nbd_connection_initialize(
+	     &nbd_connection,
+	     nbd_server,
+	     socket_descriptors[ 0 ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	socket_descriptors[ 0 ] = -1;
+
+	/* The client data is written in advance, it and the replies
+	 * fit in the socket buffers so the connection can run on this thread
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 0 ] ),
+	 NBD_FLAG_CLIENT_FIXED_NEWSTYLE | NBD_FLAG_CLIENT_NO_ZEROES );
+
+	client_data_size = 4;
+
+	memory_set(
+	 option_data,
+	 0,
+	 6 );
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 NBD_OPTION_LIST,
+	 NULL,
+	 0 );
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 99,
+	 NULL,
+	 0 );
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 NBD_OPTION_INFO,
+	 option_data,
+	 2 );
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 NBD_OPTION_INFO,
+	 option_data,
+	 6 );
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 NBD_OPTION_GO,
+	 option_data,
+	 6 );
+
+	for( reply_index = 0;
+	     reply_index < 9;
+	     reply_index++ )
+	{
+		ewf_test_nbd_server_append_request(
+		 client_data,
+		 &client_data_size,
+		 &( replies[ reply_index ] ) );
+	}
+	ewf_test_nbd_server_append_request(
+	 client_data,
+	 &client_data_size,
+	 &disconnect_request );
+
+	write_count = write(
+	               socket_descriptors[ 1 ],
+	               client_data,
+	               client_data_size );
+
+	if( write_count != (ssize_t) client_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write client data.",
+		 function );
+
+		goto on_error;
+	}
+	result = nbd_connection_run(
+	          nbd_connection );
+
+	/* Freeing the connection closes the server side of the socket pair
+	 * which makes a missing reply show up as end-of-file instead of blocking
+	 */
+	if( nbd_connection_free(
+	     &nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_handshake(
+		          socket_descriptors[ 1 ] );
+	}
+	else
+	{
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_option_reply(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_LIST,
+		          NBD_REPLY_SERVER,
+		          reply_data,
+		          4 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_option_reply(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_LIST,
+		          NBD_REPLY_ACK,
+		          NULL,
+		          0 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_option_reply(
+		          socket_descriptors[ 1 ],
+		          99,
+		          NBD_REPLY_ERROR_UNSUPPORTED,
+		          NULL,
+		          0 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_option_reply(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_INFO,
+		          NBD_REPLY_ERROR_INVALID,
+		          NULL,
+		          0 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_information_replies(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_INFO );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_information_replies(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_GO );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_simple_replies(
+		          socket_descriptors[ 1 ],
+		          replies,
+		          9 );
+	}
+	/* The disconnect request has no reply
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive(
+		          socket_descriptors[ 1 ],
+		          reply_data,
+		          1 );
+
+		result = ( result == 0 ) ? 1 : 0;
+	}
+	close(
+	 socket_descriptors[ 1 ] );
+
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+
+on_error:
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	return( -1 );
+}
+
+/* Tests aborting the option negotiation
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_nbd_server_abort(
+     nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	uint8_t client_data[ 32 ];
+
+	nbd_connection_t *nbd_connection = NULL;
+	static char *function            = "ewf_test_nbd_server_abort";
+	size_t client_data_size          = 0;
+	ssize_t write_count              = 0;
+	int result                       = 0;
+	int socket_descriptors[ 2 ]      = { -1, -1 };
+
+	fprintf(
+	 stdout,
+	 "Testing abort\t" );
+
+	if( socketpair(
+	     AF_UNIX,
+	     SOCK_STREAM,
+	     0,
+	     socket_descriptors ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create socket pair.",
+		 function );
+
+		goto on_error;
+	}
+	if( nbd_connection_initialize(
+	     &nbd_connection,
+	     nbd_server,
+	     socket_descriptors[ 0 ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	socket_descriptors[ 0 ] = -1;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 0 ] ),
+	 NBD_FLAG_CLIENT_FIXED_NEWSTYLE | NBD_FLAG_CLIENT_NO_ZEROES );
+
+	client_data_size = 4;
+
+	ewf_test_nbd_server_append_option(
+	 client_data,
+	 &client_data_size,
+	 NBD_OPTION_ABORT,
+	 NULL,
+	 0 );
+
+	write_count = write(
+	               socket_descriptors[ 1 ],
+	               client_data,
+	               client_data_size );
+
+	if( write_count != (ssize_t) client_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write client data.",
+		 function );
+
+		goto on_error;
+	}
+	/* An aborted negotiation is not an error
+	 */
+	result = nbd_connection_run(
+	          nbd_connection );
+
+	if( nbd_connection_free(
+	     &nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		result = ewf_test_nbd_server_receive_handshake(
+		          socket_descriptors[ 1 ] );
+	}
+	else
+	{
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive_option_reply(
+		          socket_descriptors[ 1 ],
+		          NBD_OPTION_ABORT,
+		          NBD_REPLY_ACK,
+		          NULL,
+		          0 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_receive(
+		          socket_descriptors[ 1 ],
+		          client_data,
+		          1 );
+
+		result = ( result == 0 ) ? 1 : 0;
+	}
+	close(
+	 socket_descriptors[ 1 ] );
+
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+
+on_error:
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_NBD_SERVER_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( HAVE_NBD_SERVER_SUPPORT )
+	libcstring_system_character_t *filenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_nbd_server.E01" ) };
+
+	libcerror_error_t *error     = NULL;
+	mount_handle_t *mount_handle = NULL;
+	nbd_server_t *nbd_server     = NULL;
+	int result                   = 0;
+#endif
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if !defined( HAVE_NBD_SERVER_SUPPORT )
+	return( EWF_TEST_NBD_SERVER_EXIT_IGNORE );
+#else
+	if( ewf_test_image_write(
+	     _LIBCSTRING_SYSTEM_STRING( "ewf_test_nbd_server" ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     EWF_TEST_NBD_SERVER_MEDIA_SIZE,
+	     0,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     NULL,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write segment files.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_initialize(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_open_input(
+	     mount_handle,
+	     filenames,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open mount handle.\n" );
+
+		goto on_error;
+	}
+	if( nbd_server_initialize(
+	     &nbd_server,
+	     mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create NBD server.\n" );
+
+		goto on_error;
+	}
+	result = ewf_test_nbd_server_transmission(
+	          nbd_server,
+	          &error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_nbd_server_abort(
+		          nbd_server,
+		          &error );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( nbd_server_free(
+	     &nbd_server,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free NBD server.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_close(
+	     mount_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_free(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free mount handle.\n" );
+
+		goto on_error;
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_nbd_server" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_server != NULL )
+	{
+		nbd_server_free(
+		 &nbd_server,
+		 NULL );
+	}
+	if( mount_handle != NULL )
+	{
+		mount_handle_close(
+		 mount_handle,
+		 NULL );
+		mount_handle_free(
+		 &mount_handle,
+		 NULL );
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_nbd_server" );
+
+	return( EXIT_FAILURE );
+#endif /* !defined( HAVE_NBD_SERVER_SUPPORT ) */
+}
+
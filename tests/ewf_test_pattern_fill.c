@@ -0,0 +1,384 @@
+/*
+ * Empty-block and pattern fill detection test and benchmark program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <time.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_simd.h"
+
+#define EWF_TEST_PATTERN_FILL_MAXIMUM_DATA_SIZE		( 2 * 1024 * 1024 )
+#define EWF_TEST_PATTERN_FILL_BENCHMARK_DATA_SIZE	( 256 * 1024 * 1024 )
+
+/* The instruction sets to test
+ */
+static int ewf_test_pattern_fill_instruction_sets[ 4 ] = {
+	LIBEWF_SIMD_INSTRUCTION_SET_NONE,
+	LIBEWF_SIMD_INSTRUCTION_SET_SSE2,
+	LIBEWF_SIMD_INSTRUCTION_SET_AVX2,
+	LIBEWF_SIMD_INSTRUCTION_SET_NEON };
+
+static const char *ewf_test_pattern_fill_instruction_set_names[ 4 ] = {
+	"generic",
+	"SSE2",
+	"AVX2",
+	"NEON" };
+
+/* Tests the pattern fill detection of all supported instruction sets on specific data
+ * The expected result is determined byte by byte
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_pattern_fill_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	libcerror_error_t *error  = NULL;
+	size_t data_offset        = 0;
+	int expected_result       = 1;
+	int instruction_set_index = 0;
+	int instruction_sets      = 0;
+	int result                = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		if( data[ data_offset ] != (uint8_t) ( pattern >> ( ( data_offset % 8 ) * 8 ) ) )
+		{
+			expected_result = 0;
+
+			break;
+		}
+	}
+	instruction_sets = libewf_simd_get_supported_instruction_sets();
+
+	for( instruction_set_index = 0;
+	     instruction_set_index < 4;
+	     instruction_set_index++ )
+	{
+		if( ( ewf_test_pattern_fill_instruction_sets[ instruction_set_index ] != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+		 && ( ( instruction_sets & ewf_test_pattern_fill_instruction_sets[ instruction_set_index ] ) == 0 ) )
+		{
+			continue;
+		}
+		result = libewf_simd_check_for_64_bit_pattern_fill(
+		          data,
+		          data_size,
+		          pattern,
+		          ewf_test_pattern_fill_instruction_sets[ instruction_set_index ],
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+		if( result != expected_result )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected %s result: %d for data size: %" PRIzd ".\n",
+			 ewf_test_pattern_fill_instruction_set_names[ instruction_set_index ],
+			 result,
+			 data_size );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the pattern fill detection
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_pattern_fill(
+     uint8_t *buffer )
+{
+	size_t data_offset  = 0;
+	size_t data_size    = 0;
+	size_t start_offset = 0;
+	uint64_t pattern    = 0;
+	int result          = 0;
+
+	for( data_size = 0;
+	     data_size <= 1024;
+	     data_size += ( data_size < 160 ) ? 1 : 61 )
+	{
+		/* Test the different alignments of the data
+		 */
+		for( start_offset = 0;
+		     start_offset < 16;
+		     start_offset++ )
+		{
+			pattern = ( data_size % 3 ) == 0 ? 0 : 0x0706050403020100ULL + data_size;
+
+			for( data_offset = 0;
+			     data_offset < data_size;
+			     data_offset++ )
+			{
+				buffer[ start_offset + data_offset ] = (uint8_t) ( pattern >> ( ( data_offset % 8 ) * 8 ) );
+			}
+			result = ewf_test_pattern_fill_data(
+			          &( buffer[ start_offset ] ),
+			          data_size,
+			          pattern );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+			if( data_size == 0 )
+			{
+				continue;
+			}
+			/* Test a mismatch in the first, middle and last byte
+			 */
+			for( data_offset = 0;
+			     data_offset < data_size;
+			     data_offset += ( data_size / 2 ) + ( data_size == 1 ) )
+			{
+				buffer[ start_offset + data_offset ] ^= 0x01;
+
+				result = ewf_test_pattern_fill_data(
+				          &( buffer[ start_offset ] ),
+				          data_size,
+				          pattern );
+
+				buffer[ start_offset + data_offset ] ^= 0x01;
+
+				if( result != 1 )
+				{
+					return( result );
+				}
+			}
+			buffer[ start_offset + data_size - 1 ] ^= 0x80;
+
+			result = ewf_test_pattern_fill_data(
+			          &( buffer[ start_offset ] ),
+			          data_size,
+			          pattern );
+
+			buffer[ start_offset + data_size - 1 ] ^= 0x80;
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Benchmarks the empty-block detection of all supported instruction sets
+ * for chunk sizes of 32 KiB up to 2 MiB
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_pattern_fill_benchmark(
+     uint8_t *buffer )
+{
+	libcerror_error_t *error  = NULL;
+	clock_t end_time          = 0;
+	clock_t start_time        = 0;
+	double elapsed_time       = 0.0;
+	double generic_time       = 0.0;
+	size_t chunk_size         = 0;
+	int instruction_set_index = 0;
+	int instruction_sets      = 0;
+	int iteration             = 0;
+	int number_of_iterations  = 0;
+
+	if( memory_set(
+	     buffer,
+	     0,
+	     EWF_TEST_PATTERN_FILL_MAXIMUM_DATA_SIZE ) == NULL )
+	{
+		return( -1 );
+	}
+	instruction_sets = libewf_simd_get_supported_instruction_sets();
+
+	fprintf(
+	 stdout,
+	 "Chunk size\tInstruction set\tMiB/s\t\tSpeed-up\n" );
+
+	for( chunk_size = 32 * 1024;
+	     chunk_size <= EWF_TEST_PATTERN_FILL_MAXIMUM_DATA_SIZE;
+	     chunk_size *= 2 )
+	{
+		number_of_iterations = (int) ( EWF_TEST_PATTERN_FILL_BENCHMARK_DATA_SIZE / chunk_size );
+
+		for( instruction_set_index = 0;
+		     instruction_set_index < 4;
+		     instruction_set_index++ )
+		{
+			if( ( ewf_test_pattern_fill_instruction_sets[ instruction_set_index ] != LIBEWF_SIMD_INSTRUCTION_SET_NONE )
+			 && ( ( instruction_sets & ewf_test_pattern_fill_instruction_sets[ instruction_set_index ] ) == 0 ) )
+			{
+				continue;
+			}
+			start_time = clock();
+
+			for( iteration = 0;
+			     iteration < number_of_iterations;
+			     iteration++ )
+			{
+				/* An empty-block of the chunk size is the worst case since all data is compared
+				 */
+				if( libewf_simd_check_for_64_bit_pattern_fill(
+				     buffer,
+				     chunk_size,
+				     0,
+				     ewf_test_pattern_fill_instruction_sets[ instruction_set_index ],
+				     &error ) != 1 )
+				{
+					libcerror_error_backtrace_fprint(
+					 error,
+					 stderr );
+
+					libcerror_error_free(
+					 &error );
+
+					return( -1 );
+				}
+			}
+			end_time = clock();
+
+			elapsed_time = (double) ( end_time - start_time ) / CLOCKS_PER_SEC;
+
+			if( elapsed_time <= 0.0 )
+			{
+				elapsed_time = 1.0 / CLOCKS_PER_SEC;
+			}
+			if( instruction_set_index == 0 )
+			{
+				generic_time = elapsed_time;
+			}
+			fprintf(
+			 stdout,
+			 "%" PRIzd " KiB\t\t%s\t\t%.1f\t\t%.2fx\n",
+			 chunk_size / 1024,
+			 ewf_test_pattern_fill_instruction_set_names[ instruction_set_index ],
+			 (double) EWF_TEST_PATTERN_FILL_BENCHMARK_DATA_SIZE / ( 1024 * 1024 ) / elapsed_time,
+			 generic_time / elapsed_time );
+		}
+	}
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint8_t *buffer                    = NULL;
+	libcstring_system_integer_t option = 0;
+	int run_benchmark                  = 0;
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _LIBCSTRING_SYSTEM_STRING( "b" ) ) ) != (libcstring_system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (libcstring_system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (libcstring_system_integer_t) 'b':
+				run_benchmark = 1;
+
+				break;
+		}
+	}
+	/* Add room to test the different alignments of the data
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_PATTERN_FILL_MAXIMUM_DATA_SIZE + 16 );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_pattern_fill(
+	     buffer ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test pattern fill.\n" );
+
+		goto on_error;
+	}
+	if( run_benchmark != 0 )
+	{
+		if( ewf_test_pattern_fill_benchmark(
+		     buffer ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark pattern fill.\n" );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -21,11 +21,14 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include <stdio.h>
+
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libcstring.h"
 #include "ewf_test_libcsystem.h"
@@ -33,12 +36,34 @@
 #include "ewf_test_libewf.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_definitions.h"
+
 /* Define to make ewf_test_read generate verbose output
 #define EWF_TEST_READ_VERBOSE
  */
 
 #define EWF_TEST_READ_BUFFER_SIZE		4096
 #define EWF_TEST_READ_NUMBER_OF_THREADS		4
+#define EWF_TEST_READ_AHEAD_DEPTH		16
+#define EWF_TEST_READ_CHUNKS_CACHE_SIZE		1024
+
+#define EWF_TEST_READ_ROUND_TRIP_MAXIMUM_SIZE		( 4 * 1024 * 1024 )
+
+/* The vectored read tests add one request per chunk for more chunks
+ * than a vectored read holds at the same time
+ */
+#define EWF_TEST_READ_VECTOR_NUMBER_OF_CHUNKS		( ( 2 * LIBEWF_READ_VECTOR_MAXIMUM_NUMBER_OF_CHUNKS ) + 3 )
+#define EWF_TEST_READ_VECTOR_MAXIMUM_NUMBER_OF_BUFFERS	( EWF_TEST_READ_VECTOR_NUMBER_OF_CHUNKS + 16 )
+#define EWF_TEST_READ_VECTOR_SECTORS_PER_CHUNK		64
+#define EWF_TEST_READ_VECTOR_MEDIA_SIZE			( ( (size64_t) EWF_TEST_READ_VECTOR_NUMBER_OF_CHUNKS * EWF_TEST_READ_VECTOR_SECTORS_PER_CHUNK * 512 ) - 1000 )
+#define EWF_TEST_READ_VECTOR_FILL_BYTE			0xa5
+
+/* The library only supports direct IO with the POSIX positional read and write
+ * functions and aligned memory allocation, refer to libewf_direct_io_handle.h
+ */
+#if !defined( WINAPI ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && defined( HAVE_STAT )
+#define EWF_TEST_READ_HAVE_DIRECT_IO
+#endif
 
 /* Tests libewf_handle_seek_offset
  * Returns 1 if successful, 0 if not or -1 on error
@@ -582,234 +607,185 @@ int ewf_test_read_from_handle(
 	return( 1 );
 }
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-
-/* The thread pool callback function
+/* Opens a handle
  * Returns 1 if successful or -1 on error
  */
-int ewf_test_read_callback_function(
-     libewf_handle_t *handle,
-     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+int ewf_test_read_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
 {
-	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
-
-	libcerror_error_t *error = NULL;
-	static char *function    = "ewf_test_read_callback_function";
-	off64_t read_offset      = 0;
-	size_t read_size         = EWF_TEST_READ_BUFFER_SIZE;
-	ssize_t read_count       = 0;
-	int number_of_iterations = 3;
-
-	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
-
-	if( handle == NULL )
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		goto on_error;
+		return( -1 );
 	}
-	while( number_of_iterations > 0 )
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     access_flags,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     access_flags,
+	     error ) != 1 )
+#endif
 	{
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              read_size,
-		              &error );
-
-		if( read_count != (ssize_t) read_size )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read from handle.",
-			 function );
-
-			goto on_error;
-		}
-		number_of_iterations--;
-
-		if( number_of_iterations > 0 )
-		{
-			read_offset = -1 * (off64_t) read_size;
-
-			if( libewf_handle_seek_offset(
-			     handle,
-			     read_offset,
-			     SEEK_CUR,
-			     &error ) == -1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_SEEK_FAILED,
-				 "%s: unable to seek in handle.",
-				 function );
+		libewf_handle_free(
+		 handle,
+		 NULL );
 
-				goto on_error;
-			}
-		}
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_backtrace_fprint(
-		 error,
-		 stderr );
-
-		libcerror_error_free(
-		 &error );
-	}
-	return( -1 );
 }
 
-/* Tests reading data from a handle in multiple threads
- * This test requires multi-threading support
+/* Tests if sequentially reading with read-ahead returns the same data as reading at offsets
+ * The chunk groups cache is reduced so that the read-ahead has to read the chunk groups
+ * again when it crosses a chunk group boundary
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int ewf_test_read_from_handle_multi_thread(
+int ewf_test_read_ahead_compare(
      libewf_handle_t *handle,
-     size64_t media_size,
-     int number_of_threads )
+     libewf_handle_t *reference_handle,
+     size64_t media_size )
 {
-	libcerror_error_t *error               = NULL;
-	libcthreads_thread_pool_t *thread_pool = NULL;
-	static char *function                  = "ewf_test_read_from_handle_multi_thread";
-	off64_t expected_offset                = 0;
-	off64_t result_offset                  = 0;
-	int iteration                          = 0;
-	int number_of_iterations               = 0;
-	int result                             = 0;
+	libcerror_error_t *error     = NULL;
+	uint8_t *buffer              = NULL;
+	uint8_t *reference_buffer    = NULL;
+	off64_t read_offset          = 0;
+	size32_t chunk_size          = 0;
+	ssize_t read_count           = 0;
+	ssize_t reference_read_count = 0;
+	int result                   = 1;
 
 	if( handle == NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_handle_seek_offset(
-	     handle,
-	     0,
-	     SEEK_SET,
-	     &error ) == -1 )
+	if( reference_handle == NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek in handle.",
-		 function );
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing reading with read-ahead across chunk groups\t" );
 
-		goto on_error;
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		result = -1;
 	}
-	if( number_of_threads > 1 )
+	else if( chunk_size == 0 )
 	{
-		number_of_iterations = number_of_threads * 32;
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * chunk_size );
 
-		expected_offset = (off64_t) number_of_iterations * EWF_TEST_READ_BUFFER_SIZE;
+		reference_buffer = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * chunk_size );
 
-		if( (size64_t) expected_offset > media_size )
+		if( ( buffer == NULL )
+		 || ( reference_buffer == NULL ) )
 		{
-			expected_offset = (off64_t) media_size;
-
-			number_of_iterations = (int) ( media_size / EWF_TEST_READ_BUFFER_SIZE );
-
-			if( ( media_size % EWF_TEST_READ_BUFFER_SIZE ) != 0 )
-			{
-				number_of_iterations += 1;
-			}
+			result = -1;
 		}
-		if( libcthreads_thread_pool_create(
-		     &thread_pool,
-		     NULL,
-		     number_of_threads,
-		     number_of_iterations,
-		     (int (*)(intptr_t *, void *)) &ewf_test_read_callback_function,
-		     NULL,
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_chunk_groups_cache_size(
+		     handle,
+		     1,
 		     &error ) != 1 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create thread pool.",
-			 function );
-
-			goto on_error;
+			result = -1;
 		}
-		for( iteration = 0;
-		     iteration < number_of_iterations;
-		     iteration++ )
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_read_ahead(
+		     handle,
+		     EWF_TEST_READ_AHEAD_DEPTH,
+		     EWF_TEST_READ_NUMBER_OF_THREADS,
+		     &error ) != 1 )
 		{
-			if( libcthreads_thread_pool_push(
-			     thread_pool,
-			     (intptr_t *) handle,
-			     &error ) == -1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push handle onto queue.",
-				 function );
-
-				goto on_error;
-			}
+			result = -1;
 		}
-		if( libcthreads_thread_pool_join(
-		     &thread_pool,
-		     &error ) != 1 )
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_seek_offset(
+		     handle,
+		     0,
+		     SEEK_SET,
+		     &error ) != 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join thread pool.",
-			 function );
-
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_handle_get_offset(
-	     handle,
-	     &result_offset,
-	     &error ) != 1 )
+	while( ( result == 1 )
+	    && ( (size64_t) read_offset < media_size ) )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve offset.",
-		 function );
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              (size_t) chunk_size,
+		              &error );
 
-		goto on_error;
-	}
-	fprintf(
-	 stdout,
-	 "Testing multi-threaded read buffer at offset: 0\t" );
+		reference_read_count = libewf_handle_read_buffer_at_offset(
+		                        reference_handle,
+		                        reference_buffer,
+		                        (size_t) chunk_size,
+		                        read_offset,
+		                        &error );
 
-	if( expected_offset != result_offset )
+		if( ( read_count <= 0 )
+		 || ( read_count != reference_read_count ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read count: %" PRIzd " at offset: %" PRIi64 "\n",
+			 read_count,
+			 read_offset );
+
+			result = 0;
+		}
+		else if( memory_compare(
+		          buffer,
+		          reference_buffer,
+		          (size_t) read_count ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 "\n",
+			 read_offset );
+
+			result = 0;
+		}
+		read_offset += (off64_t) read_count;
+	}
+	if( reference_buffer != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unexpected offset: %" PRIi64 "\n",
-		 result_offset );
+		memory_free(
+		 reference_buffer );
 	}
-	else
+	if( buffer != NULL )
 	{
-		result = 1;
+		memory_free(
+		 buffer );
 	}
 	if( result == 1 )
 	{
@@ -827,15 +803,1450 @@ int ewf_test_read_from_handle_multi_thread(
 	 stdout,
 	 "\n" );
 
-	return( result );
-
-on_error:
 	if( error != NULL )
 	{
-		libcerror_error_backtrace_fprint(
-		 error,
-		 stderr );
-
+		if( result != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests libewf_handle_read_vector
+ * The requests overlap, cross chunk boundaries, are out of range or empty and
+ * one request is added per chunk in reverse order, the data of every request is
+ * compared with the data read with libewf_handle_read_buffer_at_offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_vector(
+     libewf_handle_t *handle,
+     libewf_handle_t *reference_handle,
+     size64_t media_size,
+     int number_of_threads )
+{
+	uint8_t *buffers[ EWF_TEST_READ_VECTOR_MAXIMUM_NUMBER_OF_BUFFERS ];
+	size_t buffer_sizes[ EWF_TEST_READ_VECTOR_MAXIMUM_NUMBER_OF_BUFFERS ];
+	off64_t offsets[ EWF_TEST_READ_VECTOR_MAXIMUM_NUMBER_OF_BUFFERS ];
+
+	libcerror_error_t *error      = NULL;
+	uint8_t *reference_buffer     = NULL;
+	off64_t current_offset        = 0;
+	off64_t invalid_offset        = -1;
+	off64_t result_offset         = 0;
+	size32_t chunk_size           = 0;
+	size_t byte_index             = 0;
+	size_t expected_size          = 0;
+	size_t maximum_size           = 0;
+	ssize_t expected_read_count   = 0;
+	ssize_t read_count            = 0;
+	uint64_t chunk_index          = 0;
+	uint64_t number_of_chunks     = 0;
+	int buffer_index              = 0;
+	int number_of_buffers         = 0;
+	int result                    = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( reference_handle == NULL )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing read vector with number of threads: %d\t",
+	 number_of_threads );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_READ_VECTOR_MAXIMUM_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ]      = NULL;
+		buffer_sizes[ buffer_index ] = 0;
+		offsets[ buffer_index ]      = 0;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( chunk_size == 0 )
+	{
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		/* Overlapping and duplicate requests
+		 */
+		offsets[ 0 ]      = 0;
+		buffer_sizes[ 0 ] = (size_t) ( chunk_size / 2 );
+		offsets[ 1 ]      = (off64_t) ( chunk_size / 4 );
+		buffer_sizes[ 1 ] = (size_t) chunk_size;
+		offsets[ 2 ]      = 0;
+		buffer_sizes[ 2 ] = (size_t) ( chunk_size / 2 );
+
+		/* Requests that cross chunk boundaries
+		 */
+		offsets[ 3 ]      = (off64_t) chunk_size - 100;
+		buffer_sizes[ 3 ] = 200;
+		offsets[ 4 ]      = ( 2 * (off64_t) chunk_size ) - 1;
+		buffer_sizes[ 4 ] = (size_t) chunk_size + 2;
+		offsets[ 5 ]      = (off64_t) ( chunk_size / 2 );
+		buffer_sizes[ 5 ] = 3 * (size_t) chunk_size;
+
+		/* A request that is truncated at the end of the media data
+		 */
+		if( media_size > 100 )
+		{
+			offsets[ 6 ] = (off64_t) media_size - 100;
+		}
+		buffer_sizes[ 6 ] = EWF_TEST_READ_BUFFER_SIZE;
+
+		/* Out-of-range and zero-size requests, the last one without a buffer
+		 */
+		offsets[ 7 ]      = (off64_t) media_size;
+		buffer_sizes[ 7 ] = 100;
+		offsets[ 8 ]      = (off64_t) ( media_size + chunk_size );
+		buffer_sizes[ 8 ] = 10;
+		offsets[ 9 ]      = (off64_t) chunk_size;
+		buffer_sizes[ 9 ] = 0;
+		offsets[ 10 ]      = 0;
+		buffer_sizes[ 10 ] = 0;
+
+		number_of_buffers = 11;
+
+		/* One request per chunk in reverse order so that the requests span more chunks
+		 * than a vectored read holds at the same time
+		 */
+		number_of_chunks = media_size / chunk_size;
+
+		if( ( media_size % chunk_size ) != 0 )
+		{
+			number_of_chunks += 1;
+		}
+		if( number_of_chunks > EWF_TEST_READ_VECTOR_NUMBER_OF_CHUNKS )
+		{
+			number_of_chunks = EWF_TEST_READ_VECTOR_NUMBER_OF_CHUNKS;
+		}
+		for( chunk_index = number_of_chunks;
+		     chunk_index > 0;
+		     chunk_index-- )
+		{
+			offsets[ number_of_buffers ]      = (off64_t) ( ( ( chunk_index - 1 ) * chunk_size ) + ( ( chunk_index * 13 ) % 256 ) );
+			buffer_sizes[ number_of_buffers ] = 64;
+
+			number_of_buffers++;
+		}
+	}
+	/* Every buffer has a trailing byte to detect data written beyond the request
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( result != 1 )
+		{
+			break;
+		}
+		if( buffer_index == 10 )
+		{
+			continue;
+		}
+		buffers[ buffer_index ] = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * ( buffer_sizes[ buffer_index ] + 1 ) );
+
+		if( buffers[ buffer_index ] == NULL )
+		{
+			result = -1;
+		}
+		else if( memory_set(
+		          buffers[ buffer_index ],
+		          EWF_TEST_READ_VECTOR_FILL_BYTE,
+		          buffer_sizes[ buffer_index ] + 1 ) == NULL )
+		{
+			result = -1;
+		}
+		if( buffer_sizes[ buffer_index ] > maximum_size )
+		{
+			maximum_size = buffer_sizes[ buffer_index ];
+		}
+	}
+	if( result == 1 )
+	{
+		reference_buffer = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * maximum_size );
+
+		if( reference_buffer == NULL )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_offset(
+		     handle,
+		     &current_offset,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		read_count = libewf_handle_read_vector(
+		              handle,
+		              (void **) buffers,
+		              buffer_sizes,
+		              offsets,
+		              number_of_buffers,
+		              number_of_threads,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			result = -1;
+		}
+	}
+	/* A vectored read is not expected to change the current offset
+	 */
+	if( result == 1 )
+	{
+		if( libewf_handle_get_offset(
+		     handle,
+		     &result_offset,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+		else if( result_offset != current_offset )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected offset: %" PRIi64 "\n",
+			 result_offset );
+
+			result = 0;
+		}
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( result != 1 )
+		{
+			break;
+		}
+		expected_size = 0;
+
+		if( (size64_t) offsets[ buffer_index ] < media_size )
+		{
+			expected_size = buffer_sizes[ buffer_index ];
+
+			if( (size64_t) expected_size > ( media_size - offsets[ buffer_index ] ) )
+			{
+				expected_size = (size_t) ( media_size - offsets[ buffer_index ] );
+			}
+		}
+		expected_read_count += (ssize_t) expected_size;
+
+		if( expected_size > 0 )
+		{
+			if( libewf_handle_read_buffer_at_offset(
+			     reference_handle,
+			     reference_buffer,
+			     expected_size,
+			     offsets[ buffer_index ],
+			     &error ) != (ssize_t) expected_size )
+			{
+				result = -1;
+			}
+			else if( memory_compare(
+			          buffers[ buffer_index ],
+			          reference_buffer,
+			          expected_size ) != 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch in data of request: %d at offset: %" PRIi64 "\n",
+				 buffer_index,
+				 offsets[ buffer_index ] );
+
+				result = 0;
+			}
+		}
+		if( buffers[ buffer_index ] != NULL )
+		{
+			for( byte_index = expected_size;
+			     byte_index <= buffer_sizes[ buffer_index ];
+			     byte_index++ )
+			{
+				if( buffers[ buffer_index ][ byte_index ] != EWF_TEST_READ_VECTOR_FILL_BYTE )
+				{
+					fprintf(
+					 stderr,
+					 "Data written beyond request: %d at offset: %" PRIi64 "\n",
+					 buffer_index,
+					 offsets[ buffer_index ] );
+
+					result = 0;
+
+					break;
+				}
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		if( read_count != expected_read_count )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read count: %" PRIzd "\n",
+			 read_count );
+
+			result = 0;
+		}
+	}
+	/* A request with a negative offset is expected to fail
+	 */
+	if( result == 1 )
+	{
+		read_count = libewf_handle_read_vector(
+		              handle,
+		              (void **) buffers,
+		              buffer_sizes,
+		              &invalid_offset,
+		              1,
+		              number_of_threads,
+		              &error );
+
+		if( read_count != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read count: %" PRIzd " for negative offset\n",
+			 read_count );
+
+			result = 0;
+		}
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] != NULL )
+		{
+			memory_free(
+			 buffers[ buffer_index ] );
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		if( result != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests libewf_handle_read_vector on a written image with more chunks than
+ * a vectored read holds at the same time and a partial last chunk
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_vector_image(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+
+	libcstring_system_character_t *filenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_read_vector.E01" ) };
+
+	libcstring_system_character_t *basenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_read_vector" ) };
+
+	libcerror_error_t *error          = NULL;
+	libewf_handle_t *handle           = NULL;
+	libewf_handle_t *reference_handle = NULL;
+	off64_t write_offset              = 0;
+	size64_t media_size               = 0;
+	size_t buffer_index               = 0;
+	size_t write_size                 = 0;
+	int result                        = 1;
+
+	if( ewf_test_read_open_handle(
+	     basenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &handle,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_format(
+		     handle,
+		     LIBEWF_FORMAT_ENCASE6,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_sectors_per_chunk(
+		     handle,
+		     EWF_TEST_READ_VECTOR_SECTORS_PER_CHUNK,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_media_size(
+		     handle,
+		     EWF_TEST_READ_VECTOR_MEDIA_SIZE,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_compression_values(
+		     handle,
+		     LIBEWF_COMPRESSION_FAST,
+		     0,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	while( ( result == 1 )
+	    && ( write_offset < (off64_t) EWF_TEST_READ_VECTOR_MEDIA_SIZE ) )
+	{
+		write_size = EWF_TEST_READ_BUFFER_SIZE;
+
+		if( (size64_t) write_size > ( EWF_TEST_READ_VECTOR_MEDIA_SIZE - write_offset ) )
+		{
+			write_size = (size_t) ( EWF_TEST_READ_VECTOR_MEDIA_SIZE - write_offset );
+		}
+		/* The data differs per chunk so that misplaced chunk data is detected
+		 */
+		for( buffer_index = 0;
+		     buffer_index < write_size;
+		     buffer_index++ )
+		{
+			buffer[ buffer_index ] = (uint8_t) ( ( ( write_offset + buffer_index ) % 251 ) ^ ( ( write_offset + buffer_index ) >> 15 ) );
+		}
+		if( libewf_handle_write_buffer(
+		     handle,
+		     buffer,
+		     write_size,
+		     &error ) != (ssize_t) write_size )
+		{
+			result = -1;
+		}
+		write_offset += (off64_t) write_size;
+	}
+	if( handle != NULL )
+	{
+		if( libewf_handle_close(
+		     handle,
+		     ( result == 1 ) ? &error : NULL ) != 0 )
+		{
+			result = -1;
+		}
+		if( libewf_handle_free(
+		     &handle,
+		     ( result == 1 ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( ewf_test_read_open_handle(
+		     filenames,
+		     1,
+		     LIBEWF_OPEN_READ,
+		     &handle,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( ewf_test_read_open_handle(
+		     filenames,
+		     1,
+		     LIBEWF_OPEN_READ,
+		     &reference_handle,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_media_size(
+		     handle,
+		     &media_size,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+		else if( media_size != EWF_TEST_READ_VECTOR_MEDIA_SIZE )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected media size: %" PRIu64 "\n",
+			 media_size );
+
+			result = 0;
+		}
+	}
+	if( error != NULL )
+	{
+		if( result != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_read_vector(
+		          handle,
+		          reference_handle,
+		          media_size,
+		          0 );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_read_vector(
+		          handle,
+		          reference_handle,
+		          media_size,
+		          EWF_TEST_READ_NUMBER_OF_THREADS );
+	}
+	if( reference_handle != NULL )
+	{
+		libewf_handle_close(
+		 reference_handle,
+		 NULL );
+		libewf_handle_free(
+		 &reference_handle,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	remove(
+	 "ewf_test_read_vector.E01" );
+
+	return( result );
+}
+
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL ) || defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+
+/* Tests writing the (media) data of a handle using a compression method and reading it back
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_compression_method_round_trip(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     uint16_t compression_method )
+{
+	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+	uint8_t round_trip_buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+
+	libcstring_system_character_t *filenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_read_round_trip.Ex01" ) };
+
+	libcstring_system_character_t *basenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_read_round_trip" ) };
+
+	libcerror_error_t *error           = NULL;
+	libewf_handle_t *round_trip_handle = NULL;
+	off64_t read_offset                = 0;
+	size64_t round_trip_media_size     = 0;
+	size_t read_size                   = 0;
+	ssize_t read_count                 = 0;
+	int result                         = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing write and read with compression method: 0x%04" PRIx16 "\t",
+	 compression_method );
+
+	round_trip_media_size = media_size;
+
+	if( round_trip_media_size > EWF_TEST_READ_ROUND_TRIP_MAXIMUM_SIZE )
+	{
+		round_trip_media_size = EWF_TEST_READ_ROUND_TRIP_MAXIMUM_SIZE;
+	}
+	if( libewf_handle_initialize(
+	     &round_trip_handle,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	if( result == 1 )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     round_trip_handle,
+		     basenames,
+		     1,
+		     LIBEWF_OPEN_WRITE,
+		     &error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     round_trip_handle,
+		     basenames,
+		     1,
+		     LIBEWF_OPEN_WRITE,
+		     &error ) != 1 )
+#endif
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_media_size(
+		     round_trip_handle,
+		     round_trip_media_size,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_format(
+		     round_trip_handle,
+		     LIBEWF_FORMAT_V2_ENCASE7,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_compression_method(
+		     round_trip_handle,
+		     compression_method,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_set_compression_values(
+		     round_trip_handle,
+		     LIBEWF_COMPRESSION_FAST,
+		     0,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	while( ( result == 1 )
+	    && ( (size64_t) read_offset < round_trip_media_size ) )
+	{
+		read_size = EWF_TEST_READ_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( round_trip_media_size - read_offset ) )
+		{
+			read_size = (size_t) ( round_trip_media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		else if( libewf_handle_write_buffer(
+		          round_trip_handle,
+		          buffer,
+		          read_size,
+		          &error ) != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		read_offset += (off64_t) read_size;
+	}
+	if( round_trip_handle != NULL )
+	{
+		if( libewf_handle_close(
+		     round_trip_handle,
+		     ( result == 1 ) ? &error : NULL ) != 0 )
+		{
+			result = -1;
+		}
+		if( libewf_handle_free(
+		     &round_trip_handle,
+		     ( result == 1 ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_initialize(
+		     &round_trip_handle,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     round_trip_handle,
+		     filenames,
+		     1,
+		     LIBEWF_OPEN_READ,
+		     &error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     round_trip_handle,
+		     filenames,
+		     1,
+		     LIBEWF_OPEN_READ,
+		     &error ) != 1 )
+#endif
+		{
+			result = -1;
+		}
+	}
+	read_offset = 0;
+
+	while( ( result == 1 )
+	    && ( (size64_t) read_offset < round_trip_media_size ) )
+	{
+		read_size = EWF_TEST_READ_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( round_trip_media_size - read_offset ) )
+		{
+			read_size = (size_t) ( round_trip_media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		else if( libewf_handle_read_buffer_at_offset(
+		          round_trip_handle,
+		          round_trip_buffer,
+		          read_size,
+		          read_offset,
+		          &error ) != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		else if( memory_compare(
+		          buffer,
+		          round_trip_buffer,
+		          read_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 "\n",
+			 read_offset );
+
+			result = 0;
+		}
+		read_offset += (off64_t) read_size;
+	}
+	if( round_trip_handle != NULL )
+	{
+		libewf_handle_close(
+		 round_trip_handle,
+		 NULL );
+		libewf_handle_free(
+		 &round_trip_handle,
+		 NULL );
+	}
+	remove(
+	 "ewf_test_read_round_trip.Ex01" );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		if( result != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL ) || defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL ) */
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The thread pool callback function
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_callback_function(
+     libewf_handle_t *handle,
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewf_test_read_callback_function";
+	off64_t read_offset      = 0;
+	size_t read_size         = EWF_TEST_READ_BUFFER_SIZE;
+	ssize_t read_count       = 0;
+	int number_of_iterations = 3;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( number_of_iterations > 0 )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from handle.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_iterations--;
+
+		if( number_of_iterations > 0 )
+		{
+			read_offset = -1 * (off64_t) read_size;
+
+			if( libewf_handle_seek_offset(
+			     handle,
+			     read_offset,
+			     SEEK_CUR,
+			     &error ) == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek in handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests reading data from a handle in multiple threads
+ * This test requires multi-threading support
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_from_handle_multi_thread(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     int number_of_threads )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	static char *function                  = "ewf_test_read_from_handle_multi_thread";
+	off64_t expected_offset                = 0;
+	off64_t result_offset                  = 0;
+	int iteration                          = 0;
+	int number_of_iterations               = 0;
+	int result                             = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     &error ) == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek in handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 1 )
+	{
+		number_of_iterations = number_of_threads * 32;
+
+		expected_offset = (off64_t) number_of_iterations * EWF_TEST_READ_BUFFER_SIZE;
+
+		if( (size64_t) expected_offset > media_size )
+		{
+			expected_offset = (off64_t) media_size;
+
+			number_of_iterations = (int) ( media_size / EWF_TEST_READ_BUFFER_SIZE );
+
+			if( ( media_size % EWF_TEST_READ_BUFFER_SIZE ) != 0 )
+			{
+				number_of_iterations += 1;
+			}
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_iterations,
+		     (int (*)(intptr_t *, void *)) &ewf_test_read_callback_function,
+		     NULL,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) handle,
+			     &error ) == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push handle onto queue.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_get_offset(
+	     handle,
+	     &result_offset,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing multi-threaded read buffer at offset: 0\t" );
+
+	if( expected_offset != result_offset )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected offset: %" PRIi64 "\n",
+		 result_offset );
+	}
+	else
+	{
+		result = 1;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The thread pool callback function for concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_concurrent_callback_function(
+     off64_t *read_offset,
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+	uint8_t verification_buffer[ EWF_TEST_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewf_test_read_concurrent_callback_function";
+	size64_t media_size      = 0;
+	size_t read_size         = EWF_TEST_READ_BUFFER_SIZE;
+	ssize_t read_count       = 0;
+
+	if( read_offset == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size64_t) *read_offset >= media_size )
+	{
+		read_size = 0;
+	}
+	else if( (size64_t) ( *read_offset + read_size ) > media_size )
+	{
+		read_size = (size_t) ( media_size - *read_offset );
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              EWF_TEST_READ_BUFFER_SIZE,
+	              *read_offset,
+	              &error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The second read is expected to be served from the chunks cache
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              verification_buffer,
+	              EWF_TEST_READ_BUFFER_SIZE,
+	              *read_offset,
+	              &error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     buffer,
+	     verification_buffer,
+	     read_size ) != 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in data read at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests concurrently reading data at offsets from a handle in multiple threads
+ * This test requires multi-threading support
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_from_handle_concurrent(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     int number_of_threads )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	off64_t *read_offsets                  = NULL;
+	static char *function                  = "ewf_test_read_from_handle_concurrent";
+	off64_t result_offset                  = 0;
+	int iteration                          = 0;
+	int number_of_iterations               = 0;
+	int result                             = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     &error ) == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek in handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 1 )
+	{
+		number_of_iterations = (int) ( media_size / EWF_TEST_READ_BUFFER_SIZE );
+
+		if( ( media_size % EWF_TEST_READ_BUFFER_SIZE ) != 0 )
+		{
+			number_of_iterations += 1;
+		}
+		if( number_of_iterations > ( number_of_threads * 32 ) )
+		{
+			number_of_iterations = number_of_threads * 32;
+		}
+	}
+	if( number_of_iterations > 0 )
+	{
+		read_offsets = (off64_t *) memory_allocate(
+		                            sizeof( off64_t ) * number_of_iterations );
+
+		if( read_offsets == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read offsets.",
+			 function );
+
+			goto on_error;
+		}
+		/* Read the blocks in reverse order so that the threads do not follow the media sequentially
+		 */
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			read_offsets[ iteration ] = (off64_t) ( number_of_iterations - iteration - 1 ) * EWF_TEST_READ_BUFFER_SIZE;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_iterations,
+		     (int (*)(intptr_t *, void *)) &ewf_test_read_concurrent_callback_function,
+		     (void *) handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( read_offsets[ iteration ] ),
+			     &error ) == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push read offset onto queue.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 read_offsets );
+
+		read_offsets = NULL;
+	}
+	if( libewf_handle_get_offset(
+	     handle,
+	     &result_offset,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing concurrent read buffer at offset: 0\t" );
+
+	/* Concurrent reads are not expected to change the current offset
+	 */
+	if( result_offset != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected offset: %" PRIi64 "\n",
+		 result_offset );
+	}
+	else
+	{
+		result = 1;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
 		libcerror_error_free(
 		 &error );
 	}
@@ -845,6 +2256,11 @@ on_error:
 		 &thread_pool,
 		 NULL );
 	}
+	if( read_offsets != NULL )
+	{
+		memory_free(
+		 read_offsets );
+	}
 	return( -1 );
 }
 
@@ -861,10 +2277,15 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t **filenames = NULL;
 	libcstring_system_character_t *source     = NULL;
 	libcerror_error_t *error                  = NULL;
+	libewf_handle_t *direct_io_handle         = NULL;
 	libewf_handle_t *handle                   = NULL;
+	libewf_handle_t *reference_handle         = NULL;
 	libcstring_system_integer_t option        = 0;
 	size64_t media_size                       = 0;
 	size_t string_length                      = 0;
+	uint64_t number_of_cache_evictions        = 0;
+	uint64_t number_of_cache_hits             = 0;
+	uint64_t number_of_cache_misses           = 0;
 	int number_of_filenames                   = 0;
 
 	while( ( option = libcsystem_getopt(
@@ -1020,9 +2441,248 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ewf_test_read_from_handle_concurrent(
+	     handle,
+	     media_size,
+	     EWF_TEST_READ_NUMBER_OF_THREADS ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to concurrently read from handle in multiple threads.\n" );
+
+		goto on_error;
+	}
+#endif
+	if( libewf_handle_set_read_ahead(
+	     handle,
+	     EWF_TEST_READ_AHEAD_DEPTH,
+	     EWF_TEST_READ_NUMBER_OF_THREADS,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set read-ahead.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_from_handle(
+	     handle,
+	     media_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read from handle with read-ahead.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &reference_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open reference handle.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_ahead_compare(
+	     handle,
+	     reference_handle,
+	     media_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to compare read-ahead data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_vector(
+	     handle,
+	     reference_handle,
+	     media_size,
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read vector.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_vector(
+	     handle,
+	     reference_handle,
+	     media_size,
+	     EWF_TEST_READ_NUMBER_OF_THREADS ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read vector in multiple threads.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_vector_image() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read vector from written image.\n" );
+
+		goto on_error;
+	}
+#if defined( EWF_TEST_READ_HAVE_DIRECT_IO )
+	/* Read the same data with direct IO, both at offsets and sequentially with read-ahead
+	 */
+	if( ewf_test_read_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ | LIBEWF_ACCESS_FLAG_DIRECT_IO,
+	     &direct_io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle with direct IO.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_from_handle(
+	     direct_io_handle,
+	     media_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read from handle with direct IO.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_ahead_compare(
+	     direct_io_handle,
+	     reference_handle,
+	     media_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to compare direct IO data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     direct_io_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle with direct IO.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &direct_io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle with direct IO.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( EWF_TEST_READ_HAVE_DIRECT_IO ) */
+
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+	if( ewf_test_read_compression_method_round_trip(
+	     handle,
+	     media_size,
+	     LIBEWF_COMPRESSION_METHOD_ZSTD ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test zstd compression round trip.\n" );
+
+		goto on_error;
+	}
+#endif
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+	if( ewf_test_read_compression_method_round_trip(
+	     handle,
+	     media_size,
+	     LIBEWF_COMPRESSION_METHOD_LZ4 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test lz4 compression round trip.\n" );
+
+		goto on_error;
+	}
 #endif
+	/* Read with a chunks cache that is smaller than a single chunk
+	 */
+	if( libewf_handle_set_chunks_cache_size(
+	     handle,
+	     EWF_TEST_READ_CHUNKS_CACHE_SIZE,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set chunks cache size.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_from_handle(
+	     handle,
+	     media_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read from handle with small chunks cache.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunks_cache_statistics(
+	     handle,
+	     &number_of_cache_hits,
+	     &number_of_cache_misses,
+	     &number_of_cache_evictions,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunks cache statistics.\n" );
+
+		goto on_error;
+	}
+	if( ( media_size > 0 )
+	 && ( number_of_cache_misses == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid chunks cache statistics.\n" );
+
+		goto on_error;
+	}
 	/* Clean up
 	 */
+	if( libewf_handle_close(
+	     reference_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close reference handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &reference_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free reference handle.\n" );
+
+		goto on_error;
+	}
 	if( libewf_handle_close(
 	     handle,
 	     &error ) != 0 )
@@ -1072,6 +2732,24 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( direct_io_handle != NULL )
+	{
+		libewf_handle_close(
+		 direct_io_handle,
+		 NULL );
+		libewf_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	if( reference_handle != NULL )
+	{
+		libewf_handle_close(
+		 reference_handle,
+		 NULL );
+		libewf_handle_free(
+		 &reference_handle,
+		 NULL );
+	}
 	if( handle != NULL )
 	{
 		libewf_handle_close(
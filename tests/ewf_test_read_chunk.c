@@ -31,6 +31,7 @@
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libcstring.h"
 #include "ewf_test_libcsystem.h"
+#include "ewf_test_libcthreads.h"
 #include "ewf_test_libewf.h"
 
 /* Define to make ewf_test_read generate verbose output
@@ -598,6 +599,668 @@ int ewf_test_read_chunk_from_handle(
 	return( 1 );
 }
 
+/* Tests the chunk data pool statistics of reading chunks from a handle
+ * The chunks cache is reduced to a single chunk so that the chunk data
+ * of evicted chunks is released to and reused from the pool
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_chunk_data_pool(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size32_t chunk_size )
+{
+	libcerror_error_t *error       = NULL;
+	uint8_t *buffer                = NULL;
+	off64_t read_offset            = 0;
+	size64_t pool_size             = 0;
+	size64_t pooled_size           = 0;
+	size_t read_size               = 0;
+	ssize_t read_count             = 0;
+	uint64_t number_of_allocations = 0;
+	uint64_t number_of_reuses      = 0;
+	int result                     = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing chunk data pool statistics\t" );
+
+	pool_size = 4 * (size64_t) chunk_size;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_set_chunks_cache_size(
+	          handle,
+	          (size64_t) chunk_size,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	else if( libewf_handle_set_chunk_data_pool_size(
+	          handle,
+	          pool_size,
+	          &error ) != 1 )
+	{
+		result = -1;
+	}
+	while( ( result == 1 )
+	    && ( (size64_t) read_offset < media_size ) )
+	{
+		read_size = (size_t) chunk_size;
+
+		if( (size64_t) read_size > ( media_size - read_offset ) )
+		{
+			read_size = (size_t) ( media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			result = -1;
+		}
+		read_offset += (off64_t) read_size;
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_chunk_data_pool_statistics(
+		          handle,
+		          &number_of_allocations,
+		          &number_of_reuses,
+		          &pooled_size,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		/* Reuse requires chunks to be evicted from the chunks cache
+		 */
+		if( ( number_of_allocations == 0 )
+		 || ( ( media_size >= ( 4 * (size64_t) chunk_size ) )
+		  &&  ( number_of_reuses == 0 ) )
+		 || ( pooled_size > pool_size ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected allocations: %" PRIu64 ", reuses: %" PRIu64 " and pooled size: %" PRIu64 ".\n",
+			 number_of_allocations,
+			 number_of_reuses,
+			 pooled_size );
+
+			result = 0;
+		}
+	}
+	/* A pool size of 0 frees the pooled chunk data
+	 */
+	if( result == 1 )
+	{
+		if( libewf_handle_set_chunk_data_pool_size(
+		     handle,
+		     0,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_chunk_data_pool_statistics(
+		          handle,
+		          &number_of_allocations,
+		          &number_of_reuses,
+		          &pooled_size,
+		          &error );
+	}
+	if( ( result == 1 )
+	 && ( pooled_size != 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected pooled size: %" PRIu64 ".\n",
+		 pooled_size );
+
+		result = 0;
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( result == -1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests that a handle cannot be closed while chunk views have not been freed
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_chunk_view_close(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size32_t chunk_size )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_view_t *chunk_view = NULL;
+	uint8_t *buffer                 = NULL;
+	const uint8_t *data             = NULL;
+	size_t data_size                = 0;
+	size_t expected_data_size       = 0;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing closing handle with chunk view\t" );
+
+	expected_data_size = (size_t) chunk_size;
+
+	if( media_size < (size64_t) chunk_size )
+	{
+		expected_data_size = (size_t) media_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		result = -1;
+	}
+	else
+	{
+		result = libewf_handle_get_chunk_view(
+		          handle,
+		          0,
+		          &data,
+		          &data_size,
+		          &chunk_view,
+		          &error );
+	}
+	if( ( result == 1 )
+	 && ( data_size != expected_data_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected chunk view data size: %" PRIzd ".\n",
+		 data_size );
+
+		result = 0;
+	}
+	/* The close fails and leaves the handle and the chunk view usable
+	 */
+	if( result == 1 )
+	{
+		if( libewf_handle_close(
+		     handle,
+		     &error ) != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Handle was closed with chunk view.\n" );
+
+			result = 0;
+		}
+		else
+		{
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	if( result == 1 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              expected_data_size,
+		              0,
+		              &error );
+
+		if( read_count != (ssize_t) expected_data_size )
+		{
+			result = -1;
+		}
+		else if( memory_compare(
+		          data,
+		          buffer,
+		          expected_data_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in chunk view data.\n" );
+
+			result = 0;
+		}
+	}
+	if( chunk_view != NULL )
+	{
+		if( libewf_chunk_view_free(
+		     &chunk_view,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( result == -1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The thread pool callback function for concurrent chunk reads
+ * Reads the chunk at the offset with libewf_handle_read_data_chunk_at_offset_concurrent
+ * and compares its data with libewf_handle_read_buffer_at_offset_concurrent
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_chunk_concurrent_callback_function(
+     off64_t *read_offset,
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	uint8_t *data_buffer            = NULL;
+	uint8_t *reference_buffer       = NULL;
+	static char *function           = "ewf_test_read_chunk_concurrent_callback_function";
+	size32_t chunk_size             = 0;
+	ssize_t process_count           = 0;
+	ssize_t read_count              = 0;
+
+	if( read_offset == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	data_buffer = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * chunk_size );
+
+	reference_buffer = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * chunk_size );
+
+	if( ( data_buffer == NULL )
+	 || ( reference_buffer == NULL ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     handle,
+	     &data_chunk,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to retrieve data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_data_chunk_at_offset_concurrent(
+	              handle,
+	              data_chunk,
+	              *read_offset,
+	              &error );
+
+	if( read_count <= 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	/* The chunk is unpacked and its checksum validated in this thread
+	 */
+	process_count = libewf_data_chunk_read_buffer(
+	                 data_chunk,
+	                 data_buffer,
+	                 (size_t) chunk_size,
+	                 &error );
+
+	if( process_count <= 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from chunk at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              reference_buffer,
+	              (size_t) process_count,
+	              *read_offset,
+	              &error );
+
+	if( read_count != process_count )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     data_buffer,
+	     reference_buffer,
+	     (size_t) process_count ) != 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in chunk data at offset: %" PRIi64 ".",
+		 function,
+		 *read_offset );
+
+		goto on_error;
+	}
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 reference_buffer );
+
+	memory_free(
+	 data_buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	if( data_buffer != NULL )
+	{
+		memory_free(
+		 data_buffer );
+	}
+	return( -1 );
+}
+
+/* Tests concurrently reading chunks at offsets from a handle in multiple threads
+ * This test requires multi-threading support
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_chunk_from_handle_multi_thread(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size32_t chunk_size,
+     int number_of_threads )
+{
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	off64_t *read_offsets                  = NULL;
+	off64_t result_offset                  = 0;
+	int iteration                          = 0;
+	int number_of_iterations               = 0;
+	int result                             = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing concurrent read data chunk at offset\t" );
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     &error ) != 0 )
+	{
+		result = -1;
+	}
+	number_of_iterations = (int) ( media_size / chunk_size );
+
+	if( ( media_size % chunk_size ) != 0 )
+	{
+		number_of_iterations += 1;
+	}
+	if( number_of_iterations > ( number_of_threads * 32 ) )
+	{
+		number_of_iterations = number_of_threads * 32;
+	}
+	if( ( result == 1 )
+	 && ( number_of_iterations > 0 ) )
+	{
+		read_offsets = (off64_t *) memory_allocate(
+		                            sizeof( off64_t ) * number_of_iterations );
+
+		if( read_offsets == NULL )
+		{
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( number_of_iterations > 0 ) )
+	{
+		/* Read the chunks in reverse order so that the threads do not follow the media sequentially
+		 */
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			read_offsets[ iteration ] = (off64_t) ( number_of_iterations - iteration - 1 ) * chunk_size;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_iterations,
+		     (int (*)(intptr_t *, void *)) &ewf_test_read_chunk_concurrent_callback_function,
+		     (void *) handle,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+		for( iteration = 0;
+		     ( result == 1 ) && ( iteration < number_of_iterations );
+		     iteration++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( read_offsets[ iteration ] ),
+			     &error ) == -1 )
+			{
+				result = -1;
+			}
+		}
+		if( thread_pool != NULL )
+		{
+			/* The thread pool join fails if one of the callbacks failed
+			 */
+			if( libcthreads_thread_pool_join(
+			     &thread_pool,
+			     ( result == 1 ) ? &error : NULL ) != 1 )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_offset(
+		     handle,
+		     &result_offset,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+		/* Concurrent reads are not expected to change the current offset
+		 */
+		else if( result_offset != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected offset: %" PRIi64 "\n",
+			 result_offset );
+
+			result = 0;
+		}
+	}
+	if( read_offsets != NULL )
+	{
+		memory_free(
+		 read_offsets );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* The main program
  */
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
@@ -790,11 +1453,11 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-/* TODO implement
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( ewf_test_read_chunk_from_handle_multi_thread(
 	     handle,
 	     media_size,
+	     chunk_size,
 	     EWF_TEST_READ_CHUNK_NUMBER_OF_THREADS ) != 1 )
 	{
 		fprintf(
@@ -804,7 +1467,28 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
-*/
+	if( ewf_test_read_chunk_data_pool(
+	     handle,
+	     media_size,
+	     chunk_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test chunk data pool.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_read_chunk_view_close(
+	     handle,
+	     media_size,
+	     chunk_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test closing handle with chunk view.\n" );
+
+		goto on_error;
+	}
 	/* Clean up
 	 */
 	if( libewf_handle_close(
@@ -0,0 +1,877 @@
+/*
+ * Single file tree test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_libuna.h"
+#include "../libewf/libewf_name_hash_table.h"
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_file_tree.h"
+
+/* The names that are added after the generated file names
+ * cquvmgey and iinqsgec have the same name hash
+ */
+static const char *ewf_test_single_file_tree_names[ ] = {
+	"cquvmgey",
+	"iinqsgec",
+	"bqtwpdsl",
+	"r\xc3\xa9sum\xc3\xa9",
+	"\xe6\x96\x87\xe4\xbb\xb6",
+	"\xf0\x9f\x93\x81 folder",
+	NULL };
+
+/* The names that are not in the tree
+ * edqlvidb has the same name hash as bqtwpdsl
+ */
+static const char *ewf_test_single_file_tree_missing_names[ ] = {
+	"missing",
+	"edqlvidb",
+	"file0",
+	"file000",
+	"r\xc3\xa9sume",
+	NULL };
+
+/* A name that cannot be decoded as UTF-8
+ */
+static const char *ewf_test_single_file_tree_undecodable_name = "invalid\xff";
+
+/* Appends a sub node with a single file entry of a specific name
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_file_tree_append_sub_node(
+     libcdata_tree_node_t *node,
+     const char *name,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_file_tree_append_sub_node";
+	size_t name_size                              = 0;
+
+	if( libewf_single_file_entry_initialize(
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		goto on_error;
+	}
+	name_size = libcstring_narrow_string_length(
+	             name ) + 1;
+
+	single_file_entry->name = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * name_size );
+
+	if( single_file_entry->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     single_file_entry->name,
+	     name,
+	     name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	single_file_entry->name_size = name_size;
+
+	if( libcdata_tree_node_initialize(
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     sub_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in sub node.",
+		 function );
+
+		goto on_error;
+	}
+	single_file_entry = NULL;
+
+	if( libcdata_tree_node_append_node(
+	     node,
+	     sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append sub node.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &sub_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a single file tree node with the generated file names and the test names as sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_file_tree_initialize(
+     libcdata_tree_node_t **node,
+     int number_of_files,
+     const char *additional_name,
+     libcerror_error_t **error )
+{
+	char name[ 16 ];
+
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_file_tree_initialize";
+	int file_index                                = 0;
+	int name_index                                = 0;
+
+	if( libcdata_tree_node_initialize(
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_file_entry_initialize(
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     *node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in node.",
+		 function );
+
+		goto on_error;
+	}
+	single_file_entry = NULL;
+
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		if( libcstring_narrow_string_snprintf(
+		     name,
+		     16,
+		     "file%02d",
+		     file_index ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name: %d.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+		if( ewf_test_single_file_tree_append_sub_node(
+		     *node,
+		     name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node: %d.",
+			 function,
+			 file_index );
+
+			goto on_error;
+		}
+	}
+	for( name_index = 0;
+	     ewf_test_single_file_tree_names[ name_index ] != NULL;
+	     name_index++ )
+	{
+		if( ewf_test_single_file_tree_append_sub_node(
+		     *node,
+		     ewf_test_single_file_tree_names[ name_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node: %s.",
+			 function,
+			 ewf_test_single_file_tree_names[ name_index ] );
+
+			goto on_error;
+		}
+	}
+	if( additional_name != NULL )
+	{
+		if( ewf_test_single_file_tree_append_sub_node(
+		     *node,
+		     additional_name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append additional sub node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	if( *node != NULL )
+	{
+		libcdata_tree_node_free(
+		 node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Checks if the name hash table of a single file tree node is set
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_file_tree_check_name_hash_table(
+     libcdata_tree_node_t *node,
+     int expected_name_hash_table,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_file_tree_check_name_hash_table";
+
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( single_file_entry->sub_nodes_name_hash_table != NULL ) != ( expected_name_hash_table != 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected sub nodes name hash table.\n" );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Looks up a name by its UTF-8 and UTF-16 representation
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_file_tree_check_lookup(
+     libcdata_tree_node_t *node,
+     const char *name,
+     int expected_result,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libuna_utf16_character_t *utf16_string            = NULL;
+	static char *function                             = "ewf_test_single_file_tree_check_lookup";
+	size_t utf16_string_size                          = 0;
+	size_t utf8_string_length                         = 0;
+	int result                                        = 0;
+
+	utf8_string_length = libcstring_narrow_string_length(
+	                      name );
+
+	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+	          node,
+	          (uint8_t *) name,
+	          utf8_string_length,
+	          &sub_node,
+	          &sub_single_file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node by UTF-8 name.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != expected_result )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected result: %d for UTF-8 name: %s.\n",
+		 result,
+		 name );
+
+		return( 0 );
+	}
+	if( result != 0 )
+	{
+		if( ( sub_single_file_entry == NULL )
+		 || ( sub_single_file_entry->name_size != ( utf8_string_length + 1 ) )
+		 || ( memory_compare(
+		       sub_single_file_entry->name,
+		       name,
+		       utf8_string_length ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected sub node for UTF-8 name: %s.\n",
+			 name );
+
+			return( 0 );
+		}
+	}
+	if( libuna_utf16_string_size_from_utf8(
+	     (libuna_utf8_character_t *) name,
+	     utf8_string_length + 1,
+	     &utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine UTF-16 string size.",
+		 function );
+
+		goto on_error;
+	}
+	utf16_string = (libuna_utf16_character_t *) memory_allocate(
+	                                             sizeof( libuna_utf16_character_t ) * utf16_string_size );
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-16 string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_utf16_string_copy_from_utf8(
+	     utf16_string,
+	     utf16_string_size,
+	     (libuna_utf8_character_t *) name,
+	     utf8_string_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set UTF-16 string.",
+		 function );
+
+		goto on_error;
+	}
+	sub_single_file_entry = NULL;
+
+	result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+	          node,
+	          (uint16_t *) utf16_string,
+	          utf16_string_size - 1,
+	          &sub_node,
+	          &sub_single_file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node by UTF-16 name.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 utf16_string );
+
+	utf16_string = NULL;
+
+	if( result != expected_result )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected result: %d for UTF-16 name: %s.\n",
+		 result,
+		 name );
+
+		return( 0 );
+	}
+	if( result != 0 )
+	{
+		if( ( sub_single_file_entry == NULL )
+		 || ( sub_single_file_entry->name_size != ( utf8_string_length + 1 ) )
+		 || ( memory_compare(
+		       sub_single_file_entry->name,
+		       name,
+		       utf8_string_length ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected sub node for UTF-16 name: %s.\n",
+			 name );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( utf16_string != NULL )
+	{
+		memory_free(
+		 utf16_string );
+	}
+	return( -1 );
+}
+
+/* Looks up all the names in a single file tree node created by ewf_test_single_file_tree_initialize
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_file_tree_check_lookups(
+     libcdata_tree_node_t *node,
+     int number_of_files,
+     libcerror_error_t **error )
+{
+	char name[ 16 ];
+
+	static char *function = "ewf_test_single_file_tree_check_lookups";
+	int file_index        = 0;
+	int name_index        = 0;
+	int result            = 1;
+
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		if( libcstring_narrow_string_snprintf(
+		     name,
+		     16,
+		     "file%02d",
+		     file_index ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name: %d.",
+			 function,
+			 file_index );
+
+			return( -1 );
+		}
+		result = ewf_test_single_file_tree_check_lookup(
+		          node,
+		          name,
+		          1,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	for( name_index = 0;
+	     ewf_test_single_file_tree_names[ name_index ] != NULL;
+	     name_index++ )
+	{
+		result = ewf_test_single_file_tree_check_lookup(
+		          node,
+		          ewf_test_single_file_tree_names[ name_index ],
+		          1,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	for( name_index = 0;
+	     ewf_test_single_file_tree_missing_names[ name_index ] != NULL;
+	     name_index++ )
+	{
+		result = ewf_test_single_file_tree_check_lookup(
+		          node,
+		          ewf_test_single_file_tree_missing_names[ name_index ],
+		          0,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	return( result );
+}
+
+/* Checks if two names have the same name hash
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_file_tree_check_name_hash_collision(
+     const char *first_name,
+     const char *second_name,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_single_file_tree_check_name_hash_collision";
+	uint32_t first_hash   = 0;
+	uint32_t second_hash  = 0;
+
+	if( libewf_name_hash_table_get_utf8_name_hash(
+	     (uint8_t *) first_name,
+	     libcstring_narrow_string_length( first_name ) + 1,
+	     &first_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first name hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_name_hash_table_get_utf8_name_hash(
+	     (uint8_t *) second_name,
+	     libcstring_narrow_string_length( second_name ) + 1,
+	     &second_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve second name hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_hash != second_hash )
+	{
+		fprintf(
+		 stderr,
+		 "Names: %s and %s do not have the same name hash.\n",
+		 first_name,
+		 second_name );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Prints the result of a test
+ */
+void ewf_test_single_file_tree_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Tests the lookups in the sub nodes of a single file tree node
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_file_tree_lookup(
+     const char *description,
+     int number_of_files,
+     const char *additional_name,
+     int expected_name_hash_table,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *node = NULL;
+	int result                 = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing %s\t",
+	 description );
+
+	result = ewf_test_single_file_tree_initialize(
+	          &node,
+	          number_of_files,
+	          additional_name,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_single_file_tree_index_sub_nodes(
+		          node,
+		          error );
+
+		if( result == 0 )
+		{
+			result = 1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_file_tree_check_name_hash_table(
+		          node,
+		          expected_name_hash_table,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_file_tree_check_lookups(
+		          node,
+		          number_of_files,
+		          error );
+	}
+	if( node != NULL )
+	{
+		if( libcdata_tree_node_free(
+		     &node,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_single_file_tree_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	/* The lookups of colliding names rely on the names being compared
+	 */
+	if( ewf_test_single_file_tree_check_name_hash_collision(
+	     "cquvmgey",
+	     "iinqsgec",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test name hash collision.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_single_file_tree_check_name_hash_collision(
+	     "bqtwpdsl",
+	     "edqlvidb",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test name hash collision.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_single_file_tree_lookup(
+	     "indexed lookup",
+	     LIBEWF_SINGLE_FILE_TREE_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES,
+	     NULL,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test indexed lookup.\n" );
+
+		goto on_error;
+	}
+	/* A directory with less than the minimum number of sub nodes is not indexed
+	 */
+	if( ewf_test_single_file_tree_lookup(
+	     "linear lookup",
+	     LIBEWF_SINGLE_FILE_TREE_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES - 7,
+	     NULL,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test linear lookup.\n" );
+
+		goto on_error;
+	}
+	/* A directory with a name that cannot be decoded falls back to a linear lookup
+	 */
+	if( ewf_test_single_file_tree_lookup(
+	     "undecodable name lookup",
+	     LIBEWF_SINGLE_FILE_TREE_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES,
+	     ewf_test_single_file_tree_undecodable_name,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test undecodable name lookup.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
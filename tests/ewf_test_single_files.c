@@ -0,0 +1,1067 @@
+/*
+ * Single files test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_file_tree.h"
+#include "../libewf/libewf_single_files.h"
+
+#define EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE	4096
+#define EWF_TEST_SINGLE_FILES_MEDIA_SIZE	1048576
+#define EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES	40
+#define EWF_TEST_SINGLE_FILES_NUMBER_OF_THREADS	4
+
+/* The single file entries of the ltree
+ * the root contains: dir1 with 40 files, dir2 with 2 files and dir3 and file.txt
+ * every entry consists of a number of sub entries line and a values line
+ */
+#define EWF_TEST_SINGLE_FILES_NUMBER_OF_ENTRIES	( EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES + 8 )
+
+/* Creates the ltree data of the single files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_set_ltree_data(
+     libewf_single_files_t *single_files,
+     libcerror_error_t **error )
+{
+	char ltree_string[ EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE ];
+
+	static char *function     = "ewf_test_single_files_set_ltree_data";
+	size_t ltree_string_index = 0;
+	size_t ltree_string_size  = 0;
+	int file_index            = 0;
+	int print_count           = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = libcstring_narrow_string_snprintf(
+	               ltree_string,
+	               EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE,
+	               "5\nrec\ntb\tcl\n%d\t0\nentry\n1\np\tn\tac\n"
+	               "0\t3\n1\t\t0\n"
+	               "0\t%d\n1\tdir1\t1\n",
+	               EWF_TEST_SINGLE_FILES_MEDIA_SIZE,
+	               EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES );
+
+	for( file_index = 0;
+	     file_index < EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES;
+	     file_index++ )
+	{
+		if( ( print_count < 0 )
+		 || ( print_count >= EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE ) )
+		{
+			break;
+		}
+		ltree_string_size += (size_t) print_count;
+
+		print_count = libcstring_narrow_string_snprintf(
+		               &( ltree_string[ ltree_string_size ] ),
+		               EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE - ltree_string_size,
+		               "0\t0\n\tfile%02d\t%d\n",
+		               file_index,
+		               1000 + file_index );
+	}
+	if( ( print_count >= 0 )
+	 && ( print_count < (int) ( EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE - ltree_string_size ) ) )
+	{
+		ltree_string_size += (size_t) print_count;
+
+		print_count = libcstring_narrow_string_snprintf(
+		               &( ltree_string[ ltree_string_size ] ),
+		               EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE - ltree_string_size,
+		               "0\t3\n1\tdir2\t2\n"
+		               "0\t0\n\tfirst.txt\t2001\n"
+		               "0\t0\n\tsecond.txt\t2002\n"
+		               "0\t1\n1\tdir3\t3\n"
+		               "0\t0\n\tnested.txt\t3001\n"
+		               "0\t0\n\tfile.txt\t4\n"
+		               "\n" );
+	}
+	if( ( print_count < 0 )
+	 || ( print_count >= (int) ( EWF_TEST_SINGLE_FILES_LTREE_STRING_SIZE - ltree_string_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ltree string.",
+		 function );
+
+		return( -1 );
+	}
+	ltree_string_size += (size_t) print_count;
+
+	/* The ltree data is stored as UTF-16 little-endian
+	 */
+	single_files->section_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * 2 * ltree_string_size );
+
+	if( single_files->section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section data.",
+		 function );
+
+		return( -1 );
+	}
+	for( ltree_string_index = 0;
+	     ltree_string_index < ltree_string_size;
+	     ltree_string_index++ )
+	{
+		single_files->section_data[ 2 * ltree_string_index ]       = (uint8_t) ltree_string[ ltree_string_index ];
+		single_files->section_data[ ( 2 * ltree_string_index ) + 1 ] = 0;
+	}
+	single_files->section_data_size = 2 * ltree_string_size;
+	single_files->ltree_data        = single_files->section_data;
+	single_files->ltree_data_size   = single_files->section_data_size;
+
+	return( 1 );
+}
+
+/* Creates and parses the single files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_initialize(
+     libewf_single_files_t **single_files,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_single_files_initialize";
+	size64_t media_size   = 0;
+	uint8_t format        = 0;
+
+	if( libewf_single_files_initialize(
+	     single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_single_files_set_ltree_data(
+	     *single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ltree data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse(
+	     *single_files,
+	     &media_size,
+	     &format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size != (size64_t) EWF_TEST_SINGLE_FILES_MEDIA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unexpected media size: %" PRIu64 ".",
+		 function,
+		 media_size );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *single_files != NULL )
+	{
+		libewf_single_files_free(
+		 single_files,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the single file entry and the number of sub nodes of a single file tree node
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_get_node_values(
+     libcdata_tree_node_t *node,
+     libewf_single_file_entry_t **single_file_entry,
+     int *number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_single_files_get_node_values";
+
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub file entries of a single file tree node and all its descendants
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_read_sub_file_entries(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_files_read_sub_file_entries";
+	int number_of_sub_nodes                       = 0;
+	int sub_node_index                            = 0;
+
+	if( libewf_single_files_read_sub_file_entries(
+	     single_files,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_test_single_files_get_node_values(
+	     node,
+	     &single_file_entry,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node values.",
+		 function );
+
+		return( -1 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     node,
+		     sub_node_index,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( ewf_test_single_files_read_sub_file_entries(
+		     single_files,
+		     sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sub file entries of sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Checks if the sub nodes of a single file tree node match the entry records
+ * The sub nodes of every descendant are expected to have been read
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_files_check_sub_nodes(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libewf_single_file_entry_t *single_file_entry     = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "ewf_test_single_files_check_sub_nodes";
+	int number_of_sub_nodes                           = 0;
+	int result                                        = 0;
+	int sub_node_index                                = 0;
+	int sub_record_index                              = 0;
+	int sub_sub_nodes                                 = 0;
+
+	if( ewf_test_single_files_get_node_values(
+	     node,
+	     &single_file_entry,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( single_file_entry->record_index < 0 )
+	 || ( single_file_entry->record_index >= single_files->number_of_entry_records ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected record index: %d.\n",
+		 single_file_entry->record_index );
+
+		return( 0 );
+	}
+	if( ( single_file_entry->sub_file_entries_read == 0 )
+	 || ( (uint32_t) number_of_sub_nodes != single_files->entry_records[ single_file_entry->record_index ].number_of_sub_entries ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected number of sub nodes: %d of record: %d.\n",
+		 number_of_sub_nodes,
+		 single_file_entry->record_index );
+
+		return( 0 );
+	}
+	/* The sub entries directly follow the entry and its sub entries are followed by their descendants
+	 */
+	sub_record_index = single_file_entry->record_index + 1;
+
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     node,
+		     sub_node_index,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( ewf_test_single_files_get_node_values(
+		     sub_node,
+		     &sub_single_file_entry,
+		     &sub_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d values.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( sub_single_file_entry->record_index != sub_record_index )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected record index: %d of sub node: %d.\n",
+			 sub_single_file_entry->record_index,
+			 sub_node_index );
+
+			return( 0 );
+		}
+		result = ewf_test_single_files_check_sub_nodes(
+		          single_files,
+		          sub_node,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		sub_record_index += (int) single_files->entry_records[ sub_record_index ].number_of_descendants + 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves a sub node of a single file tree node by name
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int ewf_test_single_files_get_sub_node_by_name(
+     libcdata_tree_node_t *node,
+     const char *name,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+
+	return( libewf_single_file_tree_get_sub_node_by_utf8_name(
+	         node,
+	         (uint8_t *) name,
+	         libcstring_narrow_string_length(
+	          name ),
+	         sub_node,
+	         &sub_single_file_entry,
+	         error ) );
+}
+
+/* Checks if the single file tree of the test ltree has been read completely
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_files_check_tree(
+     libewf_single_files_t *single_files,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *directory_node          = NULL;
+	libcdata_tree_node_t *file_node               = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_files_check_tree";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	result = ewf_test_single_files_check_sub_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	/* dir1 contains enough sub entries to be indexed by name hash
+	 */
+	result = ewf_test_single_files_get_sub_node_by_name(
+	          single_files->root_file_entry_node,
+	          "dir1",
+	          &directory_node,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          directory_node,
+		          "file17",
+		          &file_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		if( ewf_test_single_files_get_node_values(
+		     directory_node,
+		     &single_file_entry,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory node values.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( number_of_sub_nodes != EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES )
+		 || ( single_file_entry->sub_nodes_name_hash_table == NULL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected sub nodes of: dir1.\n" );
+
+			return( 0 );
+		}
+		if( ewf_test_single_files_get_node_values(
+		     file_node,
+		     &single_file_entry,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file node values.",
+			 function );
+
+			return( -1 );
+		}
+		if( single_file_entry->access_time != 1017 )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected access time of: dir1/file17.\n" );
+
+			return( 0 );
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          single_files->root_file_entry_node,
+		          "dir2",
+		          &directory_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          directory_node,
+		          "dir3",
+		          &directory_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          directory_node,
+		          "nested.txt",
+		          &file_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          single_files->root_file_entry_node,
+		          "file.txt",
+		          &file_node,
+		          error );
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing sub node.\n" );
+	}
+	return( result );
+}
+
+/* Prints the result of a test
+ */
+void ewf_test_single_files_print_result(
+      int result )
+{
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Tests parsing the ltree
+ * Only the root file entry is parsed, its sub file entries are read on demand
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_files_parse(
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing parse\t" );
+
+	result = ewf_test_single_files_initialize(
+	          &single_files,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_node_values(
+		          single_files->root_file_entry_node,
+		          &single_file_entry,
+		          &number_of_sub_nodes,
+		          error );
+	}
+	if( result == 1 )
+	{
+		if( ( single_files->number_of_entry_records != EWF_TEST_SINGLE_FILES_NUMBER_OF_ENTRIES )
+		 || ( single_files->entry_records[ 0 ].number_of_sub_entries != 3 )
+		 || ( single_files->entry_records[ 0 ].number_of_descendants != ( EWF_TEST_SINGLE_FILES_NUMBER_OF_ENTRIES - 1 ) )
+		 || ( single_files->entry_records[ 1 ].number_of_sub_entries != EWF_TEST_SINGLE_FILES_NUMBER_OF_FILES ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected entry records.\n" );
+
+			result = 0;
+		}
+		else if( ( single_file_entry->type != LIBEWF_FILE_ENTRY_TYPE_DIRECTORY )
+		      || ( single_file_entry->record_index != 0 )
+		      || ( single_file_entry->sub_file_entries_read != 0 )
+		      || ( number_of_sub_nodes != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected root file entry.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_read_sub_file_entries(
+		          single_files,
+		          single_files->root_file_entry_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_check_tree(
+		          single_files,
+		          error );
+	}
+	if( single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &single_files,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_single_files_print_result(
+	 result );
+
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The thread pool callback function for reading the sub file entries
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_read_callback_function(
+     libewf_single_files_t *single_files,
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewf_test_single_files_read_callback_function";
+
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_single_files_read_sub_file_entries(
+	     single_files,
+	     single_files->root_file_entry_node,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests reading the sub file entries in multiple threads
+ * Every thread reads the entire tree so that the same sub file entries are read concurrently
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_files_read_sub_file_entries_multi_thread(
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	libewf_single_files_t *single_files    = NULL;
+	int iteration                          = 0;
+	int number_of_iterations               = 4 * EWF_TEST_SINGLE_FILES_NUMBER_OF_THREADS;
+	int result                             = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing read sub file entries multi-threaded\t" );
+
+	result = ewf_test_single_files_initialize(
+	          &single_files,
+	          error );
+
+	if( result == 1 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     EWF_TEST_SINGLE_FILES_NUMBER_OF_THREADS,
+		     number_of_iterations,
+		     (int (*)(intptr_t *, void *)) &ewf_test_single_files_read_callback_function,
+		     NULL,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	for( iteration = 0;
+	     ( result == 1 ) && ( iteration < number_of_iterations );
+	     iteration++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) single_files,
+		     error ) == -1 )
+		{
+			result = -1;
+		}
+	}
+	if( thread_pool != NULL )
+	{
+		/* The thread pool join fails if one of the callbacks failed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			result = 0;
+		}
+	}
+	/* Every sub file entry is expected to have been added once
+	 */
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_check_tree(
+		          single_files,
+		          error );
+	}
+	if( single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &single_files,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_single_files_print_result(
+	 result );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests reading the sub file entries again after reading them failed
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_single_files_read_sub_file_entries_retry(
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *directory_node          = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	size_t values_offset                          = 0;
+	int directory_record_index                    = 0;
+	int failed_record_index                       = 0;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing read sub file entries retry\t" );
+
+	result = ewf_test_single_files_initialize(
+	          &single_files,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_single_files_read_sub_file_entries(
+		          single_files,
+		          single_files->root_file_entry_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_sub_node_by_name(
+		          single_files->root_file_entry_node,
+		          "dir2",
+		          &directory_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_get_node_values(
+		          directory_node,
+		          &single_file_entry,
+		          &number_of_sub_nodes,
+		          error );
+	}
+	if( result == 1 )
+	{
+		/* Make the values of the second sub entry of dir2 unreadable
+		 * so that reading the sub file entries fails after the first sub entry was added
+		 */
+		directory_record_index = single_file_entry->record_index;
+		failed_record_index    = directory_record_index + 2;
+
+		values_offset = single_files->entry_records[ failed_record_index ].values_offset;
+
+		single_files->entry_records[ failed_record_index ].values_offset = single_files->ltree_data_size + 1;
+
+		result = libewf_single_files_read_sub_file_entries(
+		          single_files,
+		          directory_node,
+		          NULL );
+
+		single_files->entry_records[ failed_record_index ].values_offset = values_offset;
+
+		if( result != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Reading sub file entries did not fail.\n" );
+
+			result = 0;
+		}
+		else
+		{
+			result = ewf_test_single_files_get_node_values(
+			          directory_node,
+			          &single_file_entry,
+			          &number_of_sub_nodes,
+			          error );
+		}
+	}
+	if( result == 1 )
+	{
+		/* The sub nodes added before the failure are removed
+		 */
+		if( ( single_file_entry->sub_file_entries_read != 0 )
+		 || ( number_of_sub_nodes != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected sub nodes after failure.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_read_sub_file_entries(
+		          single_files,
+		          single_files->root_file_entry_node,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_single_files_check_tree(
+		          single_files,
+		          error );
+	}
+	if( single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &single_files,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_single_files_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( ewf_test_single_files_parse(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test parse.\n" );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewf_test_single_files_read_sub_file_entries_multi_thread(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read sub file entries multi-threaded.\n" );
+
+		goto on_error;
+	}
+#endif
+	if( ewf_test_single_files_read_sub_file_entries_retry(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read sub file entries retry.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
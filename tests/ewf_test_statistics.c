@@ -0,0 +1,654 @@
+/*
+ * Handle statistics test program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcsystem.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_statistics generate verbose output
+#define EWF_TEST_STATISTICS_VERBOSE
+ */
+
+#define EWF_TEST_STATISTICS_BUFFER_SIZE		4096
+
+/* The media size is not a multiple of the chunk size to test a partial last chunk
+ */
+#define EWF_TEST_STATISTICS_MEDIA_SIZE		300000
+
+/* Checks a statistic value
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_statistics_check_value(
+     uint64_t *values,
+     int statistic,
+     uint64_t minimum_value,
+     uint64_t maximum_value )
+{
+	if( ( values[ statistic ] < minimum_value )
+	 || ( values[ statistic ] > maximum_value ) )
+	{
+		fprintf(
+		 stderr,
+		 "Statistic: %d value: %" PRIu64 " out of bounds (%" PRIu64 " - %" PRIu64 ").\n",
+		 statistic,
+		 values[ statistic ],
+		 minimum_value,
+		 maximum_value );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the statistics of writing a segment file
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_statistics_write(
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error )
+{
+	uint64_t values[ LIBEWF_NUMBER_OF_STATISTICS ];
+	uint8_t buffer[ EWF_TEST_STATISTICS_BUFFER_SIZE ];
+
+	libcstring_system_character_t *basenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_statistics" ) };
+
+	libewf_handle_t *handle = NULL;
+	off64_t write_offset    = 0;
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+	uint32_t chunk_size     = 0;
+	int result              = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing statistics of writing\t" );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          error );
+
+	if( result == 1 )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_wide(
+		          handle,
+		          basenames,
+		          1,
+		          LIBEWF_OPEN_WRITE,
+		          error );
+#else
+		result = libewf_handle_open(
+		          handle,
+		          basenames,
+		          1,
+		          LIBEWF_OPEN_WRITE,
+		          error );
+#endif
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_set_media_size(
+		          handle,
+		          EWF_TEST_STATISTICS_MEDIA_SIZE,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_set_compression_values(
+		          handle,
+		          LIBEWF_COMPRESSION_BEST,
+		          0,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_handle_get_chunk_size(
+		          handle,
+		          &chunk_size,
+		          error );
+	}
+	if( ( result == 1 )
+	 && ( chunk_size == 0 ) )
+	{
+		result = -1;
+	}
+	while( ( result == 1 )
+	    && ( write_offset < (off64_t) EWF_TEST_STATISTICS_MEDIA_SIZE ) )
+	{
+		write_size = EWF_TEST_STATISTICS_BUFFER_SIZE;
+
+		if( write_size > (size_t) ( EWF_TEST_STATISTICS_MEDIA_SIZE - write_offset ) )
+		{
+			write_size = (size_t) ( EWF_TEST_STATISTICS_MEDIA_SIZE - write_offset );
+		}
+		ewf_test_image_fill_buffer(
+		 buffer,
+		 write_size,
+		 write_offset,
+		 NULL );
+
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			result = -1;
+		}
+		write_offset += (off64_t) write_size;
+	}
+	if( ( result == 1 )
+	 && ( libewf_handle_close(
+	       handle,
+	       error ) != 0 ) )
+	{
+		result = -1;
+	}
+	/* The statistics remain available after the handle is closed
+	 */
+	if( result == 1 )
+	{
+		result = libewf_handle_get_statistics(
+		          handle,
+		          values,
+		          LIBEWF_NUMBER_OF_STATISTICS,
+		          error );
+	}
+	if( result == 1 )
+	{
+		*number_of_chunks = ( EWF_TEST_STATISTICS_MEDIA_SIZE + chunk_size - 1 ) / chunk_size;
+
+		result = ewf_test_statistics_check_value(
+		          values,
+		          LIBEWF_STATISTIC_BYTES_WRITTEN,
+		          EWF_TEST_STATISTICS_MEDIA_SIZE,
+		          EWF_TEST_STATISTICS_MEDIA_SIZE );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_statistics_check_value(
+		          values,
+		          LIBEWF_STATISTIC_CHUNKS_WRITTEN,
+		          *number_of_chunks,
+		          *number_of_chunks );
+	}
+	if( result == 1 )
+	{
+		result = ewf_test_statistics_check_value(
+		          values,
+		          LIBEWF_STATISTIC_BYTES_READ,
+		          0,
+		          0 );
+	}
+	if( handle != NULL )
+	{
+		if( result != 1 )
+		{
+			libewf_handle_close(
+			 handle,
+			 NULL );
+		}
+		if( libewf_handle_free(
+		     &handle,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* Reads all the (media) data of a handle in chunk size parts
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_statistics_read_media(
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     uint8_t *expected_buffer,
+     size_t chunk_size,
+     libcerror_error_t **error )
+{
+	off64_t read_offset = 0;
+	size_t read_size    = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		return( -1 );
+	}
+	while( read_offset < (off64_t) EWF_TEST_STATISTICS_MEDIA_SIZE )
+	{
+		read_size = chunk_size;
+
+		if( read_size > (size_t) ( EWF_TEST_STATISTICS_MEDIA_SIZE - read_offset ) )
+		{
+			read_size = (size_t) ( EWF_TEST_STATISTICS_MEDIA_SIZE - read_offset );
+		}
+		if( libewf_handle_read_buffer(
+		     handle,
+		     buffer,
+		     read_size,
+		     error ) != (ssize_t) read_size )
+		{
+			return( -1 );
+		}
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 read_size,
+		 read_offset,
+		 NULL );
+
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     read_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data at offset: %" PRIi64 ".\n",
+			 read_offset );
+
+			return( 0 );
+		}
+		read_offset += (off64_t) read_size;
+	}
+	return( 1 );
+}
+
+/* Tests the statistics of reading a segment file
+ * The media data is read twice, the second time from the chunks cache
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_statistics_read(
+     uint64_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	uint64_t first_values[ LIBEWF_NUMBER_OF_STATISTICS ];
+	uint64_t values[ LIBEWF_NUMBER_OF_STATISTICS ];
+
+	libcstring_system_character_t *filenames[ 1 ] = {
+		_LIBCSTRING_SYSTEM_STRING( "ewf_test_statistics.E01" ) };
+
+	libewf_handle_t *handle  = NULL;
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	uint32_t chunk_size      = 0;
+	int open_iteration       = 0;
+	int result               = 0;
+	int statistic            = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing statistics of reading\t" );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          error );
+
+	/* Open the handle twice to test that the statistics are reset on open
+	 */
+	for( open_iteration = 0;
+	     ( result == 1 ) && ( open_iteration < 2 );
+	     open_iteration++ )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_wide(
+		          handle,
+		          filenames,
+		          1,
+		          LIBEWF_OPEN_READ,
+		          error );
+#else
+		result = libewf_handle_open(
+		          handle,
+		          filenames,
+		          1,
+		          LIBEWF_OPEN_READ,
+		          error );
+#endif
+		if( result == 1 )
+		{
+			result = libewf_handle_get_statistics(
+			          handle,
+			          values,
+			          LIBEWF_NUMBER_OF_STATISTICS,
+			          error );
+		}
+		for( statistic = LIBEWF_STATISTIC_BYTES_READ;
+		     ( result == 1 ) && ( statistic <= LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES );
+		     statistic++ )
+		{
+			result = ewf_test_statistics_check_value(
+			          values,
+			          statistic,
+			          0,
+			          0 );
+		}
+		if( ( result == 1 )
+		 && ( buffer == NULL ) )
+		{
+			result = libewf_handle_get_chunk_size(
+			          handle,
+			          &chunk_size,
+			          error );
+
+			if( ( result == 1 )
+			 && ( chunk_size == 0 ) )
+			{
+				result = -1;
+			}
+			if( result == 1 )
+			{
+				buffer = (uint8_t *) memory_allocate(
+				                      (size_t) chunk_size );
+
+				expected_buffer = (uint8_t *) memory_allocate(
+				                               (size_t) chunk_size );
+
+				if( ( buffer == NULL )
+				 || ( expected_buffer == NULL ) )
+				{
+					result = -1;
+				}
+			}
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_read_media(
+			          handle,
+			          buffer,
+			          expected_buffer,
+			          (size_t) chunk_size,
+			          error );
+		}
+		if( result == 1 )
+		{
+			result = libewf_handle_get_statistics(
+			          handle,
+			          first_values,
+			          LIBEWF_NUMBER_OF_STATISTICS,
+			          error );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_BYTES_READ,
+			          EWF_TEST_STATISTICS_MEDIA_SIZE,
+			          EWF_TEST_STATISTICS_MEDIA_SIZE );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_CHUNKS_READ,
+			          number_of_chunks,
+			          number_of_chunks );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES,
+			          1,
+			          UINT64_MAX );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_BYTES_WRITTEN,
+			          0,
+			          0 );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_CHECKSUM_FAILURES,
+			          0,
+			          0 );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          first_values,
+			          LIBEWF_STATISTIC_SEGMENT_FILE_OPENS,
+			          1,
+			          UINT64_MAX );
+		}
+		/* The second read is served from the chunks cache
+		 */
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_read_media(
+			          handle,
+			          buffer,
+			          expected_buffer,
+			          (size_t) chunk_size,
+			          error );
+		}
+		if( result == 1 )
+		{
+			result = libewf_handle_get_statistics(
+			          handle,
+			          values,
+			          LIBEWF_NUMBER_OF_STATISTICS,
+			          error );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          values,
+			          LIBEWF_STATISTIC_BYTES_READ,
+			          2 * EWF_TEST_STATISTICS_MEDIA_SIZE,
+			          2 * EWF_TEST_STATISTICS_MEDIA_SIZE );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          values,
+			          LIBEWF_STATISTIC_CHUNKS_READ,
+			          number_of_chunks,
+			          number_of_chunks );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          values,
+			          LIBEWF_STATISTIC_CHUNKS_CACHE_HITS,
+			          first_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_HITS ] + number_of_chunks,
+			          UINT64_MAX );
+		}
+		if( result == 1 )
+		{
+			result = ewf_test_statistics_check_value(
+			          values,
+			          LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES,
+			          first_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ],
+			          first_values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES ] );
+		}
+		if( result == 1 )
+		{
+			if( libewf_handle_close(
+			     handle,
+			     error ) != 0 )
+			{
+				result = -1;
+			}
+		}
+	}
+	/* Only the requested number of values is retrieved
+	 */
+	if( result == 1 )
+	{
+		values[ 2 ] = UINT64_MAX;
+
+		result = libewf_handle_get_statistics(
+		          handle,
+		          values,
+		          2,
+		          error );
+
+		if( ( result == 1 )
+		 && ( values[ 2 ] != UINT64_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Statistic value beyond the number of values was retrieved.\n" );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_handle_get_statistics(
+		     handle,
+		     values,
+		     -1,
+		     error ) != -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Negative number of values was accepted.\n" );
+
+			result = 0;
+		}
+		else
+		{
+			libcerror_error_free(
+			 error );
+		}
+	}
+	if( handle != NULL )
+	{
+		if( result != 1 )
+		{
+			libewf_handle_close(
+			 handle,
+			 NULL );
+		}
+		if( libewf_handle_free(
+		     &handle,
+		     error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	ewf_test_image_print_result(
+	 result );
+
+	return( result );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc EWF_TEST_ATTRIBUTE_UNUSED, wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main( int argc EWF_TEST_ATTRIBUTE_UNUSED, char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_chunks = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_STATISTICS_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	if( ewf_test_statistics_write(
+	     &number_of_chunks,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test statistics of writing.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_statistics_read(
+	     number_of_chunks,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test statistics of reading.\n" );
+
+		goto on_error;
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_statistics" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	ewf_test_image_remove_segment_files(
+	 "ewf_test_statistics" );
+
+	return( EXIT_FAILURE );
+}
+
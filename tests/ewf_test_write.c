@@ -38,6 +38,16 @@
  */
 
 #define EWF_TEST_WRITE_BUFFER_SIZE		4096
+#define EWF_TEST_WRITE_NUMBER_OF_THREADS	4
+
+#define EWF_TEST_WRITE_EXIT_IGNORE		77
+
+/* The library only supports direct IO with the POSIX positional read and write
+ * functions and aligned memory allocation, refer to libewf_direct_io_handle.h
+ */
+#if !defined( WINAPI ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && defined( HAVE_STAT )
+#define EWF_TEST_WRITE_HAVE_DIRECT_IO
+#endif
 
 /* Tests writing data of media size to EWF file(s) with a maximum segment size
  * Return 1 if successful, 0 if not or -1 on error
@@ -46,8 +56,10 @@ int ewf_test_write(
      const libcstring_system_character_t *filename,
      size64_t media_size,
      size64_t maximum_segment_size,
+     uint16_t compression_method,
      int8_t compression_level,
      uint8_t compression_flags,
+     int additional_access_flags,
      libcerror_error_t **error )
 {
 	libewf_handle_t *handle = NULL;
@@ -75,14 +87,14 @@ int ewf_test_write(
 	     handle,
 	     (wchar_t * const *) &filename,
 	     1,
-	     LIBEWF_OPEN_WRITE,
+	     LIBEWF_OPEN_WRITE | additional_access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     handle,
 	     (char * const *) &filename,
 	     1,
-	     LIBEWF_OPEN_WRITE,
+	     LIBEWF_OPEN_WRITE | additional_access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -129,6 +141,39 @@ int ewf_test_write(
 			goto on_error;
 		}
 	}
+	if( compression_method != LIBEWF_COMPRESSION_METHOD_NONE )
+	{
+		/* The format needs to be set before the compression method
+		 */
+		if( libewf_handle_set_format(
+		     handle,
+		     LIBEWF_FORMAT_V2_ENCASE7,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set format.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_set_compression_method(
+		     handle,
+		     compression_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set compression method.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_handle_set_compression_values(
 	     handle,
 	     compression_level,
@@ -144,6 +189,20 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	if( libewf_handle_set_number_of_compression_threads(
+	     handle,
+	     EWF_TEST_WRITE_NUMBER_OF_THREADS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set number of compression threads.",
+		 function );
+
+		goto on_error;
+	}
 	buffer = (uint8_t *) memory_allocate(
 	                      EWF_TEST_WRITE_BUFFER_SIZE );
 
@@ -325,6 +384,351 @@ on_error:
 	return( -1 );
 }
 
+/* Tests reading back the data written by ewf_test_write
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_write_read_back(
+     const libcstring_system_character_t *filename,
+     uint16_t compression_method,
+     size64_t media_size,
+     int additional_access_flags,
+     libcerror_error_t **error )
+{
+	libcstring_system_character_t **filenames        = NULL;
+	libcstring_system_character_t *segment_filename  = NULL;
+	libewf_handle_t *handle                          = NULL;
+	uint8_t *buffer                                  = NULL;
+	uint8_t *expected_buffer                         = NULL;
+	static char *function                            = "ewf_test_write_read_back";
+	const libcstring_system_character_t *extension   = NULL;
+	size_t filename_length                           = 0;
+	size_t read_size                                 = 0;
+	ssize_t read_count                               = 0;
+	int fill_value                                   = 0;
+	int number_of_filenames                          = 0;
+	int result                                       = 1;
+	int sector_iterator                              = 0;
+	int write_iterator                               = 0;
+
+	if( compression_method != LIBEWF_COMPRESSION_METHOD_NONE )
+	{
+		extension = _LIBCSTRING_SYSTEM_STRING( ".Ex01" );
+	}
+	else
+	{
+		extension = _LIBCSTRING_SYSTEM_STRING( ".E01" );
+	}
+	filename_length = libcstring_system_string_length(
+	                   filename );
+
+	segment_filename = libcstring_system_string_allocate(
+	                    filename_length + 6 );
+
+	if( segment_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     segment_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( segment_filename[ filename_length ] ),
+	     extension,
+	     libcstring_system_string_length( extension ) + 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     segment_filename,
+	     libcstring_system_string_length( segment_filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     segment_filename,
+	     libcstring_system_string_length( segment_filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ | additional_access_flags,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ | additional_access_flags,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_WRITE_BUFFER_SIZE );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               EWF_TEST_WRITE_BUFFER_SIZE );
+
+	if( ( buffer == NULL )
+	 || ( expected_buffer == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable created buffers.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data is read back in the same sizes as ewf_test_write wrote it
+	 */
+	for( write_iterator = 0;
+	     write_iterator < 2;
+	     write_iterator++ )
+	{
+		for( sector_iterator = 0;
+		     sector_iterator < 26;
+		     sector_iterator++ )
+		{
+			if( write_iterator == 0 )
+			{
+				read_size  = 512;
+				fill_value = (int) 'A' + sector_iterator;
+			}
+			else
+			{
+				read_size  = 3751;
+				fill_value = (int) 'a' + sector_iterator;
+			}
+			if( memory_set(
+			     expected_buffer,
+			     fill_value,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable set value in expected buffer.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( media_size > 0 )
+			 && ( (size64_t) read_size > media_size ) )
+			{
+				read_size = (size_t) media_size;
+			}
+			if( read_size == 0 )
+			{
+				break;
+			}
+			read_count = libewf_handle_read_buffer(
+			              handle,
+			              buffer,
+			              read_size,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable read buffer of size: %" PRIzd ".",
+				 function,
+				 read_size );
+
+				goto on_error;
+			}
+			if( memory_compare(
+			     buffer,
+			     expected_buffer,
+			     read_size ) != 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch in data read back of size: %" PRIzd ".\n",
+				 read_size );
+
+				result = 0;
+			}
+			if( media_size > 0 )
+			{
+				media_size -= read_count;
+			}
+		}
+	}
+	memory_free(
+	 expected_buffer );
+
+	expected_buffer = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free glob.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 segment_filename );
+
+	return( result );
+
+on_error:
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
@@ -335,6 +739,7 @@ int main( int argc, char * const argv[] )
 {
 	libcstring_system_character_t *option_chunk_size           = NULL;
 	libcstring_system_character_t *option_compression_level    = NULL;
+	libcstring_system_character_t *option_compression_method   = NULL;
 	libcstring_system_character_t *option_maximum_segment_size = NULL;
 	libcstring_system_character_t *option_media_size           = NULL;
 	libcerror_error_t *error                                   = NULL;
@@ -343,13 +748,16 @@ int main( int argc, char * const argv[] )
 	size64_t maximum_segment_size                              = 0;
 	size64_t media_size                                        = 0;
 	size_t string_length                                       = 0;
+	uint16_t compression_method                                = LIBEWF_COMPRESSION_METHOD_NONE;
 	uint8_t compression_flags                                  = 0;
 	int8_t compression_level                                   = LIBEWF_COMPRESSION_NONE;
+	int additional_access_flags                                = 0;
+	int result                                                 = 0;
 
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:S:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:dm:S:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -377,6 +785,20 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'd':
+#if defined( EWF_TEST_WRITE_HAVE_DIRECT_IO )
+				additional_access_flags = LIBEWF_ACCESS_FLAG_DIRECT_IO;
+
+				break;
+#else
+				return( EWF_TEST_WRITE_EXIT_IGNORE );
+#endif
+
+			case (libcstring_system_integer_t) 'm':
+				option_compression_method = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
@@ -458,6 +880,51 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_compression_method != NULL )
+	{
+		string_length = libcstring_system_string_length(
+				 option_compression_method );
+
+		if( string_length != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression method.\n" );
+
+			goto on_error;
+		}
+		/* Methods other than deflate are written using the EWF2 format
+		 * a test of a method the library was built without is skipped
+		 */
+		if( option_compression_method[ 0 ] == (libcstring_system_character_t) 'd' )
+		{
+			compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+		}
+		else if( option_compression_method[ 0 ] == (libcstring_system_character_t) 'l' )
+		{
+#if defined( HAVE_LIBLZ4 ) || defined( LZ4_DLL )
+			compression_method = LIBEWF_COMPRESSION_METHOD_LZ4;
+#else
+			return( EWF_TEST_WRITE_EXIT_IGNORE );
+#endif
+		}
+		else if( option_compression_method[ 0 ] == (libcstring_system_character_t) 'z' )
+		{
+#if defined( HAVE_LIBZSTD ) || defined( ZSTD_DLL )
+			compression_method = LIBEWF_COMPRESSION_METHOD_ZSTD;
+#else
+			return( EWF_TEST_WRITE_EXIT_IGNORE );
+#endif
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression method.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_maximum_segment_size != NULL )
 	{
 		string_length = libcstring_system_string_length(
@@ -498,8 +965,10 @@ int main( int argc, char * const argv[] )
 	     argv[ optind ],
 	     media_size,
 	     maximum_segment_size,
+	     compression_method,
 	     compression_level,
 	     compression_flags,
+	     additional_access_flags,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -508,6 +977,25 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_NONE )
+	 || ( additional_access_flags != 0 ) )
+	{
+		result = ewf_test_write_read_back(
+		          argv[ optind ],
+		          compression_method,
+		          media_size,
+		          additional_access_flags,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test read back of written data.\n" );
+
+			goto on_error;
+		}
+	}
 	return( EXIT_SUCCESS );
 
 on_error:
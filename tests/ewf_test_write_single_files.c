@@ -0,0 +1,982 @@
+/*
+ * Expert Witness Compression Format (EWF) library single files write testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_libhmac.h"
+
+#include "../libewf/ewf_ltree.h"
+#include "../libewf/ewf_section.h"
+
+#define EWF_TEST_WRITE_SINGLE_FILES_BUFFER_SIZE		4096
+#define EWF_TEST_WRITE_SINGLE_FILES_LTREE_STRING_SIZE	4096
+#define EWF_TEST_WRITE_SINGLE_FILES_MEDIA_SIZE		524288
+#define EWF_TEST_WRITE_SINGLE_FILES_NUMBER_OF_FILES	24
+
+/* The media data byte value at a specific offset
+ * so that the data of file entries at different offsets differs
+ */
+#define ewf_test_write_single_files_get_media_byte( offset ) \
+	(uint8_t) ( ( ( offset ) % 251 ) ^ ( ( offset ) >> 9 ) )
+
+typedef struct ewf_test_write_single_files_entry ewf_test_write_single_files_entry_t;
+
+struct ewf_test_write_single_files_entry
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The data offset
+	 */
+	int data_offset;
+
+	/* The data size
+	 */
+	int data_size;
+};
+
+/* The file entries in the root directory
+ * the first dup.txt is stored after the second one in the media data so that
+ * exporting in media data order would let the second one win
+ */
+ewf_test_write_single_files_entry_t ewf_test_write_single_files_root_entries[ 3 ] = {
+	{ "dup.txt", 0x00008000, 3000 },
+	{ "dup.txt", 0x00000000, 5000 },
+	{ "large.bin", 0x00040000, 196731 } };
+
+/* The file entries in the dir directory after its numbered files
+ */
+ewf_test_write_single_files_entry_t ewf_test_write_single_files_dir_entries[ 2 ] = {
+	{ "dup.txt", 0x00009000, 2500 },
+	{ "dup.txt", 0x00008800, 100 } };
+
+/* Calculates the Adler-32 checksum of the data
+ */
+uint32_t ewf_test_write_single_files_calculate_adler32(
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_index   = 0;
+	uint32_t lower_word = 1;
+	uint32_t upper_word = 0;
+
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index++ )
+	{
+		lower_word = ( lower_word + data[ data_index ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Writes the media data to a EWF file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_single_files_write_media(
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_TEST_WRITE_SINGLE_FILES_BUFFER_SIZE ];
+
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_write_single_files_write_media";
+	size_t buffer_index     = 0;
+	ssize_t write_count     = 0;
+	off64_t media_offset    = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) EWF_TEST_WRITE_SINGLE_FILES_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_offset < (off64_t) EWF_TEST_WRITE_SINGLE_FILES_MEDIA_SIZE )
+	{
+		for( buffer_index = 0;
+		     buffer_index < EWF_TEST_WRITE_SINGLE_FILES_BUFFER_SIZE;
+		     buffer_index++ )
+		{
+			buffer[ buffer_index ] = ewf_test_write_single_files_get_media_byte(
+			                          media_offset + (off64_t) buffer_index );
+		}
+		write_count = libewf_handle_write_buffer(
+			       handle,
+			       buffer,
+			       EWF_TEST_WRITE_SINGLE_FILES_BUFFER_SIZE,
+			       error );
+
+		if( write_count != (ssize_t) EWF_TEST_WRITE_SINGLE_FILES_BUFFER_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write buffer at offset: %" PRIi64 ".",
+			 function,
+			 media_offset );
+
+			goto on_error;
+		}
+		media_offset += write_count;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends a directory entry to the ltree string
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_single_files_append_directory_entry(
+     char *ltree_string,
+     size_t ltree_string_size,
+     size_t *ltree_string_length,
+     const char *name,
+     int number_of_sub_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_write_single_files_append_directory_entry";
+	int print_count       = 0;
+
+	if( *ltree_string_length >= ltree_string_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = libcstring_narrow_string_snprintf(
+	               &( ltree_string[ *ltree_string_length ] ),
+	               ltree_string_size - *ltree_string_length,
+	               "0\t%d\n1\t%s\t\t\n",
+	               number_of_sub_entries,
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( ltree_string_size - *ltree_string_length ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set directory entry: %s.",
+		 function,
+		 name );
+
+		return( -1 );
+	}
+	*ltree_string_length += (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Appends a file entry to the ltree string
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_single_files_append_file_entry(
+     char *ltree_string,
+     size_t ltree_string_size,
+     size_t *ltree_string_length,
+     const char *name,
+     int data_offset,
+     int data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_write_single_files_append_file_entry";
+	int print_count       = 0;
+
+	if( *ltree_string_length >= ltree_string_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data offset values consist of: unknown, offset and size in hexadecimal
+	 */
+	print_count = libcstring_narrow_string_snprintf(
+	               &( ltree_string[ *ltree_string_length ] ),
+	               ltree_string_size - *ltree_string_length,
+	               "0\t0\n\t%s\t%d\t1 %x %x\n",
+	               name,
+	               data_size,
+	               data_offset,
+	               data_size );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( ltree_string_size - *ltree_string_length ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file entry: %s.",
+		 function,
+		 name );
+
+		return( -1 );
+	}
+	*ltree_string_length += (size_t) print_count;
+
+	return( 1 );
+}
+
+/* Creates the ltree string
+ * the root contains 2 files named dup.txt, large.bin and dir
+ * dir contains the numbered files and 2 files named dup.txt
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_single_files_get_ltree_string(
+     char *ltree_string,
+     size_t ltree_string_size,
+     size_t *ltree_string_length,
+     libcerror_error_t **error )
+{
+	char name[ 16 ];
+
+	static char *function = "ewf_test_write_single_files_get_ltree_string";
+	int entry_index       = 0;
+	int print_count       = 0;
+
+	print_count = libcstring_narrow_string_snprintf(
+	               ltree_string,
+	               ltree_string_size,
+	               "5\nrec\ntb\tcl\n%d\t0\nentry\n1\np\tn\tls\tbe\n",
+	               EWF_TEST_WRITE_SINGLE_FILES_MEDIA_SIZE );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ltree_string_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ltree header.",
+		 function );
+
+		return( -1 );
+	}
+	*ltree_string_length = (size_t) print_count;
+
+	if( ewf_test_write_single_files_append_directory_entry(
+	     ltree_string,
+	     ltree_string_size,
+	     ltree_string_length,
+	     "",
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append root directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < 3;
+	     entry_index++ )
+	{
+		if( ewf_test_write_single_files_append_file_entry(
+		     ltree_string,
+		     ltree_string_size,
+		     ltree_string_length,
+		     ewf_test_write_single_files_root_entries[ entry_index ].name,
+		     ewf_test_write_single_files_root_entries[ entry_index ].data_offset,
+		     ewf_test_write_single_files_root_entries[ entry_index ].data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append root file entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	if( ewf_test_write_single_files_append_directory_entry(
+	     ltree_string,
+	     ltree_string_size,
+	     ltree_string_length,
+	     "dir",
+	     EWF_TEST_WRITE_SINGLE_FILES_NUMBER_OF_FILES + 2,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append dir directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* The numbered files are stored in reverse media data order
+	 */
+	for( entry_index = 0;
+	     entry_index < EWF_TEST_WRITE_SINGLE_FILES_NUMBER_OF_FILES;
+	     entry_index++ )
+	{
+		print_count = libcstring_narrow_string_snprintf(
+		               name,
+		               16,
+		               "file%02d",
+		               entry_index );
+
+		if( ( print_count < 0 )
+		 || ( print_count >= 16 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( ewf_test_write_single_files_append_file_entry(
+		     ltree_string,
+		     ltree_string_size,
+		     ltree_string_length,
+		     name,
+		     0x00010000 + ( ( EWF_TEST_WRITE_SINGLE_FILES_NUMBER_OF_FILES - 1 - entry_index ) * 0x00002000 ),
+		     0x00001000 + ( entry_index * 131 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append dir file entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		if( ewf_test_write_single_files_append_file_entry(
+		     ltree_string,
+		     ltree_string_size,
+		     ltree_string_length,
+		     ewf_test_write_single_files_dir_entries[ entry_index ].name,
+		     ewf_test_write_single_files_dir_entries[ entry_index ].data_offset,
+		     ewf_test_write_single_files_dir_entries[ entry_index ].data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append dir file entry: %s.",
+			 function,
+			 ewf_test_write_single_files_dir_entries[ entry_index ].name );
+
+			return( -1 );
+		}
+	}
+	if( *ltree_string_length >= ( ltree_string_size - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	ltree_string[ *ltree_string_length ] = '\n';
+
+	*ltree_string_length += 1;
+
+	return( 1 );
+}
+
+/* Inserts a version 1 ltree section before the done section of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_single_files_insert_ltree_section(
+     const libcstring_system_character_t *filename,
+     libcerror_error_t **error )
+{
+	char ltree_string[ EWF_TEST_WRITE_SINGLE_FILES_LTREE_STRING_SIZE ];
+
+	ewf_ltree_header_t *ltree_header                     = NULL;
+	ewf_section_descriptor_v1_t *done_section_descriptor = NULL;
+	ewf_section_descriptor_v1_t *section_descriptor      = NULL;
+	libcfile_file_t *file                                = NULL;
+	uint8_t *ltree_data                                  = NULL;
+	uint8_t *section_data                                = NULL;
+	static char *function                                = "ewf_test_write_single_files_insert_ltree_section";
+	size64_t file_size                                   = 0;
+	size_t ltree_data_size                               = 0;
+	size_t ltree_string_index                            = 0;
+	size_t ltree_string_length                           = 0;
+	size_t section_data_size                             = 0;
+	size_t section_size                                  = 0;
+	ssize_t read_count                                   = 0;
+	ssize_t write_count                                  = 0;
+	uint32_t checksum                                    = 0;
+	off64_t done_section_offset                          = 0;
+
+	if( ewf_test_write_single_files_get_ltree_string(
+	     ltree_string,
+	     EWF_TEST_WRITE_SINGLE_FILES_LTREE_STRING_SIZE,
+	     &ltree_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve ltree string.",
+		 function );
+
+		goto on_error;
+	}
+	/* The section consists of the section descriptor, the ltree header
+	 * and the ltree data, which is followed by the done section descriptor
+	 */
+	ltree_data_size = 2 * ltree_string_length;
+	section_size    = sizeof( ewf_section_descriptor_v1_t )
+	                + sizeof( ewf_ltree_header_t )
+	                + ltree_data_size;
+
+	section_data_size = section_size + sizeof( ewf_section_descriptor_v1_t );
+
+	section_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * section_data_size );
+
+	if( section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     section_data,
+	     0,
+	     sizeof( uint8_t ) * section_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section data.",
+		 function );
+
+		goto on_error;
+	}
+	section_descriptor      = (ewf_section_descriptor_v1_t *) section_data;
+	ltree_header            = (ewf_ltree_header_t *) &( section_data[ sizeof( ewf_section_descriptor_v1_t ) ] );
+	ltree_data              = &( section_data[ sizeof( ewf_section_descriptor_v1_t ) + sizeof( ewf_ltree_header_t ) ] );
+	done_section_descriptor = (ewf_section_descriptor_v1_t *) &( section_data[ section_size ] );
+
+	/* The ltree data is stored as UTF-16 little-endian
+	 */
+	for( ltree_string_index = 0;
+	     ltree_string_index < ltree_string_length;
+	     ltree_string_index++ )
+	{
+		ltree_data[ 2 * ltree_string_index ] = (uint8_t) ltree_string[ ltree_string_index ];
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size < (size64_t) sizeof( ewf_section_descriptor_v1_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The done section descriptor is stored at the end of the last segment file
+	 */
+	done_section_offset = (off64_t) ( file_size - sizeof( ewf_section_descriptor_v1_t ) );
+
+	if( libcfile_file_seek_offset(
+	     file,
+	     done_section_offset,
+	     SEEK_SET,
+	     error ) != done_section_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek done section offset: %" PRIi64 ".",
+		 function,
+		 done_section_offset );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              (uint8_t *) done_section_descriptor,
+	              sizeof( ewf_section_descriptor_v1_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( ewf_section_descriptor_v1_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read done section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     done_section_descriptor->type_string,
+	     "done",
+	     5 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported last section type.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_md5_calculate(
+	     ltree_data,
+	     ltree_data_size,
+	     ltree_header->integrity_hash,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate integrity hash.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 ltree_header->data_size,
+	 ltree_data_size );
+
+	checksum = ewf_test_write_single_files_calculate_adler32(
+	            (uint8_t *) ltree_header,
+	            sizeof( ewf_ltree_header_t ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ltree_header->checksum,
+	 checksum );
+
+	if( memory_copy(
+	     section_descriptor->type_string,
+	     "ltree",
+	     5 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy section type string.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 section_descriptor->next_offset,
+	 done_section_offset + section_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 section_descriptor->size,
+	 section_size );
+
+	checksum = ewf_test_write_single_files_calculate_adler32(
+	            (uint8_t *) section_descriptor,
+	            sizeof( ewf_section_descriptor_v1_t ) - 4 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 section_descriptor->checksum,
+	 checksum );
+
+	/* The next offset of the done section refers to itself
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 done_section_descriptor->next_offset,
+	 done_section_offset + section_size );
+
+	checksum = ewf_test_write_single_files_calculate_adler32(
+	            (uint8_t *) done_section_descriptor,
+	            sizeof( ewf_section_descriptor_v1_t ) - 4 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 done_section_descriptor->checksum,
+	 checksum );
+
+	if( libcfile_file_seek_offset(
+	     file,
+	     done_section_offset,
+	     SEEK_SET,
+	     error ) != done_section_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek done section offset: %" PRIi64 ".",
+		 function,
+		 done_section_offset );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               section_data,
+	               section_data_size,
+	               error );
+
+	if( write_count != (ssize_t) section_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write section data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 section_data );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t *segment_filename = NULL;
+	libcerror_error_t *error                        = NULL;
+	size_t filename_length                          = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( ewf_test_write_single_files_write_media(
+	     argv[ 1 ],
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write media data.\n" );
+
+		goto on_error;
+	}
+	filename_length = libcstring_system_string_length(
+	                   argv[ 1 ] );
+
+	segment_filename = libcstring_system_string_allocate(
+	                    filename_length + 5 );
+
+	if( segment_filename == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create segment filename.\n" );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     segment_filename,
+	     argv[ 1 ],
+	     filename_length ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to copy filename.\n" );
+
+		goto on_error;
+	}
+	if( libcstring_system_string_copy(
+	     &( segment_filename[ filename_length ] ),
+	     _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	     5 ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to copy extension.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_write_single_files_insert_ltree_section(
+	     segment_filename,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to insert ltree section.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 segment_filename );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	return( EXIT_FAILURE );
+}
+
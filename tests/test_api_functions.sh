@@ -11,8 +11,8 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-TEST_FUNCTIONS="get_version";
-TEST_FUNCTIONS_WITH_INPUT="open_close seek read read_chunk handle_get_values";
+TEST_FUNCTIONS="chunk_data_pool data_chunk_passthrough deflate file_handle_pool get_version handle_get_fill_range integrity_hash lazy_open lru_cache memory_map mount_handle nbd_server pattern_fill single_file_tree single_files statistics";
+TEST_FUNCTIONS_WITH_INPUT="open_close seek read read_chunk handle_get_values index_file";
 OPTION_SETS="";
 
 TEST_TOOL_DIRECTORY=".";
@@ -68,6 +68,121 @@ test_callback()
 	return ${RESULT};
 }
 
+get_md5_hash()
+{
+	local FILENAME=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q ${FILENAME};
+	else
+		md5sum ${FILENAME} | cut -d ' ' -f 1;
+	fi
+}
+
+get_allocated_size()
+{
+	local FILENAME=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		echo $(( `stat -f %b ${FILENAME}` * 512 ));
+	else
+		echo $(( `stat -c "%b * %B" ${FILENAME}` ));
+	fi
+}
+
+test_export_sparse()
+{
+	local ACQUIRESTREAM_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}acquirestream";
+
+	if ! test -x "${ACQUIRESTREAM_TOOL}";
+	then
+		ACQUIRESTREAM_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}acquirestream.exe";
+	fi
+
+	if ! test -x "${ACQUIRESTREAM_TOOL}";
+	then
+		echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+		return ${EXIT_FAILURE};
+	fi
+
+	echo -n "Testing ${TEST_DESCRIPTION} of zero-filled chunks to a sparse and a segmented raw file";
+
+	local TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	# The media data starts and ends with zero-filled chunks and the last chunk is partial
+	head -c 1048576 /dev/zero > ${TMPDIR}/media.raw;
+	yes "libewf" | head -c 65536 >> ${TMPDIR}/media.raw;
+	head -c 2035712 /dev/zero >> ${TMPDIR}/media.raw;
+
+	${ACQUIRESTREAM_TOOL} -c fast -q -t ${TMPDIR}/sparse < ${TMPDIR}/media.raw > /dev/null;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -fraw -q -t ${TMPDIR}/export-sparse -u ${TMPDIR}/sparse.E01 > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -fraw -q -S 1048576 -t ${TMPDIR}/export-segments -u ${TMPDIR}/sparse.E01 > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		cat ${TMPDIR}/export-segments.* > ${TMPDIR}/segments.raw;
+		RESULT=$?;
+	fi
+	local MEDIA_SIZE=`wc -c < ${TMPDIR}/media.raw`;
+	local MEDIA_HASH=`get_md5_hash ${TMPDIR}/media.raw`;
+
+	for EXPORT_FILE in "export-sparse.raw" "segments.raw";
+	do
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+		local EXPORT_SIZE=`wc -c < ${TMPDIR}/${EXPORT_FILE}`;
+		local EXPORT_HASH=`get_md5_hash ${TMPDIR}/${EXPORT_FILE}`;
+
+		if test ${EXPORT_SIZE} -ne ${MEDIA_SIZE} || test "${EXPORT_HASH}" != "${MEDIA_HASH}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	done
+
+	# The zero-filled chunks of the sparse raw file should not be allocated,
+	# this is only checked if the file system supports sparse files
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		dd if=/dev/zero of=${TMPDIR}/hole.raw bs=1 count=0 seek=${MEDIA_SIZE} 2> /dev/null;
+
+		if test `get_allocated_size ${TMPDIR}/hole.raw` -lt ${MEDIA_SIZE};
+		then
+			local ALLOCATED_SIZE=`get_allocated_size ${TMPDIR}/export-sparse.raw`;
+
+			if test ${ALLOCATED_SIZE} -ge ${MEDIA_SIZE};
+			then
+				RESULT=${EXIT_FAILURE};
+			fi
+		fi
+	fi
+	rm -rf ${TMPDIR};
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_TOOLS_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -129,5 +244,11 @@ fi
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -q -texport -u;
 RESULT=$?;
 
+if test ${RESULT} -eq ${EXIT_SUCCESS} || test ${RESULT} -eq ${EXIT_IGNORE};
+then
+	test_export_sparse;
+	RESULT=$?;
+fi
+
 exit ${RESULT};
 
@@ -62,6 +62,81 @@ test_callback()
 	return ${RESULT};
 }
 
+test_export_single_files_threads()
+{
+	local WRITE_SINGLE_FILES_TOOL="./${TEST_PREFIX}_test_write_single_files";
+
+	if ! test -x "${WRITE_SINGLE_FILES_TOOL}";
+	then
+		WRITE_SINGLE_FILES_TOOL="./${TEST_PREFIX}_test_write_single_files.exe";
+	fi
+
+	if ! test -x "${WRITE_SINGLE_FILES_TOOL}";
+	then
+		echo "Missing executable: ${WRITE_SINGLE_FILES_TOOL}";
+
+		return ${EXIT_FAILURE};
+	fi
+
+	echo -n "Testing ${TEST_DESCRIPTION} of single files with duplicate names with and without threads";
+
+	local TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	${WRITE_SINGLE_FILES_TOOL} ${TMPDIR}/single_files;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -fraw -q -t ${TMPDIR}/media -u ${TMPDIR}/single_files.E01 > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -ffiles -j0 -q -t ${TMPDIR}/export-single -u ${TMPDIR}/single_files.E01 > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -ffiles -j4 -q -t ${TMPDIR}/export-threads -u ${TMPDIR}/single_files.E01 > /dev/null;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		diff -r ${TMPDIR}/export-single ${TMPDIR}/export-threads;
+		RESULT=$?;
+	fi
+	# Of the file entries with the same name the first one in the ltree must be exported
+	# the values are: path, media data offset and size
+	for FILE_ENTRY in "dup.txt:32768:3000" "dir/dup.txt:36864:2500" "dir/file00:253952:4096" "large.bin:262144:196731";
+	do
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+		local FILE_ENTRY_PATH=`echo ${FILE_ENTRY} | cut -d: -f1`;
+		local FILE_ENTRY_OFFSET=`echo ${FILE_ENTRY} | cut -d: -f2`;
+		local FILE_ENTRY_SIZE=`echo ${FILE_ENTRY} | cut -d: -f3`;
+
+		tail -c +$(( ${FILE_ENTRY_OFFSET} + 1 )) ${TMPDIR}/media.raw | head -c ${FILE_ENTRY_SIZE} > ${TMPDIR}/expected;
+
+		cmp -s ${TMPDIR}/expected ${TMPDIR}/export-single/${FILE_ENTRY_PATH} && cmp -s ${TMPDIR}/expected ${TMPDIR}/export-threads/${FILE_ENTRY_PATH};
+		RESULT=$?;
+	done
+
+	rm -rf ${TMPDIR};
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_TOOLS_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -111,5 +186,23 @@ fi
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -ffiles -q -texport -u;
 RESULT=$?;
 
+# The single files exported sequentially and by the export threads
+# must match the stored reference
+for EXPORT_OPTIONS in "-j0" "-j4";
+do
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+	run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -ffiles ${EXPORT_OPTIONS} -q -texport -u;
+	RESULT=$?;
+done
+
+if test ${RESULT} -eq ${EXIT_SUCCESS} || test ${RESULT} -eq ${EXIT_IGNORE};
+then
+	test_export_single_files_threads;
+	RESULT=$?;
+fi
+
 exit ${RESULT};
 
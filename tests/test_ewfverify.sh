@@ -20,6 +20,70 @@ TEST_TOOL="${TEST_PREFIX}${TEST_SUFFIX}";
 INPUT_DIRECTORY="input";
 INPUT_GLOB="*.[Ees]*01";
 
+test_verify_threads_corrupted_chunk()
+{
+	local VERIFY_OPTIONS=$1;
+
+	local ACQUIRESTREAM_TOOL="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}acquirestream";
+
+	if ! test -x "${ACQUIRESTREAM_TOOL}";
+	then
+		ACQUIRESTREAM_TOOL="${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}acquirestream.exe";
+	fi
+
+	if ! test -x "${ACQUIRESTREAM_TOOL}";
+	then
+		echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+		return ${EXIT_FAILURE};
+	fi
+
+	echo -n "Testing ${TEST_DESCRIPTION} with options: ${VERIFY_OPTIONS} of corrupted chunk with and without threads";
+
+	local TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	# Store the chunks uncompressed so that the corrupted chunk fails its checksum
+	dd if=/dev/urandom of=${TMPDIR}/input.raw bs=32768 count=64 2> /dev/null;
+
+	${ACQUIRESTREAM_TOOL} -c none -q -t ${TMPDIR}/verify < ${TMPDIR}/input.raw > /dev/null;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local FILE_SIZE=`wc -c < ${TMPDIR}/verify.E01`;
+
+		printf '\377\377\377\377\377\377\377\377' | dd of=${TMPDIR}/verify.E01 bs=1 seek=$(( ${FILE_SIZE} / 2 )) count=8 conv=notrunc 2> /dev/null;
+
+		${TEST_EXECUTABLE} -q -j0 ${VERIFY_OPTIONS} ${TMPDIR}/verify.E01 | sed '1,2d' > ${TMPDIR}/verify-single.log;
+		local SINGLE_RESULT=${PIPESTATUS[0]};
+
+		${TEST_EXECUTABLE} -q -j4 ${VERIFY_OPTIONS} ${TMPDIR}/verify.E01 | sed '1,2d' > ${TMPDIR}/verify-threads.log;
+		local THREADS_RESULT=${PIPESTATUS[0]};
+
+		# The corrupted chunk must be reported and hashed the same way by the process threads
+		if test ${SINGLE_RESULT} -eq ${EXIT_SUCCESS} || test ${SINGLE_RESULT} -ne ${THREADS_RESULT};
+		then
+			RESULT=${EXIT_FAILURE};
+		else
+			diff ${TMPDIR}/verify-single.log ${TMPDIR}/verify-threads.log;
+			RESULT=$?;
+		fi
+	fi
+
+	rm -rf ${TMPDIR};
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_TOOLS_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -58,5 +122,27 @@ source ${TEST_RUNNER};
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_stdout_reference" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -q;
 RESULT=$?;
 
+# The output of reading in the process threads, both buffered and per chunk,
+# must match the stored single-threaded reference
+for VERIFY_OPTIONS in "-j0" "-j4" "-j0 -x" "-j4 -x";
+do
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+	run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_stdout_reference" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -q ${VERIFY_OPTIONS};
+	RESULT=$?;
+done
+
+for VERIFY_OPTIONS in "" "-x";
+do
+	if test ${RESULT} -ne ${EXIT_SUCCESS} && test ${RESULT} -ne ${EXIT_IGNORE};
+	then
+		break;
+	fi
+	test_verify_threads_corrupted_chunk "${VERIFY_OPTIONS}";
+	RESULT=$?;
+done
+
 exit ${RESULT};
 
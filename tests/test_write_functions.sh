@@ -50,7 +50,10 @@ test_api_write_function()
 
 	echo -n "Testing write function: lib${TEST_PREFIX}_${TEST_FUNCTION}";
 
-	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	if test ${RESULT} -eq ${EXIT_IGNORE};
+	then
+		echo " (SKIP)";
+	elif test ${RESULT} -ne ${EXIT_SUCCESS};
 	then
 		echo " (FAIL)";
 	else
@@ -107,6 +110,73 @@ test_write()
 	return ${RESULT};
 }
 
+test_write_compression_methods()
+{
+	local TEST_FUNCTION=$1;
+
+	# The zstd and lz4 tests are ignored if the library was built without support
+	for COMPRESSION_METHOD in deflate zstd lz4;
+	do
+		COMPRESSION_METHOD=`echo ${COMPRESSION_METHOD} | cut -c 1`;
+
+		for COMPRESSION_LEVEL in fast best;
+		do
+			COMPRESSION_LEVEL=`echo ${COMPRESSION_LEVEL} | cut -c 1`;
+
+			test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -m${COMPRESSION_METHOD} -S10000;
+			RESULT=$?;
+
+			if test ${RESULT} -eq ${EXIT_IGNORE};
+			then
+				RESULT=${EXIT_SUCCESS};
+
+				break;
+			fi
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+		done
+	done
+
+	return ${RESULT};
+}
+
+test_write_direct_io()
+{
+	local TEST_FUNCTION=$1;
+
+	# The direct IO tests are ignored if the library was built without support
+	for COMPRESSION_LEVEL in none fast;
+	do
+		COMPRESSION_LEVEL=`echo ${COMPRESSION_LEVEL} | cut -c 1`;
+
+		for MAXIMUM_SEGMENT_SIZE in 0 10000;
+		do
+			test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -d -S${MAXIMUM_SEGMENT_SIZE};
+			RESULT=$?;
+
+			if test ${RESULT} -eq ${EXIT_IGNORE};
+			then
+				return ${EXIT_SUCCESS};
+			fi
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+		done
+	done
+
+	test_api_write_function "${TEST_FUNCTION}" -B100000 -cf -md -d -S10000;
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_IGNORE};
+	then
+		RESULT=${EXIT_SUCCESS};
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_LIBRARY_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -137,6 +207,25 @@ do
 	then
 		break;
 	fi
+
+	if test "${TEST_FUNCTION}" = "write";
+	then
+		test_write_compression_methods "${TEST_FUNCTION}";
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+
+		test_write_direct_io "${TEST_FUNCTION}";
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			break;
+		fi
+	fi
 done
 
 exit ${RESULT};